@@ -22,6 +22,15 @@
 
 namespace QuantLib {
 
+    void Lattice::rollbackAll(const std::vector<DiscretizedAsset*>& assets,
+                              Time to) const {
+        for (auto* asset : assets) {
+            QL_REQUIRE(asset->method().get() == this,
+                       "asset not initialized on this lattice");
+            rollback(*asset, to);
+        }
+    }
+
     void DiscretizedOption::postAdjustValuesImpl() {
         /* In the real world, with time flowing forward, first
            any payment is settled and only after options can be
@@ -16,6 +16,7 @@
 #include <ql/experimental/credit/defaultprobabilitylatentmodel.hpp>
 #include <ql/experimental/credit/defaulttype.hpp>
 #include <ql/experimental/credit/distribution.hpp>
+#include <ql/experimental/credit/exposuresimulation.hpp>
 #include <ql/experimental/credit/factorspreadedhazardratecurve.hpp>
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
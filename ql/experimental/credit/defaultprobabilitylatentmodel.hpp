@@ -23,6 +23,7 @@
 #include <ql/experimental/credit/basket.hpp>
 #include <ql/experimental/math/latentmodel.hpp>
 #include <ql/experimental/math/gaussiancopulapolicy.hpp>
+#include <ql/math/matrix.hpp>
 #include <boost/dynamic_bitset.hpp>
 
 namespace QuantLib {
@@ -163,6 +164,24 @@ namespace QuantLib {
 
             return res;
         }
+        /*! Returns the default probabilities of all names (columns)
+        conditional on each of the given realizations of the model factors
+        (rows.) The rows are computed in parallel when OpenMP is enabled.
+        @param invCumYProbs Inverted unconditional default probabilities,
+            as in conditionalDefaultProbabilityInvP.
+        */
+        Matrix conditionalDefaultProbabilitiesInvP(
+            const std::vector<Real>& invCumYProbs,
+            const std::vector<std::vector<Real> >& mktFactors) const {
+            Matrix result(mktFactors.size(), invCumYProbs.size());
+            #pragma omp parallel for
+            for (long k=0; k<(long)mktFactors.size(); ++k) {
+                for (Size iName=0; iName<invCumYProbs.size(); ++iName)
+                    result[k][iName] = conditionalDefaultProbabilityInvP(
+                        invCumYProbs[iName], iName, mktFactors[k]);
+            }
+            return result;
+        }
     protected:
         /*! Returns the probability of default of a given name conditional on
         the realization of a given set of values of the model independent
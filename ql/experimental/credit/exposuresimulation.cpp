@@ -0,0 +1,701 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/iborcoupon.hpp>
+#include <ql/exercise.hpp>
+#include <ql/experimental/credit/exposuresimulation.hpp>
+#include <ql/instruments/fxforward.hpp>
+#include <ql/instruments/swaption.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/math/solvers1d/brent.hpp>
+#include <ql/math/statistics/incrementalstatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <tuple>
+
+namespace QuantLib {
+
+    // Collects the cash flows of a set of trades at a given date and
+    // writes their value in terms of model discount bonds.
+    class ExposureSimulation::KernelBuilder {
+      public:
+        /* if pathFixings is true, the Ibor coupons fixing on or
+           before the date are assumed to be fixed on the path; their
+           fixings are registered in the given index. */
+        KernelBuilder(const ExposureSimulation& simulation,
+                      const Date& date,
+                      bool pathFixings,
+                      std::map<std::tuple<Date, Date, Date>, Size>* fixingIndex)
+        : simulation_(simulation), date_(date),
+          time_(simulation.termStructure_->timeFromReference(date)),
+          pathFixings_(pathFixings), fixingIndex_(fixingIndex),
+          fx_(simulation.fxRates_.size(), 0.0) {}
+
+        void addLeg(const Leg& leg, Real sign) {
+            const Date today = simulation_.termStructure_->referenceDate();
+            for (const auto& cf : leg) {
+                const Date payment = cf->date();
+                if (payment <= date_)
+                    continue;
+                auto coupon = ext::dynamic_pointer_cast<FloatingRateCoupon>(cf);
+                if (coupon == nullptr || coupon->fixingDate() <= today) {
+                    bonds_[payment] += sign * cf->amount();
+                    continue;
+                }
+                auto ibor = ext::dynamic_pointer_cast<IborCoupon>(coupon);
+                QL_REQUIRE(ibor != nullptr,
+                           "floating-rate coupons other than Ibor coupons "
+                           "are not supported");
+                addIborCoupon(*ibor, sign);
+            }
+        }
+
+        void addFxForward(const FxForward& forward) {
+            const Date payment = forward.maturityDate();
+            if (payment <= date_)
+                return;
+            Real sign = forward.paySourceCurrency() ? -1.0 : 1.0;
+            addFxAmount(forward.sourceCurrency(),
+                        sign * forward.sourceNominal(), payment);
+            addFxAmount(forward.targetCurrency(),
+                        -sign * forward.targetNominal(), payment);
+        }
+
+        Kernel kernel() {
+            Kernel result;
+            result.terms = forwardTerms();
+            for (const auto& p : pending_) {
+                std::pair<Real, Real> d = discount(p.first.second);
+                result.pending.push_back(
+                    {p.first.first, p.second, d.first, d.second});
+            }
+            result.fx = fx_;
+            return result;
+        }
+
+        std::vector<Term> terms() {
+            QL_REQUIRE(pending_.empty() &&
+                           std::find_if(fx_.begin(), fx_.end(),
+                                        [](Real w) { return w != 0.0; }) == fx_.end(),
+                       "internal error: cash flows depend on the path");
+            return forwardTerms();
+        }
+
+      private:
+        std::vector<Term> forwardTerms() {
+            std::vector<Term> result;
+            result.reserve(bonds_.size() + forwards_.size());
+            for (const auto& b : bonds_) {
+                std::pair<Real, Real> d = discount(b.first);
+                result.push_back({b.second, d.first, d.second});
+            }
+            for (const auto& f : forwards_) {
+                std::pair<Real, Real> s = discount(std::get<0>(f.first)),
+                                      e = discount(std::get<1>(f.first)),
+                                      p = discount(std::get<2>(f.first));
+                result.push_back({f.second, s.first + p.first - e.first,
+                                  s.second + p.second - e.second});
+            }
+            return result;
+        }
+
+        void addIborCoupon(const IborCoupon& coupon, Real sign) {
+            const ext::shared_ptr<IborIndex>& index = coupon.iborIndex();
+            const Date start = coupon.fixingValueDate(),
+                       end = coupon.fixingEndDate(),
+                       payment = coupon.date();
+            const Time span = coupon.spanningTime();
+            const Handle<YieldTermStructure>& curve = simulation_.termStructure_;
+
+            // deterministic basis between the forecasting curve of
+            // the index and the model curve
+            Real basis = 0.0;
+            if (!index->forwardingTermStructure().empty()) {
+                Rate modelForward =
+                    (curve->discount(start) / curve->discount(end) - 1.0) / span;
+                basis = coupon.indexFixing() - modelForward;
+            }
+
+            // the amount is c0 + c1 * P(s)/P(e) at the fixing
+            const Real accrual = sign * coupon.nominal() * coupon.accrualPeriod();
+            const Real c1 = accrual * coupon.gearing() / span;
+            const Real c0 =
+                accrual * (coupon.spread() +
+                           coupon.gearing() * (basis - 1.0 / span));
+            bonds_[payment] += c0;
+
+            if (pathFixings_ && coupon.fixingDate() <= date_) {
+                auto key = std::make_tuple(coupon.fixingDate(), start, end);
+                auto i = fixingIndex_->find(key);
+                if (i == fixingIndex_->end())
+                    i = fixingIndex_->emplace(key, fixingIndex_->size()).first;
+                pending_[std::make_pair(i->second, payment)] += c1;
+            } else {
+                forwards_[std::make_tuple(start, end, payment)] += c1;
+            }
+        }
+
+        void addFxAmount(const Currency& currency, Real amount,
+                         const Date& payment) {
+            if (currency == simulation_.currency_) {
+                bonds_[payment] += amount;
+                return;
+            }
+            const std::vector<FxRate>& rates = simulation_.fxRates_;
+            auto i = std::find_if(rates.begin(), rates.end(),
+                                  [&currency](const FxRate& r) {
+                                      return r.currency == currency;
+                                  });
+            QL_REQUIRE(i != rates.end(),
+                       "no FX rate given for " << currency.code());
+            const Handle<YieldTermStructure>& foreign = i->process->dividendYield();
+            fx_[i - rates.begin()] +=
+                amount * foreign->discount(payment) / foreign->discount(date_);
+        }
+
+        std::pair<Real, Real> discount(const Date& d) {
+            auto i = discounts_.find(d);
+            if (i == discounts_.end()) {
+                Time T = simulation_.termStructure_->timeFromReference(d);
+                i = discounts_.emplace(d, simulation_.logDiscount(time_, T)).first;
+            }
+            return i->second;
+        }
+
+        const ExposureSimulation& simulation_;
+        Date date_;
+        Time time_;
+        bool pathFixings_;
+        std::map<std::tuple<Date, Date, Date>, Size>* fixingIndex_;
+        std::map<Date, Real> bonds_;
+        std::map<std::tuple<Date, Date, Date>, Real> forwards_;
+        std::map<std::pair<Size, Date>, Real> pending_;
+        std::vector<Real> fx_;
+        std::map<Date, std::pair<Real, Real> > discounts_;
+    };
+
+
+    ExposureSimulation::ExposureSimulation(std::vector<Date> exposureDates,
+                                           Size samples,
+                                           Real confidenceLevel,
+                                           BigNatural seed,
+                                           Currency currency)
+    : dates_(std::move(exposureDates)), samples_(samples),
+      confidenceLevel_(confidenceLevel), seed_(seed),
+      currency_(std::move(currency)) {
+        QL_REQUIRE(!dates_.empty(), "no exposure dates given");
+        for (Size i=1; i<dates_.size(); ++i)
+            QL_REQUIRE(dates_[i] > dates_[i-1],
+                       "exposure dates must be sorted and unique");
+        QL_REQUIRE(samples_ > 0, "at least one sample required");
+        QL_REQUIRE(confidenceLevel_ > 0.0 && confidenceLevel_ < 1.0,
+                   "confidence level (" << confidenceLevel_
+                   << ") must be in (0.0, 1.0)");
+    }
+
+    ExposureSimulation::ExposureSimulation(const ext::shared_ptr<HullWhite>& model,
+                                           std::vector<Date> exposureDates,
+                                           Size samples,
+                                           Real confidenceLevel,
+                                           BigNatural seed,
+                                           Currency currency)
+    : ExposureSimulation(std::move(exposureDates), samples,
+                         confidenceLevel, seed, std::move(currency)) {
+        QL_REQUIRE(model, "null model");
+        termStructure_ = model->termStructure();
+        process_ = model->dynamics()->process();
+        ext::shared_ptr<OneFactorModel::ShortRateDynamics> dynamics =
+            model->dynamics();
+        discountBond_ = [model, dynamics](Time t, Time T, Real x) {
+            return model->discountBond(t, T, dynamics->shortRate(t, x));
+        };
+        registerWith(model);
+        registerWith(termStructure_);
+    }
+
+    ExposureSimulation::ExposureSimulation(const ext::shared_ptr<Gsr>& model,
+                                           std::vector<Date> exposureDates,
+                                           Size samples,
+                                           Real confidenceLevel,
+                                           BigNatural seed,
+                                           Currency currency)
+    : ExposureSimulation(std::move(exposureDates), samples,
+                         confidenceLevel, seed, std::move(currency)) {
+        QL_REQUIRE(model, "null model");
+        termStructure_ = model->termStructure();
+        process_ = model->stateProcess();
+        ext::shared_ptr<StochasticProcess1D> process = process_;
+        // the model works with the standardized state
+        discountBond_ = [model, process](Time t, Time T, Real x) {
+            if (t == 0.0)
+                return model->zerobond(T, 0.0, 0.0);
+            Real y = (x - process->expectation(0.0, 0.0, t)) /
+                     process->stdDeviation(0.0, 0.0, t);
+            return model->zerobond(T, t, y);
+        };
+        registerWith(model);
+        registerWith(termStructure_);
+    }
+
+    void ExposureSimulation::addFxRate(
+                   const Currency& currency,
+                   const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+                   Real correlationWithRates) {
+        QL_REQUIRE(process, "null process");
+        QL_REQUIRE(currency != currency_,
+                   "FX rate for the domestic currency given");
+        QL_REQUIRE(correlationWithRates >= -1.0 && correlationWithRates <= 1.0,
+                   "correlation (" << correlationWithRates
+                   << ") must be in [-1.0, 1.0]");
+        for (const auto& r : fxRates_)
+            QL_REQUIRE(r.currency != currency,
+                       "FX rate for " << currency.code() << " already given");
+        fxRates_.push_back(
+            {currency, process, correlationWithRates, {}, {}});
+        registerWith(process);
+        update();
+    }
+
+    Size ExposureSimulation::addNettingSet(
+                          std::vector<ext::shared_ptr<Instrument> > trades) {
+        for (const auto& trade : trades) {
+            QL_REQUIRE(trade, "null trade");
+            registerWith(trade);
+        }
+        trades_.push_back(std::move(trades));
+        update();
+        return trades_.size() - 1;
+    }
+
+    const ExposureProfile& ExposureSimulation::profile(Size nettingSet) const {
+        QL_REQUIRE(nettingSet < trades_.size(),
+                   "netting set " << nettingSet << " out of range");
+        calculate();
+        return profiles_[nettingSet];
+    }
+
+    std::pair<Real, Real> ExposureSimulation::logDiscount(Time t, Time T) const {
+        // the logarithm of the bond is affine in the state for the
+        // supported models, i.e., HullWhite and Gsr
+        Real p0 = std::log(discountBond_(t, T, 0.0));
+        Real p1 = std::log(discountBond_(t, T, 1.0));
+        return std::make_pair(p0, p0 - p1);
+    }
+
+    Size ExposureSimulation::step(Time t) const {
+        auto i = std::lower_bound(grid_.begin(), grid_.end(), t);
+        QL_REQUIRE(i != grid_.end() && *i == t,
+                   "internal error: time " << t << " not in the grid");
+        return i - grid_.begin();
+    }
+
+    void ExposureSimulation::performCalculations() const {
+        const Date today = termStructure_->referenceDate();
+        QL_REQUIRE(dates_.front() >= today,
+                   "exposure date (" << dates_.front()
+                   << ") before the reference date (" << today << ")");
+
+        times_.resize(dates_.size());
+        for (Size j=0; j<dates_.size(); ++j)
+            times_[j] = termStructure_->timeFromReference(dates_[j]);
+
+        // first, the simulation grid; it includes the fixings
+        // taking place on the path
+        std::set<Date> gridDates(dates_.begin(), dates_.end());
+        auto addFixings = [&](const Leg& leg) {
+            for (const auto& cf : leg) {
+                auto coupon = ext::dynamic_pointer_cast<FloatingRateCoupon>(cf);
+                if (coupon != nullptr && coupon->fixingDate() > today &&
+                    coupon->fixingDate() <= dates_.back())
+                    gridDates.insert(coupon->fixingDate());
+            }
+        };
+        for (const auto& trades : trades_) {
+            for (const auto& trade : trades) {
+                if (auto swaption = ext::dynamic_pointer_cast<Swaption>(trade)) {
+                    Date exercise = swaption->exercise()->lastDate();
+                    QL_REQUIRE(exercise > today,
+                               "swaption exercise date (" << exercise
+                               << ") must be after the reference date");
+                    gridDates.insert(exercise);
+                    for (const auto& leg : swaption->underlying()->legs())
+                        addFixings(leg);
+                } else if (auto swap = ext::dynamic_pointer_cast<Swap>(trade)) {
+                    for (const auto& leg : swap->legs())
+                        addFixings(leg);
+                }
+            }
+        }
+        grid_.assign(1, 0.0);
+        for (const auto& d : gridDates) {
+            Time t = termStructure_->timeFromReference(d);
+            if (t > grid_.back())
+                grid_.push_back(t);
+        }
+        const Size nSteps = grid_.size() - 1;
+
+        exposureSteps_.resize(times_.size());
+        for (Size j=0; j<times_.size(); ++j)
+            exposureSteps_[j] = step(times_[j]);
+
+        // state dynamics: x(i+1) = drift + slope * x(i) + stdDev * z
+        stateDrift_.resize(nSteps);
+        stateSlope_.resize(nSteps);
+        stateStdDev_.resize(nSteps);
+        for (Size i=0; i<nSteps; ++i) {
+            Time t = grid_[i], dt = grid_[i+1] - grid_[i];
+            stateDrift_[i] = process_->expectation(t, 0.0, dt);
+            stateSlope_[i] = process_->expectation(t, 1.0, dt) - stateDrift_[i];
+            stateStdDev_[i] = process_->stdDeviation(t, 0.0, dt);
+        }
+
+        // FX dynamics, exact in the log
+        for (auto& fx : fxRates_) {
+            const GeneralizedBlackScholesProcess& p = *fx.process;
+            Real x0 = p.x0();
+            fx.drift.resize(nSteps);
+            fx.stdDev.resize(nSteps);
+            Real previousVariance = 0.0;
+            for (Size i=0; i<nSteps; ++i) {
+                Time t0 = grid_[i], t1 = grid_[i+1];
+                Real variance = p.blackVolatility()->blackVariance(t1, x0, true);
+                Real dv = std::max<Real>(variance - previousVariance, 0.0);
+                fx.drift[i] =
+                    std::log(p.dividendYield()->discount(t1) *
+                             p.riskFreeRate()->discount(t0) /
+                             (p.dividendYield()->discount(t0) *
+                              p.riskFreeRate()->discount(t1))) - 0.5 * dv;
+                fx.stdDev[i] = std::sqrt(dv);
+                previousVariance = variance;
+            }
+        }
+
+        // then, the kernels of the netting sets
+        std::map<std::tuple<Date, Date, Date>, Size> fixingIndex;
+        nettingSets_.assign(trades_.size(), NettingSet());
+        for (Size n=0; n<trades_.size(); ++n) {
+            NettingSet& nettingSet = nettingSets_[n];
+            std::vector<KernelBuilder> builders;
+            builders.reserve(dates_.size());
+            for (const auto& d : dates_)
+                builders.emplace_back(*this, d, true, &fixingIndex);
+
+            for (const auto& trade : trades_[n]) {
+                if (auto swaption = ext::dynamic_pointer_cast<Swaption>(trade)) {
+                    nettingSet.swaptions.push_back(
+                        swaptionKernel(*swaption, fixingIndex));
+                } else if (auto swap = ext::dynamic_pointer_cast<Swap>(trade)) {
+                    for (Size k=0; k<swap->legs().size(); ++k) {
+                        Real sign = swap->payer(k) ? -1.0 : 1.0;
+                        for (auto& b : builders)
+                            b.addLeg(swap->leg(k), sign);
+                    }
+                } else if (auto fx = ext::dynamic_pointer_cast<FxForward>(trade)) {
+                    for (auto& b : builders)
+                        b.addFxForward(*fx);
+                } else {
+                    QL_FAIL("unsupported trade type");
+                }
+            }
+
+            nettingSet.kernels.reserve(dates_.size());
+            for (auto& b : builders)
+                nettingSet.kernels.push_back(b.kernel());
+        }
+
+        // the fixings on the path, in order of time
+        fixings_.assign(fixingIndex.size(), Fixing());
+        for (const auto& f : fixingIndex) {
+            Time t = termStructure_->timeFromReference(std::get<0>(f.first));
+            Time s = termStructure_->timeFromReference(std::get<1>(f.first));
+            Time e = termStructure_->timeFromReference(std::get<2>(f.first));
+            std::pair<Real, Real> ds = logDiscount(t, s), de = logDiscount(t, e);
+            fixings_[f.second] = {t, step(t), ds.first - de.first,
+                                  ds.second - de.second};
+        }
+
+        // finally, the simulation itself
+        const Size nFx = fxRates_.size();
+        const Size nFactors = 1 + nFx;
+        const Size nExposures = dates_.size();
+        const Size nSets = nettingSets_.size();
+        const Size nValues = nSets * nExposures;
+        const Size dimension = std::max<Size>(nSteps * nFactors, 1);
+        PseudoRandom::rsg_type rsg =
+            PseudoRandom::make_sequence_generator(dimension, seed_);
+
+        std::vector<IncrementalStatistics> positive(nValues), negative(nValues);
+        std::vector<StreamingStatistics> quantiles(nValues);
+
+        const Size chunkSize = 1024;
+        std::vector<Real> normals(chunkSize * dimension);
+        std::vector<Real> values(chunkSize * nValues);
+        for (Size first=0; first<samples_; first+=chunkSize) {
+            const Size paths = std::min(chunkSize, samples_ - first);
+
+            // random numbers are drawn serially, in path order...
+            for (Size p=0; p<paths; ++p) {
+                const std::vector<Real>& z = rsg.nextSequence().value;
+                std::copy(z.begin(), z.end(), normals.begin() + p * dimension);
+            }
+
+            // ...the paths are valued concurrently...
+            #pragma omp parallel for if(paths*nValues*nSteps > 10000)
+            for (long p=0; p<long(paths); ++p) {
+                std::vector<Real> states, fxRates, fixings;
+                simulatePath(&normals[p * dimension], &values[p * nValues],
+                             states, fxRates, fixings);
+            }
+
+            // ...and the exposures are collected in path order.
+            for (Size p=0; p<paths; ++p) {
+                const Real* v = &values[p * nValues];
+                for (Size k=0; k<nValues; ++k) {
+                    positive[k].add(std::max<Real>(v[k], 0.0));
+                    negative[k].add(std::max<Real>(-v[k], 0.0));
+                    quantiles[k].add(-v[k]);
+                }
+            }
+        }
+
+        profiles_.resize(nSets);
+        for (Size n=0; n<nSets; ++n) {
+            ExposureProfile& profile = profiles_[n];
+            profile.expectedExposure.resize(nExposures);
+            profile.expectedNegativeExposure.resize(nExposures);
+            profile.potentialFutureExposure.resize(nExposures);
+            for (Size j=0; j<nExposures; ++j) {
+                Size k = n * nExposures + j;
+                profile.expectedExposure[j] = positive[k].mean();
+                profile.expectedNegativeExposure[j] = negative[k].mean();
+                profile.potentialFutureExposure[j] = std::max<Real>(
+                    -quantiles[k].percentile(1.0 - confidenceLevel_), 0.0);
+            }
+            if (nExposures == 1) {
+                profile.expectedPositiveExposure = profile.expectedExposure[0];
+            } else {
+                Real integral = 0.0;
+                for (Size j=1; j<nExposures; ++j)
+                    integral += 0.5 * (profile.expectedExposure[j-1] +
+                                       profile.expectedExposure[j]) *
+                                (times_[j] - times_[j-1]);
+                profile.expectedPositiveExposure =
+                    integral / (times_.back() - times_.front());
+            }
+        }
+    }
+
+    ExposureSimulation::SwaptionKernel ExposureSimulation::swaptionKernel(
+                const Swaption& swaption,
+                std::map<std::tuple<Date, Date, Date>, Size>& fixingIndex) const {
+        QL_REQUIRE(swaption.exercise()->type() == Exercise::European,
+                   "only European swaptions are supported");
+        const FixedVsFloatingSwap& swap = *swaption.underlying();
+        const Date exercise = swaption.exercise()->lastDate();
+        const Time T0 = termStructure_->timeFromReference(exercise);
+
+        SwaptionKernel result;
+        result.exerciseStep = step(T0);
+
+        // value of the underlying at exercise
+        KernelBuilder atExercise(*this, exercise, false, nullptr);
+        Date lastPayment = exercise;
+        for (Size k=0; k<swap.legs().size(); ++k) {
+            for (const auto& cf : swap.leg(k)) {
+                auto coupon = ext::dynamic_pointer_cast<FloatingRateCoupon>(cf);
+                QL_REQUIRE(coupon == nullptr || cf->date() <= exercise ||
+                               coupon->fixingDate() >= exercise,
+                           "swaption coupons fixing before exercise "
+                           "are not supported");
+                lastPayment = std::max(lastPayment, cf->date());
+            }
+            atExercise.addLeg(swap.leg(k), swap.payer(k) ? -1.0 : 1.0);
+        }
+        QL_REQUIRE(lastPayment > exercise,
+                   "no cash flows after the swaption exercise date");
+        result.atExercise = atExercise.terms();
+        std::pair<Real, Real> last =
+            logDiscount(T0, termStructure_->timeFromReference(lastPayment));
+        result.lastAlpha = last.first;
+        result.lastBeta = last.second;
+
+        // exercise boundary, assuming the underlying value to be
+        // monotonic in the state
+        const std::vector<Term>& terms = result.atExercise;
+        auto underlying = [&terms](Real x) {
+            Real sum = 0.0;
+            for (const auto& t : terms)
+                sum += t.weight * std::exp(t.alpha - t.beta * x);
+            return sum;
+        };
+        Real mean = process_->expectation(0.0, process_->x0(), T0);
+        Real stdDev = process_->stdDeviation(0.0, process_->x0(), T0);
+        Real lower = mean - 12.0 * stdDev, upper = mean + 12.0 * stdDev;
+        Real fLower = underlying(lower), fUpper = underlying(upper);
+        result.omega = fUpper >= fLower ? 1.0 : -1.0;
+        if (fLower > 0.0 && fUpper > 0.0) {
+            // always exercised
+            result.criticalState = -result.omega * QL_MAX_REAL;
+        } else if (fLower <= 0.0 && fUpper <= 0.0) {
+            // never exercised
+            result.criticalState = result.omega * QL_MAX_REAL;
+        } else {
+            Brent solver;
+            solver.setMaxEvaluations(1000);
+            result.criticalState =
+                solver.solve(underlying, 1.0e-12, mean, lower, upper);
+        }
+
+        // before exercise, the closed-form value needs the bonds
+        // maturing at exercise and at the last payment...
+        const bool physical = swaption.settlementType() == Settlement::Physical;
+        result.exerciseBond.resize(dates_.size());
+        result.lastBond.resize(dates_.size());
+        result.variance.resize(dates_.size(), 0.0);
+        result.exercised.resize(dates_.size());
+        const Time Tn = termStructure_->timeFromReference(lastPayment);
+        for (Size j=0; j<dates_.size(); ++j) {
+            if (dates_[j] < exercise) {
+                std::pair<Real, Real> p0 = logDiscount(times_[j], T0),
+                                      pn = logDiscount(times_[j], Tn);
+                result.exerciseBond[j] = {1.0, p0.first, p0.second};
+                result.lastBond[j] = {1.0, pn.first, pn.second};
+                result.variance[j] =
+                    process_->variance(times_[j], 0.0, T0 - times_[j]);
+            } else if (dates_[j] == exercise || physical) {
+                // ...while afterwards, it's the underlying swap
+                KernelBuilder builder(*this, dates_[j], true, &fixingIndex);
+                for (Size k=0; k<swap.legs().size(); ++k)
+                    builder.addLeg(swap.leg(k), swap.payer(k) ? -1.0 : 1.0);
+                result.exercised[j] = builder.kernel();
+            }
+        }
+        return result;
+    }
+
+    Real ExposureSimulation::value(const Kernel& kernel,
+                                   Real state,
+                                   const Real* fxRates,
+                                   const std::vector<Real>& fixings) const {
+        Real sum = 0.0;
+        for (const auto& t : kernel.terms)
+            sum += t.weight * std::exp(t.alpha - t.beta * state);
+        for (const auto& t : kernel.pending)
+            sum += t.weight * fixings[t.fixing] *
+                   std::exp(t.alpha - t.beta * state);
+        for (Size k=0; k<kernel.fx.size(); ++k)
+            sum += kernel.fx[k] * fxRates[k];
+        return sum;
+    }
+
+    void ExposureSimulation::simulatePath(const Real* normals,
+                                          Real* values,
+                                          std::vector<Real>& states,
+                                          std::vector<Real>& fxRates,
+                                          std::vector<Real>& fixings) const {
+        const Size nSteps = grid_.size() - 1;
+        const Size nFx = fxRates_.size();
+        const Size nFactors = 1 + nFx;
+        const Size nExposures = dates_.size();
+
+        // the path of the state and of the FX rates; the latter are
+        // only stored at the exposure dates
+        states.resize(nSteps + 1);
+        fxRates.resize(nExposures * nFx);
+        fixings.resize(fixings_.size());
+        std::vector<Real> logFx(nFx);
+        for (Size k=0; k<nFx; ++k)
+            logFx[k] = std::log(fxRates_[k].process->x0());
+
+        states[0] = process_->x0();
+        Size nextExposure = 0;
+        for (Size i=0; i<=nSteps; ++i) {
+            if (i > 0) {
+                const Real* z = normals + (i - 1) * nFactors;
+                states[i] = stateDrift_[i-1] + stateSlope_[i-1] * states[i-1] +
+                            stateStdDev_[i-1] * z[0];
+                for (Size k=0; k<nFx; ++k) {
+                    const FxRate& fx = fxRates_[k];
+                    Real rho = fx.correlation;
+                    Real w = rho * z[0] + std::sqrt(1.0 - rho * rho) * z[k+1];
+                    logFx[k] += fx.drift[i-1] + fx.stdDev[i-1] * w;
+                }
+            }
+            if (nextExposure < nExposures && exposureSteps_[nextExposure] == i) {
+                for (Size k=0; k<nFx; ++k)
+                    fxRates[nextExposure * nFx + k] = std::exp(logFx[k]);
+                ++nextExposure;
+            }
+        }
+        for (Size f=0; f<fixings_.size(); ++f) {
+            const Fixing& fixing = fixings_[f];
+            fixings[f] = std::exp(fixing.alpha - fixing.beta * states[fixing.step]);
+        }
+
+        // values of the netting sets at the exposure dates
+        for (Size n=0; n<nettingSets_.size(); ++n) {
+            const NettingSet& nettingSet = nettingSets_[n];
+            for (Size j=0; j<nExposures; ++j) {
+                const Size i = exposureSteps_[j];
+                const Real x = states[i];
+                const Real* fx = nFx > 0 ? &fxRates[j * nFx] : nullptr;
+                Real v = value(nettingSet.kernels[j], x, fx, fixings);
+                for (const auto& swaption : nettingSet.swaptions) {
+                    if (i >= swaption.exerciseStep) {
+                        Real xe = states[swaption.exerciseStep];
+                        if (swaption.omega * (xe - swaption.criticalState) > 0.0)
+                            v += value(swaption.exercised[j], x, fx, fixings);
+                    } else {
+                        v += swaptionValue(swaption, j, x);
+                    }
+                }
+                values[n * nExposures + j] = v;
+            }
+        }
+    }
+
+    Real ExposureSimulation::swaptionValue(const SwaptionKernel& swaption,
+                                           Size j,
+                                           Real state) const {
+        // Jamshidian's decomposition in terms of the distribution of
+        // the state at exercise in the corresponding forward measure
+        const Term& b0 = swaption.exerciseBond[j];
+        const Term& bn = swaption.lastBond[j];
+        const Real v = swaption.variance[j];
+        const Real logP0 = b0.alpha - b0.beta * state;
+        const Real logPn = bn.alpha - bn.beta * state;
+        const Real mean = (swaption.lastAlpha +
+                           0.5 * swaption.lastBeta * swaption.lastBeta * v -
+                           (logPn - logP0)) / swaption.lastBeta;
+        const Real stdDev = std::sqrt(v);
+        const Real omega = swaption.omega;
+        CumulativeNormalDistribution N;
+        Real sum = 0.0;
+        for (const auto& t : swaption.atExercise) {
+            Real d = omega * (mean - t.beta * v - swaption.criticalState) / stdDev;
+            sum += t.weight *
+                   std::exp(t.alpha - t.beta * mean + 0.5 * t.beta * t.beta * v) *
+                   N(d);
+        }
+        return std::exp(logP0) * sum;
+    }
+
+}
@@ -0,0 +1,237 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file exposuresimulation.hpp
+    \brief Monte Carlo simulation of the exposure profiles of netting sets
+*/
+
+#ifndef quantlib_exposure_simulation_hpp
+#define quantlib_exposure_simulation_hpp
+
+#include <ql/currency.hpp>
+#include <ql/instrument.hpp>
+#include <ql/models/shortrate/onefactormodels/gsr.hpp>
+#include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <functional>
+#include <map>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    class Swaption;
+
+    //! exposure profile of a netting set
+    struct ExposureProfile {
+        //! expected positive exposure at each date
+        std::vector<Real> expectedExposure;
+        //! expected negative exposure at each date
+        std::vector<Real> expectedNegativeExposure;
+        //! potential future exposure at each date
+        std::vector<Real> potentialFutureExposure;
+        //! time average of the expected exposure over the dates
+        Real expectedPositiveExposure;
+    };
+
+    //! Monte Carlo simulation of the exposure profiles of netting sets
+    /*! The domestic short rate follows a one-factor Gaussian model
+        (either HullWhite or Gsr) whose state is simulated exactly on
+        a grid made of the exposure dates, of the fixing dates of the
+        floating coupons and of the exercise dates of the swaptions.  FX rates can be added; each
+        of them follows the given Black-Scholes process, correlated
+        with the short rate; the process curves are used for the
+        drift and for discounting foreign cash flows.
+
+        Netting sets can include swaps (VanillaSwap and other
+        FixedVsFloatingSwap instances), European swaptions and FX
+        forwards.  Trades are not revalued on each path; instead, the
+        values of the cash flows are written in terms of model
+        discount bonds, whose logarithms are affine in the state.
+        The resulting coefficients are aggregated over the netting
+        set at each exposure date before the simulation, so that the
+        cost of a path doesn't depend on the number of linear trades
+        but only on the number of distinct payment dates.  Ibor
+        coupons are projected on the model curve plus a deterministic
+        basis to the forecasting curve of their index (convexity
+        adjustments are not included).  Swaptions are valued in
+        closed form by Jamshidian's decomposition, written in terms
+        of the state at exercise.
+
+        Paths are simulated in parallel when OpenMP is enabled; the
+        results don't depend on the number of threads.  Exposures are
+        collected in StreamingStatistics with a fixed tail, so that
+        the memory used doesn't grow with the number of samples; the
+        potential future exposure is exact as long as the samples
+        beyond the quantile fit in the tail, and is estimated by the
+        digest otherwise.
+
+        Exposures are expressed in domestic currency and are not
+        discounted; they are simulated in the measure of the model
+        (the risk-neutral measure for HullWhite, the forward measure
+        of its state process for Gsr).  Collateral is not
+        considered.
+
+        \warning swaptions must be European, the position is assumed
+                 to be long, and their floating coupons must fix on or
+                 after the exercise date.
+    */
+    class ExposureSimulation : public LazyObject {
+      public:
+        /*! \param currency  the domestic currency; it's used to
+                             identify the domestic leg of FX forwards.
+            \param confidenceLevel  the quantile of the exposure
+                                    returned as potential future
+                                    exposure.
+        */
+        ExposureSimulation(const ext::shared_ptr<HullWhite>& model,
+                           std::vector<Date> exposureDates,
+                           Size samples,
+                           Real confidenceLevel = 0.95,
+                           BigNatural seed = 42,
+                           Currency currency = Currency());
+        ExposureSimulation(const ext::shared_ptr<Gsr>& model,
+                           std::vector<Date> exposureDates,
+                           Size samples,
+                           Real confidenceLevel = 0.95,
+                           BigNatural seed = 42,
+                           Currency currency = Currency());
+        //! \name Modifiers
+        //@{
+        /*! adds an FX rate; the spot of the process is the value of a
+            unit of the given currency in domestic currency.
+        */
+        void addFxRate(const Currency& currency,
+                       const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+                       Real correlationWithRates = 0.0);
+        //! adds a netting set and returns its index
+        Size addNettingSet(std::vector<ext::shared_ptr<Instrument> > trades);
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Date>& exposureDates() const { return dates_; }
+        const std::vector<Time>& exposureTimes() const { return times_; }
+        Size samples() const { return samples_; }
+        Size nettingSets() const { return trades_.size(); }
+        //@}
+        //! \name Results
+        //@{
+        const ExposureProfile& profile(Size nettingSet) const;
+        //@}
+      private:
+        // value of a term: weight * exp(alpha - beta * x)
+        struct Term {
+            Real weight, alpha, beta;
+        };
+        // as above, times the value realized by a fixing
+        struct PendingTerm {
+            Size fixing;
+            Real weight, alpha, beta;
+        };
+        // value of a set of linear trades at a given time
+        struct Kernel {
+            std::vector<Term> terms;
+            std::vector<PendingTerm> pending;
+            // weights of the FX rates
+            std::vector<Real> fx;
+        };
+        struct SwaptionKernel {
+            Size exerciseStep;
+            // value of the underlying in terms of the state at exercise;
+            // it's exercised where omega*(x - criticalState) > 0.
+            std::vector<Term> atExercise;
+            Real criticalState, omega;
+            // log-discount from exercise to the last payment
+            Real lastAlpha, lastBeta;
+            // at each exposure date before exercise, the bonds maturing
+            // at exercise and at the last payment, and the variance of
+            // the state at exercise
+            std::vector<Term> exerciseBond, lastBond;
+            std::vector<Real> variance;
+            // value of the underlying, if exercised, at later dates
+            std::vector<Kernel> exercised;
+        };
+        struct NettingSet {
+            std::vector<Kernel> kernels;
+            std::vector<SwaptionKernel> swaptions;
+        };
+        struct FxRate {
+            Currency currency;
+            ext::shared_ptr<GeneralizedBlackScholesProcess> process;
+            Real correlation;
+            std::vector<Real> drift, stdDev;
+        };
+        // forward discount P(t,start)/P(t,end) at a fixing time t
+        struct Fixing {
+            Time time;
+            Size step;
+            Real alpha, beta;
+        };
+        class KernelBuilder;
+
+        ExposureSimulation(std::vector<Date> exposureDates,
+                           Size samples,
+                           Real confidenceLevel,
+                           BigNatural seed,
+                           Currency currency);
+        void performCalculations() const override;
+        SwaptionKernel swaptionKernel(
+            const Swaption& swaption,
+            std::map<std::tuple<Date, Date, Date>, Size>& fixingIndex) const;
+        void simulatePath(const Real* normals,
+                          Real* values,
+                          std::vector<Real>& states,
+                          std::vector<Real>& fxRates,
+                          std::vector<Real>& fixings) const;
+        Real value(const Kernel& kernel,
+                   Real state,
+                   const Real* fxRates,
+                   const std::vector<Real>& fixings) const;
+        Real swaptionValue(const SwaptionKernel& swaption,
+                           Size exposure,
+                           Real state) const;
+        std::pair<Real, Real> logDiscount(Time t, Time T) const;
+        Size step(Time t) const;
+
+        // model
+        Handle<YieldTermStructure> termStructure_;
+        ext::shared_ptr<StochasticProcess1D> process_;
+        std::function<Real(Time, Time, Real)> discountBond_;
+        // parameters
+        std::vector<Date> dates_;
+        mutable std::vector<Time> times_;
+        Size samples_;
+        Real confidenceLevel_;
+        BigNatural seed_;
+        Currency currency_;
+        std::vector<std::vector<ext::shared_ptr<Instrument> > > trades_;
+        // simulation data
+        mutable std::vector<FxRate> fxRates_;
+        mutable std::vector<NettingSet> nettingSets_;
+        mutable std::vector<Fixing> fixings_;
+        mutable std::vector<Time> grid_;
+        mutable std::vector<Size> exposureSteps_;
+        mutable std::vector<Real> stateDrift_, stateSlope_, stateStdDev_;
+        // results
+        mutable std::vector<ExposureProfile> profiles_;
+    };
+
+}
+
+#endif
@@ -33,8 +33,13 @@
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/math/statistics/histogram.hpp>
 #include <ql/math/statistics/riskstatistics.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 /* Intended to replace
     ql\experimental\credit\randomdefaultmodel.Xpp
@@ -67,16 +72,96 @@ namespace QuantLib {
     // replaces class Loss
     template <class simEventOwner> struct simEvent;
 
+    namespace detail {
+
+        //! Columnar storage of simulation events
+        /*! The events of all the scenarios are stored contiguously,
+            one scenario after the other, together with the offset of
+            each scenario; this avoids one allocation per scenario and
+            keeps the statistics scans cache-friendly.
+        */
+        template <class Event>
+        class SimEventStore {
+          public:
+            //! read-only view of the events of a scenario
+            class Scenario {
+              public:
+                Scenario(const Event* begin, const Event* end)
+                : begin_(begin), end_(end) {}
+                Size size() const { return end_ - begin_; }
+                bool empty() const { return begin_ == end_; }
+                const Event& operator[](Size i) const { return begin_[i]; }
+                const Event* begin() const { return begin_; }
+                const Event* end() const { return end_; }
+              private:
+                const Event* begin_;
+                const Event* end_;
+            };
+
+            SimEventStore() : offsets_(1, 0) {}
+
+            //! adds an event to the scenario being written
+            void add(const Event& event) { events_.push_back(event); }
+            //! closes the scenario being written
+            void closeScenario() { offsets_.push_back(events_.size()); }
+            //! appends the scenarios stored in another store
+            void append(const SimEventStore& other) {
+                Size offset = events_.size();
+                events_.insert(events_.end(),
+                               other.events_.begin(), other.events_.end());
+                offsets_.reserve(offsets_.size() + other.scenarios());
+                for (Size i=1; i<other.offsets_.size(); ++i)
+                    offsets_.push_back(offset + other.offsets_[i]);
+            }
+            void clear() {
+                events_.clear();
+                offsets_.assign(1, 0);
+            }
+
+            Size scenarios() const { return offsets_.size() - 1; }
+            Scenario scenario(Size i) const {
+                const Event* data = events_.data();
+                return Scenario(data + offsets_[i], data + offsets_[i+1]);
+            }
+          private:
+            std::vector<Event> events_;
+            std::vector<Size> offsets_;
+        };
+
+        template <class USNG, class = void>
+        struct hasSkipTo : std::false_type {};
+
+        template <class USNG>
+        struct hasSkipTo<USNG, decltype(
+            void(std::declval<const USNG&>().skipTo(std::uint32_t())))>
+        : std::true_type {};
+
+    }
+
 
     /*! Base class for latent model monte carlo simulation. Independent of the
     copula type and the generator.
     Generates the factors and variable samples and determines event threshold
     but it is not responsible for actual event specification; thats the derived
     classes responsibility according to what they model.
-    Derived classes need mainly to implement nextSample (Worker::nextSample in
-    the multithreaded version) to compute the simulation event generated, if
-    any, from the latent variables sample. They also have the accompanying
-    event trait to specify.
+    Derived classes need mainly to implement nextSample to compute the
+    simulation events generated, if any, from the latent variables sample.
+    They also have the accompanying event trait to specify.
+
+    When the sequence generator can skip ahead (as SobolRsg does) and the
+    derived class declares its nextSample method safe to be called
+    concurrently, scenarios are generated in parallel chunks when OpenMP
+    is enabled; each chunk uses its own sampler positioned at the start
+    of the chunk, so that the scenarios are the same as in a serial run
+    regardless of the number of threads.
+
+    By default all the scenarios are stored for the statistics to be
+    computed on demand. Alternatively, the dates of interest can be
+    registered beforehand through streamStatistics(); in that case, the
+    scenarios are generated in blocks and discarded once the statistics
+    depending on them (number of defaults and tranche losses) have been
+    accumulated, so that the memory used does not grow with the number of
+    simulations.
     */
     /* CRTP used for performance to avoid virtual table resolution in the Monte
     Carlo. Not only in sample generation but access; quite an amount of time can
@@ -100,7 +185,11 @@ namespace QuantLib {
         // random generation is performed in this class only.
         typedef typename LatentModel<copulaPolicy>::template FactorSampler<USNG>
             copulaRNG_type;
+        typedef derivedRandomLM<copulaPolicy, USNG> derived_type;
     protected:
+        typedef simEvent<derived_type> event_type;
+        typedef detail::SimEventStore<event_type> store_type;
+
       RandomLM(Size numFactors, Size numLMVars, copulaPolicy copula, Size nSims, BigNatural seed)
       : seed_(seed), numFactors_(numFactors), numLMVars_(numLMVars), nSims_(nSims),
         copula_(std::move(copula)) {}
@@ -114,31 +203,74 @@ namespace QuantLib {
         }
 
         void performCalculations() const override {
-            static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                this)->initDates();//in update?
+            static_cast<const derived_type*>(this)->initDates();//in update?
             copulasRng_ = ext::make_shared<copulaRNG_type>(copula_, seed_);
             performSimulations();
         }
 
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for (Size i = nSims_; i != 0U; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            simsBuffer_.clear();
+            if (streamDates_.empty()) {
+                generateSimulations(0, nSims_);
+                return;
+            }
+
+            Date today = Settings::instance().evaluationDate();
+            Size basketSize = basket_->size();
+            streamedStats_.assign(streamDates_.size(), StreamedStatistics());
+            for (auto& stats : streamedStats_)
+                stats.eventCounts.assign(basketSize+1, 0);
+            for (Size first=0; first<nSims_; first+=streamingBlockSize) {
+                generateSimulations(
+                    first, std::min<Size>(streamingBlockSize, nSims_-first));
+                accumulateStatistics(today);
+                simsBuffer_.clear();
             }
         }
 
-        /* Method to access simulation results and avoiding a copy of
-        each thread results buffer. PerformCalculations should have been called.
-        Here in the monothread version this method is redundant/trivial but
-        serves to detach the statistics access to the way the simulations are
-        stored.
+        /* Appends the scenarios from first to first+n to the buffer. The
+        derived class nextSample writes the events of a single scenario. */
+        void generateSimulations(Size first, Size n) const {
+            const auto* derived = static_cast<const derived_type*>(this);
+            if (!(detail::hasSkipTo<USNG>::value &&
+                  derived_type::concurrentSampling)) {
+                // the sampler keeps its state from one block to the next
+                for (Size i = n; i != 0U; i--) {
+                    const std::vector<Real>& sample =
+                        copulasRng_->nextSequence().value;
+                    derived->nextSample(sample, simsBuffer_);
+                    simsBuffer_.closeScenario();
+                }
+                return;
+            }
+
+            QL_REQUIRE(first + n <= std::numeric_limits<std::uint32_t>::max(),
+                       "too many simulations for the sequence generator");
+            // the partition doesn't depend on the number of threads
+            Size nChunks = (n + simulationChunkSize - 1) / simulationChunkSize;
+            std::vector<store_type> chunks(nChunks);
+            #pragma omp parallel for if(nChunks > 1) schedule(dynamic)
+            for (long c=0; c<long(nChunks); ++c) {
+                Size begin = first + c * simulationChunkSize;
+                Size end = std::min(begin + simulationChunkSize, first + n);
+                copulaRNG_type rng(copula_, seed_);
+                skipSampler(rng, begin, detail::hasSkipTo<USNG>());
+                for (Size i=begin; i<end; ++i) {
+                    derived->nextSample(rng.nextSequence().value, chunks[c]);
+                    chunks[c].closeScenario();
+                }
+            }
+            for (const auto& chunk : chunks)
+                simsBuffer_.append(chunk);
+        }
+
+        /* Method to access simulation results. PerformCalculations should
+        have been called; the results are only available if statistics are
+        not streamed.
         */
-        const std::vector<simEvent<derivedRandomLM<copulaPolicy, USNG> > >&
-            getSim(const Size iSim) const { return simsBuffer_[iSim]; }
+        typename store_type::Scenario getSim(const Size iSim) const {
+            return simsBuffer_.scenario(iSim);
+        }
 
         /* Allows statistics to be written generically for fixed and random
         recovery rates. */
@@ -201,16 +333,63 @@ namespace QuantLib {
     public:
       ~RandomLM() override = default;
 
+        //! \name Streaming
+        //@{
+        /*! Registers the dates at which statistics will be requested.
+            When the list is not empty, scenarios are not stored; the
+            number of defaults and the tranche losses at the given dates
+            are accumulated while scenarios are generated, and only
+            probAtLeastNEvents, expectedTrancheLoss and
+            expectedTrancheLossInterval are available, at those dates.
+            An empty list restores the default behavior.
+        */
+        void streamStatistics(std::vector<Date> dates) {
+            streamDates_ = std::move(dates);
+            streamedStats_.clear();
+            // NOLINTNEXTLINE(bugprone-parent-virtual-call)
+            LazyObject::update();
+        }
+        //@}
+
+        //! number of scenarios generated by each task
+        static constexpr Size simulationChunkSize = 1024;
+        //! number of scenarios kept in memory when streaming statistics
+        static constexpr Size streamingBlockSize = 64 * simulationChunkSize;
+
     private:
+        struct StreamedStatistics {
+            // number of scenarios with a given number of defaults
+            std::vector<Size> eventCounts;
+            // sum of tranche losses and of their squares
+            Real lossSum = 0.0, lossSquaresSum = 0.0;
+        };
+
+        static void skipSampler(const copulaRNG_type& rng, Size n,
+                                std::true_type) {
+            rng.skipTo(n);
+        }
+        static void skipSampler(const copulaRNG_type&, Size, std::false_type) {}
+
+        void accumulateStatistics(const Date& today) const;
+        //! loss of the tranche in a scenario
+        Real trancheLoss(const typename store_type::Scenario& events,
+                         Date::serial_type val, const Date& today) const;
+        Size streamedIndex(const Date& d) const;
+        void requireScenarios() const {
+            QL_REQUIRE(streamDates_.empty(),
+                       "statistic not available when streaming statistics");
+        }
+
         BigNatural seed_;
+        std::vector<Date> streamDates_;
+        mutable std::vector<StreamedStatistics> streamedStats_;
     protected:
         const Size numFactors_;
         const Size numLMVars_;
 
         const Size nSims_;
 
-        mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
-            USNG > > > > simsBuffer_;
+        mutable store_type simsBuffer_;
 
         mutable copulaPolicy copula_;
         mutable ext::shared_ptr<copulaRNG_type> copulasRng_;
@@ -223,6 +402,60 @@ namespace QuantLib {
 
     /* ---- Statistics ---------------------------------------------------  */
 
+    template<template <class, class> class D, class C, class URNG>
+    Real RandomLM<D, C, URNG>::trancheLoss(
+        const typename store_type::Scenario& events, Date::serial_type val,
+        const Date& today) const
+    {
+        Real attachAmount = basket_->attachmentAmount();
+        Real detachAmount = basket_->detachmentAmount();
+
+        Real portfSimLoss=0.;
+        for(Size iEvt=0; iEvt < events.size(); iEvt++) {
+            // if event is within time horizon...
+            if(val > static_cast<Date::serial_type>(events[iEvt].dayFromRef)) {
+                Size iName = events[iEvt].nameIdx;
+                portfSimLoss +=
+                    basket_->exposure(basket_->names()[iName],
+                        Date(events[iEvt].dayFromRef +
+                            today.serialNumber())) *
+                                (1.-getEventRecovery(events[iEvt]));
+            }
+        }
+        return std::min(std::max(portfSimLoss - attachAmount, 0.),
+            detachAmount - attachAmount);
+    }
+
+    template<template <class, class> class D, class C, class URNG>
+    void RandomLM<D, C, URNG>::accumulateStatistics(const Date& today) const
+    {
+        for(Size iDate=0; iDate < streamDates_.size(); iDate++) {
+            Date::serial_type val =
+                streamDates_[iDate].serialNumber() - today.serialNumber();
+            StreamedStatistics& stats = streamedStats_[iDate];
+            for(Size iSim=0; iSim < simsBuffer_.scenarios(); iSim++) {
+                auto events = getSim(iSim);
+                Size simCount = 0;
+                for(Size iEvt=0; iEvt < events.size(); iEvt++)
+                    if(val > static_cast<Date::serial_type>(
+                           events[iEvt].dayFromRef)) simCount++;
+                stats.eventCounts[simCount]++;
+                Real loss = trancheLoss(events, val, today);
+                stats.lossSum += loss;
+                stats.lossSquaresSum += loss * loss;
+            }
+        }
+    }
+
+    template<template <class, class> class D, class C, class URNG>
+    Size RandomLM<D, C, URNG>::streamedIndex(const Date& d) const {
+        auto it = std::find(streamDates_.begin(), streamDates_.end(), d);
+        QL_REQUIRE(it != streamDates_.end(),
+                   "statistics not streamed for " << d);
+        return it - streamDates_.begin();
+    }
+
+
     template<template <class, class> class D, class C, class URNG>
     Probability RandomLM<D, C, URNG>::probAtLeastNEvents(Size n,
         const Date& d) const
@@ -237,10 +470,16 @@ namespace QuantLib {
         if(n==0) return 1.;
 
         Real counts = 0.;
+        if (!streamDates_.empty()) {
+            const std::vector<Size>& eventCounts =
+                streamedStats_[streamedIndex(d)].eventCounts;
+            for(Size k=n; k < eventCounts.size(); k++)
+                counts += eventCounts[k];
+            return counts/nSims_;
+        }
         for(Size iSim=0; iSim < nSims_; iSim++) {
             Size simCount = 0;
-            const std::vector<simEvent<D<C, URNG> > >& events =
-                getSim(iSim);
+            auto events = getSim(iSim);
             for(Size iEvt=0; iEvt < events.size(); iEvt++)
                 // duck type on the members:
                 if(val > events[iEvt].dayFromRef) simCount++;
@@ -255,6 +494,7 @@ namespace QuantLib {
                                                                       const Date& d) const
     {
         calculate();
+        requireScenarios();
         Size basketSize = basket_->size();
 
         QL_REQUIRE(n>0 && n<=basketSize, "Impossible number of defaults.");
@@ -266,7 +506,7 @@ namespace QuantLib {
 
         std::vector<Probability> hitsByDate(basketSize, 0.);
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            auto events = getSim(iSim);
             std::map<unsigned short, unsigned short> namesDefaulting;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 // if event is within time horizon...
@@ -299,6 +539,7 @@ namespace QuantLib {
     {
         // a control variate with the probabilities is possible
         calculate();
+        requireScenarios();
         Date today = Settings::instance().evaluationDate();
 
         QL_REQUIRE(d>today, "Date for statistic must be in the future.");
@@ -311,7 +552,7 @@ namespace QuantLib {
         Real expectedDefi = 0.;
         Real expectedDefj = 0.;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            auto events = getSim(iSim);
             Real imatch = 0., jmatch = 0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if((val > events[iEvt].dayFromRef) &&
@@ -346,37 +587,27 @@ namespace QuantLib {
         const Date& d, Probability confidencePerc) const
     {
         calculate();
+        Real confidenceFactor =
+            InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc));
+        if (!streamDates_.empty()) {
+            const StreamedStatistics& stats = streamedStats_[streamedIndex(d)];
+            Real n = static_cast<Real>(nSims_);
+            Real mean = stats.lossSum / n;
+            Real variance = std::max<Real>(
+                (stats.lossSquaresSum / n - mean * mean) * n / (n - 1.), 0.);
+            return std::make_pair(mean,
+                                  std::sqrt(variance / n) * confidenceFactor);
+        }
+
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = d.serialNumber() - today.serialNumber();
 
-        Real attachAmount = basket_->attachmentAmount();
-        Real detachAmount = basket_->detachmentAmount();
-
-        // Real trancheLoss= 0.;
         GeneralStatistics lossStats;
-        for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
-
-            Real portfSimLoss=0.;
-            for(Size iEvt=0; iEvt < events.size(); iEvt++) {
-                // if event is within time horizon...
-                if(val > static_cast<Date::serial_type>(
-					   events[iEvt].dayFromRef)) {
-                    Size iName = events[iEvt].nameIdx;
-                    // ...and is contained in the basket.
-                        portfSimLoss +=
-                            basket_->exposure(basket_->names()[iName],
-                                Date(events[iEvt].dayFromRef +
-                                    today.serialNumber())) *
-                                        (1.-getEventRecovery(events[iEvt]));
-               }
-            }
-            lossStats.add(// d  ates? current losses? realized defaults, not yet
-                std::min(std::max(portfSimLoss - attachAmount, 0.),
-                    detachAmount - attachAmount) );
-        }
-        return std::make_pair(lossStats.mean(), lossStats.errorEstimate() *
-            InverseCumulativeNormal::standard_value(0.5*(1.+confidencePerc)));
+        for(Size iSim=0; iSim < nSims_; iSim++)
+            // d  ates? current losses? realized defaults, not yet
+            lossStats.add(trancheLoss(getSim(iSim), val, today));
+        return std::make_pair(lossStats.mean(),
+            lossStats.errorEstimate() * confidenceFactor);
     }
 
 
@@ -408,12 +639,13 @@ namespace QuantLib {
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
         calculate();
+        requireScenarios();
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            auto events = getSim(iSim);
 
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
@@ -447,6 +679,7 @@ namespace QuantLib {
         QL_REQUIRE(d >= today,
             "Requested percentile date must lie after computation date.");
         calculate();
+        requireScenarios();
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
@@ -457,7 +690,7 @@ namespace QuantLib {
         //GenericRiskStatistics<GeneralStatistics> statsX;
         std::vector<Real> losses;
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            auto events = getSim(iSim);
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if(val > static_cast<Date::serial_type>(
@@ -541,6 +774,7 @@ namespace QuantLib {
         QL_REQUIRE(percentile >= 0. && percentile <= 1.,
             "Incorrect percentile");
         calculate();
+        requireScenarios();
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
@@ -549,7 +783,7 @@ namespace QuantLib {
         Date today = Settings::instance().evaluationDate();
         Date::serial_type val = d.serialNumber() - today.serialNumber();
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            auto events = getSim(iSim);
             Real portfSimLoss=0.;
             for(Size iEvt=0; iEvt < events.size(); iEvt++) {
                 if(val > static_cast<Date::serial_type>(
@@ -639,6 +873,7 @@ namespace QuantLib {
         /* Check 'loss' value integrity: i.e. is within tranche limits? (should
             have been done basket...)*/
         calculate();
+        requireScenarios();
 
         Real attachAmount = basket_->attachmentAmount();
         Real detachAmount = basket_->detachmentAmount();
@@ -651,7 +886,7 @@ namespace QuantLib {
         Date::serial_type val = date.serialNumber() - today.serialNumber();
 
         for(Size iSim=0; iSim < nSims_; iSim++) {
-            const std::vector<simEvent<D<C, URNG> > >& events = getSim(iSim);
+            auto events = getSim(iSim);
             Real portfSimLoss=0.;
             //std::vector<Real> splitBuffer(numLiveNames_, 0.);
             std::vector<simEvent<D<C, URNG> > > splitEventsBuffer;
@@ -801,6 +1036,15 @@ namespace QuantLib {
 
     /*! Default only latent model simulation with trivially fixed recovery
         amounts.
+
+        Default times are obtained by inverting, on a daily grid, the default
+        probabilities of each name up to the maximum horizon; these are
+        tabulated before the simulation, so that no term structure is
+        accessed while scenarios are generated and the generation can run
+        concurrently.  The table takes maxHorizon_ probabilities per name.
+
+        \note The accuracy parameter of the constructors is no longer
+              used, since the inversion on the daily grid is exact.
     */
     template<class copulaPolicy, class USNG = SobolRsg>
     class RandomDefaultLM : public RandomLM<RandomDefaultLM, copulaPolicy, USNG>
@@ -811,20 +1055,17 @@ namespace QuantLib {
         // \todo Consider this to be only a ConstantLossLM instead
         const ext::shared_ptr<DefaultLatentModel<copulaPolicy> > model_;
         const std::vector<Real> recoveries_;
-        // for time inversion:
-        Real accuracy_;
     public:
         // \todo: Allow a constructor building its own default latent model.
       explicit RandomDefaultLM(const ext::shared_ptr<DefaultLatentModel<copulaPolicy> >& model,
                                const std::vector<Real>& recoveries = std::vector<Real>(),
                                Size nSims = 0, // stats will crash on div by zero, FIX ME.
-                               Real accuracy = 1.e-6,
+                               Real /* accuracy */ = 1.e-6,
                                BigNatural seed = 2863311530UL)
       : RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>(
             model->numFactors(), model->size(), model->copula(), nSims, seed),
         model_(model),
-        recoveries_(recoveries.empty() ? std::vector<Real>(model->size(), 0.) : recoveries),
-        accuracy_(accuracy) {
+        recoveries_(recoveries.empty() ? std::vector<Real>(model->size(), 0.) : recoveries) {
           // redundant through basket?
           this->registerWith(Settings::instance().evaluationDate());
           this->registerWith(model_);
@@ -832,14 +1073,13 @@ namespace QuantLib {
         explicit RandomDefaultLM(
             const ext::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >& model,
             Size nSims = 0,// stats will crash on div by zero, FIX ME.
-            Real accuracy = 1.e-6,
+            Real /* accuracy */ = 1.e-6,
             BigNatural seed = 2863311530UL)
         : RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>
             (model->numFactors(), model->size(), model->copula(),
                 nSims, seed ),
           model_(model),
-          recoveries_(model->recoveries()),
-          accuracy_(accuracy)
+          recoveries_(model->recoveries())
         {
             // redundant through basket?
             this->registerWith(Settings::instance().evaluationDate());
@@ -859,20 +1099,38 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        // nextSample only reads data precalculated in initDates
+        static constexpr bool concurrentSampling = true;
+
+        void nextSample(const std::vector<Real>& values,
+                        detail::SimEventStore<defaultSimEvent>& sims) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
-              determine if the default took place and subsequently compute its
-              event time)
+              determine if the default took place) and the daily default
+              probabilities used to compute its event time.
             */
             Date today = Settings::instance().evaluationDate();
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const ext::shared_ptr<Pool>& pool = this->basket_->pool();
-            for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
-                horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
-                    defaultProbability(this->basket_->defaultKeys()[iName])
-                        ->defaultProbability(maxHorizonDate, true));
+            Size nNames = this->basket_->size();
+            horizonDefaultPs_.resize(nNames);
+            dailyDefaultPs_.resize(nNames * this->maxHorizon_);
+            for(Size iName=0; iName < nNames; ++iName) {//use'live'
+                const Handle<DefaultProbabilityTermStructure>& dfts =
+                    pool->get(pool->names()[iName]).
+                    defaultProbability(this->basket_->defaultKeys()[iName]);
+                horizonDefaultPs_[iName] =
+                    dfts->defaultProbability(maxHorizonDate, true);
+                // days are counted from the curve reference date
+                Date curveRef = dfts->referenceDate();
+                Probability* dailyPs =
+                    &dailyDefaultPs_[iName * this->maxHorizon_];
+                for(Size iDay=0; iDay < this->maxHorizon_; ++iDay)
+                    dailyPs[iDay] = dfts->defaultProbability(
+                        curveRef + Period(static_cast<Integer>(iDay), Days),
+                        true);
+            }
         }
         Real getEventRecovery(const defaultSimEvent& evt) const {
             return recoveries_[evt.nameIdx];
@@ -910,6 +1168,9 @@ namespace QuantLib {
         // Default probabilities for each name at the time of the maximun
         //   horizon date. Cached for perf.
         mutable std::vector<Probability> horizonDefaultPs_;
+        // Default probabilities for each name and day up to the horizon,
+        //   stored name after name.
+        mutable std::vector<Probability> dailyDefaultPs_;
     };
 
 
@@ -918,12 +1179,9 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        detail::SimEventStore<defaultSimEvent>& sims) const
     {
-        const ext::shared_ptr<Pool>& pool = this->basket_->pool();
-        // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
-
         for(Size iName=0; iName<model_->size(); iName++) {
             Real latentVarSample =
                 model_->latentVarValue(values, iName);
@@ -931,15 +1189,15 @@ namespace QuantLib {
                model_->cumulativeY(latentVarSample, iName);
             // If the default simulated lies before the max date:
             if (horizonDefaultPs_[iName] >= simDefaultProb) {
-                const Handle<DefaultProbabilityTermStructure>& dfts =
-                    pool->get(pool->names()[iName]).// use 'live' names
-                    defaultProbability(this->basket_->defaultKeys()[iName]);
                 // compute and store default time with respect to the
-                //  curve ref date:
-                Size dateSTride =
-                    static_cast<Size>(Brent().solve(// casted from Real:
-                        detail::Root(dfts, simDefaultProb),
-                            accuracy_,0.,1.));
+                //  curve ref date; that is, the first day at which the
+                //  default probability reaches the simulated one.
+                const Probability* dailyPs =
+                    &dailyDefaultPs_[iName * this->maxHorizon_];
+                Size dateSTride = std::min<Size>(
+                    std::lower_bound(dailyPs, dailyPs + this->maxHorizon_,
+                                     simDefaultProb) - dailyPs,
+                    this->maxHorizon_ - 1);
                    /*
                    // value if one approximates to a flat HR;
                    //   faster (>x2) but it introduces an error:..
@@ -950,9 +1208,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
-               //emplace_back
+                sims.add(defaultSimEvent(iName, dateSTride));
             }
         /* Used to remove sims with no events. Uses less memory, faster
         post-statistics. But only if all names in the portfolio have low
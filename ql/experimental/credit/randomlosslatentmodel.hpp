@@ -101,7 +101,11 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomLossLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        // nextSample reads the term structures, so it runs serially
+        static constexpr bool concurrentSampling = false;
+
+        void nextSample(const std::vector<Real>& values,
+                        detail::SimEventStore<defaultSimEvent>& sims) const;
 
         // see note on randomdefaultlatentmodel
         void initDates() const {
@@ -113,6 +117,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const ext::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -155,10 +160,10 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomLossLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const 
+        const std::vector<Real>& values,
+        detail::SimEventStore<defaultSimEvent>& sims) const
     {
         const ext::shared_ptr<Pool>& pool = this->basket_->pool();
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
 
         // half the model is defaults, the other half are RRs...
         for(Size iName=0; iName<copula_->size()/2; iName++) {
@@ -212,8 +217,7 @@ namespace QuantLib {
                 Real recovery = 
                     copula_->conditionalRecovery(latentRRVarSample,
                         iName, eventDate);
-                this->simsBuffer_.back().push_back(
-                  defaultSimEvent(iName, dateSTride, recovery));
+                sims.add(defaultSimEvent(iName, dateSTride, recovery));
                 //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster 
@@ -53,26 +53,23 @@ namespace QuantLib {
       : copula_(m), nBuckets_(nbuckets) {}
 
     private:
-      /*!
-      @param pDefDate Vector of unconditional default probabilities for each
-      live name (at the current evaluation date). This is passed instead of
-      the date for performance reasons (if in the future other magnitudes
-      -e.g. lgd- are contingent on the date they shouldd be passed too).
+      /* Loss distribution conditional on the market factor, given the
+         conditional default probabilities of the names; it is computed
+         with the recursion in eq. 10 p.68 on a dense array, whose i-th
+         element is the probability of a loss of i loss units.
       */
-      std::map<Real, Probability> conditionalLossDistrib(const std::vector<Probability>& pDefDate,
-                                                         const std::vector<Real>& mktFactor) const;
-      Real expectedConditionalLoss(const std::vector<Probability>& pDefDate, //<< never used!!
-                                   const std::vector<Real>& mktFactor) const;
-      std::vector<Real> conditionalLossProb(const std::vector<Probability>& pDefDate,
-                                            // const Date& date,
-                                            const std::vector<Real>& mktFactor) const;
-      // versions using the P-inverse, deprecate the former
-      std::map<Real, Probability> conditionalLossDistribInvP(const std::vector<Real>& pDefDate,
-                                                             // const Date& date,
-                                                             const std::vector<Real>& mktFactor) const;
-      Real expectedConditionalLossInvP(const std::vector<Real>& pDefDate,
-                                       // const Date& date,
-                                       const std::vector<Real>& mktFactor) const;
+      void conditionalLossDistrib(const Probability* condDefProbs,
+                                  std::vector<Probability>& distrib) const;
+      // tranche loss expected under a conditional loss distribution
+      Real expectedConditionalLoss(const Probability* distrib) const;
+      /* Conditional loss distributions on each of the integration
+         nodes of the latent model (rows), computed in parallel when
+         OpenMP is enabled; returns false if the integration doesn't
+         work on a fixed set of nodes.
+      */
+      bool conditionalLossDistribs(const std::vector<Real>& invPDefDate,
+                                   Matrix& distribs,
+                                   std::vector<Real>& weights) const;
     protected:
       void resetModel() override;
 
@@ -119,6 +116,8 @@ namespace QuantLib {
             detachAmount_,
             notional_;
         mutable Size remainingBsktSize_;
+        // largest attainable loss, in loss units
+        mutable Size maxLossUnits_;
         mutable std::vector<Real> notionals_;
     };
 
@@ -131,46 +130,31 @@ namespace QuantLib {
     inline Real RecursiveLossModel<CP>::expectedTrancheLoss(
         const Date& date) const 
     {
-/*
-        std::map<Real, Probability> dist = lossDistribution(date);
-
-        Real expLoss = 0.;
-        std::map<Real, Probability>::iterator distIt = dist.begin();
-
-        while(distIt != dist.end()) {
-            Real loss = distIt->first * lossUnit_;
-            loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
-            // MIN MAX BUGS ....??
-            expLoss += loss * distIt->second;
-            distIt++;
-        }
-        return expLoss ;
-
-
-
-
-    ///////////////////////////////////////////////////////////////////////
-
-        // calculate inverted unconditional Ps first so we save the inversion:
-        // TO DO : turn to STL algorithm code
-        std::vector<Probability> uncDefProb = 
-            basket_->remainingProbabilities(date);
-
-        return copula_->integratedExpectedValue(
-            [&](const std::vector<Real>& v1) {
-                return expectedConditionalLoss(uncDefProb, v1);
-            });
-            */
-
+        // calculate inverted unconditional Ps first so we save the inversion
         std::vector<Probability> uncDefProb = 
             basket_->remainingProbabilities(date);
         std::vector<Real> invProb;
         for(Size i=0; i<uncDefProb.size(); ++i)
            invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
-           ///  invProb.push_back(CP::inverseCumulativeY(uncDefProb[i], i));//<-static call
+
+        Matrix distribs;
+        std::vector<Real> weights;
+        if (conditionalLossDistribs(invProb, distribs, weights)) {
+            Real expLoss = 0.;
+            for(Size k=0; k<weights.size(); ++k)
+                expLoss += weights[k] *
+                    expectedConditionalLoss(distribs.row_begin(k));
+            return expLoss;
+        }
+
+        std::vector<Probability> condDefProb(remainingBsktSize_), distrib;
         return copula_->integratedExpectedValue(
             [&](const std::vector<Real>& v1) {
-                return expectedConditionalLossInvP(invProb, v1);
+                for(Size i=0; i<remainingBsktSize_; ++i)
+                    condDefProb[i] = copula_->conditionalDefaultProbabilityInvP(
+                        invProb[i], i, v1);
+                conditionalLossDistrib(condDefProb.data(), distrib);
+                return expectedConditionalLoss(distrib.data());
             });
     }
 
@@ -179,9 +163,28 @@ namespace QuantLib {
 
         std::vector<Probability> uncDefProb = 
             basket_->remainingProbabilities(date);
+        std::vector<Real> invProb;
+        for(Size i=0; i<uncDefProb.size(); ++i)
+           invProb.push_back(copula_->inverseCumulativeY(uncDefProb[i], i));
+
+        Matrix distribs;
+        std::vector<Real> weights;
+        if (conditionalLossDistribs(invProb, distribs, weights)) {
+            std::vector<Real> results(distribs.columns(), 0.);
+            for(Size k=0; k<weights.size(); ++k)
+                for(Size j=0; j<results.size(); ++j)
+                    results[j] += weights[k] * distribs[k][j];
+            return results;
+        }
+
+        std::vector<Probability> condDefProb(remainingBsktSize_), distrib;
         return copula_->integratedExpectedValueV(
             [&](const std::vector<Real>& v1) {
-                return conditionalLossProb(uncDefProb, v1);
+                for(Size i=0; i<remainingBsktSize_; ++i)
+                    condDefProb[i] = copula_->conditionalDefaultProbabilityInvP(
+                        invProb[i], i, v1);
+                conditionalLossDistrib(condDefProb.data(), distrib);
+                return distrib;
             });
     }
 
@@ -207,8 +210,12 @@ namespace QuantLib {
         lgds.erase(std::remove(lgds.begin(), lgds.end(), 0.), lgds.end());
         lossUnit_ = *(std::min_element(lgds.begin(), lgds.end()))
             / nBuckets_;
-        for(Size i=0; i<remainingBsktSize_; ++i)
+        wk_.clear();
+        maxLossUnits_ = 0;
+        for(Size i=0; i<remainingBsktSize_; ++i) {
             wk_.push_back(std::floor(lgdsTmp[i]/lossUnit_ + .5));
+            maxLossUnits_ += static_cast<Size>(wk_.back());
+        }
     }
 
     // make it return a distribution object?
@@ -299,194 +306,75 @@ namespace QuantLib {
     }
 
     template<class CP>
-    std::map<Real, Probability> RecursiveLossModel<CP>::conditionalLossDistrib(
-            const std::vector<Probability>& pDefDate, 
-            //const Date& date,
-            const std::vector<Real>& mktFactor) const 
-    {
-        //eq. 10 p.68
-        //attainable losses distribution, recursive algorithm
-        const std::vector<Probability>& uncDefProb = pDefDate;// alias, remove
-
-        std::map<Real, Probability> pIndepDistrib;
-        ////////  K=0
-        pIndepDistrib.insert(std::make_pair(0., 1.));
-        for(Size iName=0; iName<remainingBsktSize_; ++iName) {
-            Probability pDef =
-                copula_->conditionalDefaultProbability(uncDefProb[iName], iName,
-                                                mktFactor);
-            ////// iterate on all possible losses in the distribution:
-            std::map<Real, Probability> pDistTemp;
-            auto distIt = pIndepDistrib.begin();
-            while(distIt != pIndepDistrib.end()) {
-              ///   update prob if this name does not default
-              auto matchIt = pDistTemp.find(distIt->first);
-              if (matchIt != pDistTemp.end()) {
-                  matchIt->second += distIt->second * (1. - pDef);
-                }else{
-                    pDistTemp.insert(std::make_pair(distIt->first,
-                        distIt->second * (1.-pDef)));
-                }
-              ////   and if it does
-                matchIt = pDistTemp.find(distIt->first + wk_[iName]);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * pDef;
-                }else{
-                    pDistTemp.insert(std::make_pair(
-                        distIt->first+wk_[iName], distIt->second * pDef));
-                }
-                ++distIt;
-            }
-           /////  copy back
-            pIndepDistrib = pDistTemp;
-        }
-        /* Apply tranche limits now .... mind you this could be done outside*/
-        ////  to be done....
-        return pIndepDistrib;
-    }
-
-    // twice?! rewrite one in terms of the other, this is a duplicate!
-    template<class CP>
-    std::map<Real, Probability> RecursiveLossModel<CP>::conditionalLossDistribInvP(
-            const std::vector<Real>& invpDefDate, 
-            //const Date& date,
-            const std::vector<Real>& mktFactor) const 
+    void RecursiveLossModel<CP>::conditionalLossDistrib(
+            const Probability* condDefProbs,
+            std::vector<Probability>& distrib) const 
     {
         // eq. 10 p.68
         // attainable losses distribution, recursive algorithm
-
-        std::map<Real, Probability> pIndepDistrib;
+        distrib.assign(maxLossUnits_+1, 0.);
         // K=0
-        pIndepDistrib.insert(std::make_pair(0., 1.));
+        distrib[0] = 1.;
+        Size maxLoss = 0;
         for(Size iName=0; iName<remainingBsktSize_; ++iName) {
-            Probability pDef =
-                copula_->conditionalDefaultProbabilityInvP(invpDefDate[iName], 
-                    iName, mktFactor);
-
-            // iterate on all possible losses in the distribution:
-            std::map<Real, Probability> pDistTemp;
-            auto distIt = pIndepDistrib.begin();
-            while(distIt != pIndepDistrib.end()) {
-                // update prob if this name does not default
-                auto matchIt = pDistTemp.find(distIt->first);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * (1.-pDef);
-                }else{
-                    pDistTemp.insert(std::make_pair(distIt->first,
-                        distIt->second * (1.-pDef)));
-                }
-                // and if it does
-                matchIt = pDistTemp.find(distIt->first + wk_[iName]);
-                if(matchIt != pDistTemp.end()) {
-                    matchIt->second += distIt->second * pDef;
-                }else{
-                    pDistTemp.insert(std::make_pair(
-                        distIt->first+wk_[iName], distIt->second * pDef));
-                }
-                ++distIt;
+            auto w = static_cast<Size>(wk_[iName]);
+            if(w == 0)
+                continue;
+            Probability pDef = condDefProbs[iName];
+            // going down, so that the probability of each loss is
+            // updated after being used for the loss w units higher
+            for(Size k=maxLoss+1; k-- > 0; ) {
+                // this name defaults
+                distrib[k+w] += distrib[k] * pDef;
+                // or it does not
+                distrib[k] *= 1.-pDef;
             }
-            // copy back
-            pIndepDistrib = pDistTemp;
+            maxLoss += w;
         }
-        /* Apply tranche limits now .... mind you this could be done outside*/
-        return pIndepDistrib;
     }
 
-
-
-
-    /*
-    Bugs here???. The max min on the tranche looks 
-    wrong. It is better to have a tranche function since that way we can avoid 
-    adding up losses over all the possible losses rather than just over the 
-    tranche limits.
-    */
     //! Portfolio loss conditional to the market factor value
     template<class CP>
     Real RecursiveLossModel<CP>::expectedConditionalLoss(
-        const std::vector<Probability>& pDefDate, 
-        //const Date& date,
-        const std::vector<Real>& mktFactor) const 
-    {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistrib(pDefDate, mktFactor);
-
-        // get the expected value subject to the value of the market
-        //   factor.
-        Real expLoss = 0.;
-        //---------------------------------------------------------------
-        /* This is the original (easy to read) loop which I have partially
-             unroll below to take profit of the fact that once we go over
-             the tranche top the loss amount is fixed:
-        */
-        auto distIt = pIndepDistrib.begin();
-
-        while(distIt != pIndepDistrib.end()) {
-            Real loss = distIt->first * lossUnit_;
-     //       loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
-            loss = std::min(std::max(loss - attachAmount_, 0.), 
-                detachAmount_ - attachAmount_);
-            // MIN MAX BUGS ....??
-            expLoss += loss * distIt->second;
-            ++distIt;
-        }
-        return expLoss ;
-    }
-
-    template<class CP>
-    // again, I am duplicating code.
-    Real RecursiveLossModel<CP>::expectedConditionalLossInvP(
-                                 const std::vector<Real>& invPDefDate, 
-                                 //const Date& date,
-                                 const std::vector<Real>& mktFactor) const 
+        const Probability* distrib) const 
     {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistribInvP(invPDefDate, mktFactor);
-
         // get the expected value subject to the value of the market
         //   factor.
         Real expLoss = 0.;
-        //---------------------------------------------------------------
-        /* This is the original (easy to read) loop which I have partially
-             unroll below to take profit of the fact that once we go over
-             the tranche top the loss amount is fixed:
-        */
-        auto distIt = pIndepDistrib.begin();
-
-        while(distIt != pIndepDistrib.end()) {
-            Real loss = distIt->first * lossUnit_;
-   //         loss = std::max(std::min(loss, detachAmount_)-attachAmount_, 0.);
+        for(Size k=0; k<=maxLossUnits_; ++k) {
+            Real loss = k * lossUnit_;
             loss = std::min(std::max(loss - attachAmount_, 0.), 
                 detachAmount_ - attachAmount_);
-            // MIN MAX BUGS ....???
-            expLoss += loss * distIt->second;
-            ++distIt;
+            expLoss += loss * distrib[k];
         }
         return expLoss ;
     }
 
     template<class CP>
-    std::vector<Real> RecursiveLossModel<CP>::conditionalLossProb(
-        const std::vector<Probability>& pDefDate, 
-        //const Date& date,
-        const std::vector<Real>& mktFactor) const 
+    bool RecursiveLossModel<CP>::conditionalLossDistribs(
+        const std::vector<Real>& invPDefDate,
+        Matrix& distribs,
+        std::vector<Real>& weights) const 
     {
-        std::map<Real, Probability> pIndepDistrib =
-            conditionalLossDistrib(pDefDate, mktFactor);
-
-        std::vector<Real> results;
-        auto distIt = pIndepDistrib.begin();
-        while(distIt != pIndepDistrib.end()) {
-            //Real loss = distIt->first * loss_unit_
-            //                    ;
-            //loss = std::max(std::min(loss,
-            //    results_.xMax)-results_.xMin, 0.);
-            //expLoss += loss * distIt->second;
-
-            results.push_back(distIt->second);
-             ++distIt;
+        std::vector<std::vector<Real> > factors;
+        if(!copula_->integrationNodes(factors, weights))
+            return false;
+        // conditional probabilities for all names on all nodes first...
+        Matrix condDefProbs =
+            copula_->conditionalDefaultProbabilitiesInvP(invPDefDate, factors);
+        // ...then the recursion on each node
+        distribs = Matrix(factors.size(), maxLossUnits_+1);
+        #pragma omp parallel
+        {
+            std::vector<Probability> distrib;
+            #pragma omp for
+            for(long k=0; k<(long)factors.size(); ++k) {
+                conditionalLossDistrib(condDefProbs.row_begin(k), distrib);
+                std::copy(distrib.begin(), distrib.end(),
+                          distribs.row_begin(k));
+            }
         }
-        return results;
+        return true;
     }
 
 }
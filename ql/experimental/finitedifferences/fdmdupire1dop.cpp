@@ -59,8 +59,8 @@ Array FdmDupire1dOp::preconditioner(const Array &r, Real dt) const {
     return solve_splitting(0, r, dt);
 }
 
-std::vector<SparseMatrix> FdmDupire1dOp::toMatrixDecomp() const {
-    return std::vector<SparseMatrix>(1, mapT_.toMatrix());
+std::vector<CsrMatrix> FdmDupire1dOp::toCsrMatrixDecomp() const {
+    return std::vector<CsrMatrix>(1, mapT_.toCsrMatrix());
 }
 
 }
@@ -93,8 +93,8 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmExtendedOrnsteinUhlenbeckOp::toMatrixDecomp() const {
-        return std::vector<SparseMatrix>(1, mapX_.toMatrix());
+    std::vector<CsrMatrix> FdmExtendedOrnsteinUhlenbeckOp::toCsrMatrixDecomp() const {
+        return std::vector<CsrMatrix>(1, mapX_.toCsrMatrix());
     }
 
 }
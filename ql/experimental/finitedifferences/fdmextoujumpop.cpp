@@ -69,8 +69,8 @@ namespace QuantLib {
         const Array yInt   = gaussLaguerreIntegration_.x();
         const Array weights= gaussLaguerreIntegration_.weights();
 
-        integroPart_ = SparseMatrix(mesher_->layout()->size(),
-                                    mesher_->layout()->size());
+        const Size n = mesher_->layout()->size();
+        CsrMatrix::Builder integroPart(n, n, n*(2*yInt.size()+1));
 
         Array yLoc(mesher_->layout()->dim()[1]);
         for (const auto& iter : *mesher_->layout()) {
@@ -79,7 +79,7 @@ namespace QuantLib {
 
         for (const auto& iter : *mesher_->layout()) {
             const Size diag = iter.index();
-            integroPart_(diag, diag) -= lambda;
+            integroPart.add(diag, diag, -lambda);
 
             const Real y = mesher_->location(iter, 1);
             const Integer yIndex = iter.coordinates()[1];
@@ -93,12 +93,13 @@ namespace QuantLib {
                                        yLoc.end()-1, ys) - yLoc.begin()-1;
 
                 const Real s = (ys-yLoc[l])/(yLoc[l+1]-yLoc[l]);
-                integroPart_(diag, mesher_->layout()->neighbourhood(iter, 1, l-yIndex))
-                    += weight*lambda*(1-s);
-                integroPart_(diag, mesher_->layout()->neighbourhood(iter, 1, l+1-yIndex))
-                    += weight*lambda*s;
+                integroPart.add(diag, mesher_->layout()->neighbourhood(iter, 1, l-yIndex),
+                                weight*lambda*(1-s));
+                integroPart.add(diag, mesher_->layout()->neighbourhood(iter, 1, l+1-yIndex),
+                                weight*lambda*s);
             }
         }
+        integroPart_ = integroPart.matrix();
     }
 
     Size FdmExtOUJumpOp::size() const {
@@ -149,11 +150,11 @@ namespace QuantLib {
         return prod(integroPart_, r);
     }
 
-    std::vector<SparseMatrix> FdmExtOUJumpOp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmExtOUJumpOp::toCsrMatrixDecomp() const {
         QL_REQUIRE(bcSet_.empty(), "boundary conditions are not supported");
 
-        std::vector<SparseMatrix> retVal(1, ouOp_->toMatrixDecomp().front());
-        retVal.push_back(dyMap_.toMatrix());
+        std::vector<CsrMatrix> retVal(1, ouOp_->toCsrMatrixDecomp().front());
+        retVal.push_back(dyMap_.toCsrMatrix());
         retVal.push_back(integroPart_);
 
         return retVal;
@@ -24,7 +24,7 @@
 #ifndef quantlib_fdm_ext_ou_jump_op_hpp
 #define quantlib_fdm_ext_ou_jump_op_hpp
 
-#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/integrals/gaussianquadratures.hpp>
 #include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
@@ -61,7 +61,7 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& r, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
-        std::vector<SparseMatrix> toMatrixDecomp() const override;
+        std::vector<CsrMatrix> toCsrMatrixDecomp() const override;
       private:
         Array integro(const Array& r) const;
 
@@ -76,7 +76,7 @@ namespace QuantLib {
 
         const TripleBandLinearOp dyMap_;
 
-        SparseMatrix integroPart_;
+        CsrMatrix integroPart_;
     };
 }
 
@@ -106,14 +106,14 @@ namespace QuantLib {
         return klugeOp_->solve_splitting(0, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmKlugeExtOUOp::toMatrixDecomp() const {
-        const std::vector<SparseMatrix> klugeDecomp = klugeOp_->toMatrixDecomp();
+    std::vector<CsrMatrix> FdmKlugeExtOUOp::toCsrMatrixDecomp() const {
+        const std::vector<CsrMatrix> klugeDecomp = klugeOp_->toCsrMatrixDecomp();
 
         return {
             klugeDecomp[0],
             klugeDecomp[1],
-            ouOp_->toMatrixDecomp().front(),
-            corrMap_.toMatrix() + klugeDecomp[2]
+            ouOp_->toCsrMatrixDecomp().front(),
+            corrMap_.toCsrMatrix() + klugeDecomp[2]
         };
     }
 
@@ -106,11 +106,11 @@ Array FdmZabrOp::preconditioner(const Array &r, Real dt) const {
     return solve_splitting(0, r, dt);
 }
 
-std::vector<SparseMatrix> FdmZabrOp::toMatrixDecomp() const {
+std::vector<CsrMatrix> FdmZabrOp::toCsrMatrixDecomp() const {
     return {
-        dxMap_.getMap().toMatrix(),
-        dyMap_.getMap().toMatrix(),
-        dxyMap_.toMatrix()
+        dxMap_.getMap().toCsrMatrix(),
+        dyMap_.getMap().toCsrMatrix(),
+        dxyMap_.toCsrMatrix()
     };
 }
 
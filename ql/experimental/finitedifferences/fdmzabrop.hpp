@@ -82,7 +82,7 @@ class FdmZabrOp : public FdmLinearOpComposite {
     Array solve_splitting(Size direction, const Array& r, Real s) const override;
     Array preconditioner(const Array& r, Real s) const override;
 
-    std::vector<SparseMatrix> toMatrixDecomp() const override;
+    std::vector<CsrMatrix> toCsrMatrixDecomp() const override;
 
   private:
     const Array volatilityValues_;
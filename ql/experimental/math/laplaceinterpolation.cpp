@@ -24,7 +24,8 @@
 #include <ql/experimental/math/laplaceinterpolation.hpp>
 #include <ql/math/matrix.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
-#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <ql/math/matrixutilities/ilu0preconditioner.hpp>
 #include <ql/methods/finitedifferences/meshers/fdm1dmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
@@ -91,32 +92,34 @@ namespace QuantLib {
                 QL_FAIL("no impl");
             }
             Array preconditioner(const Array& r, Real s) const override { QL_FAIL("no impl"); }
-            std::vector<SparseMatrix> toMatrixDecomp() const override {
-                std::vector<SparseMatrix> decomp;
+            std::vector<CsrMatrix> toCsrMatrixDecomp() const override {
+                std::vector<CsrMatrix> decomp;
                 decomp.reserve(map_.size());
-for (auto const& m : map_)
-                    decomp.push_back(m.toMatrix());
+                for (auto const& m : map_)
+                    decomp.push_back(m.toCsrMatrix());
                 return decomp;
             }
         };
 
-        SparseMatrix op = LaplaceOp(mesher).toMatrix();
+        const CsrMatrix op = LaplaceOp(mesher).toCsrMatrix();
 
         // set up the linear system to solve
 
         Size N = layout_->size();
 
-        SparseMatrix g(N, N, 5 * N);
+        CsrMatrix::Builder g(N, N, 5 * N);
         Array rhs(N, 0.0), guess(N, 0.0);
         Real guessTmp = 0.0;
 
         struct f_A {
-            const SparseMatrix& g;
-            explicit f_A(const SparseMatrix& g) : g(g) {}
+            const CsrMatrix& g;
+            explicit f_A(const CsrMatrix& g) : g(g) {}
             Array operator()(const Array& x) const { return prod(g, x); }
         };
 
-        auto rowit = op.begin1();
+        QL_REQUIRE(op.rows() == N,
+                   "LaplaceInterpolation: op matrix rows (" << op.rows()
+                       << ") do not match expected row count (" << N << ")");
         Size count = 0;
         std::vector<Real> corner_h(dim.size());
         std::vector<Size> corner_neighbour_index(dim.size());
@@ -124,10 +127,6 @@ for (auto const& m : map_)
             const auto& coord = pos.coordinates();
             Real val =
                 y_(numberOfCoordinatesIncluded_ == x_.size() ? coord : fullCoordinates(coord));
-            QL_REQUIRE(rowit != op.end1() && rowit.index1() == count,
-                       "LaplaceInterpolation: op matrix row iterator ("
-                           << (rowit != op.end1() ? std::to_string(rowit.index1()) : "na")
-                           << ") does not match expected row count (" << count << ")");
             if (val == Null<Real>()) {
                 bool isCorner = true;
                 for (Size d = 0; d < dim.size() && isCorner; ++d) {
@@ -155,26 +154,30 @@ for (auto const& m : map_)
                                 weight += corner_h[i];
                         }
                         weight = dim.size() == 1 ? Real(1.0) : Real(weight / sum_corner_h);
-                        g(count, layout_->index(coord_j)) = -weight;
+                        g.add(count, layout_->index(coord_j), -weight);
                     }
-                    g(count, count) = 1.0;
+                    g.add(count, count, 1.0);
                 } else {
                     // point with at least one dimension with non-trivial second derivative
-                    for (auto colit = rowit.begin(); colit != rowit.end(); ++colit)
-                        g(count, colit.index2()) = *colit;
+                    for (Size k = op.rowOffsets()[count]; k < op.rowOffsets()[count + 1]; ++k)
+                        g.add(count, op.columnIndices()[k], op.values()[k]);
                 }
                 rhs[count] = 0.0;
                 guess[count] = guessTmp;
             } else {
-                g(count, count) = 1;
+                g.add(count, count, 1.0);
                 rhs[count] = val;
                 guess[count] = guessTmp = val;
             }
             ++count;
-            ++rowit;
         }
 
-        interpolatedValues_ = BiCGstab(f_A(g), maxIterMultiplier_ * N, relTol_).solve(rhs, guess).x;
+        const CsrMatrix gm = g.matrix();
+        const ILU0Preconditioner ilu(gm);
+        interpolatedValues_ =
+            BiCGstab(f_A(gm), maxIterMultiplier_ * N, relTol_,
+                     [&ilu](const Array& x) { return ilu.apply(x); })
+                .solve(rhs, guess).x;
     }
 
     std::vector<Size>
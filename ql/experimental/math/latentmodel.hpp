@@ -31,6 +31,7 @@
 #include <ql/experimental/math/polarstudenttrng.hpp>
 #include <ql/handle.hpp>
 #include <ql/quote.hpp>
+#include <cstdint>
 #include <vector>
 
 /*! \file latentmodel.hpp
@@ -81,6 +82,14 @@ namespace QuantLib {
             const std::vector<Real>& arg)>& f) const {
             QL_FAIL("No vector integration provided");
         }
+        /* Nodes and weights of the integration rule, for integrands
+           evaluated on all the nodes at once; returns false if the
+           integration doesn't work on a fixed set of nodes.
+        */
+        virtual bool nodes(std::vector<std::vector<Real> >& points,
+                           std::vector<Real>& weights) const {
+            return false;
+        }
         virtual ~LMIntegration() = default;
     };
 
@@ -124,6 +133,11 @@ namespace QuantLib {
             const override {
             return GaussianQuadMultidimIntegrator::integrate<std::vector<Real>>(f);
         }
+        bool nodes(std::vector<std::vector<Real> >& points,
+                   std::vector<Real>& weights) const override {
+            GaussianQuadMultidimIntegrator::nodes(points, weights);
+            return true;
+        }
         ~IntegrationBase() override = default;
     };
 
@@ -428,6 +442,16 @@ namespace QuantLib {
                 x_.value = copula_.allFactorCumulInverter(sample.value);
                 return x_;
             }
+            /*! Positions a newly built sampler so that the next call
+                to nextSequence() returns the n-th sample of the sequence.
+                Only available for sequence generators providing a
+                skipTo method (e.g., SobolRsg); it allows independent
+                samplers to produce consecutive chunks of the same
+                sequence.
+            */
+            void skipTo(Size n) const {
+                sequenceGen_.skipTo(static_cast<std::uint32_t>(n));
+            }
         private:
             USNG sequenceGen_;// copy, we might be mutithreaded
             mutable sample_type x_;
@@ -596,6 +620,22 @@ namespace QuantLib {
             return integration()->integrateV(//see note in LMIntegrators base class
                 [&](const std::vector<Real>& x){ return M(copula_.density(x), f(x)); });
         }
+        /*! Returns the values of the model factors on which the
+            integration is performed and their weights, including the
+            density, so that integrands can be evaluated on all of
+            them at once; the expected value of a function is then the
+            weighted sum of its values.  Returns false if the
+            integration doesn't work on a fixed set of nodes, in
+            which case the methods above must be used.
+        */
+        bool integrationNodes(std::vector<std::vector<Real> >& factors,
+                              std::vector<Real>& weights) const {
+            if (!integration()->nodes(factors, weights))
+                return false;
+            for (Size k=0; k<factors.size(); ++k)
+                weights[k] *= copula_.density(factors[k]);
+            return true;
+        }
     protected:
         // Integrable models must provide their integrator.
         // Arguable, not having the integration in the LM class saves that 
@@ -35,6 +35,29 @@ namespace QuantLib {
         spawnFcts<maxDimensions_>();
     }
 
+    void GaussianQuadMultidimIntegrator::nodes(
+                                    std::vector<std::vector<Real> >& points,
+                                    std::vector<Real>& weights) const {
+        const Array& x = integral_.x();
+        const Array& w = integral_.weights();
+        const Size n = x.size();
+        Size size = 1;
+        for (Size d=0; d<dimension_; ++d)
+            size *= n;
+        points.assign(size, std::vector<Real>(dimension_));
+        weights.assign(size, 1.0);
+        // tensor product of the one-dimensional quadrature
+        for (Size k=0; k<size; ++k) {
+            Size index = k;
+            for (Size d=0; d<dimension_; ++d) {
+                Size i = index % n;
+                index /= n;
+                points[k][d] = x[i];
+                weights[k] *= w[i];
+            }
+        }
+    }
+
 }
 
 #endif
@@ -86,6 +86,13 @@ namespace QuantLib {
         //! Integration quadrature order.
         Size order() const {return integralV_.order();}
 
+        /*! Returns the nodes of the quadrature over \f$ R^{dim} \f$ and
+            their weights, so that integrands can be evaluated on all
+            the nodes at once (e.g., in parallel.)
+        */
+        void nodes(std::vector<std::vector<Real> >& points,
+                   std::vector<Real>& weights) const;
+
         //! Integrates function f over \f$ R^{dim} \f$
         /* This function is just syntax since the only thing it does is calling 
         to integrate<RetType> which has to exist for the type returned by the 
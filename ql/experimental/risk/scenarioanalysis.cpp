@@ -0,0 +1,183 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+namespace QuantLib {
+
+    namespace {
+
+        // sets the quotes to the given values, notifying each of
+        // their observers once; unless already disabled, updates are
+        // deferred until all quotes are set.
+        void setQuotes(const std::vector<ext::shared_ptr<SimpleQuote> >& quotes,
+                       const std::vector<Real>& values) {
+            ObservableSettings& settings = ObservableSettings::instance();
+            const bool defer = settings.updatesEnabled();
+            if (defer)
+                settings.disableUpdates(true);
+            for (Size i=0; i<quotes.size(); ++i) {
+                if (quotes[i]->value() != values[i])
+                    quotes[i]->setValue(values[i]);
+            }
+            if (defer)
+                settings.enableUpdates();
+        }
+
+        // restores the original values of the quotes on exit
+        class QuoteRestorer {
+          public:
+            explicit QuoteRestorer(
+                      const std::vector<ext::shared_ptr<SimpleQuote> >& quotes)
+            : quotes_(quotes), values_(quotes.size()) {
+                for (Size i=0; i<quotes.size(); ++i)
+                    values_[i] = quotes[i]->value();
+            }
+            ~QuoteRestorer() {
+                try {
+                    setQuotes(quotes_, values_);
+                } catch (...) {
+                    // nothing we can do about it
+                }
+            }
+            QuoteRestorer(const QuoteRestorer&) = delete;
+            QuoteRestorer& operator=(const QuoteRestorer&) = delete;
+            const std::vector<Real>& values() const { return values_; }
+          private:
+            const std::vector<ext::shared_ptr<SimpleQuote> >& quotes_;
+            std::vector<Real> values_;
+        };
+
+    }
+
+    ScenarioAnalysis::ScenarioAnalysis(
+                        std::vector<ext::shared_ptr<SimpleQuote> > quotes,
+                        std::vector<ext::shared_ptr<Instrument> > trades)
+    : quotes_(std::move(quotes)), trades_(std::move(trades)),
+      affectedTrades_(quotes_.size()) {
+        for (const auto& q : quotes_)
+            QL_REQUIRE(q, "null quote");
+        for (const auto& t : trades_) {
+            QL_REQUIRE(t, "null trade");
+            graph_.add(t);
+        }
+
+        std::map<const LazyObject*, Size> nodes;
+        for (Size i=0; i<graph_.size(); ++i)
+            nodes[graph_.node(i).get()] = i;
+        nodes_.reserve(trades_.size());
+        for (const auto& t : trades_)
+            nodes_.push_back(nodes.at(static_cast<const LazyObject*>(t.get())));
+
+        // the quotes reached by each node, either directly or through
+        // its dependencies (which come first in the graph)
+        std::map<const Observable*, Size> quoteIndex;
+        for (Size q=0; q<quotes_.size(); ++q)
+            quoteIndex[static_cast<const Observable*>(quotes_[q].get())] = q;
+        std::vector<std::vector<Size> > reached(graph_.size());
+        for (Size i=0; i<graph_.size(); ++i) {
+            std::vector<Size>& r = reached[i];
+            for (const Observable* o : graph_.observables(i)) {
+                auto q = quoteIndex.find(o);
+                if (q != quoteIndex.end())
+                    r.push_back(q->second);
+            }
+            for (Size j : graph_.dependencies(i))
+                r.insert(r.end(), reached[j].begin(), reached[j].end());
+            std::sort(r.begin(), r.end());
+            r.erase(std::unique(r.begin(), r.end()), r.end());
+        }
+        for (Size i=0; i<trades_.size(); ++i) {
+            for (Size q : reached[nodes_[i]])
+                affectedTrades_[q].push_back(i);
+        }
+    }
+
+    const std::vector<Size>& ScenarioAnalysis::affectedTrades(Size quote) const {
+        QL_REQUIRE(quote < quotes_.size(),
+                   "quote " << quote << " out of range [0, "
+                   << quotes_.size() << ")");
+        return affectedTrades_[quote];
+    }
+
+    Real ScenarioAnalysis::throughput() const {
+        QL_REQUIRE(elapsedTime_ != Null<Real>(), "no scenarios run");
+        return elapsedTime_ > 0.0 ?
+            Real(scenarios_ * trades_.size()) / elapsedTime_ : QL_MAX_REAL;
+    }
+
+    std::vector<Real> ScenarioAnalysis::baseValues() const {
+        graph_.calculate(nodes_);
+        std::vector<Real> values(trades_.size());
+        for (Size i=0; i<trades_.size(); ++i)
+            values[i] = trades_[i]->NPV();
+        return values;
+    }
+
+    Matrix ScenarioAnalysis::profitAndLoss(const Matrix& shifts) const {
+        QL_REQUIRE(shifts.columns() == quotes_.size(),
+                   "wrong number of shifts (" << shifts.columns()
+                   << ", " << quotes_.size() << " required)");
+
+        const auto start = std::chrono::steady_clock::now();
+        QuoteRestorer restorer(quotes_);
+        const std::vector<Real>& base = restorer.values();
+        const std::vector<Real> baseNPV = baseValues();
+
+        Matrix result(shifts.rows(), trades_.size(), 0.0);
+        std::vector<Real> values(quotes_.size());
+        // the scenario in which each trade was last found affected
+        std::vector<Size> affectedIn(trades_.size(), Size(-1));
+        std::vector<Size> affected, nodes;
+        revaluations_ = 0;
+        for (Size k=0; k<shifts.rows(); ++k) {
+            affected.clear();
+            for (Size q=0; q<quotes_.size(); ++q) {
+                values[q] = base[q] + shifts[k][q];
+                if (shifts[k][q] == 0.0)
+                    continue;
+                for (Size i : affectedTrades_[q]) {
+                    if (affectedIn[i] != k) {
+                        affectedIn[i] = k;
+                        affected.push_back(i);
+                    }
+                }
+            }
+            // quotes shifted in the previous scenario are reset here
+            setQuotes(quotes_, values);
+
+            // only the invalidated objects the affected trades depend
+            // on are recalculated
+            nodes.clear();
+            for (Size i : affected)
+                nodes.push_back(nodes_[i]);
+            graph_.calculate(nodes);
+            for (Size i : affected)
+                result[k][i] = trades_[i]->NPV() - baseNPV[i];
+            revaluations_ += affected.size();
+        }
+
+        scenarios_ = shifts.rows();
+        elapsedTime_ = std::chrono::duration<Real>(
+            std::chrono::steady_clock::now() - start).count();
+        return result;
+    }
+
+}
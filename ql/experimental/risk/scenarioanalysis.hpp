@@ -0,0 +1,103 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file scenarioanalysis.hpp
+    \brief revaluation of a portfolio under market scenarios
+*/
+
+#ifndef quantlib_scenario_analysis_hpp
+#define quantlib_scenario_analysis_hpp
+
+#include <ql/instrument.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/patterns/dependencygraph.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/utilities/null.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Revaluation of a portfolio under market scenarios
+    /*! Each scenario is a vector of additive shifts to a given set
+        of quotes; typical uses are historical or Monte Carlo
+        value-at-risk and stress testing.  For each scenario, the
+        shifts are applied together, so that each affected object is
+        notified only once; then, only the trades depending on the
+        shifted quotes are revalued, by calculating the part of their
+        dependency graph that was invalidated.  Within each
+        scenario, independent objects (e.g., curves and instruments
+        not depending on one another) are calculated in parallel
+        when OpenMP is enabled; see DependencyGraph::calculate() for
+        the corresponding requirements.
+
+        The dependencies between quotes and trades are found at
+        construction; the analysis must be rebuilt if the trades are
+        relinked to different market objects.
+
+        \warning The quotes are modified while the scenarios are
+                 run; they are restored to their original values
+                 afterwards, even if a calculation fails.
+    */
+    class ScenarioAnalysis {
+      public:
+        ScenarioAnalysis(std::vector<ext::shared_ptr<SimpleQuote> > quotes,
+                         std::vector<ext::shared_ptr<Instrument> > trades);
+        //! \name Inspectors
+        //@{
+        Size quotes() const { return quotes_.size(); }
+        Size trades() const { return trades_.size(); }
+        //! indices of the trades depending on the given quote
+        const std::vector<Size>& affectedTrades(Size quote) const;
+        //@}
+        /*! \name Statistics
+            These refer to the last call to profitAndLoss().
+        */
+        //@{
+        //! number of trades actually revalued over the scenarios
+        Size revaluations() const { return revaluations_; }
+        //! time taken, in seconds
+        Real elapsedTime() const { return elapsedTime_; }
+        //! number of scenarios times number of trades per second
+        Real throughput() const;
+        //@}
+        //! \name Calculations
+        //@{
+        //! values of the trades with the current quote values
+        std::vector<Real> baseValues() const;
+        /*! returns the profit and loss of each trade (columns) in
+            each scenario (rows) with respect to the base values; the
+            shifts are given as a matrix with a row for each scenario
+            and a column for each quote.  Trades not depending on any
+            of the quotes shifted in a scenario are not revalued and
+            their profit and loss is set to zero.
+        */
+        Matrix profitAndLoss(const Matrix& shifts) const;
+        //@}
+      private:
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes_;
+        std::vector<ext::shared_ptr<Instrument> > trades_;
+        DependencyGraph graph_;
+        // index of each trade in the graph
+        std::vector<Size> nodes_;
+        std::vector<std::vector<Size> > affectedTrades_;
+        mutable Size scenarios_ = 0, revaluations_ = 0;
+        mutable Real elapsedTime_ = Null<Real>();
+    };
+
+}
+
+#endif
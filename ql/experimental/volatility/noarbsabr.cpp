@@ -23,6 +23,7 @@
 #include <ql/math/modifiedbessel.hpp>
 #include <boost/math/special_functions/gamma.hpp>
 #include <boost/functional/hash.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -47,6 +48,16 @@ class NoArbSabrModel::p_integrand {
     }
 };
 
+class NoArbSabrModel::fp_integrand {
+    const NoArbSabrModel* model;
+  public:
+    explicit fp_integrand(const NoArbSabrModel* model)
+    : model(model) {}
+    Real operator()(Real f) const {
+        return f * model->p(f);
+    }
+};
+
 NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
                                const Real alpha, const Real beta, const Real nu,
                                const Real rho)
@@ -70,6 +81,11 @@ NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
     QL_REQUIRE(rho >= detail::NoArbSabrModel::rho_min && rho <= detail::NoArbSabrModel::rho_max,
                "rho (" << rho << ") out of bounds");
 
+    gamma_ = 1.0 / (2.0 * (1.0 - beta_));
+    sqrtOmR_ = std::sqrt(1.0 - rho_ * rho_);
+    atanRho_ = std::atan(rho_ / sqrtOmR_);
+    setForward(forward_);
+
     // determine a region sufficient for integration in the normal case
 
     fmin_ = fmax_ = forward_;
@@ -103,10 +119,10 @@ NoArbSabrModel::NoArbSabrModel(const Real expiryTime, const Real forward,
             b.solve([&](Real x){ return forwardError(x); },
                     detail::NoArbSabrModel::forward_accuracy, start,
                     std::min(detail::NoArbSabrModel::forward_search_step, start / 2.0));
-        forward_ = tmp * tmp + detail::NoArbSabrModel::strike_min;
+        setForward(tmp * tmp + detail::NoArbSabrModel::strike_min);
     } catch (Error&) {
         // fall back to unadjusted forward
-        forward_ = externalForward_;
+        setForward(externalForward_);
     }
 
     Real d = forwardError(std::sqrt(forward_ - detail::NoArbSabrModel::strike_min));
@@ -122,6 +138,53 @@ Real NoArbSabrModel::optionPrice(const Real strike) const {
             numericalIntegralOverP_);
 }
 
+std::vector<Real>
+NoArbSabrModel::optionPrices(const std::vector<Real>& strikes) const {
+    if (grid_.empty())
+        tabulate();
+    std::vector<Real> result(strikes.size(), 0.0);
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Real strike = strikes[i];
+        if (strike >= grid_.back()) {
+            // beyond the tabulated domain
+            result[i] = optionPrice(strike);
+            continue;
+        }
+        if (p(std::max(forward_, strike)) < detail::NoArbSabrModel::density_threshold)
+            continue;
+        Size j = std::upper_bound(grid_.begin(), grid_.end(), strike) - grid_.begin();
+        Real call = (*integrator_)(integrand(this, strike), strike, grid_[j]) +
+                    (fpIntegrals_[j] - strike * pIntegrals_[j]);
+        result[i] = (1.0 - absProb_) * (call / numericalIntegralOverP_);
+    }
+    return result;
+}
+
+void NoArbSabrModel::tabulate() const {
+    // the grid is geometric, since the domain often spans
+    // several orders of magnitude
+    Size n = detail::NoArbSabrModel::tabulation_points;
+    grid_.resize(n);
+    Real ratio = std::pow(fmax_ / fmin_, 1.0 / (n - 1));
+    grid_.front() = fmin_;
+    for (Size i = 1; i < n - 1; ++i)
+        grid_[i] = grid_[i - 1] * ratio;
+    grid_.back() = fmax_;
+
+    // the errors on the single intervals add up, so that
+    // we need a higher accuracy than for a single integral
+    GaussLobattoIntegral integrator(detail::NoArbSabrModel::i_max_iterations,
+                                    detail::NoArbSabrModel::i_accuracy / (n - 1));
+    pIntegrals_.assign(n, 0.0);
+    fpIntegrals_.assign(n, 0.0);
+    for (Size i = n - 1; i > 0; --i) {
+        pIntegrals_[i - 1] =
+            pIntegrals_[i] + integrator(p_integrand(this), grid_[i - 1], grid_[i]);
+        fpIntegrals_[i - 1] =
+            fpIntegrals_[i] + integrator(fp_integrand(this), grid_[i - 1], grid_[i]);
+    }
+}
+
 Real NoArbSabrModel::digitalOptionPrice(const Real strike) const {
     if (strike < QL_MIN_POSITIVE_REAL)
         return 1.0;
@@ -134,12 +197,24 @@ Real NoArbSabrModel::digitalOptionPrice(const Real strike) const {
 }
 
 Real NoArbSabrModel::forwardError(const Real forward) const {
-    forward_ = forward * forward + detail::NoArbSabrModel::strike_min;
+    setForward(forward * forward + detail::NoArbSabrModel::strike_min);
     numericalIntegralOverP_ = (*integrator_)(p_integrand(this),
                                              fmin_, fmax_);
     return optionPrice(0.0) - externalForward_;
 }
 
+void NoArbSabrModel::setForward(const Real forward) const {
+    forward_ = forward;
+    FOmB_ = std::pow(forward_, 1.0 - beta_);
+    zF_ = FOmB_ / (alpha_ * (1.0 - beta_));
+    Real Bp_B = beta_ / FOmB_;
+    kappa1_ = 0.125 * nu_ * nu_ * (2.0 - 3.0 * rho_ * rho_) -
+              0.25 * rho_ * nu_ * alpha_ * Bp_B;
+    zFGamma_ = std::pow(zF_, gamma_);
+    // invalidate the tabulated integrals
+    grid_.clear();
+}
+
 Real NoArbSabrModel::p(const Real f) const {
 
     if (f < detail::NoArbSabrModel::density_lower_bound ||
@@ -147,37 +222,29 @@ Real NoArbSabrModel::p(const Real f) const {
         return 0.0;
 
     Real fOmB = std::pow(f, 1.0 - beta_);
-    Real FOmB = std::pow(forward_, 1.0 - beta_);
 
     Real zf = fOmB / (alpha_ * (1.0 - beta_));
-    Real zF = FOmB / (alpha_ * (1.0 - beta_));
-    Real z = zF - zf;
+    Real z = zF_ - zf;
 
-    // Real JzF = std::sqrt(1.0 - 2.0 * rho_ * nu_ * zF + nu_ * nu_ * zF * zF);
+    // Real JzF = std::sqrt(1.0 - 2.0 * rho_ * nu_ * zF_ + nu_ * nu_ * zF_ * zF_);
     Real Jmzf = std::sqrt(1.0 + 2.0 * rho_ * nu_ * zf + nu_ * nu_ * zf * zf);
     Real Jz = std::sqrt(1.0 - 2.0 * rho_ * nu_ * z + nu_ * nu_ * z * z);
 
     Real xz = std::log((Jz - rho_ + nu_ * z) / (1.0 - rho_)) / nu_;
-    Real Bp_B = beta_ / FOmB;
-    // Real Bpp_B = beta_ * (2.0 * beta_ - 1.0) / (FOmB * FOmB);
-    Real kappa1 = 0.125 * nu_ * nu_ * (2.0 - 3.0 * rho_ * rho_) -
-                  0.25 * rho_ * nu_ * alpha_ * Bp_B;
+    // Real Bpp_B = beta_ * (2.0 * beta_ - 1.0) / (FOmB_ * FOmB_);
     // Real kappa2 = alpha_ * alpha_ * (0.25 * Bpp_B - 0.375 * Bp_B * Bp_B);
-    Real gamma = 1.0 / (2.0 * (1.0 - beta_));
-    Real sqrtOmR = std::sqrt(1.0 - rho_ * rho_);
     Real h = 0.5 * beta_ * rho_ / ((1.0 - beta_) * Jmzf * Jmzf) *
-             (nu_ * zf * std::log(zf * Jz / zF) +
-              (1 + rho_ * nu_ * zf) / sqrtOmR *
-                  (std::atan((nu_ * z - rho_) / sqrtOmR) +
-                   std::atan(rho_ / sqrtOmR)));
+             (nu_ * zf * std::log(zf * Jz / zF_) +
+              (1 + rho_ * nu_ * zf) / sqrtOmR_ *
+                  (std::atan((nu_ * z - rho_) / sqrtOmR_) + atanRho_));
 
     Real res =
         std::pow(Jz, -1.5) / (alpha_ * std::pow(f, beta_) * expiryTime_) *
-        std::pow(zf, 1.0 - gamma) * std::pow(zF, gamma) *
+        std::pow(zf, 1.0 - gamma_) * zFGamma_ *
         std::exp(-(xz * xz) / (2.0 * expiryTime_) +
-                 (h + kappa1 * expiryTime_)) *
-        modifiedBesselFunction_i_exponentiallyWeighted(gamma,
-                                                       Real(zF * zf / expiryTime_));
+                 (h + kappa1_ * expiryTime_)) *
+        modifiedBesselFunction_i_exponentiallyWeighted(gamma_,
+                                                       Real(zF_ * zf / expiryTime_));
     return res;
 }
 
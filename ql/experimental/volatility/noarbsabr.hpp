@@ -95,6 +95,9 @@ const Real forward_search_step = 0.0010;
 const Real density_lower_bound = 1E-50;
 // threshold to identify a zero density
 const Real density_threshold = 1E-100;
+// number of points of the grid on which the
+// density is tabulated for batched pricing
+const Size tabulation_points = 17;
 }
 
 class NoArbSabrModel {
@@ -103,6 +106,14 @@ class NoArbSabrModel {
     NoArbSabrModel(Real expiryTime, Real forward, Real alpha, Real beta, Real nu, Real rho);
 
     Real optionPrice(Real strike) const;
+    /*! Returns the call prices for the given strikes.  The
+        integrals of the density over a fixed grid spanning the
+        integration domain are computed on the first call and
+        shared by all strikes, so that each strike only requires
+        an integration up to the next grid point.  Results agree
+        with optionPrice() within the integration accuracy.
+    */
+    std::vector<Real> optionPrices(const std::vector<Real>& strikes) const;
     Real digitalOptionPrice(Real strike) const;
     Real density(const Real strike) const {
         return p(strike) * (1 - absProb_) / numericalIntegralOverP_;
@@ -121,14 +132,22 @@ class NoArbSabrModel {
     private:
       Real p(Real f) const;
       Real forwardError(Real forward) const;
+      void setForward(Real forward) const;
+      void tabulate() const;
       const Real expiryTime_, externalForward_;
       const Real alpha_, beta_, nu_, rho_;
       Real absProb_, fmin_, fmax_;
       mutable Real forward_, numericalIntegralOverP_;
       mutable Real numericalForward_;
+      // terms of the density not depending on f
+      Real gamma_, sqrtOmR_, atanRho_;
+      mutable Real FOmB_, zF_, kappa1_, zFGamma_;
+      // grid points and integrals of p(f) and f p(f) above them
+      mutable std::vector<Real> grid_, pIntegrals_, fpIntegrals_;
       ext::shared_ptr<GaussLobattoIntegral> integrator_;
       class integrand;
       class p_integrand;
+      class fp_integrand;
 };
 
 namespace detail {
@@ -60,9 +60,12 @@ class NoArbSabrSmileSection : public SmileSection {
 
   protected:
     Volatility volatilityImpl(Rate strike) const override;
+    std::vector<Volatility>
+    volatilitiesImpl(const std::vector<Rate>& strikes) const override;
 
   private:
     void init();
+    Volatility impliedVolatility(Rate strike, Real callPrice) const;
     ext::shared_ptr<NoArbSabrModel> model_;
     Rate forward_;
     std::vector<Real> params_;
@@ -53,4 +53,19 @@ Volatility SviSmileSection::volatilityImpl(Rate strike) const {
     return std::sqrt(std::max(0.0, totalVariance / exerciseTime()));
 
 }
+
+std::vector<Volatility>
+SviSmileSection::volatilitiesImpl(const std::vector<Rate>& strikes) const {
+
+    const Real a = params_[0], b = params_[1], sigma = params_[2],
+               rho = params_[3], m = params_[4];
+    const Time t = exerciseTime();
+    std::vector<Volatility> result(strikes.size());
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Real k = std::log(std::max(strikes[i], 1E-6) / forward_);
+        Real totalVariance = detail::sviTotalVariance(a, b, sigma, rho, m, k);
+        result[i] = std::sqrt(std::max(0.0, totalVariance / t));
+    }
+    return result;
+}
 } // namespace QuantLib
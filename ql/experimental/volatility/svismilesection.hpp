@@ -60,6 +60,7 @@ class SviSmileSection : public SmileSection {
 
   protected:
     Volatility volatilityImpl(Rate strike) const override;
+    std::vector<Volatility> volatilitiesImpl(const std::vector<Rate>& strikes) const override;
 
   private:
     void init();
@@ -0,0 +1,457 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file adjointreal.hpp
+    \brief tape-based adjoint real type
+*/
+
+#ifndef quantlib_adjoint_real_hpp
+#define quantlib_adjoint_real_hpp
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace QuantLib {
+
+    class AdjointReal;
+
+    //! Tape recording operations on adjoint reals
+    /*! Operations involving at least one active variable are recorded
+        on the tape active in the running thread, if any.  Variables
+        become active when registered as inputs; after the
+        calculation, derivatives of an output with respect to all the
+        inputs are obtained in a single reverse sweep:
+
+        \code
+        AdjointTape tape;
+        AdjointReal spot = 100.0, vol = 0.2;
+        tape.registerInput(spot);
+        tape.registerInput(vol);
+        AdjointReal price = f(spot, vol);
+        tape.computeAdjoints(price);
+        double delta = tape.derivative(spot), vega = tape.derivative(vol);
+        \endcode
+
+        Each statement stores the partial derivatives of its result
+        with respect to its operands, so that the memory used grows
+        linearly with the number of recorded operations; positions
+        can be saved and the tape rewound to them in order to discard
+        intermediate calculations.
+
+        \warning A tape is not thread-safe; each thread must record
+                 on its own tape.
+
+        \ingroup math
+    */
+    class AdjointTape {  // NOLINT(cppcoreguidelines-special-member-functions)
+      public:
+        typedef std::size_t Position;
+
+        //! the new tape becomes active in the running thread
+        AdjointTape() : previous_(active_) { active_ = this; }
+        //! the previously active tape, if any, is reactivated
+        ~AdjointTape() { active_ = previous_; }
+        AdjointTape(const AdjointTape&) = delete;
+        AdjointTape& operator=(const AdjointTape&) = delete;
+
+        //! the tape recording in the running thread, if any
+        static AdjointTape* active() { return active_; }
+
+        //! \name Recording
+        //@{
+        //! makes the variable active (and an input for the tape)
+        void registerInput(AdjointReal& x);
+        //! number of recorded statements
+        Position position() const { return ends_.size(); }
+        /*! discards the statements recorded after the given position;
+            variables created after it must not be used afterwards. */
+        void rewind(Position p) {
+            if (p < ends_.size()) {
+                ends_.resize(p);
+                operands_.resize(p == 0 ? 0 : ends_.back());
+                partials_.resize(operands_.size());
+            }
+            if (adjoints_.size() > p)
+                adjoints_.resize(p);
+        }
+        void clear() { rewind(0); }
+        //@}
+
+        //! \name Adjoints
+        //@{
+        //! seeds the given output with a unit adjoint and propagates it
+        void computeAdjoints(const AdjointReal& output);
+        /*! propagates the adjoints currently set (see seed()) from
+            the given position back to the beginning of the tape */
+        void computeAdjoints(Position from) {
+            adjoints_.resize(ends_.size(), 0.0);
+            for (Position i = std::min(from, ends_.size()); i > 0; --i) {
+                double a = adjoints_[i-1];
+                if (a == 0.0)
+                    continue;
+                for (std::size_t k = (i > 1 ? ends_[i-2] : 0); k < ends_[i-1]; ++k)
+                    adjoints_[operands_[k]] += a * partials_[k];
+            }
+        }
+        //! adds the given value to the adjoint of a variable
+        void seed(const AdjointReal& x, double adjoint);
+        //! the adjoint of the given variable after propagation
+        double derivative(const AdjointReal& x) const;
+        void clearAdjoints() { adjoints_.assign(adjoints_.size(), 0.0); }
+        //@}
+
+        //! \name Low-level interface
+        //@{
+        //! records a statement with the given operands and partials
+        std::size_t record(std::size_t n, const std::size_t* operands, const double* partials) {
+            for (std::size_t k = 0; k < n; ++k) {
+                operands_.push_back(operands[k]);
+                partials_.push_back(partials[k]);
+            }
+            ends_.push_back(operands_.size());
+            return ends_.size() - 1;
+        }
+        //@}
+
+      private:
+        std::vector<std::size_t> ends_, operands_;
+        std::vector<double> partials_, adjoints_;
+        AdjointTape* previous_;
+        static thread_local AdjointTape* active_;
+    };
+
+    inline thread_local AdjointTape* AdjointTape::active_ = nullptr;
+
+
+    //! Real type recording its operations on the active adjoint tape
+    /*! A variable is passive (and costs nothing beyond its value)
+        until it's registered as an input or computed from an active
+        variable while a tape is recording.
+
+        Comparisons only involve values, so that branches are taken
+        as in the underlying double calculation; the derivatives are
+        those of the branch taken.
+
+        \warning Math functions must be called unqualified (see
+                 below).  Most of the library calls them qualified,
+                 e.g., std::exp(x); therefore, this class can't be used
+                 as QL_REAL, but only with code written generically on
+                 the number type.  std::complex is only specified for
+                 built-in floating-point types and can't be used with
+                 this class.
+
+        \ingroup math
+    */
+    class AdjointReal {
+        static constexpr std::size_t passive = static_cast<std::size_t>(-1);
+      public:
+        constexpr AdjointReal(double value = 0.0) : value_(value) {} // NOLINT(google-explicit-constructor)
+
+        //! \name Inspectors
+        //@{
+        constexpr double value() const { return value_; }
+        bool isActive() const { return slot_ != passive; }
+        std::size_t slot() const { return slot_; }
+        //@}
+
+        //! \name Conversions
+        //@{
+        template <class T, std::enable_if_t<std::is_arithmetic_v<T>, int> = 0>
+        explicit constexpr operator T() const { return static_cast<T>(value_); }
+        //@}
+
+        //! \name Assignment operators
+        //@{
+        AdjointReal& operator+=(const AdjointReal& y) { return *this = *this + y; }
+        AdjointReal& operator-=(const AdjointReal& y) { return *this = *this - y; }
+        AdjointReal& operator*=(const AdjointReal& y) { return *this = *this * y; }
+        AdjointReal& operator/=(const AdjointReal& y) { return *this = *this / y; }
+        //@}
+
+        //! \name Building blocks
+        /*! These are meant for functions not covered by the overloads
+            below: the result has the given value and the given
+            partial derivatives with respect to the operand(s).
+        */
+        //@{
+        static AdjointReal unary(double value, const AdjointReal& x, double dx) {
+            AdjointReal result(value);
+            AdjointTape* tape = AdjointTape::active();
+            if (tape != nullptr && x.isActive())
+                result.slot_ = tape->record(1, &x.slot_, &dx);
+            return result;
+        }
+        static AdjointReal binary(double value,
+                                  const AdjointReal& x, double dx,
+                                  const AdjointReal& y, double dy) {
+            AdjointReal result(value);
+            AdjointTape* tape = AdjointTape::active();
+            if (tape != nullptr) {
+                if (x.isActive() && y.isActive()) {
+                    std::size_t operands[] = { x.slot_, y.slot_ };
+                    double partials[] = { dx, dy };
+                    result.slot_ = tape->record(2, operands, partials);
+                } else if (x.isActive()) {
+                    result.slot_ = tape->record(1, &x.slot_, &dx);
+                } else if (y.isActive()) {
+                    result.slot_ = tape->record(1, &y.slot_, &dy);
+                }
+            }
+            return result;
+        }
+        //@}
+
+        friend AdjointReal operator+(const AdjointReal& x, const AdjointReal& y) {
+            return binary(x.value_ + y.value_, x, 1.0, y, 1.0);
+        }
+        friend AdjointReal operator-(const AdjointReal& x, const AdjointReal& y) {
+            return binary(x.value_ - y.value_, x, 1.0, y, -1.0);
+        }
+        friend AdjointReal operator*(const AdjointReal& x, const AdjointReal& y) {
+            return binary(x.value_ * y.value_, x, y.value_, y, x.value_);
+        }
+        friend AdjointReal operator/(const AdjointReal& x, const AdjointReal& y) {
+            double r = x.value_ / y.value_;
+            return binary(r, x, 1.0 / y.value_, y, -r / y.value_);
+        }
+        friend AdjointReal operator-(const AdjointReal& x) {
+            return unary(-x.value_, x, -1.0);
+        }
+        friend const AdjointReal& operator+(const AdjointReal& x) {
+            return x;
+        }
+
+        friend bool operator==(const AdjointReal& x, const AdjointReal& y) { return x.value_ == y.value_; }
+        friend bool operator!=(const AdjointReal& x, const AdjointReal& y) { return x.value_ != y.value_; }
+        friend bool operator<(const AdjointReal& x, const AdjointReal& y) { return x.value_ < y.value_; }
+        friend bool operator<=(const AdjointReal& x, const AdjointReal& y) { return x.value_ <= y.value_; }
+        friend bool operator>(const AdjointReal& x, const AdjointReal& y) { return x.value_ > y.value_; }
+        friend bool operator>=(const AdjointReal& x, const AdjointReal& y) { return x.value_ >= y.value_; }
+
+        friend std::ostream& operator<<(std::ostream& out, const AdjointReal& x) {
+            return out << x.value_;
+        }
+
+        //! \name Math functions
+        /*! Overloads of the standard math functions.  They're hidden
+            friends, found by argument-dependent lookup only: calls
+            must be unqualified, e.g., exp(x) instead of std::exp(x),
+            and they don't hide the standard functions from calls on
+            doubles.  The mixed overloads of max and min take care of
+            calls such as max(x, 0.0), which wouldn't compile
+            otherwise.
+        */
+        //@{
+        friend AdjointReal exp(const AdjointReal& x) {
+            double e = std::exp(x.value());
+            return AdjointReal::unary(e, x, e);
+        }
+        friend AdjointReal log(const AdjointReal& x) {
+            return AdjointReal::unary(std::log(x.value()), x, 1.0 / x.value());
+        }
+        friend AdjointReal log10(const AdjointReal& x) {
+            return AdjointReal::unary(std::log10(x.value()), x,
+                                      1.0 / (x.value() * std::log(10.0)));
+        }
+        friend AdjointReal expm1(const AdjointReal& x) {
+            return AdjointReal::unary(std::expm1(x.value()), x, std::exp(x.value()));
+        }
+        friend AdjointReal log1p(const AdjointReal& x) {
+            return AdjointReal::unary(std::log1p(x.value()), x, 1.0 / (1.0 + x.value()));
+        }
+        friend AdjointReal sqrt(const AdjointReal& x) {
+            double s = std::sqrt(x.value());
+            return AdjointReal::unary(s, x, 0.5 / s);
+        }
+        friend AdjointReal cbrt(const AdjointReal& x) {
+            double c = std::cbrt(x.value());
+            return AdjointReal::unary(c, x, 1.0 / (3.0 * c * c));
+        }
+        friend AdjointReal pow(const AdjointReal& x, const AdjointReal& y) {
+            double p = std::pow(x.value(), y.value());
+            double dx = (y.value() == 0.0) ? 0.0 : y.value() * std::pow(x.value(), y.value() - 1.0);
+            double dy = (x.value() > 0.0) ? p * std::log(x.value()) : 0.0;
+            return AdjointReal::binary(p, x, dx, y, dy);
+        }
+        friend AdjointReal pow(const AdjointReal& x, double y) {
+            return pow(x, AdjointReal(y));
+        }
+        friend AdjointReal pow(double x, const AdjointReal& y) {
+            return pow(AdjointReal(x), y);
+        }
+        template <class I, std::enable_if_t<std::is_integral_v<I>, int> = 0>
+        friend AdjointReal pow(const AdjointReal& x, I y) {
+            return pow(x, AdjointReal(static_cast<double>(y)));
+        }
+        friend AdjointReal fabs(const AdjointReal& x) {
+            return AdjointReal::unary(std::fabs(x.value()), x, x.value() < 0.0 ? -1.0 : 1.0);
+        }
+        friend AdjointReal abs(const AdjointReal& x) {
+            return fabs(x);
+        }
+        friend AdjointReal sin(const AdjointReal& x) {
+            return AdjointReal::unary(std::sin(x.value()), x, std::cos(x.value()));
+        }
+        friend AdjointReal cos(const AdjointReal& x) {
+            return AdjointReal::unary(std::cos(x.value()), x, -std::sin(x.value()));
+        }
+        friend AdjointReal tan(const AdjointReal& x) {
+            double c = std::cos(x.value());
+            return AdjointReal::unary(std::tan(x.value()), x, 1.0 / (c * c));
+        }
+        friend AdjointReal asin(const AdjointReal& x) {
+            return AdjointReal::unary(std::asin(x.value()), x,
+                                      1.0 / std::sqrt(1.0 - x.value() * x.value()));
+        }
+        friend AdjointReal acos(const AdjointReal& x) {
+            return AdjointReal::unary(std::acos(x.value()), x,
+                                      -1.0 / std::sqrt(1.0 - x.value() * x.value()));
+        }
+        friend AdjointReal atan(const AdjointReal& x) {
+            return AdjointReal::unary(std::atan(x.value()), x,
+                                      1.0 / (1.0 + x.value() * x.value()));
+        }
+        friend AdjointReal atan2(const AdjointReal& y, const AdjointReal& x) {
+            double d = x.value() * x.value() + y.value() * y.value();
+            return AdjointReal::binary(std::atan2(y.value(), x.value()),
+                                       y, x.value() / d, x, -y.value() / d);
+        }
+        friend AdjointReal sinh(const AdjointReal& x) {
+            return AdjointReal::unary(std::sinh(x.value()), x, std::cosh(x.value()));
+        }
+        friend AdjointReal cosh(const AdjointReal& x) {
+            return AdjointReal::unary(std::cosh(x.value()), x, std::sinh(x.value()));
+        }
+        friend AdjointReal tanh(const AdjointReal& x) {
+            double t = std::tanh(x.value());
+            return AdjointReal::unary(t, x, 1.0 - t * t);
+        }
+        friend AdjointReal erf(const AdjointReal& x) {
+            return AdjointReal::unary(std::erf(x.value()), x,
+                                      1.1283791670955126 * std::exp(-x.value() * x.value()));
+        }
+        friend AdjointReal erfc(const AdjointReal& x) {
+            return AdjointReal::unary(std::erfc(x.value()), x,
+                                      -1.1283791670955126 * std::exp(-x.value() * x.value()));
+        }
+        friend AdjointReal fmod(const AdjointReal& x, const AdjointReal& y) {
+            double r = std::fmod(x.value(), y.value());
+            return AdjointReal::binary(r, x, 1.0, y, -std::trunc(x.value() / y.value()));
+        }
+        // piecewise-constant functions have null derivatives
+        friend AdjointReal floor(const AdjointReal& x) {
+            return std::floor(x.value());
+        }
+        friend AdjointReal ceil(const AdjointReal& x) {
+            return std::ceil(x.value());
+        }
+        friend AdjointReal round(const AdjointReal& x) {
+            return std::round(x.value());
+        }
+        friend AdjointReal trunc(const AdjointReal& x) {
+            return std::trunc(x.value());
+        }
+        friend AdjointReal modf(const AdjointReal& x, AdjointReal* integral) {
+            double i;
+            double f = std::modf(x.value(), &i);
+            *integral = i;
+            return AdjointReal::unary(f, x, 1.0);
+        }
+        friend long lround(const AdjointReal& x) { return std::lround(x.value()); }
+        friend long long llround(const AdjointReal& x) { return std::llround(x.value()); }
+        friend long lrint(const AdjointReal& x) { return std::lrint(x.value()); }
+        friend AdjointReal max(const AdjointReal& x, const AdjointReal& y) {
+            return x < y ? y : x;
+        }
+        friend AdjointReal max(const AdjointReal& x, double y) {
+            return x < y ? AdjointReal(y) : x;
+        }
+        friend AdjointReal max(double x, const AdjointReal& y) {
+            return x < y ? y : AdjointReal(x);
+        }
+        friend AdjointReal min(const AdjointReal& x, const AdjointReal& y) {
+            return y < x ? y : x;
+        }
+        friend AdjointReal min(const AdjointReal& x, double y) {
+            return y < x ? AdjointReal(y) : x;
+        }
+        friend AdjointReal min(double x, const AdjointReal& y) {
+            return y < x ? y : AdjointReal(x);
+        }
+        friend AdjointReal ldexp(const AdjointReal& x, int e) {
+            double f = std::ldexp(1.0, e);
+            return AdjointReal::unary(x.value() * f, x, f);
+        }
+        friend AdjointReal frexp(const AdjointReal& x, int* e) {
+            double m = std::frexp(x.value(), e);
+            return AdjointReal::unary(m, x, std::ldexp(1.0, -*e));
+        }
+
+        friend bool isnan(const AdjointReal& x) { return std::isnan(x.value()); }
+        friend bool isinf(const AdjointReal& x) { return std::isinf(x.value()); }
+        friend bool isfinite(const AdjointReal& x) { return std::isfinite(x.value()); }
+        friend bool signbit(const AdjointReal& x) { return std::signbit(x.value()); }
+        //@}
+
+      private:
+        friend class AdjointTape;
+        double value_;
+        std::size_t slot_ = passive;
+    };
+
+
+    // inline definitions
+
+    inline void AdjointTape::registerInput(AdjointReal& x) {
+        x.slot_ = record(0, nullptr, nullptr);
+    }
+
+    inline void AdjointTape::computeAdjoints(const AdjointReal& output) {
+        clearAdjoints();
+        if (!output.isActive())
+            return;
+        seed(output, 1.0);
+        computeAdjoints(output.slot_ + 1);
+    }
+
+    inline void AdjointTape::seed(const AdjointReal& x, double adjoint) {
+        if (!x.isActive())
+            throw std::logic_error("cannot seed a passive variable");
+        adjoints_.resize(ends_.size(), 0.0);
+        adjoints_[x.slot_] += adjoint;
+    }
+
+    inline double AdjointTape::derivative(const AdjointReal& x) const {
+        return (x.isActive() && x.slot_ < adjoints_.size()) ? adjoints_[x.slot_] : 0.0;
+    }
+
+}
+
+namespace std {
+
+    template <>
+    class numeric_limits<QuantLib::AdjointReal> : public numeric_limits<double> {};
+
+}
+
+#endif
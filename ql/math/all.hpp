@@ -2,7 +2,9 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/math/abcdmathfunction.hpp>
+#include <ql/math/adjointreal.hpp>
 #include <ql/math/array.hpp>
+#include <ql/math/arraypool.hpp>
 #include <ql/math/autocovariance.hpp>
 #include <ql/math/bernsteinpolynomial.hpp>
 #include <ql/math/beta.hpp>
@@ -28,6 +28,7 @@
 
 #include <ql/types.hpp>
 #include <ql/errors.hpp>
+#include <ql/math/arraypool.hpp>
 #include <ql/utilities/null.hpp>
 #include <iterator>
 #include <functional>
@@ -144,7 +145,7 @@ namespace QuantLib {
         //@}
 
       private:
-        std::unique_ptr<Real[]> data_;
+        detail::ArrayStorage data_;
         Size n_;
     };
 
@@ -155,6 +156,22 @@ namespace QuantLib {
     /*! \relates Array */
     Real Norm2(const Array&);
 
+    // in-place operations
+    /*! \relates Array
+        computes \f$ y_i \leftarrow y_i + \alpha x_i \f$ without temporaries.
+    */
+    void Axpy(Real alpha, const Array& x, Array& y);
+    /*! \relates Array
+        computes \f$ r_i = a_i + b_i c_i \f$ in a single pass; the
+        result can be any of the operands, and is resized if needed.
+    */
+    void MultiplyAdd(const Array& a, const Array& b, const Array& c, Array& r);
+    /*! \relates Array
+        computes \f$ r_i = a_i + b c_i \f$ in a single pass; the
+        result can be any of the operands, and is resized if needed.
+    */
+    void MultiplyAdd(const Array& a, Real b, const Array& c, Array& r);
+
     // unary operators
     /*! \relates Array */
     Array operator+(const Array& v);
@@ -265,21 +282,21 @@ namespace QuantLib {
     // inline definitions
 
     inline Array::Array(Size size)
-    : data_(size != 0U ? new Real[size] : nullptr), n_(size) {}
+    : data_(detail::allocateArrayStorage(size)), n_(size) {}
 
     inline Array::Array(Size size, Real value)
-    : data_(size != 0U ? new Real[size] : nullptr), n_(size) {
+    : data_(detail::allocateArrayStorage(size)), n_(size) {
         std::fill(begin(),end(),value);
     }
 
     inline Array::Array(Size size, Real value, Real increment)
-    : data_(size != 0U ? new Real[size] : nullptr), n_(size) {
+    : data_(detail::allocateArrayStorage(size)), n_(size) {
         for (iterator i=begin(); i!=end(); ++i, value+=increment)
             *i = value;
     }
 
     inline Array::Array(const Array& from)
-    : data_(from.n_ != 0U ? new Real[from.n_] : nullptr), n_(from.n_) {
+    : data_(detail::allocateArrayStorage(from.n_)), n_(from.n_) {
         if (data_)
             std::copy(from.begin(),from.end(),begin());
     }
@@ -293,7 +310,7 @@ namespace QuantLib {
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 std::unique_ptr<Real[]>& data_,
+                                 ArrayStorage& data_,
                                  Size& n_,
                                  I begin, I end,
                                  const std::true_type&) {
@@ -303,20 +320,20 @@ namespace QuantLib {
             // Array with a given value, which we do here.
             Size n = begin;
             Real value = end;
-            data_.reset(n ? new Real[n] : nullptr);
+            data_ = allocateArrayStorage(n);
             n_ = n;
             std::fill(a.begin(),a.end(),value);
         }
 
         template <class I>
         inline void _fill_array_(Array& a,
-                                 std::unique_ptr<Real[]>& data_,
+                                 ArrayStorage& data_,
                                  Size& n_,
                                  const I& begin, const I& end,
                                  const std::false_type&) {
             // true iterators
             Size n = std::distance(begin, end);
-            data_.reset(n ? new Real[n] : nullptr);
+            data_ = allocateArrayStorage(n);
             n_ = n;
             #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
             if (n_)
@@ -549,6 +566,36 @@ namespace QuantLib {
         return std::sqrt(DotProduct(v, v));
     }
 
+    // in-place operations
+
+    inline void Axpy(Real alpha, const Array& x, Array& y) {
+        QL_REQUIRE(x.size() == y.size(),
+                   "arrays with different sizes (" << x.size() << ", "
+                   << y.size() << ") cannot be added");
+        std::transform(y.begin(), y.end(), x.begin(), y.begin(),
+                       [=](Real yi, Real xi) -> Real { return yi + alpha * xi; });
+    }
+
+    inline void MultiplyAdd(const Array& a, const Array& b, const Array& c, Array& r) {
+        QL_REQUIRE(a.size() == b.size() && a.size() == c.size(),
+                   "arrays with different sizes (" << a.size() << ", "
+                   << b.size() << ", " << c.size() << ") cannot be combined");
+        if (r.size() != a.size())
+            r = Array(a.size());
+        for (Size i=0; i<a.size(); ++i)
+            r[i] = a[i] + b[i] * c[i];
+    }
+
+    inline void MultiplyAdd(const Array& a, Real b, const Array& c, Array& r) {
+        QL_REQUIRE(a.size() == c.size(),
+                   "arrays with different sizes (" << a.size() << ", "
+                   << c.size() << ") cannot be combined");
+        if (r.size() != a.size())
+            r = Array(a.size());
+        std::transform(a.begin(), a.end(), c.begin(), r.begin(),
+                       [=](Real ai, Real ci) -> Real { return ai + b * ci; });
+    }
+
     // overloaded operators
 
     // unary
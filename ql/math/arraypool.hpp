@@ -0,0 +1,235 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file arraypool.hpp
+    \brief recycling of storage for arrays and matrices
+*/
+
+#ifndef quantlib_array_pool_hpp
+#define quantlib_array_pool_hpp
+
+#include <ql/types.hpp>
+#include <memory>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Cache of storage for arrays and matrices
+    /*! Calculations creating many short-lived Array or Matrix
+        temporaries of similar sizes, such as the steps of a
+        finite-difference scheme, can install a pool on the current
+        thread for their duration.  While the pool is installed,
+        released storage is kept in size classes (powers of two)
+        instead of being returned to the heap, and new storage is
+        taken from it when possible.
+
+        Storage is not tied to the pool it came from; arrays can
+        outlive the pool and can be released on any thread, in which
+        case they are either cached by the pool current at that time
+        or returned to the heap.
+
+        \code
+        ArrayPool pool;
+        {
+            ArrayPool::Scope scope(pool);
+            // ...calculations...
+        }
+        \endcode
+    */
+    class ArrayPool {
+      public:
+        explicit ArrayPool(Size maxCachedBlocks = 16);
+        ~ArrayPool();
+        ArrayPool(const ArrayPool&) = delete;
+        ArrayPool(ArrayPool&&) = delete;
+        ArrayPool& operator=(const ArrayPool&) = delete;
+        ArrayPool& operator=(ArrayPool&&) = delete;
+
+        //! installs a pool on the current thread for its lifetime
+        /*! Scopes can be nested; the previously installed pool (if
+            any) is restored when the scope is destroyed.  The pool
+            must outlive the scope.
+        */
+        class Scope {
+          public:
+            explicit Scope(ArrayPool& pool);
+            ~Scope();
+            Scope(const Scope&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            Scope& operator=(Scope&&) = delete;
+          private:
+            ArrayPool* previous_;
+        };
+
+        //! the pool installed on the current thread, if any
+        static ArrayPool* current() { return current_; }
+
+        //! \name Inspectors
+        //@{
+        //! number of requests served from the cache
+        Size reused() const { return reused_; }
+        //! number of blocks currently cached
+        Size cached() const;
+        //@}
+
+        //! \name Instrumentation
+        //@{
+        /*! number of heap allocations performed by Array and Matrix
+            on the current thread since the last reset
+        */
+        static Size heapAllocations() { return heapAllocations_; }
+        static void resetHeapAllocations() { heapAllocations_ = 0; }
+        //@}
+
+        /*! \name Low-level interface
+            These methods are used by Array and Matrix and should not
+            be needed otherwise.
+        */
+        //@{
+        /*! returns a cached block with room for at least n elements,
+            or a null pointer if none is available.  On return, the
+            capacity is the one the block has or, if none was found,
+            the one a new block should have in order to be cached.
+        */
+        Real* acquire(Size n, Size& capacity);
+        //! caches the block if possible; returns whether it did
+        bool release(Real* p, Size capacity);
+
+        static Real* allocate(Size capacity);
+        static void deallocate(Real* p, Size capacity) noexcept;
+        //@}
+
+      private:
+        static constexpr Size classes_ = 32;
+        Size maxCachedBlocks_;
+        std::vector<Real*> blocks_[classes_];
+        Size reused_ = 0;
+        static inline thread_local ArrayPool* current_ = nullptr;
+        static inline thread_local Size heapAllocations_ = 0;
+    };
+
+    namespace detail {
+
+        class ArrayStorageDeleter {
+          public:
+            ArrayStorageDeleter() = default;
+            explicit ArrayStorageDeleter(Size capacity) : capacity_(capacity) {}
+            void operator()(Real* p) const noexcept {
+                ArrayPool* pool = ArrayPool::current();
+                if (pool == nullptr || !pool->release(p, capacity_))
+                    ArrayPool::deallocate(p, capacity_);
+            }
+          private:
+            Size capacity_ = 0;
+        };
+
+        typedef std::unique_ptr<Real[], ArrayStorageDeleter> ArrayStorage;
+
+        inline ArrayStorage allocateArrayStorage(Size n) {
+            if (n == 0)
+                return ArrayStorage();
+            Size capacity = n;
+            Real* p = nullptr;
+            ArrayPool* pool = ArrayPool::current();
+            if (pool != nullptr)
+                p = pool->acquire(n, capacity);
+            if (p == nullptr)
+                p = ArrayPool::allocate(capacity);
+            return ArrayStorage(p, ArrayStorageDeleter(capacity));
+        }
+
+    }
+
+
+    // inline definitions
+
+    inline ArrayPool::ArrayPool(Size maxCachedBlocks)
+    : maxCachedBlocks_(maxCachedBlocks) {
+        // no reallocation can happen when releasing blocks
+        for (auto& blocks : blocks_)
+            blocks.reserve(maxCachedBlocks_);
+    }
+
+    inline ArrayPool::~ArrayPool() {
+        for (Size k=0; k<classes_; ++k) {
+            for (Real* p : blocks_[k])
+                deallocate(p, Size(1) << k);
+        }
+    }
+
+    inline Size ArrayPool::cached() const {
+        Size n = 0;
+        for (const auto& blocks : blocks_)
+            n += blocks.size();
+        return n;
+    }
+
+    inline ArrayPool::Scope::Scope(ArrayPool& pool) : previous_(current_) {
+        current_ = &pool;
+    }
+
+    inline ArrayPool::Scope::~Scope() {
+        current_ = previous_;
+    }
+
+    inline Real* ArrayPool::acquire(Size n, Size& capacity) {
+        Size k = 0;
+        while ((Size(1) << k) < n)
+            ++k;
+        if (k >= classes_) {
+            capacity = n;
+            return nullptr;
+        }
+        capacity = Size(1) << k;
+        std::vector<Real*>& blocks = blocks_[k];
+        if (blocks.empty())
+            return nullptr;
+        Real* p = blocks.back();
+        blocks.pop_back();
+        ++reused_;
+        return p;
+    }
+
+    inline bool ArrayPool::release(Real* p, Size capacity) {
+        // only blocks with a size-class capacity can be reused
+        if ((capacity & (capacity - 1)) != 0)
+            return false;
+        Size k = 0;
+        while ((Size(1) << k) < capacity)
+            ++k;
+        if (k >= classes_ || blocks_[k].size() >= maxCachedBlocks_)
+            return false;
+        blocks_[k].push_back(p);
+        return true;
+    }
+
+    inline Real* ArrayPool::allocate(Size capacity) {
+        ++heapAllocations_;
+        auto* p = static_cast<Real*>(::operator new(capacity * sizeof(Real)));
+        std::uninitialized_default_construct_n(p, capacity);
+        return p;
+    }
+
+    inline void ArrayPool::deallocate(Real* p, Size capacity) noexcept {
+        std::destroy_n(p, capacity);
+        ::operator delete(p);
+    }
+
+}
+
+#endif
@@ -54,6 +54,11 @@ class SABRWrapper {
         return shiftedSabrVolatility(x, forward_, t_, params_[0], params_[1],
                                      params_[2], params_[3], shift_, volatilityType);
     }
+    std::vector<Real> volatilities(const std::vector<Real>& x,
+                                   const VolatilityType volatilityType) {
+        return shiftedSabrVolatility(x, forward_, t_, params_[0], params_[1],
+                                     params_[2], params_[3], shift_, volatilityType);
+    }
 
   private:
     const Real t_, &forward_;
@@ -43,11 +43,24 @@
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/null.hpp>
-#include <utility>
 #include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace QuantLib::detail {
 
+// true if the model instance can evaluate a number of strikes at once
+template <class T, class = void>
+struct XABRHasVolatilities : std::false_type {};
+
+template <class T>
+struct XABRHasVolatilities<
+    T,
+    std::void_t<decltype(std::declval<T&>().volatilities(
+        std::declval<const std::vector<Real>&>(), std::declval<VolatilityType>()))> >
+: std::true_type {};
+
 template <typename Model> class XABRCoeffHolder {
   public:
     XABRCoeffHolder(const Time t,
@@ -241,14 +254,30 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
     Real derivative(Real) const override { QL_FAIL("XABR derivative not implemented"); }
     Real secondDerivative(Real) const override { QL_FAIL("XABR secondDerivative not implemented"); }
 
+    // model volatilities at the interpolation nodes; when the model
+    // supports it, the whole smile is evaluated at once
+    std::vector<Real> nodeValues() const {
+        if constexpr (XABRHasVolatilities<typename Model::type>::value) {
+            return this->modelInstance_->volatilities(
+                std::vector<Real>(this->xBegin_, this->xEnd_), volatilityType_);
+        } else {
+            std::vector<Real> results;
+            results.reserve(this->xEnd_ - this->xBegin_);
+            for (I1 x = this->xBegin_; x != this->xEnd_; ++x)
+                results.push_back(value(*x));
+            return results;
+        }
+    }
+
     // calculate total squared weighted difference (L2 norm)
     Real interpolationSquaredError() const {
         Real error, totalError = 0.0;
-        I1 x = this->xBegin_;
+        const std::vector<Real> v = nodeValues();
+        auto m = v.begin();
         I2 y = this->yBegin_;
         auto w = this->weights_.begin();
-        for (; x != this->xEnd_; ++x, ++y, ++w) {
-            error = (value(*x) - *y);
+        for (; m != v.end(); ++m, ++y, ++w) {
+            error = (*m - *y);
             totalError += error * error * (*w);
         }
         return totalError;
@@ -256,13 +285,14 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
 
     // calculate weighted differences
     Array interpolationErrors() const {
-        Array results(this->xEnd_ - this->xBegin_);
-        I1 x = this->xBegin_;
+        const std::vector<Real> v = nodeValues();
+        Array results(v.size());
+        auto m = v.begin();
         Array::iterator r = results.begin();
         I2 y = this->yBegin_;
         auto w = this->weights_.begin();
-        for (; x != this->xEnd_; ++x, ++r, ++w, ++y) {
-            *r = (value(*x) - *y) * std::sqrt(*w);
+        for (; m != v.end(); ++m, ++r, ++w, ++y) {
+            *r = (*m - *y) * std::sqrt(*w);
         }
         return results;
     }
@@ -275,10 +305,11 @@ class XABRInterpolationImpl final : public Interpolation::templateImpl<I1, I2>,
 
     Real interpolationMaxError() const {
         Real error, maxError = QL_MIN_REAL;
-        I1 i = this->xBegin_;
+        const std::vector<Real> v = nodeValues();
+        auto i = v.begin();
         I2 j = this->yBegin_;
-        for (; i != this->xEnd_; ++i, ++j) {
-            error = std::fabs(value(*i) - *j);
+        for (; i != v.end(); ++i, ++j) {
+            error = std::fabs(*i - *j);
             maxError = std::max(maxError, error);
         }
         return maxError;
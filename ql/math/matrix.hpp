@@ -146,7 +146,7 @@ namespace QuantLib {
         void swap(Matrix&) noexcept;
         //@}
       private:
-        std::unique_ptr<Real[]> data_;
+        detail::ArrayStorage data_;
         Size rows_ = 0, columns_ = 0;
     };
 
@@ -220,27 +220,27 @@ namespace QuantLib {
 
     // inline definitions
 
-    inline Matrix::Matrix() : data_((Real*)nullptr) {}
+    inline Matrix::Matrix() = default;
 
     inline Matrix::Matrix(Size rows, Size columns)
-    : data_(rows * columns > 0 ? new Real[rows * columns] : (Real*)nullptr), rows_(rows),
+    : data_(detail::allocateArrayStorage(rows * columns)), rows_(rows),
       columns_(columns) {}
 
     inline Matrix::Matrix(Size rows, Size columns, Real value)
-    : data_(rows * columns > 0 ? new Real[rows * columns] : (Real*)nullptr), rows_(rows),
+    : data_(detail::allocateArrayStorage(rows * columns)), rows_(rows),
       columns_(columns) {
         std::fill(begin(),end(),value);
     }
 
     template <class Iterator>
     inline Matrix::Matrix(Size rows, Size columns, Iterator begin, Iterator end)
-    : data_(rows * columns > 0 ? new Real[rows * columns] : (Real*)nullptr), rows_(rows),
+    : data_(detail::allocateArrayStorage(rows * columns)), rows_(rows),
       columns_(columns) {
         std::copy(begin, end, this->begin());
     }
 
     inline Matrix::Matrix(const Matrix& from)
-    : data_(!from.empty() ? new Real[from.rows_ * from.columns_] : (Real*)nullptr),
+    : data_(detail::allocateArrayStorage(from.rows_ * from.columns_)),
       rows_(from.rows_), columns_(from.columns_) {
         #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
         if (!from.empty())
@@ -248,14 +248,13 @@ namespace QuantLib {
         std::copy(from.begin(),from.end(),begin());
     }
 
-    inline Matrix::Matrix(Matrix&& from) noexcept
-    : data_((Real*)nullptr) {
+    inline Matrix::Matrix(Matrix&& from) noexcept {
         swap(from);
     }
 
     inline Matrix::Matrix(std::initializer_list<std::initializer_list<Real>> data)
-    : data_(data.size() == 0 || data.begin()->size() == 0 ?
-            (Real*)nullptr : new Real[data.size() * data.begin()->size()]),
+    : data_(detail::allocateArrayStorage(
+            data.size() == 0 ? 0 : data.size() * data.begin()->size())),
       rows_(data.size()), columns_(data.size() == 0 ? 0 : data.begin()->size()) {
         Size i=0;
         for (const auto& row : data) {
@@ -0,0 +1,204 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    CsrMatrix::CsrMatrix(Size rows,
+                         Size columns,
+                         std::vector<Size> rowOffsets,
+                         std::vector<Size> columnIndices,
+                         std::vector<Real> values)
+    : rows_(rows), columns_(columns), rowOffsets_(std::move(rowOffsets)),
+      columnIndices_(std::move(columnIndices)), values_(std::move(values)) {
+        QL_REQUIRE(rowOffsets_.size() == rows_+1,
+                   "wrong number of row offsets (" << rowOffsets_.size()
+                   << ", " << rows_+1 << " required)");
+        QL_REQUIRE(rowOffsets_.front() == 0, "first row offset must be zero");
+        QL_REQUIRE(columnIndices_.size() == values_.size(),
+                   "column indices and values have different sizes");
+        QL_REQUIRE(rowOffsets_.back() == values_.size(),
+                   "last row offset (" << rowOffsets_.back()
+                   << ") does not match the number of values ("
+                   << values_.size() << ")");
+        for (Size i=0; i < rows_; ++i) {
+            QL_REQUIRE(rowOffsets_[i] <= rowOffsets_[i+1],
+                       "decreasing row offsets at row " << i);
+            for (Size k=rowOffsets_[i]; k < rowOffsets_[i+1]; ++k) {
+                QL_REQUIRE(columnIndices_[k] < columns_,
+                           "column index " << columnIndices_[k]
+                           << " out of range at row " << i);
+                QL_REQUIRE(k == rowOffsets_[i]
+                           || columnIndices_[k-1] < columnIndices_[k],
+                           "column indices not increasing at row " << i);
+            }
+        }
+    }
+
+    CsrMatrix::CsrMatrix(const SparseMatrix& m)
+    : rows_(m.size1()), columns_(m.size2()), rowOffsets_(m.size1()+1) {
+        const Size nonZeros = m.nnz();
+        // rows past filled1()-1 are empty and not stored by ublas
+        const Size filledRows = std::min<Size>(m.filled1(), rows_+1);
+        std::copy(m.index1_data().begin(),
+                  m.index1_data().begin() + filledRows,
+                  rowOffsets_.begin());
+        std::fill(rowOffsets_.begin() + filledRows, rowOffsets_.end(),
+                  nonZeros);
+        columnIndices_.assign(m.index2_data().begin(),
+                              m.index2_data().begin() + nonZeros);
+        values_.assign(m.value_data().begin(),
+                       m.value_data().begin() + nonZeros);
+    }
+
+    Real CsrMatrix::operator()(Size i, Size j) const {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "element (" << i << ", " << j << ") out of range");
+        const auto begin = columnIndices_.begin() + rowOffsets_[i];
+        const auto end = columnIndices_.begin() + rowOffsets_[i+1];
+        const auto iter = std::lower_bound(begin, end, j);
+        return (iter != end && *iter == j)
+            ? values_[iter - columnIndices_.begin()] : 0.0;
+    }
+
+    SparseMatrix CsrMatrix::toSparseMatrix() const {
+        SparseMatrix m(rows_, columns_, values_.size());
+        for (Size i=0; i < rows_; ++i)
+            for (Size k=rowOffsets_[i]; k < rowOffsets_[i+1]; ++k)
+                m.push_back(i, columnIndices_[k], values_[k]);
+        return m;
+    }
+
+
+    CsrMatrix::Builder::Builder(Size rows, Size columns, Size expectedNonZeros)
+    : rows_(rows), columns_(columns) {
+        elements_.reserve(expectedNonZeros);
+    }
+
+    void CsrMatrix::Builder::add(Size i, Size j, Real value) {
+        QL_REQUIRE(i < rows_ && j < columns_,
+                   "element (" << i << ", " << j << ") out of range");
+        elements_.push_back({i, j, value});
+    }
+
+    CsrMatrix CsrMatrix::Builder::matrix() const {
+        // counting sort by row; the order of insertion is preserved
+        std::vector<Size> start(rows_+1, 0);
+        for (const auto& e : elements_)
+            ++start[e.row+1];
+        for (Size i=0; i < rows_; ++i)
+            start[i+1] += start[i];
+
+        std::vector<Size> order(elements_.size()), next(start);
+        for (Size k=0; k < elements_.size(); ++k)
+            order[next[elements_[k].row]++] = k;
+
+        std::vector<Size> rowOffsets(rows_+1, 0), columnIndices;
+        std::vector<Real> values;
+        columnIndices.reserve(elements_.size());
+        values.reserve(elements_.size());
+
+        for (Size i=0; i < rows_; ++i) {
+            const auto begin = order.begin() + start[i];
+            const auto end = order.begin() + start[i+1];
+            std::stable_sort(begin, end, [this](Size a, Size b) {
+                return elements_[a].column < elements_[b].column;
+            });
+            for (auto iter = begin; iter != end; ++iter) {
+                const Element& e = elements_[*iter];
+                if (iter == begin || columnIndices.back() != e.column) {
+                    columnIndices.push_back(e.column);
+                    values.push_back(0.0);
+                }
+                values.back() += e.value;
+            }
+            rowOffsets[i+1] = values.size();
+        }
+
+        return {rows_, columns_, std::move(rowOffsets),
+                std::move(columnIndices), std::move(values)};
+    }
+
+
+    Array prod(const CsrMatrix& A, const Array& x) {
+        QL_REQUIRE(x.size() == A.columns(),
+                   "vectors and sparse matrices with different sizes ("
+                   << x.size() << ", " << A.rows() << "x" << A.columns() <<
+                   ") cannot be multiplied");
+
+        const Size n = A.rows();
+        const Size* offsets = A.rowOffsets().data();
+        const Size* columns = A.columnIndices().data();
+        const Real* values = A.values().data();
+        const Real* xptr = x.begin();
+
+        Array b(n);
+        Real* bptr = b.begin();
+
+        #pragma omp parallel for if(n > 10000)
+        for (long i=0; i < long(n); ++i) {
+            Real t = 0.0;
+            for (Size k=offsets[i]; k < offsets[i+1]; ++k)
+                t += values[k]*xptr[columns[k]];
+            bptr[i] = t;
+        }
+        return b;
+    }
+
+    CsrMatrix operator+(const CsrMatrix& A, const CsrMatrix& B) {
+        QL_REQUIRE(A.rows() == B.rows() && A.columns() == B.columns(),
+                   "sparse matrices with different sizes ("
+                   << A.rows() << "x" << A.columns() << ", "
+                   << B.rows() << "x" << B.columns() << ") cannot be added");
+
+        const std::vector<Size>& ao = A.rowOffsets();
+        const std::vector<Size>& ac = A.columnIndices();
+        const std::vector<Real>& av = A.values();
+        const std::vector<Size>& bo = B.rowOffsets();
+        const std::vector<Size>& bc = B.columnIndices();
+        const std::vector<Real>& bv = B.values();
+
+        std::vector<Size> rowOffsets(A.rows()+1, 0), columnIndices;
+        std::vector<Real> values;
+        columnIndices.reserve(A.nonZeros() + B.nonZeros());
+        values.reserve(A.nonZeros() + B.nonZeros());
+
+        for (Size i=0; i < A.rows(); ++i) {
+            Size ka = ao[i], kb = bo[i];
+            while (ka < ao[i+1] || kb < bo[i+1]) {
+                if (kb == bo[i+1] || (ka < ao[i+1] && ac[ka] < bc[kb])) {
+                    columnIndices.push_back(ac[ka]);
+                    values.push_back(av[ka++]);
+                } else if (ka == ao[i+1] || bc[kb] < ac[ka]) {
+                    columnIndices.push_back(bc[kb]);
+                    values.push_back(bv[kb++]);
+                } else {
+                    columnIndices.push_back(ac[ka]);
+                    values.push_back(av[ka++] + bv[kb++]);
+                }
+            }
+            rowOffsets[i+1] = values.size();
+        }
+
+        return {A.rows(), A.columns(), std::move(rowOffsets),
+                std::move(columnIndices), std::move(values)};
+    }
+
+}
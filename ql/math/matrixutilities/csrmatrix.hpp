@@ -0,0 +1,120 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file csrmatrix.hpp
+    \brief sparse matrix in compressed-sparse-row format
+*/
+
+#ifndef quantlib_csr_matrix_hpp
+#define quantlib_csr_matrix_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/math/matrixutilities/sparsematrix.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Sparse matrix in compressed-sparse-row format
+    /*! The non-zero elements of row \f$ i \f$ are stored in the
+        range [rowOffsets()[i], rowOffsets()[i+1]) of the
+        columnIndices() and values() arrays, with increasing column
+        indices.  Elements explicitly set to zero are kept as part of
+        the structure, as for SparseMatrix.
+
+        Instances are immutable; they are built by means of the
+        CsrMatrix::Builder class or converted from a SparseMatrix.
+        The toSparseMatrix() method returns the equivalent
+        SparseMatrix for code using the boost::ublas interface.
+    */
+    class CsrMatrix {
+      public:
+        class Builder;
+
+        CsrMatrix() = default;
+        /*! \pre rowOffsets must have size rows+1 and be
+                 non-decreasing; column indices must be increasing
+                 within each row.
+        */
+        CsrMatrix(Size rows,
+                  Size columns,
+                  std::vector<Size> rowOffsets,
+                  std::vector<Size> columnIndices,
+                  std::vector<Real> values);
+        explicit CsrMatrix(const SparseMatrix& m);
+
+        //! \name Inspectors
+        //@{
+        Size rows() const { return rows_; }
+        Size columns() const { return columns_; }
+        Size nonZeros() const { return values_.size(); }
+        const std::vector<Size>& rowOffsets() const { return rowOffsets_; }
+        const std::vector<Size>& columnIndices() const { return columnIndices_; }
+        const std::vector<Real>& values() const { return values_; }
+        //! returns zero for elements outside the structure
+        Real operator()(Size i, Size j) const;
+        //@}
+
+        //! \name Conversion
+        //@{
+        SparseMatrix toSparseMatrix() const;
+        //@}
+      private:
+        Size rows_ = 0, columns_ = 0;
+        std::vector<Size> rowOffsets_ = std::vector<Size>(1, 0);
+        std::vector<Size> columnIndices_;
+        std::vector<Real> values_;
+    };
+
+
+    //! Builder for CsrMatrix instances
+    /*! Elements can be added in any order; elements added more than
+        once to the same position are summed in the order they were
+        added.
+    */
+    class CsrMatrix::Builder {
+      public:
+        Builder(Size rows, Size columns, Size expectedNonZeros = 0);
+
+        void add(Size i, Size j, Real value);
+        CsrMatrix matrix() const;
+
+      private:
+        struct Element {
+            Size row, column;
+            Real value;
+        };
+        Size rows_, columns_;
+        std::vector<Element> elements_;
+    };
+
+
+    /*! \relates CsrMatrix
+        Rows are processed concurrently when OpenMP is enabled; each
+        row is summed in increasing column order, so results do not
+        depend on the number of threads.
+    */
+    Array prod(const CsrMatrix& A, const Array& x);
+
+    /*! \relates CsrMatrix
+        the structure of the result is the union of the structures of
+        the operands.
+    */
+    CsrMatrix operator+(const CsrMatrix& A, const CsrMatrix& B);
+
+}
+
+#endif
@@ -0,0 +1,99 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/matrixutilities/ilu0preconditioner.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    ILU0Preconditioner::ILU0Preconditioner(const CsrMatrix& A)
+    : diagonal_(A.rows()) {
+        QL_REQUIRE(A.rows() == A.columns(),
+                   "square matrix required (" << A.rows() << "x"
+                   << A.columns() << " given)");
+
+        const Size n = A.rows();
+        const std::vector<Size>& offsets = A.rowOffsets();
+        const std::vector<Size>& columns = A.columnIndices();
+        std::vector<Real> values = A.values();
+
+        for (Size i=0; i < n; ++i) {
+            const auto begin = columns.begin() + offsets[i];
+            const auto end = columns.begin() + offsets[i+1];
+            const auto iter = std::lower_bound(begin, end, i);
+            QL_REQUIRE(iter != end && *iter == i,
+                       "missing diagonal element in row " << i);
+            diagonal_[i] = iter - columns.begin();
+        }
+
+        // position of the elements of the current row, by column
+        const Size none = offsets.back();
+        std::vector<Size> position(n, none);
+
+        for (Size i=0; i < n; ++i) {
+            for (Size k=offsets[i]; k < offsets[i+1]; ++k)
+                position[columns[k]] = k;
+
+            for (Size k=offsets[i]; k < diagonal_[i]; ++k) {
+                const Size j = columns[k];
+                const Real pivot = values[diagonal_[j]];
+                QL_REQUIRE(pivot != 0.0, "zero pivot in row " << j);
+                const Real l = values[k] /= pivot;
+                for (Size m=diagonal_[j]+1; m < offsets[j+1]; ++m) {
+                    const Size p = position[columns[m]];
+                    if (p != none)
+                        values[p] -= l*values[m];
+                }
+            }
+            QL_REQUIRE(values[diagonal_[i]] != 0.0, "zero pivot in row " << i);
+
+            for (Size k=offsets[i]; k < offsets[i+1]; ++k)
+                position[columns[k]] = none;
+        }
+
+        lu_ = CsrMatrix(n, n, offsets, columns, std::move(values));
+    }
+
+    Array ILU0Preconditioner::apply(const Array& b) const {
+        const Size n = lu_.rows();
+        QL_REQUIRE(b.size() == n,
+                   "wrong array size (" << b.size() << ", "
+                   << n << " required)");
+
+        const std::vector<Size>& offsets = lu_.rowOffsets();
+        const std::vector<Size>& columns = lu_.columnIndices();
+        const std::vector<Real>& values = lu_.values();
+
+        Array x(b);
+        // forward substitution with unit lower triangular L...
+        for (Size i=0; i < n; ++i) {
+            Real t = x[i];
+            for (Size k=offsets[i]; k < diagonal_[i]; ++k)
+                t -= values[k]*x[columns[k]];
+            x[i] = t;
+        }
+        // ...and backward substitution with U
+        for (Size i=n; i-- > 0;) {
+            Real t = x[i];
+            for (Size k=diagonal_[i]+1; k < offsets[i+1]; ++k)
+                t -= values[k]*x[columns[k]];
+            x[i] = t/values[diagonal_[i]];
+        }
+        return x;
+    }
+
+}
@@ -0,0 +1,61 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file ilu0preconditioner.hpp
+    \brief zero fill-in incomplete LU preconditioner for CSR matrices
+*/
+
+#ifndef quantlib_ilu0_preconditioner_hpp
+#define quantlib_ilu0_preconditioner_hpp
+
+#include <ql/math/matrixutilities/csrmatrix.hpp>
+
+namespace QuantLib {
+
+    //! Zero fill-in incomplete LU preconditioner
+    /*! The factors \f$ L \f$ (with unit diagonal) and \f$ U \f$ have
+        the same structure as the given matrix and are stored together
+        in a single CsrMatrix, as in the ILU(0) algorithm by Saad.
+        The factorization works in place on the CSR arrays; it is
+        usually much faster than SparseILUPreconditioner with
+        <tt>lfil = 0</tt>.
+
+        References:
+        Saad, Yousef. 1996, Iterative methods for sparse linear systems,
+        http://www-users.cs.umn.edu/~saad/books.html
+
+        \pre the matrix must be square and all its diagonal elements
+             must be part of the structure.
+    */
+    class ILU0Preconditioner {
+      public:
+        explicit ILU0Preconditioner(const CsrMatrix& A);
+
+        //! strict lower part holds \f$ L \f$, the rest holds \f$ U \f$
+        const CsrMatrix& factors() const { return lu_; }
+
+        //! returns \f$ (LU)^{-1} b \f$
+        Array apply(const Array& b) const;
+
+      private:
+        CsrMatrix lu_;
+        std::vector<Size> diagonal_;
+    };
+
+}
+
+#endif
@@ -10,4 +10,6 @@
 #include <ql/math/statistics/riskstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/statistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <ql/math/statistics/tdigest.hpp>
 
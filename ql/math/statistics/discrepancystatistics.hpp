@@ -93,6 +93,9 @@ namespace QuantLib {
         }
         void reset(Size dimension = 0);
       private:
+        // these wouldn't update the discrepancy
+        using SequenceStatistics::addBatch;
+        using SequenceStatistics::merge;
         mutable Real adiscr_, cdiscr_;
         Real bdiscr_, ddiscr_;
     };
@@ -178,6 +178,9 @@ namespace QuantLib {
                 add(*begin, *wbegin);
         }
 
+        //! adds the samples collected by another instance
+        void merge(const GeneralStatistics& other);
+
         //! resets the data to a null set
         void reset();
 
@@ -235,6 +238,21 @@ namespace QuantLib {
         sorted_ = false;
     }
 
+    inline void GeneralStatistics::merge(const GeneralStatistics& other) {
+        if (other.samples_.empty())
+            return;
+        if (&other == this) {
+            const Size n = samples_.size();
+            samples_.reserve(2*n);
+            for (Size i=0; i<n; ++i)
+                samples_.push_back(samples_[i]);
+        } else {
+            samples_.insert(samples_.end(),
+                            other.samples_.begin(), other.samples_.end());
+        }
+        sorted_ = false;
+    }
+
     inline void GeneralStatistics::reset() {
         samples_ = std::vector<std::pair<Real,Real> >();
         sorted_ = true;
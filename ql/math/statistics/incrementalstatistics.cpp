@@ -20,7 +20,8 @@
 */
 
 #include <ql/math/statistics/incrementalstatistics.hpp>
-#include <iomanip>
+#include <algorithm>
+#include <cmath>
 
 namespace QuantLib {
 
@@ -29,28 +30,23 @@ namespace QuantLib {
     }
 
     Size IncrementalStatistics::samples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(acc_);
+        return samples_;
     }
 
     Real IncrementalStatistics::weightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(acc_);
+        return weightSum_;
     }
 
     Real IncrementalStatistics::mean() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_mean>(acc_);
+        return sum1_/weightSum_;
     }
 
     Real IncrementalStatistics::variance() const {
         QL_REQUIRE(weightSum() > 0.0, "sampleWeight_= 0, unsufficient");
         QL_REQUIRE(samples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(samples());
-        return n / (n - 1.0) *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_variance>(acc_);
+        return n / (n - 1.0) * variance_;
     }
 
     Real IncrementalStatistics::standardDeviation() const {
@@ -66,47 +62,45 @@ namespace QuantLib {
         Real n = static_cast<Real>(samples());
         Real r1 = n / (n - 2.0);
         Real r2 = (n - 1.0) / (n - 2.0);
-        return std::sqrt(r1 * r2) * 
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::weighted_skewness>(acc_);
+        Real m = sum1_/weightSum_;
+        Real m2 = sum2_/weightSum_, m3 = sum3_/weightSum_;
+        Real s2 = m2 - m * m;
+        return std::sqrt(r1 * r2) *
+               ((m3 - 3.0 * m2 * m + 2.0 * m * m * m) / (s2 * std::sqrt(s2)));
     }
 
     Real IncrementalStatistics::kurtosis() const {
         QL_REQUIRE(samples() > 3,
                    "sample number <= 3, unsufficient");
-        boost::accumulators::extract_result<
-            boost::accumulators::tag::weighted_kurtosis>(acc_);
         Real n = static_cast<Real>(samples());
         Real r1 = (n - 1.0) / (n - 2.0);
         Real r2 = (n + 1.0) / (n - 3.0);
         Real r3 = (n - 1.0) / (n - 3.0);
-        return ((3.0 + boost::accumulators::extract_result<
-                           boost::accumulators::tag::weighted_kurtosis>(acc_)) *
-                    r2 -
-                3.0 * r3) *
-               r1;
+        Real m = sum1_/weightSum_;
+        Real m2 = sum2_/weightSum_, m3 = sum3_/weightSum_,
+             m4 = sum4_/weightSum_;
+        Real s2 = m2 - m * m;
+        Real excess = (m4 - 4.0 * m3 * m + 6.0 * m2 * m * m
+                       - 3.0 * m * m * m * m) / (s2 * s2) - 3.0;
+        return ((3.0 + excess) * r2 - 3.0 * r3) * r1;
     }
 
     Real IncrementalStatistics::min() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::min>(acc_);
+        return min_;
     }
 
     Real IncrementalStatistics::max() const {
         QL_REQUIRE(samples() > 0, "empty sample set");
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::max>(acc_);
+        return max_;
     }
 
     Size IncrementalStatistics::downsideSamples() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::count>(downsideAcc_);
+        return downsideSamples_;
     }
 
     Real IncrementalStatistics::downsideWeightSum() const {
-        return boost::accumulators::extract_result<
-            boost::accumulators::tag::sum_of_weights>(downsideAcc_);
+        return downsideWeightSum_;
     }
 
     Real IncrementalStatistics::downsideVariance() const {
@@ -114,9 +108,7 @@ namespace QuantLib {
         QL_REQUIRE(downsideSamples() > 1, "sample number <= 1, unsufficient");
         Real n = static_cast<Real>(downsideSamples());
         Real r1 = n / (n - 1.0);
-        return r1 *
-               boost::accumulators::extract_result<
-                   boost::accumulators::tag::moment<2> >(downsideAcc_);
+        return r1 * (downsideSum2_ / downsideWeightSum_);
     }
 
     Real IncrementalStatistics::downsideDeviation() const {
@@ -126,14 +118,73 @@ namespace QuantLib {
     void IncrementalStatistics::add(Real value, Real valueWeight) {
         QL_REQUIRE(valueWeight >= 0.0, "negative weight (" << valueWeight
                                                            << ") not allowed");
-        acc_(value, boost::accumulators::weight = valueWeight);
-        if(value < 0.0)
-            downsideAcc_(value, boost::accumulators::weight = valueWeight);
+        const bool first = (weightSum_ == 0.0);
+        ++samples_;
+        weightSum_ += valueWeight;
+        if (weightSum_ > 0.0) {
+            Real previousWeight = weightSum_ - valueWeight;
+            mean_ = (mean_ * previousWeight + value * valueWeight) / weightSum_;
+            if (!first) {
+                Real d = value - mean_;
+                variance_ = variance_ * previousWeight / weightSum_
+                    + d * d * valueWeight / previousWeight;
+            }
+        }
+
+        Real value2 = value * value;
+        sum1_ += value * valueWeight;
+        sum2_ += valueWeight * value2;
+        sum3_ += valueWeight * (value2 * value);
+        sum4_ += valueWeight * (value2 * value2);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+
+        if (value < 0.0) {
+            ++downsideSamples_;
+            downsideWeightSum_ += valueWeight;
+            downsideSum2_ += valueWeight * value2;
+        }
+    }
+
+    void IncrementalStatistics::merge(const IncrementalStatistics& other) {
+        if (&other == this) {
+            IncrementalStatistics copy(other);
+            merge(copy);
+            return;
+        }
+
+        const Real wa = weightSum_, wb = other.weightSum_, w = wa + wb;
+        if (wa == 0.0) {
+            mean_ = other.mean_;
+            variance_ = other.variance_;
+        } else if (wb > 0.0) {
+            Real delta = other.mean_ - mean_;
+            variance_ = (wa * variance_ + wb * other.variance_
+                         + delta * delta * wa * wb / w) / w;
+            mean_ += delta * wb / w;
+        }
+        samples_ += other.samples_;
+        weightSum_ = w;
+
+        sum1_ += other.sum1_;
+        sum2_ += other.sum2_;
+        sum3_ += other.sum3_;
+        sum4_ += other.sum4_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+
+        downsideSamples_ += other.downsideSamples_;
+        downsideWeightSum_ += other.downsideWeightSum_;
+        downsideSum2_ += other.downsideSum2_;
     }
 
     void IncrementalStatistics::reset() {
-        acc_ = accumulator_set();
-        downsideAcc_ = downside_accumulator_set();
+        samples_ = downsideSamples_ = 0;
+        weightSum_ = mean_ = variance_ = 0.0;
+        sum1_ = sum2_ = sum3_ = sum4_ = 0.0;
+        downsideWeightSum_ = downsideSum2_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
     }
 
 }
@@ -21,8 +21,6 @@
 
 /*! \file incrementalstatistics.hpp
     \brief statistics tool based on incremental accumulation
-           in the meantime, this is just a wrapper to the boost
-           accumulator library, kept for backward compatibility
 */
 
 #ifndef quantlib_incremental_statistics_hpp
@@ -30,24 +28,21 @@
 
 #include <ql/utilities/null.hpp>
 #include <ql/errors.hpp>
-#include <boost/accumulators/accumulators.hpp>
-#include <boost/accumulators/statistics/stats.hpp>
-#include <boost/accumulators/statistics/count.hpp>
-#include <boost/accumulators/statistics/sum.hpp>
-#include <boost/accumulators/statistics/min.hpp>
-#include <boost/accumulators/statistics/max.hpp>
-#include <boost/accumulators/statistics/weighted_mean.hpp>
-#include <boost/accumulators/statistics/weighted_variance.hpp>
-#include <boost/accumulators/statistics/weighted_skewness.hpp>
-#include <boost/accumulators/statistics/weighted_kurtosis.hpp>
-#include <boost/accumulators/statistics/weighted_moment.hpp>
 
 namespace QuantLib {
 
     //! Statistics tool based on incremental accumulation
     /*! It can accumulate a set of data and return statistics (e.g: mean,
         variance, skewness, kurtosis, error estimation, etc.).
-        This class is a wrapper to the boost accumulator library.
+        Instances can be merged, so that samples can be collected in
+        separate instances (e.g., one per thread) and combined
+        afterwards.
+
+        The accumulation follows the one of the weighted statistics
+        of the boost accumulator library, which this class used to
+        wrap; the mean and the variance are updated incrementally,
+        while skewness and kurtosis are calculated from the weighted
+        raw moments.
     */
 
     class IncrementalStatistics {
@@ -145,29 +140,23 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the samples collected by another instance
+        /*! The mean and variance are combined as in Chan, Golub and
+            LeVeque, "Updating Formulae and a Pairwise Algorithm for
+            Computing Sample Variances" (1979).
+        */
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
-     private:
-       typedef boost::accumulators::accumulator_set<
-           Real,
-           boost::accumulators::stats<
-               boost::accumulators::tag::count, boost::accumulators::tag::min,
-               boost::accumulators::tag::max,
-               boost::accumulators::tag::weighted_mean,
-               boost::accumulators::tag::weighted_variance,
-               boost::accumulators::tag::weighted_skewness,
-               boost::accumulators::tag::weighted_kurtosis,
-               boost::accumulators::tag::sum_of_weights>,
-           Real> accumulator_set;
-        accumulator_set acc_;
-        typedef boost::accumulators::accumulator_set<
-            Real, boost::accumulators::stats<
-                      boost::accumulators::tag::count,
-                      boost::accumulators::tag::weighted_moment<2>,
-                      boost::accumulators::tag::sum_of_weights>,
-            Real> downside_accumulator_set;
-        downside_accumulator_set downsideAcc_;
+      private:
+        Size samples_;
+        Real weightSum_, mean_, variance_;
+        // weighted sums of the powers of the samples
+        Real sum1_, sum2_, sum3_, sum4_;
+        Real min_, max_;
+        Size downsideSamples_;
+        Real downsideWeightSum_, downsideSum2_;
     };
 
 }
@@ -43,6 +43,13 @@ namespace QuantLib {
         requested to the 1-D underlying StatisticsType class, with the
         usual compile-time checks provided by the template approach.
 
+        Samples can also be added in batches, in which case the
+        accumulation is parallelized over the dimensions when
+        OpenMP is enabled; and instances can be merged, provided
+        that the underlying StatisticsType class can be, so that
+        samples can be collected separately (e.g., one instance per
+        thread) and combined afterwards.
+
         \test the correctness of the returned values is tested by
               checking them against numerical calculations.
     */
@@ -132,19 +139,39 @@ namespace QuantLib {
                        " required, " << std::distance(begin, end) <<
                        " provided");
 
-            quadraticSum_ += weight * outerProduct(begin, end,
-                                                   begin, end);
+            sample_.assign(begin, end);
+
+            // rank-one update of the quadratic sum, in place
+            for (Size i=0; i<dimension_; ++i) {
+                const Real xi = sample_[i];
+                Matrix::row_iterator q = quadraticSum_.row_begin(i);
+                for (Size j=0; j<dimension_; ++j)
+                    q[j] += weight * (xi * sample_[j]);
+            }
 
-            for (Size i=0; i<dimension_; ++begin, ++i)
-                stats_[i].add(*begin, weight);
+            for (Size i=0; i<dimension_; ++i)
+                stats_[i].add(sample_[i], weight);
 
         }
+        /*! adds a batch of samples, one for each row of the matrix.
+            The results are the same as adding the rows one by one.
+
+            \pre weights, if given, must be as many as the samples
+                 and positive or null
+        */
+        void addBatch(const Matrix& samples,
+                      const std::vector<Real>& weights = std::vector<Real>());
+        //! adds the samples collected by another instance
+        /*! \pre the two instances must have the same dimension */
+        void merge(const GenericSequenceStatistics& other);
         //@}
       protected:
         Size dimension_ = 0;
         std::vector<statistics_type> stats_;
         mutable std::vector<Real> results_;
         Matrix quadraticSum_;
+      private:
+        std::vector<Real> sample_;
     };
 
     //! default multi-dimensional statistics tool
@@ -243,6 +270,65 @@ namespace QuantLib {
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::addBatch(
+                                       const Matrix& samples,
+                                       const std::vector<Real>& weights) {
+        const Size n = samples.rows();
+        if (n == 0)
+            return;
+        if (dimension_ == 0)
+            reset(samples.columns());
+
+        QL_REQUIRE(samples.columns() == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << samples.columns() << " provided");
+        QL_REQUIRE(weights.empty() || weights.size() == n,
+                   "weight size mismatch: " << n <<
+                   " required, " << weights.size() << " provided");
+        for (Real w : weights)
+            QL_REQUIRE(w >= 0.0, "negative weight (" << w
+                                                     << ") not allowed");
+
+        // each thread takes a set of dimensions and updates the
+        // corresponding row of the upper triangle of the quadratic
+        // sum; the order of accumulation is the same as in add().
+        const Size d = dimension_;
+        #pragma omp parallel for if(n*d*d > 1000000)
+        for (long i=0; i < long(d); ++i) {
+            Matrix::row_iterator q = quadraticSum_.row_begin(i);
+            for (Size k=0; k<n; ++k) {
+                Matrix::const_row_iterator x = samples.row_begin(k);
+                const Real w = weights.empty() ? 1.0 : weights[k];
+                const Real xi = x[i];
+                for (Size j=i; j<d; ++j)
+                    q[j] += w * (xi * x[j]);
+                stats_[i].add(xi, w);
+            }
+        }
+
+        for (Size i=1; i<d; ++i)
+            for (Size j=0; j<i; ++j)
+                quadraticSum_[i][j] = quadraticSum_[j][i];
+    }
+
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                  const GenericSequenceStatistics& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "dimension mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+        quadraticSum_ += other.quadraticSum_;
+    }
+
     template <class Stat>
     Matrix GenericSequenceStatistics<Stat>::covariance() const {
         Real sampleWeight = weightSum();
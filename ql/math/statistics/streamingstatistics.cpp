@@ -0,0 +1,213 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/statistics/streamingstatistics.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    StreamingStatistics::StreamingStatistics(Size tailSize, Real compression)
+    : tailSize_(tailSize), digest_(compression) {
+        reset();
+    }
+
+    Real StreamingStatistics::mean() const {
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        return mean_;
+    }
+
+    Real StreamingStatistics::variance() const {
+        QL_REQUIRE(weightSum_ > 0.0, "sampleWeight_= 0, unsufficient");
+        QL_REQUIRE(samples_ > 1, "sample number <= 1, unsufficient");
+        Real n = static_cast<Real>(samples_);
+        return n / (n - 1.0) * (m2_ / weightSum_);
+    }
+
+    Real StreamingStatistics::standardDeviation() const {
+        return std::sqrt(variance());
+    }
+
+    Real StreamingStatistics::errorEstimate() const {
+        return std::sqrt(variance() / samples_);
+    }
+
+    Real StreamingStatistics::skewness() const {
+        QL_REQUIRE(samples_ > 2, "sample number <= 2, unsufficient");
+        Real n = static_cast<Real>(samples_);
+        Real r1 = n / (n - 2.0);
+        Real r2 = (n - 1.0) / (n - 2.0);
+        Real s2 = m2_ / weightSum_;
+        return std::sqrt(r1 * r2) * (m3_ / weightSum_) / (s2 * std::sqrt(s2));
+    }
+
+    Real StreamingStatistics::kurtosis() const {
+        QL_REQUIRE(samples_ > 3, "sample number <= 3, unsufficient");
+        Real n = static_cast<Real>(samples_);
+        Real r1 = (n - 1.0) / (n - 2.0);
+        Real r2 = (n + 1.0) / (n - 3.0);
+        Real r3 = (n - 1.0) / (n - 3.0);
+        Real s2 = m2_ / weightSum_;
+        return ((m4_ / weightSum_) / (s2 * s2) * r2 - 3.0 * r3) * r1;
+    }
+
+    Real StreamingStatistics::min() const {
+        QL_REQUIRE(samples_ > 0, "empty sample set");
+        return min_;
+    }
+
+    Real StreamingStatistics::max() const {
+        QL_REQUIRE(samples_ > 0, "empty sample set");
+        return max_;
+    }
+
+    Real StreamingStatistics::percentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        const Real target = percent*weightSum_;
+        std::vector<std::pair<Real,Real> > sorted(tail_);
+        std::sort(sorted.begin(), sorted.end());
+
+        // all the samples in the digest are above the ones in the tail
+        Real integral = 0.0;
+        for (const auto& sample : sorted) {
+            integral += sample.second;
+            if (integral >= target)
+                return sample.first;
+        }
+
+        const Real digestWeight = digest_.weightSum();
+        if (digestWeight == 0.0)
+            return sorted.back().first;
+        return digest_.quantile(
+            std::min((target-integral)/digestWeight, Real(1.0)));
+    }
+
+    Real StreamingStatistics::topPercentile(Real percent) const {
+
+        QL_REQUIRE(percent > 0.0 && percent <= 1.0,
+                   "percentile (" << percent << ") must be in (0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        const Real target = percent*weightSum_;
+        const Real digestWeight = digest_.weightSum();
+        if (digestWeight >= target)
+            return digest_.quantile(1.0 - target/digestWeight);
+
+        std::vector<std::pair<Real,Real> > sorted(tail_);
+        std::sort(sorted.begin(), sorted.end());
+
+        Real integral = digestWeight;
+        for (auto k = sorted.rbegin(); k != sorted.rend(); ++k) {
+            integral += k->second;
+            if (integral >= target)
+                return k->first;
+        }
+        return sorted.front().first;
+    }
+
+    void StreamingStatistics::add(Real value, Real weight) {
+        QL_REQUIRE(weight >= 0.0, "negative weight (" << weight
+                                                      << ") not allowed");
+        addMoments(1, weight, value, 0.0, 0.0, 0.0);
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        addToTail(value, weight);
+    }
+
+    void StreamingStatistics::merge(const StreamingStatistics& other) {
+        QL_REQUIRE(other.tailSize_ == tailSize_,
+                   "different tail sizes (" << tailSize_ << ", "
+                   << other.tailSize_ << ") cannot be merged");
+        if (&other == this) {
+            StreamingStatistics copy(other);
+            merge(copy);
+            return;
+        }
+
+        addMoments(other.samples_, other.weightSum_, other.mean_,
+                   other.m2_, other.m3_, other.m4_);
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        // if the other tail is full, the samples in the other digest
+        // can't belong to the merged tail
+        for (const auto& sample : other.tail_)
+            addToTail(sample.first, sample.second);
+        digest_.merge(other.digest_);
+    }
+
+    void StreamingStatistics::reset() {
+        samples_ = 0;
+        weightSum_ = mean_ = m2_ = m3_ = m4_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        tail_.clear();
+        tail_.reserve(tailSize_);
+        digest_.reset();
+    }
+
+    void StreamingStatistics::addToTail(Real value, Real weight) {
+        if (tail_.size() < tailSize_) {
+            tail_.emplace_back(value, weight);
+            std::push_heap(tail_.begin(), tail_.end());
+        } else if (tailSize_ > 0 && value < tail_.front().first) {
+            // the largest sample in the tail moves to the digest
+            std::pop_heap(tail_.begin(), tail_.end());
+            const std::pair<Real,Real> largest = tail_.back();
+            tail_.back() = std::make_pair(value, weight);
+            std::push_heap(tail_.begin(), tail_.end());
+            digest_.add(largest.first, largest.second);
+        } else {
+            digest_.add(value, weight);
+        }
+    }
+
+    void StreamingStatistics::addMoments(Size samples, Real weight, Real mean,
+                                         Real m2, Real m3, Real m4) {
+        // pairwise update of the central moments, see Pebay,
+        // "Formulas for robust, one-pass parallel computation of
+        // covariances and arbitrary-order statistical moments" (2008)
+        samples_ += samples;
+        if (weight == 0.0)
+            return;
+        if (weightSum_ == 0.0) {
+            weightSum_ = weight;
+            mean_ = mean;
+            m2_ = m2;
+            m3_ = m3;
+            m4_ = m4;
+            return;
+        }
+
+        const Real wa = weightSum_, wb = weight, w = wa + wb;
+        const Real delta = mean - mean_;
+        const Real d_w = delta / w;
+        const Real d2_w2 = d_w * d_w;
+
+        m4_ += m4 + delta * d_w * d2_w2 * wa * wb * (wa * wa - wa * wb + wb * wb)
+            + 6.0 * d2_w2 * (wa * wa * m2 + wb * wb * m2_)
+            + 4.0 * d_w * (wa * m3 - wb * m3_);
+        m3_ += m3 + delta * d2_w2 * wa * wb * (wa - wb)
+            + 3.0 * d_w * (wa * m2 - wb * m2_);
+        m2_ += m2 + delta * d_w * wa * wb;
+        mean_ += d_w * wb;
+        weightSum_ = w;
+    }
+
+}
@@ -0,0 +1,236 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file streamingstatistics.hpp
+    \brief statistics tool with bounded memory and mergeable quantiles
+*/
+
+#ifndef quantlib_streaming_statistics_hpp
+#define quantlib_streaming_statistics_hpp
+
+#include <ql/math/statistics/riskstatistics.hpp>
+#include <ql/math/statistics/tdigest.hpp>
+#include <ql/utilities/null.hpp>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Statistics tool with bounded memory and mergeable quantiles
+    /*! This class can be used in place of GeneralStatistics when
+        storing all samples is not viable.  Moments are accumulated
+        incrementally; the distribution is summarized by an exact
+        copy of the lowest samples (the tail, whose size is set at
+        construction) and by a TDigest of all the others.
+
+        Percentiles falling within the tail, and expectation values
+        over ranges lying entirely below the largest tail sample
+        (such as the ones used by GenericRiskStatistics for
+        value-at-risk and expected shortfall at high confidence) are
+        calculated exactly as GeneralStatistics would; other ones are
+        estimated from the digest, whose centroids are used in place
+        of the samples they summarize.  For instance, with the default
+        tail size, value-at-risk and expected shortfall at 99% are
+        exact for up to 100000 samples.
+
+        Instances can be merged, so that samples can be collected in
+        separate instances (e.g., one per thread) and combined
+        afterwards.
+    */
+    class StreamingStatistics {
+      public:
+        typedef Real value_type;
+        explicit StreamingStatistics(Size tailSize = 1000,
+                                     Real compression = 100.0);
+        //! \name Inspectors
+        //@{
+        Size tailSize() const { return tailSize_; }
+        Real compression() const { return digest_.compression(); }
+
+        //! number of samples collected
+        Size samples() const { return samples_; }
+
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+
+        /*! returns the mean, defined as
+            \f[ \langle x \rangle = \frac{\sum w_i x_i}{\sum w_i}. \f]
+        */
+        Real mean() const;
+
+        /*! returns the variance, defined as
+            \f[ \frac{N}{N-1} \left\langle \left(
+                x-\langle x \rangle \right)^2 \right\rangle. \f]
+        */
+        Real variance() const;
+
+        /*! returns the standard deviation \f$ \sigma \f$, defined as the
+            square root of the variance.
+        */
+        Real standardDeviation() const;
+
+        /*! returns the error estimate on the mean value, defined as
+            \f$ \epsilon = \sigma/\sqrt{N}. \f$
+        */
+        Real errorEstimate() const;
+
+        /*! returns the skewness, defined as
+            \f[ \frac{N^2}{(N-1)(N-2)} \frac{\left\langle \left(
+                x-\langle x \rangle \right)^3 \right\rangle}{\sigma^3}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real skewness() const;
+
+        /*! returns the excess kurtosis, defined as
+            \f[ \frac{N^2(N+1)}{(N-1)(N-2)(N-3)}
+                \frac{\left\langle \left(x-\langle x \rangle \right)^4
+                \right\rangle}{\sigma^4} - \frac{3(N-1)^2}{(N-2)(N-3)}. \f]
+            The above evaluates to 0 for a Gaussian distribution.
+        */
+        Real kurtosis() const;
+
+        /*! returns the minimum sample value */
+        Real min() const;
+
+        /*! returns the maximum sample value */
+        Real max() const;
+
+        //! lowest samples, kept exactly, in no particular order
+        const std::vector<std::pair<Real,Real> >& tail() const {
+            return tail_;
+        }
+
+        //! summary of the samples not in the tail
+        const TDigest& digest() const { return digest_; }
+
+        /*! Expectation value of a function \f$ f \f$ on a given
+            range \f$ \mathcal{R} \f$, i.e.,
+            \f[ \mathrm{E}\left[f \;|\; \mathcal{R}\right] =
+                \frac{\sum_{x_i \in \mathcal{R}} f(x_i) w_i}{
+                      \sum_{x_i \in \mathcal{R}} w_i}. \f]
+            The range is passed as a boolean function returning
+            <tt>true</tt> if the argument belongs to the range
+            or <tt>false</tt> otherwise.  Samples outside the tail
+            are replaced by the centroids of the digest.
+
+            The function returns a pair made of the result and
+            the number of observations in the given range.
+        */
+        template <class Func, class Predicate>
+        std::pair<Real,Size> expectationValue(const Func& f,
+                                              const Predicate& inRange) const {
+            Real num = 0.0, den = 0.0;
+            Size N = 0;
+            for (const auto& sample : tail_) {
+                Real x = sample.first, w = sample.second;
+                if (inRange(x)) {
+                    num += f(x)*w;
+                    den += w;
+                    N += 1;
+                }
+            }
+            if (!digest_.empty()) {
+                for (const auto& c : digest_.centroids()) {
+                    if (inRange(c.mean)) {
+                        num += f(c.mean)*c.weight;
+                        den += c.weight;
+                        N += c.samples;
+                    }
+                }
+            }
+            if (N == 0)
+                return std::make_pair<Real,Size>(Null<Real>(),0);
+            else
+                return std::make_pair(num/den,N);
+        }
+
+        /*! Expectation value of a function \f$ f \f$ over the whole
+            set of samples; equivalent to passing the other overload
+            a range function always returning <tt>true</tt>.
+        */
+        template <class Func>
+        std::pair<Real,Size> expectationValue(const Func& f) const {
+            return expectationValue(f, [](Real x) { return true; });
+        }
+
+        /*! \f$ y \f$-th percentile, defined as the value \f$ \bar{x} \f$
+            such that
+            \f[ y = \frac{\sum_{x_i < \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real percentile(Real y) const;
+
+        /*! \f$ y \f$-th top percentile, defined as the value
+            \f$ \bar{x} \f$ such that
+            \f[ y = \frac{\sum_{x_i > \bar{x}} w_i}{
+                          \sum_i w_i} \f]
+
+            \pre \f$ y \f$ must be in the range \f$ (0-1]. \f$
+        */
+        Real topPercentile(Real y) const;
+        //@}
+
+        //! \name Modifiers
+        //@{
+        //! adds a datum to the set, possibly with a weight
+        /*! \pre weight must be positive or null */
+        void add(Real value, Real weight = 1.0);
+        //! adds a sequence of data to the set, with default weight
+        template <class DataIterator>
+        void addSequence(DataIterator begin, DataIterator end) {
+            for (;begin!=end;++begin)
+                add(*begin);
+        }
+        //! adds a sequence of data to the set, each with its weight
+        /*! \pre weights must be positive or null */
+        template <class DataIterator, class WeightIterator>
+        void addSequence(DataIterator begin, DataIterator end,
+                         WeightIterator wbegin) {
+            for (;begin!=end;++begin,++wbegin)
+                add(*begin, *wbegin);
+        }
+        //! adds the samples collected by another instance
+        /*! \pre the two instances must have the same tail size */
+        void merge(const StreamingStatistics& other);
+        //! resets the data to a null set
+        void reset();
+        //@}
+      private:
+        void addToTail(Real value, Real weight);
+        void addMoments(Size samples, Real weight, Real mean,
+                        Real m2, Real m3, Real m4);
+        Size tailSize_;
+        Size samples_;
+        Real weightSum_, mean_, m2_, m3_, m4_, min_, max_;
+        // max-heap on the sample value
+        std::vector<std::pair<Real,Real> > tail_;
+        TDigest digest_;
+    };
+
+    //! streaming risk measures tool
+    /*! This can be used in place of RiskStatistics, e.g., as the
+        statistics policy of McSimulation or SequenceStatistics.
+    */
+    typedef GenericRiskStatistics<GenericGaussianStatistics<StreamingStatistics> >
+        StreamingRiskStatistics;
+
+}
+
+
+#endif
@@ -0,0 +1,201 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/errors.hpp>
+#include <ql/math/statistics/tdigest.hpp>
+#include <ql/mathconstants.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    TDigest::TDigest(Real compression)
+    : compression_(compression) {
+        QL_REQUIRE(compression >= 10.0,
+                   "compression (" << compression << ") must be at least 10");
+        reset();
+    }
+
+    Real TDigest::min() const {
+        QL_REQUIRE(samples_ > 0, "empty sample set");
+        return min_;
+    }
+
+    Real TDigest::max() const {
+        QL_REQUIRE(samples_ > 0, "empty sample set");
+        return max_;
+    }
+
+    const std::vector<TDigest::Centroid>& TDigest::centroids() const {
+        compress();
+        return centroids_;
+    }
+
+    void TDigest::add(Real value, Real weight) {
+        QL_REQUIRE(weight >= 0.0, "negative weight (" << weight
+                                                      << ") not allowed");
+        ++samples_;
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+        // null weights don't affect the distribution
+        if (weight > 0.0) {
+            weightSum_ += weight;
+            buffer_.push_back({value, weight, 1});
+            if (Real(buffer_.size()) >= 5.0*compression_)
+                compress();
+        }
+    }
+
+    void TDigest::merge(const TDigest& other) {
+        if (other.samples_ == 0)
+            return;
+        const std::vector<Centroid>& c = other.centroids();
+        buffer_.insert(buffer_.end(), c.begin(), c.end());
+        samples_ += other.samples_;
+        weightSum_ += other.weightSum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+        compress();
+    }
+
+    void TDigest::reset() {
+        samples_ = 0;
+        weightSum_ = 0.0;
+        min_ = QL_MAX_REAL;
+        max_ = QL_MIN_REAL;
+        centroids_.clear();
+        buffer_.clear();
+    }
+
+    void TDigest::compress() const {
+        if (buffer_.empty())
+            return;
+
+        std::vector<Centroid> all;
+        all.reserve(centroids_.size() + buffer_.size());
+        all.insert(all.end(), centroids_.begin(), centroids_.end());
+        all.insert(all.end(), buffer_.begin(), buffer_.end());
+        buffer_.clear();
+        std::stable_sort(all.begin(), all.end(),
+                         [](const Centroid& a, const Centroid& b) {
+                             return a.mean < b.mean;
+                         });
+
+        const Real totalWeight = weightSum_;
+        // k_1 scale function; a centroid can span at most one unit of k
+        const auto k = [this, totalWeight](Real w) {
+            const Real z = std::max(-1.0, std::min(1.0, 2.0*w/totalWeight - 1.0));
+            return compression_ * std::asin(z) / (2.0 * M_PI);
+        };
+
+        centroids_.clear();
+        Centroid current = all.front();
+        Real weightSoFar = 0.0, kLeft = k(0.0);
+        for (Size i=1; i<all.size(); ++i) {
+            const Centroid& next = all[i];
+            const Real proposed = current.weight + next.weight;
+            if (k(weightSoFar + proposed) - kLeft <= 1.0) {
+                current.mean += (next.mean - current.mean)*next.weight/proposed;
+                current.weight = proposed;
+                current.samples += next.samples;
+            } else {
+                centroids_.push_back(current);
+                weightSoFar += current.weight;
+                kLeft = k(weightSoFar);
+                current = next;
+            }
+        }
+        centroids_.push_back(current);
+    }
+
+    Real TDigest::quantile(Real q) const {
+        QL_REQUIRE(q >= 0.0 && q <= 1.0,
+                   "quantile (" << q << ") must be in [0.0, 1.0]");
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        const std::vector<Centroid>& c = centroids();
+        const Size n = c.size();
+        const Real target = q*weightSum_;
+
+        // the extremes are samples themselves; within the average
+        // sample weight from either end, they are returned exactly
+        const Real sampleWeight = weightSum_/samples_;
+        if (target <= sampleWeight)
+            return min_;
+        if (target >= weightSum_ - sampleWeight)
+            return max_;
+
+        // between the minimum and the center of the first centroid...
+        const Real firstCenter = 0.5*c.front().weight;
+        if (target < firstCenter) {
+            if (c.front().samples == 1)
+                return c.front().mean;
+            return min_ + (c.front().mean - min_)*target/firstCenter;
+        }
+        // ...between the center of the last centroid and the maximum...
+        const Real lastCenter = weightSum_ - 0.5*c.back().weight;
+        if (target > lastCenter) {
+            if (c.back().samples == 1)
+                return c.back().mean;
+            return c.back().mean + (max_ - c.back().mean)
+                *(target-lastCenter)/(weightSum_-lastCenter);
+        }
+        // ...or between the centers of two adjacent centroids
+        Real center = firstCenter;
+        for (Size i=0; i<n-1; ++i) {
+            const Real nextCenter = center + 0.5*(c[i].weight + c[i+1].weight);
+            if (target <= nextCenter) {
+                return c[i].mean + (c[i+1].mean - c[i].mean)
+                    *(target-center)/(nextCenter-center);
+            }
+            center = nextCenter;
+        }
+        return c.back().mean;
+    }
+
+    Real TDigest::cdf(Real x) const {
+        QL_REQUIRE(weightSum_ > 0.0, "empty sample set");
+
+        if (x < min_)
+            return 0.0;
+        if (x >= max_)
+            return 1.0;
+
+        const std::vector<Centroid>& c = centroids();
+        const Size n = c.size();
+
+        // between the minimum and the center of the first centroid...
+        const Real firstCenter = 0.5*c.front().weight;
+        if (x < c.front().mean) {
+            return firstCenter*(x - min_)/(c.front().mean - min_)/weightSum_;
+        }
+        // ...between the centers of two adjacent centroids...
+        Real center = firstCenter;
+        for (Size i=0; i<n-1; ++i) {
+            const Real nextCenter = center + 0.5*(c[i].weight + c[i+1].weight);
+            if (x < c[i+1].mean) {
+                return (center + (nextCenter-center)
+                        *(x - c[i].mean)/(c[i+1].mean - c[i].mean))/weightSum_;
+            }
+            center = nextCenter;
+        }
+        // ...or between the center of the last centroid and the maximum
+        return (center + (weightSum_-center)
+                *(x - c.back().mean)/(max_ - c.back().mean))/weightSum_;
+    }
+
+}
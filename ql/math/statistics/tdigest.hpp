@@ -0,0 +1,92 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tdigest.hpp
+    \brief t-digest sketch for streaming quantile estimation
+*/
+
+#ifndef quantlib_tdigest_hpp
+#define quantlib_tdigest_hpp
+
+#include <ql/types.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! t-digest sketch for streaming quantile estimation
+    /*! The digest summarizes a stream of weighted samples with a
+        bounded number of centroids (about twice the compression
+        parameter) whose size is kept small near the tails of the
+        distribution; therefore, extreme quantiles are estimated with
+        a relative accuracy much better than central ones.  Digests
+        can be merged, so that samples can be collected in separate
+        digests (e.g., one per thread) and combined afterwards.
+
+        This is the merging variant of the algorithm with the
+        \f$ k_1 \f$ scale function.
+
+        References:
+        Dunning T., Ertl O., "Computing extremely accurate quantiles
+        using t-digests", arXiv:1902.04023 (2019).
+    */
+    class TDigest {
+      public:
+        struct Centroid {
+            Real mean, weight;
+            Size samples;
+        };
+        explicit TDigest(Real compression = 100.0);
+        //! \name Inspectors
+        //@{
+        Real compression() const { return compression_; }
+        //! number of samples collected
+        Size samples() const { return samples_; }
+        //! sum of data weights
+        Real weightSum() const { return weightSum_; }
+        bool empty() const { return samples_ == 0; }
+        Real min() const;
+        Real max() const;
+        //! centroids sorted by increasing mean
+        const std::vector<Centroid>& centroids() const;
+        /*! value \f$ \bar{x} \f$ such that a fraction \f$ q \f$ of
+            the total weight lies below it, interpolated between
+            centroids.
+
+            \pre \f$ q \f$ must be in the range \f$ [0-1]. \f$
+        */
+        Real quantile(Real q) const;
+        //! estimated fraction of the total weight below \f$ x \f$
+        Real cdf(Real x) const;
+        //@}
+        //! \name Modifiers
+        //@{
+        //! \pre weight must be positive or null
+        void add(Real value, Real weight = 1.0);
+        void merge(const TDigest& other);
+        void reset();
+        //@}
+      private:
+        void compress() const;
+        Real compression_;
+        Size samples_ = 0;
+        Real weightSum_ = 0.0, min_, max_;
+        mutable std::vector<Centroid> centroids_, buffer_;
+    };
+
+}
+
+#endif
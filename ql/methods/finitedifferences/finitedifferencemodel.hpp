@@ -24,6 +24,7 @@
 #ifndef quantlib_finite_difference_model_hpp
 #define quantlib_finite_difference_model_hpp
 
+#include <ql/math/arraypool.hpp>
 #include <ql/methods/finitedifferences/boundarycondition.hpp>
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/stepcondition.hpp>
@@ -92,6 +93,10 @@ namespace QuantLib {
             QL_REQUIRE(from >= to,
                        "trying to roll back from " << from << " to " << to);
 
+            // the temporaries created at each step are recycled
+            ArrayPool pool;
+            ArrayPool::Scope scope(pool);
+
             Time dt = (from-to)/steps, t = from;
             evolver_.setStep(dt);
 
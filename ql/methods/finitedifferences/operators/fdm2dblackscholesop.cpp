@@ -145,13 +145,16 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
-    std::vector<SparseMatrix> Fdm2dBlackScholesOp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> Fdm2dBlackScholesOp::toCsrMatrixDecomp() const {
+        const Size n = mesher_->layout()->size();
+        CsrMatrix::Builder rate(n, n, n);
+        for (Size i=0; i < n; ++i)
+            rate.add(i, i, currentForwardRate_);
+
         return {
-            opX_.toMatrix(),
-            opY_.toMatrix(),
-            corrMapT_.toMatrix() +
-            currentForwardRate_*boost::numeric::ublas::identity_matrix<Real>(
-                    mesher_->layout()->size())
+            opX_.toCsrMatrix(),
+            opY_.toCsrMatrix(),
+            corrMapT_.toCsrMatrix() + rate.matrix()
         };
     }
 
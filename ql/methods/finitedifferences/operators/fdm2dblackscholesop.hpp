@@ -54,7 +54,7 @@ namespace QuantLib {
         Array solve_splitting(Size direction, const Array& x, Real s) const override;
         Array preconditioner(const Array& r, Real s) const override;
 
-        std::vector<SparseMatrix> toMatrixDecomp() const override;
+        std::vector<CsrMatrix> toCsrMatrixDecomp() const override;
 
       private:
         const ext::shared_ptr<FdmMesher> mesher_;
@@ -117,7 +117,7 @@ namespace QuantLib {
         return lambda_*(integral-r);
     }
 
-    std::vector<SparseMatrix> FdmBatesOp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmBatesOp::toCsrMatrixDecomp() const {
         QL_FAIL("not implemented");
     }
 
@@ -112,8 +112,8 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmBlackScholesFwdOp::toMatrixDecomp() const {
-        return std::vector<SparseMatrix>(1, mapT_.toMatrix());
+    std::vector<CsrMatrix> FdmBlackScholesFwdOp::toCsrMatrixDecomp() const {
+        return std::vector<CsrMatrix>(1, mapT_.toCsrMatrix());
     }
 
 }
@@ -54,13 +54,17 @@ namespace QuantLib {
 
         if (localVol_ != nullptr) {
             Array v(mesher_->layout()->size());
-            for (const auto& iter : *mesher_->layout()) {
-                const Size i = iter.index();
-
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
+            if (illegalLocalVolOverwrite_ < 0.0) {
+                // the whole slice at once, so that the local vol can
+                // share the strike-independent part of the calculation
+                const std::vector<Volatility> vols = localVol_->localVols(
+                    0.5*(t1+t2), std::vector<Real>(x_.begin(), x_.end()), true);
+                for (Size i=0; i < v.size(); ++i)
+                    v[i] = squared(vols[i]);
+            }
+            else {
+                for (const auto& iter : *mesher_->layout()) {
+                    const Size i = iter.index();
                     try {
                         v[i] = squared(localVol_->localVol(0.5*(t1+t2), x_[i], true));
                     } catch (Error&) {
@@ -130,8 +134,8 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmBlackScholesOp::toMatrixDecomp() const {
-        return std::vector<SparseMatrix>(1, mapT_.toMatrix());
+    std::vector<CsrMatrix> FdmBlackScholesOp::toCsrMatrixDecomp() const {
+        return std::vector<CsrMatrix>(1, mapT_.toCsrMatrix());
     }
 
 }
@@ -79,8 +79,8 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmCEVOp::toMatrixDecomp() const {
-        return std::vector<SparseMatrix>(1, mapT_.toMatrix());
+    std::vector<CsrMatrix> FdmCEVOp::toCsrMatrixDecomp() const {
+        return std::vector<CsrMatrix>(1, mapT_.toCsrMatrix());
     }
 
 }
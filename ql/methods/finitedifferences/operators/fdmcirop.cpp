@@ -164,11 +164,11 @@ namespace QuantLib {
         return solve_splitting(1, solve_splitting(0, r, dt), dt) ;
     }
 
-    std::vector<SparseMatrix> FdmCIROp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmCIROp::toCsrMatrixDecomp() const {
         return {
-            dxMap_.getMap().toMatrix(),
-            dyMap_.getMap().toMatrix(),
-            dzMap_.getMap().toMatrix()
+            dxMap_.getMap().toCsrMatrix(),
+            dyMap_.getMap().toCsrMatrix(),
+            dzMap_.getMap().toCsrMatrix()
         };
     }
 
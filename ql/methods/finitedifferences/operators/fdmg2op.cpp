@@ -106,11 +106,11 @@ namespace QuantLib {
         return solve_splitting(direction1_, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmG2Op::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmG2Op::toCsrMatrixDecomp() const {
         return {
-            mapX_.toMatrix(),
-            mapY_.toMatrix(),
-            corrMap_.toMatrix()
+            mapX_.toCsrMatrix(),
+            mapY_.toCsrMatrix(),
+            corrMap_.toCsrMatrix()
         };
     }
 
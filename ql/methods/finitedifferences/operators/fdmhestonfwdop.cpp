@@ -216,13 +216,13 @@ namespace QuantLib {
         return v;
     }
 
-    std::vector<SparseMatrix> FdmHestonFwdOp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmHestonFwdOp::toCsrMatrixDecomp() const {
 
-        std::vector<SparseMatrix> retVal(3);
+        std::vector<CsrMatrix> retVal(3);
 
-        retVal[0] = mapX_->toMatrix();
-        retVal[1] = mapY_->toMatrix();
-        retVal[2] = correlation_->toMatrix();
+        retVal[0] = mapX_->toCsrMatrix();
+        retVal[1] = mapY_->toCsrMatrix();
+        retVal[2] = correlation_->toCsrMatrix();
 
         return retVal;
     }
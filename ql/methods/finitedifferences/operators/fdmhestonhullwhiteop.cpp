@@ -141,12 +141,12 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmHestonHullWhiteOp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmHestonHullWhiteOp::toCsrMatrixDecomp() const {
         return {
-            dxMap_.getMap().toMatrix(),
-            dyMap_.toMatrix(),
-            hullWhiteOp_.toMatrixDecomp().front(),
-            hestonCorrMap_.toMatrix() + equityIrCorrMap_.toMatrix()
+            dxMap_.getMap().toCsrMatrix(),
+            dyMap_.toCsrMatrix(),
+            hullWhiteOp_.toCsrMatrixDecomp().front(),
+            hestonCorrMap_.toCsrMatrix() + equityIrCorrMap_.toCsrMatrix()
         };
     }
 
@@ -185,11 +185,11 @@ namespace QuantLib {
         return solve_splitting(1, solve_splitting(0, r, dt), dt) ;
     }
 
-    std::vector<SparseMatrix> FdmHestonOp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmHestonOp::toCsrMatrixDecomp() const {
         return {
-            dxMap_.getMap().toMatrix(),
-            dyMap_.getMap().toMatrix(),
-            correlationMap_.toMatrix()
+            dxMap_.getMap().toCsrMatrix(),
+            dyMap_.getMap().toCsrMatrix(),
+            correlationMap_.toCsrMatrix()
         };
     }
 
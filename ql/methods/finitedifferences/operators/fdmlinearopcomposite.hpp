@@ -26,6 +26,7 @@
 #ifndef quantlib_fdm_affine_map_composite_hpp
 #define quantlib_fdm_affine_map_composite_hpp
 
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/sparsematrix.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearop.hpp>
 #include <numeric>
@@ -45,14 +46,28 @@ namespace QuantLib {
         virtual Array solve_splitting(Size direction, const Array& r, Real s) const = 0;
         virtual Array preconditioner(const Array& r, Real s) const = 0;
 
+        //! the default implementation converts the CSR decomposition
         virtual std::vector<SparseMatrix> toMatrixDecomp() const {
-            QL_FAIL(" ublas representation is not implemented");
+            const std::vector<CsrMatrix> dcmp = toCsrMatrixDecomp();
+            std::vector<SparseMatrix> retVal;
+            retVal.reserve(dcmp.size());
+            for (const auto& m : dcmp)
+                retVal.push_back(m.toSparseMatrix());
+            return retVal;
+        }
+
+        virtual std::vector<CsrMatrix> toCsrMatrixDecomp() const {
+            QL_FAIL("CSR representation is not implemented");
         }
 
         SparseMatrix toMatrix() const override {
-            const std::vector<SparseMatrix> dcmp = toMatrixDecomp();
+            return toCsrMatrix().toSparseMatrix();
+        }
+
+        CsrMatrix toCsrMatrix() const override {
+            const std::vector<CsrMatrix> dcmp = toCsrMatrixDecomp();
             return std::accumulate(dcmp.begin()+1, dcmp.end(),
-                                   SparseMatrix(dcmp.front()));
+                                   CsrMatrix(dcmp.front()));
         }
 
     };
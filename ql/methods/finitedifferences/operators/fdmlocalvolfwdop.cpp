@@ -85,8 +85,8 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmLocalVolFwdOp::toMatrixDecomp() const {
-        return std::vector<SparseMatrix>(1, mapT_.toMatrix());
+    std::vector<CsrMatrix> FdmLocalVolFwdOp::toCsrMatrixDecomp() const {
+        return std::vector<CsrMatrix>(1, mapT_.toCsrMatrix());
     }
 
 }
@@ -96,11 +96,11 @@ namespace QuantLib {
         return solve_splitting(1, solve_splitting(0, r, dt), dt) ;
     }
 
-    std::vector<SparseMatrix> FdmSabrOp::toMatrixDecomp() const {
+    std::vector<CsrMatrix> FdmSabrOp::toCsrMatrixDecomp() const {
         return {
-            mapA_.toMatrix(),
-            mapF_.toMatrix(),
-            correlationMap_.toMatrix()
+            mapA_.toCsrMatrix(),
+            mapF_.toCsrMatrix(),
+            correlationMap_.toCsrMatrix()
         };
     }
 
@@ -320,8 +320,8 @@ namespace QuantLib {
         return solve_splitting(direction_, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmSquareRootFwdOp::toMatrixDecomp() const {
-        return std::vector<SparseMatrix>(1, mapX_->toMatrix());
+    std::vector<CsrMatrix> FdmSquareRootFwdOp::toCsrMatrixDecomp() const {
+        return std::vector<CsrMatrix>(1, mapX_->toCsrMatrix());
     }
 
 }
@@ -82,12 +82,12 @@ namespace QuantLib {
         return solve_splitting(0, r, dt);
     }
 
-    std::vector<SparseMatrix> FdmWienerOp::toMatrixDecomp() const {
-        std::vector<SparseMatrix> retVal;
+    std::vector<CsrMatrix> FdmWienerOp::toCsrMatrixDecomp() const {
+        std::vector<CsrMatrix> retVal;
 
         retVal.reserve(ops_.size());
         for (const auto& op: ops_)
-            retVal.push_back(op->toMatrix());
+            retVal.push_back(op->toCsrMatrix());
 
         return retVal;
     }
@@ -121,8 +121,9 @@ namespace QuantLib {
         const Size *i10(i10_.get()),                   *i12(i12_.get());
         const Size *i20(i20_.get()), *i21(i21_.get()), *i22(i22_.get());
 
-        //#pragma omp parallel for
-        for (Size i=0; i < retVal.size(); ++i) {
+        const long size = long(retVal.size());
+        #pragma omp parallel for if(size > 10000)
+        for (long i=0; i < size; ++i) {
             retVal[i] =   a00[i]*u[i00[i]]
                         + a01[i]*u[i01[i]]
                         + a02[i]*u[i02[i]]
@@ -137,22 +138,26 @@ namespace QuantLib {
     }
 
     SparseMatrix NinePointLinearOp::toMatrix() const {
+        return toCsrMatrix().toSparseMatrix();
+    }
+
+    CsrMatrix NinePointLinearOp::toCsrMatrix() const {
         const Size n = mesher_->layout()->size();
 
-        SparseMatrix retVal(n, n, 9*n);
+        CsrMatrix::Builder builder(n, n, 9*n);
         for (Size i=0; i < mesher_->layout()->size(); ++i) {
-            retVal(i, i00_[i]) += a00_[i];
-            retVal(i, i01_[i]) += a01_[i];
-            retVal(i, i02_[i]) += a02_[i];
-            retVal(i, i10_[i]) += a10_[i];
-            retVal(i, i      ) += a11_[i];
-            retVal(i, i12_[i]) += a12_[i];
-            retVal(i, i20_[i]) += a20_[i];
-            retVal(i, i21_[i]) += a21_[i];
-            retVal(i, i22_[i]) += a22_[i];
+            builder.add(i, i00_[i], a00_[i]);
+            builder.add(i, i01_[i], a01_[i]);
+            builder.add(i, i02_[i], a02_[i]);
+            builder.add(i, i10_[i], a10_[i]);
+            builder.add(i, i,       a11_[i]);
+            builder.add(i, i12_[i], a12_[i]);
+            builder.add(i, i20_[i], a20_[i]);
+            builder.add(i, i21_[i], a21_[i]);
+            builder.add(i, i22_[i], a22_[i]);
         }
 
-        return retVal;
+        return builder.matrix();
     }
 
 
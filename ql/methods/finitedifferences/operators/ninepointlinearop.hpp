@@ -50,6 +50,7 @@ namespace QuantLib {
         void swap(NinePointLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CsrMatrix toCsrMatrix() const override;
 
       protected:
         NinePointLinearOp() = default;
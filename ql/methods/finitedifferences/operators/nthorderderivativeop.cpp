@@ -31,8 +31,7 @@ namespace QuantLib {
 
     NthOrderDerivativeOp::NthOrderDerivativeOp(
         Size direction, Size order, Integer nPoints,
-        const ext::shared_ptr<FdmMesher>& mesher)
-    : m_(mesher->layout()->size(), mesher->layout()->size()) {
+        const ext::shared_ptr<FdmMesher>& mesher) {
 
         const Integer hPoints = nPoints/2;
         const bool isEven = (nPoints == 2*hPoints);
@@ -49,6 +48,9 @@ namespace QuantLib {
         QL_REQUIRE(nPoints > 1 && Integer(nPoints) <= nx,
              "inconsistent number of points");
 
+        const Size n = mesher->layout()->size();
+        CsrMatrix::Builder builder(n, n, n*nPoints);
+
         Array xOffsets(nPoints);
         const std::function<Real(Real)> emptyFct;
 
@@ -71,9 +73,11 @@ namespace QuantLib {
             for (Integer j=0; j < nPoints; ++j) {
                 const Size k = mesher->layout()->neighbourhood(iter, direction, ilx - ix + j);
 
-                m_(i, k) = weights[j];
+                builder.add(i, k, weights[j]);
             }
         }
+
+        m_ = builder.matrix();
     }
 
     NthOrderDerivativeOp::array_type NthOrderDerivativeOp::apply(const array_type& r) const {
@@ -82,6 +86,10 @@ namespace QuantLib {
 
 
     SparseMatrix NthOrderDerivativeOp::toMatrix() const {
+        return m_.toSparseMatrix();
+    }
+
+    CsrMatrix NthOrderDerivativeOp::toCsrMatrix() const {
         return m_;
     }
 
@@ -37,9 +37,10 @@ namespace QuantLib {
 
         array_type apply(const array_type& r) const override;
         SparseMatrix toMatrix() const override;
+        CsrMatrix toCsrMatrix() const override;
 
       private:
-        SparseMatrix m_;
+        CsrMatrix m_;
     };
 }
 
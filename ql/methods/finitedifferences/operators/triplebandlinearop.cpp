@@ -233,9 +233,10 @@ namespace QuantLib {
         const auto* i0ptr = i0_.get();
         const auto* i2ptr = i2_.get();
 
+        const long size = long(mesher_->layout()->size());
         array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (auto i=0U; i < mesher_->layout()->size(); ++i) {
+        #pragma omp parallel for if(size > 10000)
+        for (long i=0; i < size; ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
 
@@ -243,16 +244,20 @@ namespace QuantLib {
     }
 
     SparseMatrix TripleBandLinearOp::toMatrix() const {
+        return toCsrMatrix().toSparseMatrix();
+    }
+
+    CsrMatrix TripleBandLinearOp::toCsrMatrix() const {
         const auto n = mesher_->layout()->size();
 
-        SparseMatrix retVal(n, n, 3*n);
+        CsrMatrix::Builder builder(n, n, 3*n);
         for (auto i=0U; i < n; ++i) {
-            retVal(i, i0_[i]) += lower_[i];
-            retVal(i, i     ) += diag_[i];
-            retVal(i, i2_[i]) += upper_[i];
+            builder.add(i, i0_[i], lower_[i]);
+            builder.add(i, i,      diag_[i]);
+            builder.add(i, i2_[i], upper_[i]);
         }
 
-        return retVal;
+        return builder.matrix();
     }
 
 
@@ -273,41 +278,60 @@ namespace QuantLib {
         const auto* dptr = diag_.get();
         const auto* uptr = upper_.get();
 
-        // Thomas algorithm to solve a tridiagonal system.
+        // Thomas algorithm to solve a tridiagonal system.  Since the
+        // operator doesn't couple different lines along the direction,
+        // each line is an independent system and they can be solved
+        // concurrently; the arithmetic is the same as for a single
+        // sweep over the whole grid.
         const auto size = mesher_->layout()->size();
-        const auto solve = [&](const auto& index) {
-            Array result(size);
+        const auto n = mesher_->layout()->dim()[direction_];
+        const auto nLines = long(size / n);
+        Array result(size);
 
-            auto previous = index(0);
-            auto beta = a*dptr[previous] + b;
-            QL_REQUIRE(beta != 0.0, "division by zero");
-            beta = 1.0 / beta;
-            result[previous] = r[previous] * beta;
+        const auto solve = [&](const auto& index) {
+            bool singular = false;
 
-            for (auto j=1U; j<size; ++j) {
-                const auto current = index(j);
-                temp_[j] = a * uptr[previous] * beta;
+            #pragma omp parallel for reduction(||:singular) if(nLines > 1 && size > 10000)
+            for (long line=0; line < nLines; ++line) {
+                const Size first = line*n, last = first + n;
 
-                beta = b + a * (dptr[current] - temp_[j] * lptr[current]);
-                QL_ENSURE(beta != 0.0, "division by zero");
+                auto previous = index(first);
+                auto beta = a*dptr[previous] + b;
+                if (beta == 0.0) {
+                    singular = true;
+                    continue;
+                }
                 beta = 1.0 / beta;
+                result[previous] = r[previous] * beta;
+
+                for (auto j=first+1; j<last; ++j) {
+                    const auto current = index(j);
+                    temp_[j] = a * uptr[previous] * beta;
+
+                    beta = b + a * (dptr[current] - temp_[j] * lptr[current]);
+                    if (beta == 0.0) {
+                        singular = true;
+                        break;
+                    }
+                    beta = 1.0 / beta;
+
+                    result[current] =
+                        (r[current] - a*lptr[current]*result[previous]) * beta;
+                    previous = current;
+                }
 
-                result[current] =
-                    (r[current] - a*lptr[current]*result[previous]) * beta;
-                previous = current;
+                for (auto j=last-1; j>first; --j)
+                    result[index(j-1)] -= temp_[j] * result[index(j)];
             }
-
-            // j cannot be greater than or equal to zero when Size is unsigned.
-            for (auto j=size-2; j>0; --j)
-                result[index(j)] -= temp_[j+1] * result[index(j+1)];
-            result[index(0)] -= temp_[1] * result[index(1)];
-
-            return result;
+            QL_ENSURE(!singular, "division by zero");
         };
 
         // The first direction follows storage order and needs no index lookup.
         if (direction_ == 0)
-            return solve([](Size i) { return i; });
-        return solve([this](Size i) { return reverseIndex_[i]; });
+            solve([](Size i) { return i; });
+        else
+            solve([this](Size i) { return reverseIndex_[i]; });
+
+        return result;
     }
 }
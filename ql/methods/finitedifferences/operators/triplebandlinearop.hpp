@@ -62,6 +62,7 @@ namespace QuantLib {
         void swap(TripleBandLinearOp& m) noexcept;
 
         SparseMatrix toMatrix() const override;
+        CsrMatrix toCsrMatrix() const override;
 
       protected:
         TripleBandLinearOp() = default;
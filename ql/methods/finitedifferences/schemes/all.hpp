@@ -11,4 +11,5 @@
 #include <ql/methods/finitedifferences/schemes/methodoflinesscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/trbdf2scheme.hpp>
+#include <ql/methods/finitedifferences/schemes/warmstartschemehelper.hpp>
 
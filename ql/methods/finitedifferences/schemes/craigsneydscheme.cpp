@@ -37,22 +37,27 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
+        Array y = map_->apply(a);
+        MultiplyAdd(a, dt_, y, y);
         bcSet_.applyAfterApplying(y);
 
         auto y0 = y;
 
         for (auto i=0U; i < map_->size(); ++i) {
-            auto rhs = y - theta_*dt_*map_->apply_direction(i, a);
+            Array rhs = map_->apply_direction(i, a);
+            MultiplyAdd(y, -theta_*dt_, rhs, rhs);
             y = map_->solve_splitting(i, rhs, -theta_*dt_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        auto yt = y0 + mu_*dt_*map_->apply_mixed(y-a);
+        Axpy(-1.0, a, y);
+        Array yt = map_->apply_mixed(y);
+        MultiplyAdd(y0, mu_*dt_, yt, yt);
         bcSet_.applyAfterApplying(yt);
 
         for (auto i=0U; i < map_->size(); ++i) {
-            auto rhs = yt - theta_*dt_*map_->apply_direction(i, a);
+            Array rhs = map_->apply_direction(i, a);
+            MultiplyAdd(yt, -theta_*dt_, rhs, rhs);
             yt = map_->solve_splitting(i, rhs, -theta_*dt_);
         }
         bcSet_.applyAfterSolving(yt);
@@ -34,11 +34,13 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
+        Array y = map_->apply(a);
+        MultiplyAdd(a, dt_, y, y);
         bcSet_.applyAfterApplying(y);
 
         for (auto i=0U; i < map_->size(); ++i) {
-            auto rhs = y - theta_*dt_*map_->apply_direction(i, a);
+            Array rhs = map_->apply_direction(i, a);
+            MultiplyAdd(y, -theta_*dt_, rhs, rhs);
             y = map_->solve_splitting(i, rhs, -theta_*dt_);
         }
         bcSet_.applyAfterSolving(y);
@@ -37,7 +37,7 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        a += (theta*dt_) * map_->apply(a);
+        Axpy(theta*dt_, map_->apply(a), a);
         bcSet_.applyAfterApplying(a);
     }
 
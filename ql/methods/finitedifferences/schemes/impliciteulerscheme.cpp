@@ -56,21 +56,25 @@ namespace QuantLib {
             auto preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -theta*dt_); };
             auto applyF = [&](const Array& _a){ return apply(_a, theta); };
 
+            const Array guess = warmStart_.guess(a, theta*dt_);
+
             if (solverType_ == BiCGstab) {
                 const BiCGStabResult result =
                     QuantLib::BiCGstab(applyF, std::max(Size(10), a.size()),
-                        relTol_, preconditioner).solve(a, a);
+                        relTol_, preconditioner).solve(a, guess);
 
                 (*iterations_) += result.iterations;
+                warmStart_.update(a, result.x, theta*dt_);
                 a = result.x;
             }
             else if (solverType_ == GMRES) {
                 const GMRESResult result =
                     QuantLib::GMRES(applyF, std::max(Size(10), a.size() / 10U), relTol_,
                                     preconditioner)
-                        .solve(a, a);
+                        .solve(a, guess);
 
                 (*iterations_) += result.errors.size();
+                warmStart_.update(a, result.x, theta*dt_);
                 a = result.x;
             }
             else
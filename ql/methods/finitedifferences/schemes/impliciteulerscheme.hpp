@@ -29,6 +29,7 @@
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/schemes/boundaryconditionschemehelper.hpp>
+#include <ql/methods/finitedifferences/schemes/warmstartschemehelper.hpp>
 
 namespace QuantLib {
 
@@ -66,6 +67,7 @@ namespace QuantLib {
         const ext::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
         const SolverType solverType_;
+        WarmStartSchemeHelper warmStart_;
     };
 }
 
@@ -30,6 +30,7 @@
 #include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
 #include <ql/methods/finitedifferences/operatortraits.hpp>
 #include <ql/methods/finitedifferences/schemes/boundaryconditionschemehelper.hpp>
+#include <ql/methods/finitedifferences/schemes/warmstartschemehelper.hpp>
 #include <functional>
 #include <utility>
 
@@ -72,6 +73,7 @@ namespace QuantLib {
         const BoundaryConditionSchemeHelper bcSet_;
         const Real relTol_;
         const SolverType solverType_;
+        WarmStartSchemeHelper warmStart_;
     };
 
     template <class TrapezoidalScheme>
@@ -125,20 +127,24 @@ namespace QuantLib {
             auto preconditioner = [&](const Array& _a){ return map_->preconditioner(_a, -beta_); };
             auto applyF = [&](const Array& _a){ return apply(_a); };
 
+            const Array guess = warmStart_.guess(f, beta_);
+
             if (solverType_ == BiCGstab) {
                 const BiCGStabResult result =
                     QuantLib::BiCGstab(applyF, std::max(Size(10), fn.size()),
-                        relTol_, preconditioner).solve(f, f);
+                        relTol_, preconditioner).solve(f, guess);
 
                 (*iterations_) += result.iterations;
+                warmStart_.update(f, result.x, beta_);
                 fn = result.x;
             } else if (solverType_ == GMRES) {
                 const GMRESResult result =
                     QuantLib::GMRES(applyF, std::max(Size(10), fn.size() / 10U), relTol_,
                                     preconditioner)
-                        .solve(f, f);
+                        .solve(f, guess);
 
                 (*iterations_) += result.errors.size();
+                warmStart_.update(f, result.x, beta_);
                 fn = result.x;
             }
             else
@@ -0,0 +1,56 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file warmstartschemehelper.hpp
+    \brief initial guesses for the iterative solvers of implicit schemes
+*/
+
+#ifndef quantlib_warm_start_scheme_helper_hpp
+#define quantlib_warm_start_scheme_helper_hpp
+
+#include <ql/math/array.hpp>
+#include <ql/utilities/null.hpp>
+
+namespace QuantLib {
+
+    //! initial guesses for the iterative solvers of implicit schemes
+    /*! An implicit step solves \f$ (1 - s L) x = b \f$; the
+        correction \f$ x - b = s L x \f$ changes slowly between
+        consecutive steps, so that the one of the previous step
+        (rescaled for the current \f$ s \f$) added to \f$ b \f$ is
+        a better starting point for the solver than \f$ b \f$ alone.
+    */
+    class WarmStartSchemeHelper {
+      public:
+        Array guess(const Array& b, Real s) const {
+            if (correction_.size() != b.size() || s_ == Null<Real>() || s_ == 0.0)
+                return b;
+            return b + (s/s_)*correction_;
+        }
+        void update(const Array& b, const Array& x, Real s) {
+            correction_ = x - b;
+            s_ = s;
+        }
+
+      private:
+        Array correction_;
+        Real s_ = Null<Real>();
+    };
+
+}
+
+#endif
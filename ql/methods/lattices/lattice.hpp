@@ -28,6 +28,9 @@
 #include <ql/numericalmethod.hpp>
 #include <ql/discretizedasset.hpp>
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 
 namespace QuantLib {
 
@@ -51,6 +54,12 @@ namespace QuantLib {
                         Array& newValues) const;
         \endcode
 
+        The descendants and probabilities of the nodes are assumed not
+        to change once the lattice is built; the default stepback
+        caches them in flat tables for each level the first time the
+        level is used.  Discount factors are not cached, since they
+        can depend on parameters being fitted.
+
         \ingroup lattices
     */
     template <class Impl>
@@ -70,6 +79,14 @@ namespace QuantLib {
         void initialize(DiscretizedAsset&, Time t) const override;
         void rollback(DiscretizedAsset&, Time to) const override;
         void partialRollback(DiscretizedAsset&, Time to) const override;
+        /*! Rolls back the assets together; the discount factors at
+            each step are computed once for all of them.
+
+            If the derived class defines its own stepback, the
+            assets are rolled back one by one through it instead.
+        */
+        void rollbackAll(const std::vector<DiscretizedAsset*>& assets,
+                         Time to) const override;
         //! Computes the present value of an asset using Arrow-Debrew prices
         Real presentValue(DiscretizedAsset&) const override;
         //@}
@@ -80,6 +97,12 @@ namespace QuantLib {
                       const Array& values,
                       Array& newValues) const;
 
+        /*! levels with at least this number of nodes are rolled back
+            in parallel when OpenMP is enabled; on smaller levels, the
+            overhead of starting the threads is not repaid.
+        */
+        static constexpr Size parallelStepbackThreshold = 2048;
+
       protected:
         void computeStatePrices(Size until) const;
 
@@ -87,8 +110,25 @@ namespace QuantLib {
         mutable std::vector<Array> statePrices_;
 
       private:
+        // descendants and probabilities of the nodes at a level,
+        // stored branch by branch (the entry for node j and branch l
+        // is at l*size+j) so that they can be accessed sequentially
+        struct Level {
+            std::vector<Size> descendants;
+            std::vector<Real> probabilities;
+        };
+        const Level& level(Size i) const;
+        // sets the undiscounted expected values for nodes [begin,end)
+        void expectedValues(const Level& branching, Size size,
+                            Size begin, Size end,
+                            const Array& values, Array& newValues) const;
+
+        // number of nodes processed together during a stepback
+        static constexpr Size blockSize_ = 256;
+
         Size n_;
         mutable Size statePricesLimit_;
+        mutable std::vector<Level> levels_;
     };
 
 
@@ -98,18 +138,42 @@ namespace QuantLib {
     void TreeLattice<Impl>::computeStatePrices(Size until) const {
         for (Size i=statePricesLimit_; i<until; i++) {
             statePrices_.push_back(Array(this->impl().size(i+1), 0.0));
-            for (Size j=0; j<this->impl().size(i); j++) {
+            const Level& branching = level(i);
+            const Size size = this->impl().size(i);
+            for (Size j=0; j<size; j++) {
                 DiscountFactor disc = this->impl().discount(i,j);
                 Real statePrice = statePrices_[i][j];
                 for (Size l=0; l<n_; l++) {
-                    statePrices_[i+1][this->impl().descendant(i,j,l)] +=
-                        statePrice*disc*this->impl().probability(i,j,l);
+                    statePrices_[i+1][branching.descendants[l*size+j]] +=
+                        statePrice*disc*branching.probabilities[l*size+j];
                 }
             }
         }
         statePricesLimit_ = until;
     }
 
+    template <class Impl>
+    const typename TreeLattice<Impl>::Level&
+    TreeLattice<Impl>::level(Size i) const {
+        if (i >= levels_.size())
+            levels_.resize(i+1);
+        Level& branching = levels_[i];
+        if (branching.descendants.empty()) {
+            const Size size = this->impl().size(i);
+            branching.descendants.resize(n_*size);
+            branching.probabilities.resize(n_*size);
+            for (Size l=0; l<n_; l++) {
+                for (Size j=0; j<size; j++) {
+                    branching.descendants[l*size+j] =
+                        this->impl().descendant(i,j,l);
+                    branching.probabilities[l*size+j] =
+                        this->impl().probability(i,j,l);
+                }
+            }
+        }
+        return branching;
+    }
+
     template <class Impl>
     const Array& TreeLattice<Impl>::statePrices(Size i) const {
         if (i>statePricesLimit_)
@@ -152,29 +216,138 @@ namespace QuantLib {
         auto iFrom = Integer(t_.index(from));
         auto iTo = Integer(t_.index(to));
 
+        // the buffer is swapped with the asset values at each step,
+        // so that the storage is reused as the levels get smaller
+        Array newValues;
         for (Integer i=iFrom-1; i>=iTo; --i) {
-            Array newValues(this->impl().size(i));
+            Size size = this->impl().size(i);
+            if (newValues.size() < size)
+                newValues = Array(size);
+            else
+                newValues.resize(size);
             this->impl().stepback(i, asset.values(), newValues);
             asset.time() = t_[i];
-            asset.values() = newValues;
+            asset.values().swap(newValues);
             // skip the very last adjustment
             if (i != iTo)
                 asset.adjustValues();
         }
     }
 
+    template <class Impl>
+    void TreeLattice<Impl>::rollbackAll(
+                                const std::vector<DiscretizedAsset*>& assets,
+                                Time to) const {
+
+        // the joint rollback below reproduces the default stepback;
+        // derived classes defining their own must be used as they are
+        if constexpr (!std::is_same<decltype(&Impl::stepback),
+                                    decltype(&TreeLattice::stepback)>::value) {
+            Lattice::rollbackAll(assets, to);
+            return;
+        }
+
+        const Size n = assets.size();
+        auto iTo = Integer(t_.index(to));
+        Integer iFrom = iTo;
+        // current time index of each asset
+        std::vector<Integer> positions(n);
+        for (Size k=0; k<n; ++k) {
+            QL_REQUIRE(assets[k]->method().get() == this,
+                       "asset #" << k+1 << " not initialized on this lattice");
+            Time from = assets[k]->time();
+            QL_REQUIRE(from > to || close(from,to),
+                       "cannot roll asset #" << k+1 << " back to " << to
+                       << " (it is already at t = " << from << ")");
+            positions[k] = close(from,to) ? iTo : Integer(t_.index(from));
+            iFrom = std::max(iFrom, positions[k]);
+        }
+
+        std::vector<Array> buffers(n);
+        std::vector<Size> active;
+        active.reserve(n);
+        Array discounts;
+        for (Integer i=iFrom-1; i>=iTo; --i) {
+            // assets join the others when the rollback reaches them
+            active.clear();
+            for (Size k=0; k<n; ++k) {
+                if (positions[k] > i)
+                    active.push_back(k);
+            }
+
+            const Size size = this->impl().size(i);
+            if (discounts.size() < size)
+                discounts = Array(size);
+            else
+                discounts.resize(size);
+            #pragma omp parallel for if(size >= parallelStepbackThreshold)
+            for (long j=0; j<(long)size; j++)
+                discounts[j] = this->impl().discount(i,j);
+            for (Size k : active) {
+                if (buffers[k].size() < size)
+                    buffers[k] = Array(size);
+                else
+                    buffers[k].resize(size);
+            }
+
+            const Level& branching = level(i);
+            const auto blocks = (long)((size + blockSize_ - 1) / blockSize_);
+            #pragma omp parallel for if(size*active.size() >= parallelStepbackThreshold)
+            for (long b=0; b<blocks; b++) {
+                const Size begin = b*blockSize_;
+                const Size end = std::min(begin + blockSize_, size);
+                for (Size k : active) {
+                    Array& newValues = buffers[k];
+                    expectedValues(branching, size, begin, end,
+                                   assets[k]->values(), newValues);
+                    for (Size j=begin; j<end; j++)
+                        newValues[j] *= discounts[j];
+                }
+            }
+
+            for (Size k : active) {
+                assets[k]->time() = t_[i];
+                assets[k]->values().swap(buffers[k]);
+                positions[k] = i;
+                // skip the very last adjustment...
+                if (i != iTo)
+                    assets[k]->adjustValues();
+            }
+        }
+
+        // ...which is performed here for all assets
+        for (auto* asset : assets)
+            asset->adjustValues();
+    }
+
     template <class Impl>
     void TreeLattice<Impl>::stepback(Size i, const Array& values,
                                      Array& newValues) const {
-        #pragma omp parallel for
-        for (long j=0; j<(long)this->impl().size(i); j++) {
-            Real value = 0.0;
-            for (Size l=0; l<n_; l++) {
-                value += this->impl().probability(i,j,l) *
-                         values[this->impl().descendant(i,j,l)];
-            }
-            value *= this->impl().discount(i,j);
-            newValues[j] = value;
+        const Level& branching = level(i);
+        const Size size = this->impl().size(i);
+        const auto blocks = (long)((size + blockSize_ - 1) / blockSize_);
+        #pragma omp parallel for if(size >= parallelStepbackThreshold)
+        for (long k=0; k<blocks; k++) {
+            const Size begin = k*blockSize_;
+            const Size end = std::min(begin + blockSize_, size);
+            expectedValues(branching, size, begin, end, values, newValues);
+            for (Size j=begin; j<end; j++)
+                newValues[j] *= this->impl().discount(i,j);
+        }
+    }
+
+    template <class Impl>
+    inline void TreeLattice<Impl>::expectedValues(const Level& branching,
+                                                  Size size,
+                                                  Size begin, Size end,
+                                                  const Array& values,
+                                                  Array& newValues) const {
+        std::fill(newValues.begin() + begin, newValues.begin() + end, 0.0);
+        for (Size l=0; l<n_; l++) {
+            const Size* descendants = &branching.descendants[l*size];
+            const Real* probabilities = &branching.probabilities[l*size];
+            for (Size j=begin; j<end; j++)
+                newValues[j] += probabilities[j] * values[descendants[j]];
         }
     }
 
@@ -25,8 +25,10 @@
 #ifndef quantlib_montecarlo_model_hpp
 #define quantlib_montecarlo_model_hpp
 
+#include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/shared_ptr.hpp>
 #include <utility>
 
@@ -46,6 +48,12 @@ namespace QuantLib {
         provide the additional control option, namely the option path
         pricer and the option value.
 
+        An optional greeks path pricer can also be passed; it is
+        called on the same paths as the main pricer and returns the
+        pathwise or likelihood-ratio estimators of a number of
+        sensitivities, which are accumulated separately.  Control
+        variates are not applied to them.
+
         \ingroup mcarlo
     */
     template <template <class> class MC, class RNG, class S = Statistics>
@@ -58,6 +66,9 @@ namespace QuantLib {
         typedef typename path_generator_type::sample_type sample_type;
         typedef typename path_pricer_type::result_type result_type;
         typedef S stats_type;
+        typedef PathPricer<typename sample_type::value_type, Array>
+            greeks_pricer_type;
+        typedef SequenceStatistics greeks_stats_type;
         // constructor
         MonteCarloModel(
             ext::shared_ptr<path_generator_type> pathGenerator,
@@ -67,15 +78,23 @@ namespace QuantLib {
             ext::shared_ptr<path_pricer_type> cvPathPricer = ext::shared_ptr<path_pricer_type>(),
             result_type cvOptionValue = result_type(),
             ext::shared_ptr<path_generator_type> cvPathGenerator =
-                ext::shared_ptr<path_generator_type>())
+                ext::shared_ptr<path_generator_type>(),
+            ext::shared_ptr<greeks_pricer_type> greeksPathPricer =
+                ext::shared_ptr<greeks_pricer_type>())
         : pathGenerator_(std::move(pathGenerator)), pathPricer_(std::move(pathPricer)),
           sampleAccumulator_(std::move(sampleAccumulator)), isAntitheticVariate_(antitheticVariate),
           cvPathPricer_(std::move(cvPathPricer)), cvOptionValue_(cvOptionValue),
-          cvPathGenerator_(std::move(cvPathGenerator)) {
+          cvPathGenerator_(std::move(cvPathGenerator)),
+          greeksPathPricer_(std::move(greeksPathPricer)) {
             isControlVariate_ = static_cast<bool>(cvPathPricer_);
+            if (greeksPathPricer_)
+                greeksAccumulator_ = ext::make_shared<greeks_stats_type>();
         }
         void addSamples(Size samples);
         const stats_type& sampleAccumulator() const;
+        //! whether greeks are being accumulated
+        bool hasGreeks() const { return static_cast<bool>(greeksPathPricer_); }
+        const greeks_stats_type& greeksAccumulator() const;
       private:
         ext::shared_ptr<path_generator_type> pathGenerator_;
         ext::shared_ptr<path_pricer_type> pathPricer_;
@@ -85,6 +104,8 @@ namespace QuantLib {
         result_type cvOptionValue_;
         bool isControlVariate_;
         ext::shared_ptr<path_generator_type> cvPathGenerator_;
+        ext::shared_ptr<greeks_pricer_type> greeksPathPricer_;
+        ext::shared_ptr<greeks_stats_type> greeksAccumulator_;
     };
 
     // inline definitions
@@ -94,6 +115,10 @@ namespace QuantLib {
 
             const sample_type& path = pathGenerator_->next();
             result_type price = (*pathPricer_)(path.value);
+            // the path is overwritten by the antithetic one below
+            Array greeks;
+            if (greeksPathPricer_)
+                greeks = (*greeksPathPricer_)(path.value);
 
             if (isControlVariate_) {
                 if (!cvPathGenerator_) {
@@ -118,8 +143,15 @@ namespace QuantLib {
                 }
 
                 sampleAccumulator_.add((price+price2)/2.0, path.weight);
+                if (greeksPathPricer_) {
+                    greeks += (*greeksPathPricer_)(atPath.value);
+                    greeks /= 2.0;
+                    greeksAccumulator_->add(greeks, path.weight);
+                }
             } else {
                 sampleAccumulator_.add(price, path.weight);
+                if (greeksPathPricer_)
+                    greeksAccumulator_->add(greeks, path.weight);
             }
         }
     }
@@ -130,6 +162,13 @@ namespace QuantLib {
         return sampleAccumulator_;
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MonteCarloModel<MC,RNG,S>::greeks_stats_type&
+    MonteCarloModel<MC,RNG,S>::greeksAccumulator() const {
+        QL_REQUIRE(greeksAccumulator_, "greeks not requested");
+        return *greeksAccumulator_;
+    }
+
 }
 
 
@@ -460,7 +460,12 @@ namespace QuantLib {
                 const ext::shared_ptr<FdmScheme> fdmScheme(
                     fdmSchemeFactory(fdmSchemeDesc, hestonFwdOp));
 
-                for (Size j=0; j < x.size(); ++j) {
+                const std::vector<Volatility> localVols = localVol_->localVols(
+                    t, std::vector<Real>(x.begin(), x.end()));
+
+                // the x-slices are independent of each other
+                #pragma omp parallel for if(x.size()*vGrid > 10000)
+                for (long j=0; j < long(x.size()); ++j) {
                     Array pSlice(vGrid);
                     for (Size k=0; k < vGrid; ++k)
                         pSlice[k] = pn[j + k*xGrid];
@@ -476,15 +481,14 @@ namespace QuantLib {
                       : DiscreteSimpsonIntegral()(v, v*pSlice);
 
                     const Real scale = pInt/vpInt;
-                    const Volatility localVol = localVol_->localVol(t, x[j]);
+                    const Volatility localVol = localVols[j];
 
                     const Real l = (scale >= 0.0)
                       ? localVol*std::sqrt(scale) : Real(1.0);
 
                     (*L)[j][i] = std::min(50.0, std::max(0.001, l));
-
-                    leverageFct->setInterpolation(Linear());
                 }
+                leverageFct->setInterpolation(Linear());
 
                 const Real sLowerBound = std::max(x.front(),
                     std::exp(localVolRND.invcdf(
@@ -149,9 +149,8 @@ namespace QuantLib {
             const Time t = timeGrid_->at(n-1);
             const Time dt = timeGrid_->dt(n-1);
 
-            Array x0(2), dw(2);
-
-            for (Size i=0; i < calibrationPaths_; ++i) {
+            const auto evolve = [&](Size i) {
+                Array x0(2), dw(2);
                 x0[0] = pairs[i].first;
                 x0[1] = pairs[i].second;
 
@@ -162,27 +161,39 @@ namespace QuantLib {
 
                 pairs[i].first = x0[0];
                 pairs[i].second = x0[1];
-            }
+            };
+
+            // all paths are evolved in lockstep; the first one is
+            // evolved serially so that any lazy calculation in the
+            // term structures is performed before going parallel
+            evolve(0);
+            #pragma omp parallel for if(calibrationPaths_ > 1000)
+            for (long i=1; i < long(calibrationPaths_); ++i)
+                evolve(i);
 
             std::sort(pairs.begin(), pairs.end());
 
-            Size s = 0U, e = 0U;
-            for (Size i=0; i < nBins_; ++i) {
-                const Size inc = k + static_cast<unsigned long>(i < m);
-                e = s + inc;
+            // conditional expectation of the variance in each bin
+            std::vector<Real> binAverage(nBins_);
+            #pragma omp parallel for if(calibrationPaths_ > 1000)
+            for (long i=0; i < long(nBins_); ++i) {
+                const Size s = i*k + std::min(Size(i), m);
+                const Size e = s + k + static_cast<unsigned long>(Size(i) < m);
 
                 Real sum=0.0;
                 for (Size j=s; j < e; ++j) {
                     sum+=pairs[j].second;
                 }
-                sum/=inc;
+                binAverage[i] = sum/(e-s);
 
                 vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
-                (*L)[i][n] = std::sqrt(squared(localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
-
-                s = e;
             }
 
+            const std::vector<Volatility> localVols =
+                localVol_->localVols(t, *vStrikes[n], true);
+            for (Size i=0; i < nBins_; ++i)
+                (*L)[i][n] = std::sqrt(squared(localVols[i])/binAverage[i]);
+
             leverageFunction_->setInterpolation<Linear>();
         }
     }
@@ -2,6 +2,8 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
+#include <ql/models/marketmodels/batchevolver.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
 #include <ql/models/marketmodels/constrainedevolver.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
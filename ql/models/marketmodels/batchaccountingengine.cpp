@@ -0,0 +1,170 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
+#include <ql/models/marketmodels/batchevolver.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/models/marketmodels/curvestate.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    BatchAccountingEngine::BatchAccountingEngine(
+                    const ext::shared_ptr<MarketModelBatchEvolver>& evolver,
+                    const BrownianGeneratorFactory& factory,
+                    const Clone<MarketModelMultiProduct>& product,
+                    Real initialNumeraireValue,
+                    Size pathsPerBatch,
+                    Size concurrentBatches)
+    : initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      pathsPerBatch_(pathsPerBatch) {
+        QL_REQUIRE(evolver, "null evolver");
+        QL_REQUIRE(pathsPerBatch > 0, "at least one path per batch required");
+        QL_REQUIRE(concurrentBatches > 0,
+                   "at least one concurrent batch required");
+
+        generator_ = factory.create(evolver->numberOfFactors(),
+                                    evolver->numberOfSteps());
+        brownians_.resize(evolver->numberOfFactors());
+
+        const std::vector<Time>& cashFlowTimes =
+            product->possibleCashFlowTimes();
+        const std::vector<Rate>& rateTimes = product->evolution().rateTimes();
+        discounters_.reserve(cashFlowTimes.size());
+        for (Real cashFlowTime : cashFlowTimes)
+            discounters_.emplace_back(cashFlowTime, rateTimes);
+
+        batches_.resize(concurrentBatches);
+        for (Size b=0; b<concurrentBatches; ++b) {
+            Batch& batch = batches_[b];
+            batch.evolver = (b == 0 ? evolver : evolver->clone());
+            batch.products.assign(pathsPerBatch_, product);
+            batch.brownians.resize(evolver->numberOfSteps());
+            batch.numberCashFlowsThisStep.resize(numberProducts_);
+            batch.cashFlowsGenerated.resize(numberProducts_);
+            for (Size i=0; i<numberProducts_; ++i)
+                batch.cashFlowsGenerated[i].resize(
+                          product->maxNumberOfCashFlowsPerProductPerStep());
+        }
+    }
+
+    void BatchAccountingEngine::drawBrownians(Batch& batch, Size paths) {
+        if (batch.weights.size() != paths) {
+            batch.weights.resize(paths);
+            for (auto& m : batch.brownians)
+                m = Matrix(brownians_.size(), paths);
+        }
+        for (Size p=0; p<paths; ++p) {
+            Real weight = generator_->nextPath();
+            for (auto& m : batch.brownians) {
+                weight *= generator_->nextStep(brownians_);
+                std::copy(brownians_.begin(), brownians_.end(),
+                          m.column_begin(p));
+            }
+            batch.weights[p] = weight;
+        }
+    }
+
+    void BatchAccountingEngine::simulate(Batch& batch) const {
+        Size paths = batch.weights.size();
+        MarketModelBatchEvolver& evolver = *batch.evolver;
+        const std::vector<Size>& numeraires = evolver.numeraires();
+
+        evolver.startNewBatch(paths);
+        for (Size p=0; p<paths; ++p)
+            batch.products[p]->reset();
+        batch.numerairesHeld = Matrix(numberProducts_, paths, 0.0);
+        batch.principals.assign(paths, 1.0);
+        batch.done.assign(paths, false);
+
+        Size remaining = paths, step = 0;
+        while (remaining > 0) {
+            QL_REQUIRE(step < batch.brownians.size(),
+                       "product not terminated at the end of the evolution");
+            Size thisStep = evolver.currentStep();
+            evolver.advanceStep(batch.brownians[step++]);
+            Size numeraire = numeraires[thisStep];
+
+            for (Size p=0; p<paths; ++p) {
+                if (batch.done[p])
+                    continue;
+                const CurveState& state = evolver.currentState(p);
+                bool done = batch.products[p]->nextTimeStep(
+                                              state,
+                                              batch.numberCashFlowsThisStep,
+                                              batch.cashFlowsGenerated);
+                // for each product and each cash flow, convert the
+                // cash flow to numeraires as in AccountingEngine
+                for (Size i=0; i<numberProducts_; ++i) {
+                    const std::vector<MarketModelMultiProduct::CashFlow>&
+                        cashflows = batch.cashFlowsGenerated[i];
+                    for (Size j=0; j<batch.numberCashFlowsThisStep[i]; ++j) {
+                        const MarketModelDiscounter& discounter =
+                            discounters_[cashflows[j].timeIndex];
+                        Real bonds = cashflows[j].amount *
+                            discounter.numeraireBonds(state, numeraire);
+                        batch.numerairesHeld[i][p] +=
+                            bonds/batch.principals[p];
+                    }
+                }
+
+                if (done) {
+                    batch.done[p] = true;
+                    --remaining;
+                } else {
+                    Size nextNumeraire = numeraires[thisStep+1];
+                    batch.principals[p] *=
+                        state.discountRatio(numeraire, nextNumeraire);
+                }
+            }
+        }
+    }
+
+    void BatchAccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
+                                                   Size numberOfPaths) {
+        Size pathsPerRound = pathsPerBatch_ * batches_.size();
+        for (Size first=0; first<numberOfPaths; first+=pathsPerRound) {
+            Size paths = std::min(pathsPerRound, numberOfPaths-first);
+            Size nBatches = (paths + pathsPerBatch_ - 1) / pathsPerBatch_;
+
+            // random numbers are drawn serially, in path order...
+            for (Size b=0; b<nBatches; ++b)
+                drawBrownians(batches_[b],
+                              std::min(pathsPerBatch_, paths-b*pathsPerBatch_));
+
+            // ...the batches are simulated concurrently...
+            #pragma omp parallel for if(nBatches > 1)
+            for (long b=0; b<long(nBatches); ++b)
+                simulate(batches_[b]);
+
+            // ...and results are collected in path order.
+            for (Size b=0; b<nBatches; ++b) {
+                const Batch& batch = batches_[b];
+                Matrix values(batch.weights.size(), numberProducts_);
+                for (Size p=0; p<batch.weights.size(); ++p) {
+                    for (Size i=0; i<numberProducts_; ++i)
+                        values[p][i] =
+                            batch.numerairesHeld[i][p] * initialNumeraireValue_;
+                }
+                stats.addBatch(values, batch.weights);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,92 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchaccountingengine.hpp
+    \brief engine collecting cash flows along batches of market-model paths
+*/
+
+#ifndef quantlib_batch_accounting_engine_hpp
+#define quantlib_batch_accounting_engine_hpp
+
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/models/marketmodels/discounter.hpp>
+#include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/utilities/clone.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class MarketModelBatchEvolver;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Engine collecting cash flows along batches of market-model paths
+    /*! This engine works as AccountingEngine, but it evolves paths in
+        batches using a MarketModelBatchEvolver.  Each batch uses its
+        own copies of the evolver and of the product; when OpenMP is
+        enabled, a number of batches are simulated concurrently.
+
+        The Brownian increments are drawn from a single generator, in
+        the same order as AccountingEngine would, and results are
+        added to the statistics in path order; therefore, results do
+        not depend on the number of threads.  The whole path is drawn
+        in advance, though, so that products terminating early
+        consume a different number of random numbers than with
+        AccountingEngine; results will be the same only for products
+        spanning the whole evolution or with generators (such as
+        SobolBrownianGenerator) drawing whole paths anyway.
+    */
+    class BatchAccountingEngine {
+      public:
+        BatchAccountingEngine(
+            const ext::shared_ptr<MarketModelBatchEvolver>& evolver,
+            const BrownianGeneratorFactory& factory,
+            const Clone<MarketModelMultiProduct>& product,
+            Real initialNumeraireValue,
+            Size pathsPerBatch = 256,
+            Size concurrentBatches = 8);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        struct Batch {
+            ext::shared_ptr<MarketModelBatchEvolver> evolver;
+            std::vector<Clone<MarketModelMultiProduct> > products;
+            // one matrix (factors x paths) per step
+            std::vector<Matrix> brownians;
+            std::vector<Real> weights;
+            // numeraires held (products x paths)
+            Matrix numerairesHeld;
+            std::vector<Real> principals;
+            std::vector<bool> done;
+            std::vector<Size> numberCashFlowsThisStep;
+            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
+                                                         cashFlowsGenerated;
+        };
+        void drawBrownians(Batch& batch, Size paths);
+        void simulate(Batch& batch) const;
+
+        ext::shared_ptr<BrownianGenerator> generator_;
+        Real initialNumeraireValue_;
+        Size numberProducts_, pathsPerBatch_;
+        std::vector<MarketModelDiscounter> discounters_;
+        std::vector<Batch> batches_;
+        std::vector<Real> brownians_;
+    };
+
+}
+
+#endif
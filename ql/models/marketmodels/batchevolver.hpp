@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchevolver.hpp
+    \brief market-model evolver advancing a batch of paths
+*/
+
+#ifndef quantlib_market_model_batch_evolver_hpp
+#define quantlib_market_model_batch_evolver_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class CurveState;
+
+    //! Market-model evolver working on a batch of paths
+    /*! Abstract base class. Unlike MarketModelEvolver, the evolver
+        advances a number of paths in lockstep; the forward rates are
+        stored in a matrix whose rows correspond to the rates and whose
+        columns correspond to the paths, so that the evolution can be
+        written as operations on whole rows.
+
+        The evolver doesn't own a Brownian generator; the increments
+        for each step are passed to advanceStep, so that the same
+        evolver can be cloned and used on different threads while the
+        random numbers are drawn in a single sequence.
+    */
+    class MarketModelBatchEvolver {
+      public:
+        virtual ~MarketModelBatchEvolver() = default;
+
+        virtual const std::vector<Size>& numeraires() const = 0;
+        //! number of factors of the Brownian increments
+        virtual Size numberOfFactors() const = 0;
+        //! number of steps of each path
+        virtual Size numberOfSteps() const = 0;
+        //! resets the given number of paths to the initial state
+        virtual void startNewBatch(Size numberOfPaths) = 0;
+        /*! advances all the paths by one step; the i-th column of the
+            passed matrix holds the Brownian increments for the i-th
+            path.
+        */
+        virtual void advanceStep(const Matrix& brownians) = 0;
+        virtual Size currentStep() const = 0;
+        virtual Size numberOfPaths() const = 0;
+        //! forward rates (rates x paths)
+        virtual const Matrix& forwards() const = 0;
+        virtual const CurveState& currentState(Size path) const = 0;
+        virtual void setInitialState(const CurveState&) = 0;
+        //! returns an independent copy of the evolver
+        virtual ext::shared_ptr<MarketModelBatchEvolver> clone() const = 0;
+    };
+
+}
+
+#endif
@@ -23,6 +23,7 @@
 
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -178,4 +179,83 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& forwards,
+                                     Matrix& drifts) const {
+        QL_REQUIRE(forwards.rows()==numberOfRates_, "numberOfRates <> dim");
+        QL_REQUIRE(drifts.rows()==numberOfRates_ &&
+                   drifts.columns()==forwards.columns(),
+                   "drifts size inconsistent with forwards");
+
+        Size paths = forwards.columns();
+        if (batchTmp_.columns() != paths) {
+            batchTmp_ = Matrix(numberOfRates_, paths);
+            batchE_ = Matrix(numberOfFactors_, paths);
+        }
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards.row_begin(i);
+            Real* g = batchTmp_.row_begin(i);
+            Real d = displacements_[i], oneOverTau = oneOverTaus_[i];
+            for (Size p=0; p<paths; ++p)
+                g[p] = (f[p]+d) / (oneOverTau+f[p]);
+        }
+
+        detail::computeReducedDrifts(pseudo_, numeraire_, alive_,
+                                     batchTmp_, batchE_, drifts);
+    }
+
+    namespace detail {
+
+        void computeReducedDrifts(const Matrix& pseudo,
+                                  Size numeraire,
+                                  Size alive,
+                                  const Matrix& g,
+                                  Matrix& e,
+                                  Matrix& drifts) {
+            // Same recursion as in computeReduced, with the running sums
+            // over the rates kept for all paths at once.
+            Size n = pseudo.rows(), factors = pseudo.columns();
+            Size paths = g.columns();
+
+            if (numeraire>0)
+                std::fill(drifts.row_begin(numeraire-1),
+                          drifts.row_end(numeraire-1), 0.0);
+
+            // backward from N-2 down to alive
+            std::fill(e.begin(), e.end(), 0.0);
+            for (Integer i=static_cast<Integer>(numeraire)-2;
+                 i>=static_cast<Integer>(alive); --i) {
+                Real* d = drifts.row_begin(i);
+                const Real* gi = g.row_begin(i+1);
+                std::fill(d, d+paths, 0.0);
+                for (Size r=0; r<factors; ++r) {
+                    Real* er = e.row_begin(r);
+                    Real a1 = pseudo[i+1][r], a0 = pseudo[i][r];
+                    for (Size p=0; p<paths; ++p) {
+                        er[p] += gi[p] * a1;
+                        d[p] -= er[p] * a0;
+                    }
+                }
+            }
+
+            // forward from N up to n-1
+            std::fill(e.begin(), e.end(), 0.0);
+            for (Size i=numeraire; i<n; ++i) {
+                Real* d = drifts.row_begin(i);
+                const Real* gi = g.row_begin(i);
+                std::fill(d, d+paths, 0.0);
+                for (Size r=0; r<factors; ++r) {
+                    Real* er = e.row_begin(r);
+                    Real a = pseudo[i][r];
+                    for (Size p=0; p<paths; ++p) {
+                        er[p] += gi[p] * a;
+                        d[p] += er[p] * a;
+                    }
+                }
+            }
+        }
+
+    }
+
 }
@@ -63,6 +63,11 @@ namespace QuantLib {
                             std::vector<Real>& drifts) const;
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
+        /*! Computes the drifts for a batch of paths with factor
+            reduction; the forwards and drifts of each path are stored
+            in a column of the passed matrices, whose rows correspond
+            to the rates. */
+        void compute(const Matrix& fwds, Matrix& drifts) const;
 
       private:
         Size numberOfRates_, numberOfFactors_;
@@ -74,9 +79,25 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix batchTmp_, batchE_;
         std::vector<Size> downs_, ups_;
     };
 
+    namespace detail {
+
+        /* Reduced-factor drift recursion for a batch of paths, shared by
+           the log-normal and normal calculators; g holds the forward
+           factors (rates x paths) and e is a factors x paths workspace.
+        */
+        void computeReducedDrifts(const Matrix& pseudo,
+                                  Size numeraire,
+                                  Size alive,
+                                  const Matrix& g,
+                                  Matrix& e,
+                                  Matrix& drifts);
+
+    }
+
 }
 
 #endif
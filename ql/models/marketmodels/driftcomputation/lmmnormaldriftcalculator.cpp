@@ -18,6 +18,7 @@
  FOR A PARTICULAR PURPOSE.  See the license for more details.
 */
 
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmnormaldriftcalculator.hpp>
 
 namespace QuantLib {
@@ -155,4 +156,30 @@ namespace QuantLib {
         }
     }
 
+    void LMMNormalDriftCalculator::compute(const Matrix& forwards,
+                                           Matrix& drifts) const {
+        QL_REQUIRE(forwards.rows()==numberOfRates_, "numberOfRates <> dim");
+        QL_REQUIRE(drifts.rows()==numberOfRates_ &&
+                   drifts.columns()==forwards.columns(),
+                   "drifts size inconsistent with forwards");
+
+        Size paths = forwards.columns();
+        if (batchTmp_.columns() != paths) {
+            batchTmp_ = Matrix(numberOfRates_, paths);
+            batchE_ = Matrix(numberOfFactors_, paths);
+        }
+
+        // Precompute forwards factor
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards.row_begin(i);
+            Real* g = batchTmp_.row_begin(i);
+            Real oneOverTau = oneOverTaus_[i];
+            for (Size p=0; p<paths; ++p)
+                g[p] = 1.0/(oneOverTau+f[p]);
+        }
+
+        detail::computeReducedDrifts(pseudo_, numeraire_, alive_,
+                                     batchTmp_, batchE_, drifts);
+    }
+
 }
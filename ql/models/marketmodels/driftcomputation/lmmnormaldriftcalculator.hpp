@@ -64,6 +64,11 @@ namespace QuantLib {
                             std::vector<Real>& drifts) const;
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
+        /*! Computes the drifts for a batch of paths with factor
+            reduction; the forwards and drifts of each path are stored
+            in a column of the passed matrices, whose rows correspond
+            to the rates. */
+        void compute(const Matrix& fwds, Matrix& drifts) const;
 
 
       private:
@@ -75,6 +80,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix batchTmp_, batchE_;
         std::vector<Size> downs_, ups_;
     };
 
@@ -1,6 +1,7 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/models/marketmodels/evolvers/batchfwdrateevolvers.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalcmswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalcotswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
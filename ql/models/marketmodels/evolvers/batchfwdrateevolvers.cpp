@@ -0,0 +1,430 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/batchfwdrateevolvers.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace QuantLib {
+
+    // BatchFwdRateEvolver
+
+    BatchFwdRateEvolver::BatchFwdRateEvolver(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel->numberOfFactors()),
+      currentStep_(initialStep),
+      displacements_(marketModel->displacements()),
+      alive_(marketModel->evolution().firstAliveRate()),
+      column_(numberOfRates_) {
+        checkCompatibility(marketModel->evolution(), numeraires);
+    }
+
+    const std::vector<Size>& BatchFwdRateEvolver::numeraires() const {
+        return numeraires_;
+    }
+
+    Size BatchFwdRateEvolver::numberOfFactors() const {
+        return numberOfFactors_;
+    }
+
+    Size BatchFwdRateEvolver::numberOfSteps() const {
+        return marketModel_->evolution().numberOfSteps() - initialStep_;
+    }
+
+    Size BatchFwdRateEvolver::currentStep() const {
+        return currentStep_;
+    }
+
+    Size BatchFwdRateEvolver::numberOfPaths() const {
+        return paths_;
+    }
+
+    const Matrix& BatchFwdRateEvolver::forwards() const {
+        return forwards_;
+    }
+
+    const CurveState& BatchFwdRateEvolver::currentState(Size path) const {
+        QL_REQUIRE(path < paths_,
+                   "path " << path << " out of range (" << paths_ << " paths)");
+        return curveStates_[path];
+    }
+
+    void BatchFwdRateEvolver::setNumberOfPaths(Size paths) {
+        if (paths == paths_)
+            return;
+        paths_ = paths;
+        forwards_ = Matrix(numberOfRates_, paths_);
+        curveStates_.assign(paths_,
+                            LMMCurveState(marketModel_->evolution().rateTimes()));
+        resizeWorkspace();
+    }
+
+    void BatchFwdRateEvolver::updateCurveStates() {
+        for (Size p=0; p<paths_; ++p) {
+            std::copy(forwards_.column_begin(p), forwards_.column_end(p),
+                      column_.begin());
+            curveStates_[p].setOnForwardRates(column_);
+        }
+    }
+
+    void BatchFwdRateEvolver::addCorrelatedBrownians(const Matrix& brownians,
+                                                     Matrix& rates) const {
+        QL_REQUIRE(brownians.rows() == numberOfFactors_ &&
+                   brownians.columns() == paths_,
+                   "Brownian increments (" << brownians.rows() << "x"
+                   << brownians.columns() << ") inconsistent with "
+                   << numberOfFactors_ << " factors and " << paths_
+                   << " paths");
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        for (Size i=alive_[currentStep_]; i<numberOfRates_; ++i) {
+            Real* x = rates.row_begin(i);
+            for (Size f=0; f<numberOfFactors_; ++f) {
+                Real a = A[i][f];
+                const Real* z = brownians.row_begin(f);
+                for (Size p=0; p<paths_; ++p)
+                    x[p] += a * z[p];
+            }
+        }
+    }
+
+
+    // BatchLogNormalFwdRateEvolver
+
+    BatchLogNormalFwdRateEvolver::BatchLogNormalFwdRateEvolver(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep)
+    : BatchFwdRateEvolver(marketModel, numeraires, initialStep),
+      initialLogForwards_(numberOfRates_), initialDrifts_(numberOfRates_) {
+        Size steps = marketModel->evolution().numberOfSteps();
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.emplace_back(A, displacements_,
+                                      marketModel->evolution().rateTaus(),
+                                      numeraires[j], alive_[j]);
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), Real(0.0));
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        setForwards(marketModel_->initialRates());
+    }
+
+    void BatchLogNormalFwdRateEvolver::setForwards(
+                                        const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        for (Size i=0; i<numberOfRates_; ++i)
+             initialLogForwards_[i] = std::log(forwards[i] +
+                                               displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void BatchLogNormalFwdRateEvolver::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    void BatchLogNormalFwdRateEvolver::resizeWorkspace() {
+        logForwards_ = Matrix(numberOfRates_, paths_);
+        drifts1_ = Matrix(numberOfRates_, paths_);
+    }
+
+    void BatchLogNormalFwdRateEvolver::startNewBatch(Size numberOfPaths) {
+        setNumberOfPaths(numberOfPaths);
+        currentStep_ = initialStep_;
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+        updateForwards(0);
+    }
+
+    void BatchLogNormalFwdRateEvolver::computeDrifts1() {
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].compute(forwards_, drifts1_);
+        } else {
+            for (Size i=0; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                          initialDrifts_[i]);
+        }
+    }
+
+    void BatchLogNormalFwdRateEvolver::evolveWithDrifts1(
+                                                const Matrix& brownians) {
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+        Size alive = alive_[currentStep_];
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Real* x = logForwards_.row_begin(i);
+            const Real* d = drifts1_.row_begin(i);
+            Real fixed = fixedDrift[i];
+            for (Size p=0; p<paths_; ++p)
+                x[p] += d[p] + fixed;
+        }
+        addCorrelatedBrownians(brownians, logForwards_);
+        updateForwards(alive);
+    }
+
+    void BatchLogNormalFwdRateEvolver::updateForwards(Size alive) {
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            const Real* x = logForwards_.row_begin(i);
+            Real* f = forwards_.row_begin(i);
+            Real displacement = displacements_[i];
+            for (Size p=0; p<paths_; ++p)
+                f[p] = std::exp(x[p]) - displacement;
+        }
+    }
+
+
+    // BatchLogNormalFwdRateEuler
+
+    BatchLogNormalFwdRateEuler::BatchLogNormalFwdRateEuler(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep)
+    : BatchLogNormalFwdRateEvolver(marketModel, numeraires, initialStep) {}
+
+    void BatchLogNormalFwdRateEuler::advanceStep(const Matrix& brownians) {
+        // a) compute drifts D1 at T1;
+        computeDrifts1();
+        // b) evolve forwards up to T2 using D1;
+        evolveWithDrifts1(brownians);
+        // c) update curve states
+        updateCurveStates();
+        ++currentStep_;
+    }
+
+    ext::shared_ptr<MarketModelBatchEvolver>
+    BatchLogNormalFwdRateEuler::clone() const {
+        return ext::make_shared<BatchLogNormalFwdRateEuler>(*this);
+    }
+
+
+    // BatchLogNormalFwdRatePc
+
+    BatchLogNormalFwdRatePc::BatchLogNormalFwdRatePc(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep)
+    : BatchLogNormalFwdRateEvolver(marketModel, numeraires, initialStep) {}
+
+    void BatchLogNormalFwdRatePc::resizeWorkspace() {
+        BatchLogNormalFwdRateEvolver::resizeWorkspace();
+        drifts2_ = Matrix(numberOfRates_, paths_);
+    }
+
+    void BatchLogNormalFwdRatePc::advanceStep(const Matrix& brownians) {
+        // a) compute drifts D1 at T1;
+        computeDrifts1();
+
+        // b) evolve forwards up to T2 using D1;
+        evolveWithDrifts1(brownians);
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].compute(forwards_, drifts2_);
+
+        // d) correct forwards using both drifts
+        Size alive = alive_[currentStep_];
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Real* x = logForwards_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            const Real* d2 = drifts2_.row_begin(i);
+            for (Size p=0; p<paths_; ++p)
+                x[p] += (d2[p]-d1[p])/2.0;
+        }
+        updateForwards(alive);
+
+        // e) update curve states
+        updateCurveStates();
+
+        ++currentStep_;
+    }
+
+    ext::shared_ptr<MarketModelBatchEvolver>
+    BatchLogNormalFwdRatePc::clone() const {
+        return ext::make_shared<BatchLogNormalFwdRatePc>(*this);
+    }
+
+
+    // BatchLogNormalFwdRateIpc
+
+    BatchLogNormalFwdRateIpc::BatchLogNormalFwdRateIpc(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep)
+    : BatchLogNormalFwdRateEvolver(marketModel, numeraires, initialStep),
+      rateTaus_(marketModel->evolution().rateTaus()) {
+        QL_REQUIRE(isInTerminalMeasure(marketModel->evolution(), numeraires),
+                   "terminal measure required for ipc ");
+        // as in LogNormalFwdRateIpc, the fixed drifts are taken from
+        // the covariance matrices
+        for (Size j=0; j<fixedDrifts_.size(); ++j) {
+            const Matrix& C = marketModel->covariance(j);
+            for (Size k=0; k<numberOfRates_; ++k)
+                fixedDrifts_[j][k] = -0.5*C[k][k];
+        }
+    }
+
+    void BatchLogNormalFwdRateIpc::resizeWorkspace() {
+        BatchLogNormalFwdRateEvolver::resizeWorkspace();
+        g_ = Matrix(numberOfRates_, paths_);
+        drifts2_.resize(paths_);
+    }
+
+    void BatchLogNormalFwdRateIpc::advanceStep(const Matrix& brownians) {
+        // a) compute drifts D1 at T1;
+        computeDrifts1();
+
+        // b) evolve the rates backwards, correcting the drifts with
+        //    the rates already evolved
+        addCorrelatedBrownians(brownians, logForwards_);
+        const Matrix& C = marketModel_->covariance(currentStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+        Integer alive = alive_[currentStep_];
+        for (Integer i=numberOfRates_-1; i>=alive; --i) {
+            std::fill(drifts2_.begin(), drifts2_.end(), 0.0);
+            for (Size j=i+1; j<numberOfRates_; ++j) {
+                Real c = C[i][j];
+                const Real* g = g_.row_begin(j);
+                for (Size p=0; p<paths_; ++p)
+                    drifts2_[p] -= g[p]*c;
+            }
+            Real* x = logForwards_.row_begin(i);
+            Real* f = forwards_.row_begin(i);
+            Real* g = g_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            Real fixed = fixedDrift[i], displacement = displacements_[i],
+                tau = rateTaus_[i];
+            for (Size p=0; p<paths_; ++p) {
+                x[p] += 0.5*(d1[p]+drifts2_[p]) + fixed;
+                f[p] = std::exp(x[p]) - displacement;
+                g[p] = tau*(f[p]+displacement)/(1.0+tau*f[p]);
+            }
+        }
+
+        // c) update curve states
+        updateCurveStates();
+
+        ++currentStep_;
+    }
+
+    ext::shared_ptr<MarketModelBatchEvolver>
+    BatchLogNormalFwdRateIpc::clone() const {
+        return ext::make_shared<BatchLogNormalFwdRateIpc>(*this);
+    }
+
+
+    // BatchNormalFwdRatePc
+
+    BatchNormalFwdRatePc::BatchNormalFwdRatePc(
+                           const ext::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           Size initialStep)
+    : BatchFwdRateEvolver(marketModel, numeraires, initialStep),
+      initialDrifts_(numberOfRates_) {
+        Size steps = marketModel->evolution().numberOfSteps();
+        calculators_.reserve(steps);
+        for (Size j=0; j<steps; ++j)
+            calculators_.emplace_back(marketModel_->pseudoRoot(j),
+                                      marketModel->evolution().rateTaus(),
+                                      numeraires[j], alive_[j]);
+
+        setForwards(marketModel_->initialRates());
+    }
+
+    void BatchNormalFwdRatePc::setForwards(const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        initialForwards_ = forwards;
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void BatchNormalFwdRatePc::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    void BatchNormalFwdRatePc::resizeWorkspace() {
+        drifts1_ = Matrix(numberOfRates_, paths_);
+        drifts2_ = Matrix(numberOfRates_, paths_);
+    }
+
+    void BatchNormalFwdRatePc::startNewBatch(Size numberOfPaths) {
+        setNumberOfPaths(numberOfPaths);
+        currentStep_ = initialStep_;
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(forwards_.row_begin(i), forwards_.row_end(i),
+                      initialForwards_[i]);
+    }
+
+    void BatchNormalFwdRatePc::advanceStep(const Matrix& brownians) {
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].compute(forwards_, drifts1_);
+        } else {
+            for (Size i=0; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                          initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1;
+        Size alive = alive_[currentStep_];
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Real* f = forwards_.row_begin(i);
+            const Real* d = drifts1_.row_begin(i);
+            for (Size p=0; p<paths_; ++p)
+                f[p] += d[p];
+        }
+        addCorrelatedBrownians(brownians, forwards_);
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].compute(forwards_, drifts2_);
+
+        // d) correct forwards using both drifts
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Real* f = forwards_.row_begin(i);
+            const Real* d1 = drifts1_.row_begin(i);
+            const Real* d2 = drifts2_.row_begin(i);
+            for (Size p=0; p<paths_; ++p)
+                f[p] += (d2[p]-d1[p])/2.0;
+        }
+
+        // e) update curve states
+        updateCurveStates();
+
+        ++currentStep_;
+    }
+
+    ext::shared_ptr<MarketModelBatchEvolver>
+    BatchNormalFwdRatePc::clone() const {
+        return ext::make_shared<BatchNormalFwdRatePc>(*this);
+    }
+
+}
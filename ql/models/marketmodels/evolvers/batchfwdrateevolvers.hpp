@@ -0,0 +1,189 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchfwdrateevolvers.hpp
+    \brief forward-rate evolvers advancing a batch of paths
+*/
+
+#ifndef quantlib_batch_fwd_rate_evolvers_hpp
+#define quantlib_batch_fwd_rate_evolvers_hpp
+
+#include <ql/models/marketmodels/batchevolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmnormaldriftcalculator.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+
+    //! base class for batched forward-rate evolvers
+    /*! It manages the forward rates and the curve states of the paths
+        in the batch; derived classes implement the discretization.
+    */
+    class BatchFwdRateEvolver : public MarketModelBatchEvolver {
+      public:
+        //! \name MarketModelBatchEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const override;
+        Size numberOfFactors() const override;
+        Size numberOfSteps() const override;
+        Size currentStep() const override;
+        Size numberOfPaths() const override;
+        const Matrix& forwards() const override;
+        const CurveState& currentState(Size path) const override;
+        //@}
+      protected:
+        BatchFwdRateEvolver(const ext::shared_ptr<MarketModel>&,
+                            const std::vector<Size>& numeraires,
+                            Size initialStep);
+        /*! sets the number of paths, resizing the forwards and
+            calling resizeWorkspace if it changed.
+        */
+        void setNumberOfPaths(Size paths);
+        virtual void resizeWorkspace() = 0;
+        //! sets the curve states on the current forwards
+        void updateCurveStates();
+        //! adds the correlated increments to the given rates
+        void addCorrelatedBrownians(const Matrix& brownians,
+                                    Matrix& rates) const;
+
+        // inputs
+        ext::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_;
+        Size currentStep_, paths_ = 0;
+        std::vector<Spread> displacements_;
+        std::vector<Size> alive_;
+        Matrix forwards_;
+        std::vector<LMMCurveState> curveStates_;
+        std::vector<Rate> column_;
+    };
+
+
+    //! base class for batched log-normal forward-rate evolvers
+    class BatchLogNormalFwdRateEvolver : public BatchFwdRateEvolver {
+      public:
+        void startNewBatch(Size numberOfPaths) override;
+        void setInitialState(const CurveState&) override;
+      protected:
+        BatchLogNormalFwdRateEvolver(const ext::shared_ptr<MarketModel>&,
+                                     const std::vector<Size>& numeraires,
+                                     Size initialStep);
+        void resizeWorkspace() override;
+        void setForwards(const std::vector<Real>& forwards);
+        //! writes the drifts at the current step into drifts1_
+        void computeDrifts1();
+        /*! adds drifts1_, the fixed drift, and the correlated
+            increments to the log-forwards, starting at the first
+            alive rate, and updates the forwards accordingly.
+        */
+        void evolveWithDrifts1(const Matrix& brownians);
+        void updateForwards(Size alive);
+
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        std::vector<Real> initialLogForwards_, initialDrifts_;
+        // working variables
+        Matrix logForwards_, drifts1_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+
+    //! Euler discretization for a batch of paths
+    /*! The random numbers being the same, results are the same as
+        with LogNormalFwdRateEuler up to rounding.
+    */
+    class BatchLogNormalFwdRateEuler : public BatchLogNormalFwdRateEvolver {
+      public:
+        BatchLogNormalFwdRateEuler(const ext::shared_ptr<MarketModel>&,
+                                   const std::vector<Size>& numeraires,
+                                   Size initialStep = 0);
+        void advanceStep(const Matrix& brownians) override;
+        ext::shared_ptr<MarketModelBatchEvolver> clone() const override;
+    };
+
+
+    //! Predictor-Corrector for a batch of paths
+    /*! The random numbers being the same, results are the same as
+        with LogNormalFwdRatePc up to rounding.
+    */
+    class BatchLogNormalFwdRatePc : public BatchLogNormalFwdRateEvolver {
+      public:
+        BatchLogNormalFwdRatePc(const ext::shared_ptr<MarketModel>&,
+                                const std::vector<Size>& numeraires,
+                                Size initialStep = 0);
+        void advanceStep(const Matrix& brownians) override;
+        ext::shared_ptr<MarketModelBatchEvolver> clone() const override;
+      protected:
+        void resizeWorkspace() override;
+      private:
+        Matrix drifts2_;
+    };
+
+
+    //! Iterative Predictor-Corrector for a batch of paths
+    /*! The random numbers being the same, results are the same as
+        with LogNormalFwdRateIpc up to rounding.
+
+        \pre the terminal measure must be used
+    */
+    class BatchLogNormalFwdRateIpc : public BatchLogNormalFwdRateEvolver {
+      public:
+        BatchLogNormalFwdRateIpc(const ext::shared_ptr<MarketModel>&,
+                                 const std::vector<Size>& numeraires,
+                                 Size initialStep = 0);
+        void advanceStep(const Matrix& brownians) override;
+        ext::shared_ptr<MarketModelBatchEvolver> clone() const override;
+      protected:
+        void resizeWorkspace() override;
+      private:
+        std::vector<Time> rateTaus_;
+        Matrix g_;
+        std::vector<Real> drifts2_;
+    };
+
+
+    //! Predictor-Corrector for normal forward rates on a batch of paths
+    /*! The random numbers being the same, results are the same as
+        with NormalFwdRatePc up to rounding.
+    */
+    class BatchNormalFwdRatePc : public BatchFwdRateEvolver {
+      public:
+        BatchNormalFwdRatePc(const ext::shared_ptr<MarketModel>&,
+                             const std::vector<Size>& numeraires,
+                             Size initialStep = 0);
+        void startNewBatch(Size numberOfPaths) override;
+        void advanceStep(const Matrix& brownians) override;
+        void setInitialState(const CurveState&) override;
+        ext::shared_ptr<MarketModelBatchEvolver> clone() const override;
+      protected:
+        void resizeWorkspace() override;
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        std::vector<Rate> initialForwards_;
+        std::vector<Real> initialDrifts_;
+        Matrix drifts1_, drifts2_;
+        std::vector<LMMNormalDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
@@ -320,32 +320,161 @@ namespace QuantLib {
         }
     }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
- 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    namespace detail {
+
+        PathwiseEulerPath::PathwiseEulerPath(Size numberSteps,
+                                             Size numberRates,
+                                             Size numberFactors,
+                                             Size numberProducts,
+                                             Size numberCashFlowTimes)
+        : LIBORRates(numberSteps+1, numberRates, 0.0),
+          LIBORRatios(numberSteps+1, numberRates, 0.0),
+          Discounts(numberSteps+1, numberRates+1, 0.0),
+          StepsDiscounts(numberSteps+1, numberRates+1, 0.0),
+          StepsDiscountsSquared(numberSteps+1, numberRates, 0.0),
+          brownians(numberSteps, numberFactors, 0.0),
+          numberCashFlowsThisIndex(numberProducts,
+                                   std::vector<Size>(numberCashFlowTimes, 0)),
+          totalCashFlowsThisIndex(numberProducts,
+                                  Matrix(numberCashFlowTimes, numberRates+1, 0.0)) {
+            for (Size i=0; i <= numberSteps; ++i)
+            {
+                Discounts[i][0] = 1.0;
+                StepsDiscounts[i][0] = 1.0;
+            }
+        }
+
+    }
+
+    namespace {
+
+        // runs the evolver along a path, recording what is needed by the
+        // backward computation of the vegas engines
+        void simulateEulerPath(
+                   LogNormalFwdRateEuler& evolver,
+                   MarketModelPathwiseMultiProduct& product,
+                   const std::vector<Real>& initialForwards,
+                   std::vector<Size>& numberCashFlowsThisStep,
+                   std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >&
+                                                             cashFlowsGenerated,
+                   detail::PathwiseEulerPath& path)
+        {
+            Size numberProducts = path.numberCashFlowsThisIndex.size();
+            Size numberRates = initialForwards.size();
+
+            // clear accumulation variables
+            for (Size i=0; i < numberProducts; ++i)
+            {
+                std::fill(path.numberCashFlowsThisIndex[i].begin(),
+                          path.numberCashFlowsThisIndex[i].end(), 0);
+                std::fill(path.totalCashFlowsThisIndex[i].begin(),
+                          path.totalCashFlowsThisIndex[i].end(), 0.0);
+            }
+
+            Real weight = evolver.startNewPath();
+            product.reset();
+
+            std::copy(initialForwards.begin(), initialForwards.end(),
+                      path.LIBORRates.row_begin(evolver.currentStep()));
+
+            Size thisStep;
+
+            bool done = false;
+            do {
+                thisStep = evolver.currentStep();
+                Size storeStep = thisStep+1;
+                weight *= evolver.advanceStep();
+
+                const CurveState& state = evolver.currentState();
+                done = product.nextTimeStep(state,
+                    numberCashFlowsThisStep,
+                    cashFlowsGenerated);
+
+                const std::vector<Rate>& currentForwards = state.forwardRates();
+                const std::vector<Real>& brownians = evolver.browniansThisStep();
+                std::copy(brownians.begin(), brownians.end(),
+                          path.brownians.row_begin(thisStep));
+
+                for (Size i=0; i < numberRates; ++i)
+                {
+                    Real x = state.discountRatio(i+1,i);
+                    path.StepsDiscounts[storeStep][i+1] = x;
+                    path.StepsDiscountsSquared[storeStep][i] = x*x;
+
+                    path.LIBORRatios[storeStep][i] =
+                        currentForwards[i]/path.LIBORRates[thisStep][i];
+                    path.LIBORRates[storeStep][i] = currentForwards[i];
+                    path.Discounts[storeStep][i+1] = state.discountRatio(i+1,0);
+                }
+
+                // for each product...
+                for (Size i=0; i<numberProducts; ++i)
+                {
+                    // ...and each cash flow...
+                    for (Size j=0; j<numberCashFlowsThisStep[i]; ++j)
+                    {
+                        Size k = cashFlowsGenerated[i][j].timeIndex;
+                        ++path.numberCashFlowsThisIndex[i][k];
+
+                        for (Size l=0; l <= numberRates; ++l)
+                            path.totalCashFlowsThisIndex[i][k][l] +=
+                                cashFlowsGenerated[i][j].amount[l]*weight;
+                    }
+                }
+
+            } while (!done);
+
+            path.finalStepDone = thisStep;
+        }
+
+        // adds the values of the given paths (one per row) to the running
+        // sums; each sum is accumulated in path order, so that the result
+        // doesn't depend on the number of threads
+        void accumulatePathValues(const Matrix& values,
+                                  Size numberOfPaths,
+                                  std::vector<Real>& sums,
+                                  std::vector<Real>& sumsqs)
+        {
+            Size numberOfValues = sums.size();
+            #pragma omp parallel for if(numberOfValues*numberOfPaths > 100000)
+            for (long j=0; j < long(numberOfValues); ++j)
+            {
+                for (Size i=0; i < numberOfPaths; ++i)
+                {
+                    Real value = values[i][j];
+                    sums[j] += value;
+                    sumsqs[j] += value*value;
+                }
+            }
+        }
+
+    }
 
     PathwiseVegasAccountingEngine::PathwiseVegasAccountingEngine(
         ext::shared_ptr<LogNormalFwdRateEuler> evolver, // method relies heavily on LMM Euler
         const Clone<MarketModelPathwiseMultiProduct>& product,
         ext::shared_ptr<MarketModel> pseudoRootStructure, // we need pseudo-roots and displacements
         const std::vector<std::vector<Matrix> >& vegaBumps,
-        Real initialNumeraireValue)
+        Real initialNumeraireValue,
+        Size pathsPerBatch,
+        Size concurrentBatches)
     : evolver_(std::move(evolver)), product_(product),
       pseudoRootStructure_(std::move(pseudoRootStructure)),
       initialNumeraireValue_(initialNumeraireValue), numberProducts_(product->numberOfProducts()),
-      doDeflation_(!product->alreadyDeflated()), numerairesHeld_(product->numberOfProducts()),
+      pathsPerBatch_(pathsPerBatch), doDeflation_(!product->alreadyDeflated()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
-      cashFlowsGenerated_(product->numberOfProducts()),
-      stepsDiscounts_(pseudoRootStructure_->numberOfRates() + 1),
-      vegasThisPath_(product->numberOfProducts(), vegaBumps[0].size()),
-      deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates() + 1) {
+      cashFlowsGenerated_(product->numberOfProducts()) {
 
-        stepsDiscounts_[0]=1.0;
+        QL_REQUIRE(pathsPerBatch > 0, "at least one path per batch required");
+        QL_REQUIRE(concurrentBatches > 0, "at least one concurrent batch required");
 
         numberRates_ = pseudoRootStructure_->numberOfRates();
         numberSteps_ = pseudoRootStructure_->numberOfSteps();
-        fullDerivatives_.resize(numberRates_);
-
+        Size factors = pseudoRootStructure_->numberOfFactors();
 
         const EvolutionDescription& evolution = pseudoRootStructure_->evolution();
         numeraires_ =  moneyMarketMeasure(evolution);
@@ -355,35 +484,33 @@ namespace QuantLib {
 
         numberBumps_ = vegaBumps[0].size();
 
+        // the workspace is replicated for each batch
+        Workspace workspace;
+
         for (Size i =0; i < numberSteps_; ++i)
         {
             Size thisSize = vegaBumps[i].size();
             QL_REQUIRE(thisSize == numberBumps_,"We must have precisely the same number of bumps for each step.");
-            jacobianComputers_.emplace_back(
+            workspace.jacobianComputers.emplace_back(
                 pseudoRootStructure_->pseudoRoot(i), evolution.firstAliveRate()[i], numeraires_[i],
                 evolution.rateTaus(), vegaBumps[i], pseudoRootStructure_->displacements());
 
-            jacobiansThisPaths_.emplace_back(numberBumps_, pseudoRootStructure_->numberOfRates());
+            workspace.jacobiansThisPaths.emplace_back(numberBumps_, numberRates_);
         }
 
+        workspace.lastForwards.resize(numberRates_);
+        workspace.currentForwards.resize(numberRates_);
+        workspace.stepsDiscounts.resize(numberRates_+1);
+        workspace.brownians.resize(factors);
+        workspace.numerairesHeld.resize(numberProducts_);
+        workspace.V.assign(numberProducts_, Matrix(numberSteps_+1, numberRates_));
+        workspace.partials = Matrix(factors, numberRates_);
+        workspace.vegasThisPath = Matrix(numberProducts_, numberBumps_);
+        workspace.deflatorAndDerivatives.resize(numberRates_+1);
+        workspace.fullDerivatives.resize(numberRates_);
 
+        workspaces_.assign(concurrentBatches, workspace);
 
-        Matrix VModel(numberSteps_+1,numberRates_);
-
-
-
-        Discounts_ = Matrix(numberSteps_+1,numberRates_+1);
-
-        for (Size i=0; i <= numberSteps_; ++i)
-            Discounts_[i][0] = 1.0;
-
-
-        V_.reserve(numberProducts_);
-
-        Matrix  modelCashFlowIndex(product_->possibleCashFlowTimes().size(), numberRates_+1);
-
-
-        numberCashFlowsThisIndex_.resize(numberProducts_);
 
         for (Size i=0; i<numberProducts_; ++i)
         {
@@ -392,21 +519,8 @@ namespace QuantLib {
 
             for (auto& j : cashFlowsGenerated_[i])
                 j.amount.resize(numberRates_ + 1);
-
-            numberCashFlowsThisIndex_[i].resize(product_->possibleCashFlowTimes().size());
-
-            V_.push_back(VModel);
-
-
-            totalCashFlowsThisIndex_.push_back(modelCashFlowIndex);
         }
 
-        LIBORRatios_ = VModel;
-        StepsDiscountsSquared_ = VModel;
-        LIBORRates_ =VModel;
-
-
-
 
         const std::vector<Time>& cashFlowTimes =
             product_->possibleCashFlowTimes();
@@ -438,27 +552,34 @@ namespace QuantLib {
             cashFlowIndicesThisStep_[index].push_back(i);
         }
 
-        partials_ = Matrix(pseudoRootStructure_->numberOfFactors(),numberRates_);
+        paths_.assign(pathsPerBatch*concurrentBatches,
+                      detail::PathwiseEulerPath(numberSteps_, numberRates_, factors,
+                                                numberProducts_, numberCashFlowTimes_));
     }
 
-    Real PathwiseVegasAccountingEngine::singlePathValues(std::vector<Real>& values)
+    void PathwiseVegasAccountingEngine::simulatePath(detail::PathwiseEulerPath& path)
     {
+        simulateEulerPath(*evolver_, *product_, pseudoRootStructure_->initialRates(),
+                          numberCashFlowsThisStep_, cashFlowsGenerated_, path);
+    }
+
+    void PathwiseVegasAccountingEngine::singlePathValues(const detail::PathwiseEulerPath& path,
+                                                         Workspace& workspace,
+                                                         Real* values) const
+    {
+        std::vector<Matrix>& V_ = workspace.V;
+        Matrix& partials_ = workspace.partials;
+        Matrix& vegasThisPath_ = workspace.vegasThisPath;
+        std::vector<Matrix>& jacobiansThisPaths_ = workspace.jacobiansThisPaths;
+        std::vector<Real>& numerairesHeld_ = workspace.numerairesHeld;
+        std::vector<Real>& deflatorAndDerivatives_ = workspace.deflatorAndDerivatives;
+        std::vector<Real>& fullDerivatives_ = workspace.fullDerivatives;
 
-        const std::vector<Real>& initialForwards_(pseudoRootStructure_->initialRates());
-        currentForwards_ = initialForwards_;
         // clear accumulation variables
         for (Size i=0; i < numberProducts_; ++i)
         {
             numerairesHeld_[i]=0.0;
 
-            for (Size j=0; j < numberCashFlowTimes_; ++j)
-            {
-                numberCashFlowsThisIndex_[i][j] =0;
-
-                for (Size k=0; k <= numberRates_; ++k)
-                    totalCashFlowsThisIndex_[i][j][k] =0.0;
-            }
-
             for (Size l=0;  l< numberRates_; ++l)
                 for (Size m=0; m <= numberSteps_; ++m)
                     V_[i][m][l] =0.0;
@@ -468,62 +589,33 @@ namespace QuantLib {
 
         }
 
+        Integer finalStepDone = path.finalStepDone;
 
+        // jacobians of the rates with respect to the bumps along the path
+        for (Integer step = 0; step <= finalStepDone; ++step)
+        {
+            std::copy(path.LIBORRates.row_begin(step), path.LIBORRates.row_end(step),
+                      workspace.lastForwards.begin());
+            std::copy(path.LIBORRates.row_begin(step+1), path.LIBORRates.row_end(step+1),
+                      workspace.currentForwards.begin());
+            std::copy(path.StepsDiscounts.row_begin(step+1), path.StepsDiscounts.row_end(step+1),
+                      workspace.stepsDiscounts.begin());
+            std::copy(path.brownians.row_begin(step), path.brownians.row_end(step),
+                      workspace.brownians.begin());
+
+            workspace.jacobianComputers[step].getBumps(workspace.lastForwards,
+                                                       workspace.stepsDiscounts,
+                                                       workspace.currentForwards,
+                                                       workspace.brownians,
+                                                       jacobiansThisPaths_[step]);
+        }
 
-        Real weight = evolver_->startNewPath();
-        product_->reset();
-
-        Size thisStep;
-
-        bool done = false;
-        do {
-            thisStep = evolver_->currentStep();
-            Size storeStep = thisStep+1;
-            weight *= evolver_->advanceStep();
-
-            done = product_->nextTimeStep(evolver_->currentState(),
-                numberCashFlowsThisStep_,
-                cashFlowsGenerated_);
-
-            lastForwards_ = currentForwards_;
-            currentForwards_ =  evolver_->currentState().forwardRates();
-
-            for (unsigned long i=0; i < numberRates_; ++i)
-            {
-                Real x=  evolver_->currentState().discountRatio(i+1,i);
-                stepsDiscounts_[i+1] = x;
-                StepsDiscountsSquared_[storeStep][i] = x*x;
-
-                LIBORRatios_[storeStep][i] = currentForwards_[i]/lastForwards_[i];
-                LIBORRates_[storeStep][i] = currentForwards_[i];
-                Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
-            }
-
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
-
-
-
-            // for each product...
-            for (Size i=0; i<numberProducts_; ++i)
-            {
-                // ...and each cash flow...
-                for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j)
-                {
-                    Size k = cashFlowsGenerated_[i][j].timeIndex;
-                    ++numberCashFlowsThisIndex_[i][ k];
-
-                    for (Size l=0; l <= numberRates_; ++l)
-                        totalCashFlowsThisIndex_[i][k][l] += cashFlowsGenerated_[i][j].amount[l]*weight;
-
-                }
-            }
-
-
-        } while (!done);
+        const Matrix& LIBORRates_ = path.LIBORRates;
+        const Matrix& LIBORRatios_ = path.LIBORRatios;
+        const Matrix& StepsDiscountsSquared_ = path.StepsDiscountsSquared;
+        const std::vector<std::vector<Size> >& numberCashFlowsThisIndex_ =
+            path.numberCashFlowsThisIndex;
+        const std::vector<Matrix>& totalCashFlowsThisIndex_ = path.totalCashFlowsThisIndex;
 
         // ok we've gathered cash-flows, still have to backwards computation
 
@@ -532,8 +624,6 @@ namespace QuantLib {
 
         bool flowsFound = false;
 
-        Integer finalStepDone = thisStep;
-
         for (Integer currentStep =  numberSteps_-1; currentStep >=0 ; --currentStep) // must be a signed type as we go negative
         {
             Integer stepToUse = std::min<Integer>(currentStep, finalStepDone)+1;
@@ -552,7 +642,7 @@ namespace QuantLib {
                 if (!noFlows)
                 {
                     if (doDeflation_)
-                        discounters_[cashFlowIndex].getFactors(LIBORRates_, Discounts_,stepToUse, deflatorAndDerivatives_); // get amount to discount cash flow by and amount to multiply its derivatives by
+                        discounters_[cashFlowIndex].getFactors(LIBORRates_, path.Discounts,stepToUse, deflatorAndDerivatives_); // get amount to discount cash flow by and amount to multiply its derivatives by
 
                     for (Size j=0; j < numberProducts_; ++j)
                     {
@@ -671,33 +761,42 @@ namespace QuantLib {
                 values[i*entriesPerProduct + numberRates_ +k +1 ] = vegasThisPath_[i][k]*initialNumeraireValue_;
         }
 
-        return 1.0; // we have put the weight in already, this results in lower variance since weight changes along the path
+        // we have put the weight in already, this results in lower variance since weight changes along the path
     }
 
     void PathwiseVegasAccountingEngine::multiplePathValues(std::vector<Real>& means, std::vector<Real>& errors,
         Size numberOfPaths)
     {
-        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberBumps_));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
-
+        Size numberOfValues = product_->numberOfProducts()*(1+numberRates_+numberBumps_);
+        means.resize(numberOfValues);
+        errors.resize(numberOfValues);
+        std::vector<Real> sums(numberOfValues,0.0);
+        std::vector<Real> sumsqs(numberOfValues,0.0);
 
+        Matrix values(paths_.size(), numberOfValues);
 
-        for (Size i=0; i<numberOfPaths; ++i)
+        for (Size first=0; first<numberOfPaths; first+=paths_.size())
         {
-            /* Real weight = */ singlePathValues(values);
-            // stats.add(values,weight);
-            for (Size j=0; j < values.size(); ++j)
-            {
-                sums[j] += values[j];
-                sumsqs[j] += values[j]*values[j];
+            Size paths = std::min(paths_.size(), numberOfPaths-first);
+            Size batches = (paths+pathsPerBatch_-1)/pathsPerBatch_;
 
+            // the evolver is shared, so the paths are simulated serially...
+            for (Size i=0; i<paths; ++i)
+                simulatePath(paths_[i]);
+
+            // ...while the backward computations run concurrently
+            #pragma omp parallel for if(batches > 1)
+            for (long b=0; b<long(batches); ++b)
+            {
+                Size end = std::min<Size>((b+1)*pathsPerBatch_, paths);
+                for (Size i=b*pathsPerBatch_; i<end; ++i)
+                    singlePathValues(paths_[i], workspaces_[b], values.row_begin(i));
             }
+
+            accumulatePathValues(values, paths, sums, sumsqs);
         }
 
-        for (Size j=0; j < values.size(); ++j)
+        for (Size j=0; j < numberOfValues; ++j)
             {
                 means[j] = sums[j]/numberOfPaths;
                 Real meanSq = sumsqs[j]/numberOfPaths;
@@ -707,31 +806,30 @@ namespace QuantLib {
             }
     }
 
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
     PathwiseVegasOuterAccountingEngine::PathwiseVegasOuterAccountingEngine(
         ext::shared_ptr<LogNormalFwdRateEuler> evolver, // method relies heavily on LMM Euler
         const Clone<MarketModelPathwiseMultiProduct>& product,
         ext::shared_ptr<MarketModel> pseudoRootStructure, // we need pseudo-roots and displacements
         const std::vector<std::vector<Matrix> >& vegaBumps,
-        Real initialNumeraireValue)
+        Real initialNumeraireValue,
+        Size pathsPerBatch,
+        Size concurrentBatches)
     : evolver_(std::move(evolver)), product_(product),
       pseudoRootStructure_(std::move(pseudoRootStructure)), vegaBumps_(vegaBumps),
       initialNumeraireValue_(initialNumeraireValue), numberProducts_(product->numberOfProducts()),
-      doDeflation_(!product->alreadyDeflated()), numerairesHeld_(product->numberOfProducts()),
+      pathsPerBatch_(pathsPerBatch), doDeflation_(!product->alreadyDeflated()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
-      cashFlowsGenerated_(product->numberOfProducts()),
-      stepsDiscounts_(pseudoRootStructure_->numberOfRates() + 1),
-      elementary_vegas_ThisPath_(product->numberOfProducts()),
-      deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates() + 1) {
+      cashFlowsGenerated_(product->numberOfProducts()) {
 
-        stepsDiscounts_[0]=1.0;
+        QL_REQUIRE(pathsPerBatch > 0, "at least one path per batch required");
+        QL_REQUIRE(concurrentBatches > 0, "at least one concurrent batch required");
 
         numberRates_ = pseudoRootStructure_->numberOfRates();
         numberSteps_ = pseudoRootStructure_->numberOfSteps();
         factors_ = pseudoRootStructure_->numberOfFactors();
-        fullDerivatives_.resize(numberRates_);
 
 
         const EvolutionDescription& evolution = pseudoRootStructure_->evolution();
@@ -742,41 +840,33 @@ namespace QuantLib {
 
         numberBumps_ = vegaBumps[0].size();
 
-       std::vector<Matrix> jacobiansThisPathsModel;
-       jacobiansThisPathsModel.reserve(numberRates_);
-       for (Size i =0; i < numberRates_; ++i)
-           jacobiansThisPathsModel.emplace_back(numberRates_, factors_);
+        // the workspace is replicated for each batch
+        Workspace workspace;
 
+        // vector of vector of matrices to store jacobians of rates with respect to pseudo-root
+        // elements
+        std::vector<Matrix> jacobiansThisPathsModel(numberRates_, Matrix(numberRates_, factors_, 0.0));
 
         for (Size i =0; i < numberSteps_; ++i)
         {
-            jacobianComputers_.emplace_back(
+            workspace.jacobianComputers.emplace_back(
                 pseudoRootStructure_->pseudoRoot(i), evolution.firstAliveRate()[i], numeraires_[i],
                 evolution.rateTaus(), pseudoRootStructure_->displacements());
 
-            // vector of vector of matrices to store jacobians of rates with respect to pseudo-root
-            // elements
-            jacobiansThisPaths_.push_back(jacobiansThisPathsModel);
+            workspace.jacobiansThisPaths.push_back(jacobiansThisPathsModel);
         }
 
+        workspace.lastForwards.resize(numberRates_);
+        workspace.currentForwards.resize(numberRates_);
+        workspace.stepsDiscounts.resize(numberRates_+1);
+        workspace.brownians.resize(factors_);
+        workspace.numerairesHeld.resize(numberProducts_);
+        workspace.V.assign(numberProducts_, Matrix(numberSteps_+1, numberRates_));
+        workspace.partials = Matrix(factors_, numberRates_);
+        workspace.deflatorAndDerivatives.resize(numberRates_+1);
 
+        workspaces_.assign(concurrentBatches, workspace);
 
-        Matrix VModel(numberSteps_+1,numberRates_);
-
-
-
-        Discounts_ = Matrix(numberSteps_+1,numberRates_+1);
-
-        for (Size i=0; i <= numberSteps_; ++i)
-            Discounts_[i][0] = 1.0;
-
-
-        V_.reserve(numberProducts_);
-
-        Matrix  modelCashFlowIndex(product_->possibleCashFlowTimes().size(), numberRates_+1);
-
-
-        numberCashFlowsThisIndex_.resize(numberProducts_);
 
         for (Size i=0; i<numberProducts_; ++i)
         {
@@ -785,21 +875,8 @@ namespace QuantLib {
 
             for (auto& j : cashFlowsGenerated_[i])
                 j.amount.resize(numberRates_ + 1);
-
-            numberCashFlowsThisIndex_[i].resize(product_->possibleCashFlowTimes().size());
-
-            V_.push_back(VModel);
-
-
-            totalCashFlowsThisIndex_.push_back(modelCashFlowIndex);
         }
 
-        LIBORRatios_ = VModel;
-        StepsDiscountsSquared_ = VModel;
-        LIBORRates_ =VModel;
-
-
-
 
         const std::vector<Time>& cashFlowTimes =
             product_->possibleCashFlowTimes();
@@ -831,117 +908,67 @@ namespace QuantLib {
             cashFlowIndicesThisStep_[index].push_back(i);
         }
 
-        partials_ = Matrix(pseudoRootStructure_->numberOfFactors(),numberRates_);
-
-//      set up this container object        
-//        std::vector<std::vector<std::vector<Matrix> >  > elementary_vegas_ThisPath_;  // dimensions are product, step, rate, rate and factor
-
-        { // force destruction of modelVegaMatrix as soon as no longer needed 
-            Matrix modelVegaMatrix(numberRates_, factors_,0.0);
+        numberElementaryVegas_ = numberSteps_*numberRates_*factors_;
 
-            for (Size i=0; i < numberProducts_; ++i)
-            {  
-                elementary_vegas_ThisPath_[i].resize(numberSteps_);
-                for (Size j=0; j < numberSteps_; ++j)
-                {
-                   
-                        elementary_vegas_ThisPath_[i][j]= modelVegaMatrix;
-                }
-            }
-        } // modelVegaMatrix destroyed here 
+        paths_.assign(pathsPerBatch*concurrentBatches,
+                      detail::PathwiseEulerPath(numberSteps_, numberRates_, factors_,
+                                                numberProducts_, numberCashFlowTimes_));
+    }
 
-        numberElementaryVegas_ = numberSteps_*numberRates_*factors_;
-/*
-        gaussians_.resize(numberSteps_);
-        distinguishedFactor_=0;
-        distinguishedRate_=0;
-        distinguishedStep_=0;
-*/
+    void PathwiseVegasOuterAccountingEngine::simulatePath(detail::PathwiseEulerPath& path)
+    {
+        simulateEulerPath(*evolver_, *product_, pseudoRootStructure_->initialRates(),
+                          numberCashFlowsThisStep_, cashFlowsGenerated_, path);
     }
 
-    Real PathwiseVegasOuterAccountingEngine::singlePathValues(std::vector<Real>& values)
+    void PathwiseVegasOuterAccountingEngine::singlePathValues(const detail::PathwiseEulerPath& path,
+                                                              Workspace& workspace,
+                                                              Real* values) const
     {
+        std::vector<Matrix>& V_ = workspace.V;
+        Matrix& partials_ = workspace.partials;
+        std::vector<std::vector<Matrix> >& jacobiansThisPaths_ = workspace.jacobiansThisPaths;
+        std::vector<Real>& numerairesHeld_ = workspace.numerairesHeld;
+        std::vector<Real>& deflatorAndDerivatives_ = workspace.deflatorAndDerivatives;
 
-        const std::vector<Real>& initialForwards_(pseudoRootStructure_->initialRates());
-        currentForwards_ = initialForwards_;
         // clear accumulation variables
         for (Size i=0; i < numberProducts_; ++i)
         {
             numerairesHeld_[i]=0.0;
 
-            for (Size j=0; j < numberCashFlowTimes_; ++j)
-            {
-                numberCashFlowsThisIndex_[i][j] =0;
-
-                for (Size k=0; k <= numberRates_; ++k)
-                    totalCashFlowsThisIndex_[i][j][k] =0.0;
-            }
-
             for (Size l=0;  l< numberRates_; ++l)
                 for (Size m=0; m <= numberSteps_; ++m)
                     V_[i][m][l] =0.0;
 
         }
 
+        Integer finalStepDone = path.finalStepDone;
 
-
-        Real weight = evolver_->startNewPath();
-        product_->reset();
-
-        Size thisStep;
-
-        bool done = false;
-        do 
+        // jacobians of the rates with respect to the pseudo-root elements along the path
+        for (Integer step = 0; step <= finalStepDone; ++step)
         {
-            thisStep = evolver_->currentStep();
-            Size storeStep = thisStep+1;
-            weight *= evolver_->advanceStep();
-
-            done = product_->nextTimeStep(evolver_->currentState(),
-                numberCashFlowsThisStep_,
-                cashFlowsGenerated_);
-
-            lastForwards_ = currentForwards_;
-            currentForwards_ =  evolver_->currentState().forwardRates();
-
-            for (unsigned long i=0; i < numberRates_; ++i)
-            {
-                Real x=  evolver_->currentState().discountRatio(i+1,i);
-                stepsDiscounts_[i+1] = x;
-                StepsDiscountsSquared_[storeStep][i] = x*x;
-
-                LIBORRatios_[storeStep][i] = currentForwards_[i]/lastForwards_[i];
-                LIBORRates_[storeStep][i] = currentForwards_[i];
-                Discounts_[storeStep][i+1] = evolver_->currentState().discountRatio(i+1,0);
-            }
-
-            jacobianComputers_[thisStep].getBumps(lastForwards_,
-                                         stepsDiscounts_,
-                                         currentForwards_,
-                                         evolver_->browniansThisStep(),
-                                         jacobiansThisPaths_[thisStep]);
-
-//            gaussians_[thisStep] = evolver_->browniansThisStep();
-
-
-
-            // for each product...
-            for (Size i=0; i<numberProducts_; ++i)
-            {
-                // ...and each cash flow...
-                for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j)
-                {
-                    Size k = cashFlowsGenerated_[i][j].timeIndex;
-                    ++numberCashFlowsThisIndex_[i][ k];
-
-                    for (Size l=0; l <= numberRates_; ++l)
-                        totalCashFlowsThisIndex_[i][k][l] += cashFlowsGenerated_[i][j].amount[l]*weight;
-
-                }
-            }
-
+            std::copy(path.LIBORRates.row_begin(step), path.LIBORRates.row_end(step),
+                      workspace.lastForwards.begin());
+            std::copy(path.LIBORRates.row_begin(step+1), path.LIBORRates.row_end(step+1),
+                      workspace.currentForwards.begin());
+            std::copy(path.StepsDiscounts.row_begin(step+1), path.StepsDiscounts.row_end(step+1),
+                      workspace.stepsDiscounts.begin());
+            std::copy(path.brownians.row_begin(step), path.brownians.row_end(step),
+                      workspace.brownians.begin());
+
+            workspace.jacobianComputers[step].getBumps(workspace.lastForwards,
+                                                       workspace.stepsDiscounts,
+                                                       workspace.currentForwards,
+                                                       workspace.brownians,
+                                                       jacobiansThisPaths_[step]);
+        }
 
-        } while (!done);
+        const Matrix& LIBORRates_ = path.LIBORRates;
+        const Matrix& LIBORRatios_ = path.LIBORRatios;
+        const Matrix& StepsDiscountsSquared_ = path.StepsDiscountsSquared;
+        const std::vector<std::vector<Size> >& numberCashFlowsThisIndex_ =
+            path.numberCashFlowsThisIndex;
+        const std::vector<Matrix>& totalCashFlowsThisIndex_ = path.totalCashFlowsThisIndex;
 
         // ok we've gathered cash-flows, still have to backwards computation
 
@@ -950,8 +977,6 @@ namespace QuantLib {
 
         bool flowsFound = false;
 
-        Integer finalStepDone = thisStep;
-
         for (Integer currentStep =  numberSteps_-1; currentStep >=0 ; --currentStep) // must be a signed type as we go negative
         {
             Integer stepToUse = std::min<Integer>(currentStep, finalStepDone)+1;
@@ -970,7 +995,7 @@ namespace QuantLib {
                 if (!noFlows)
                 {
                     if (doDeflation_)
-                        discounters_[cashFlowIndex].getFactors(LIBORRates_, Discounts_,stepToUse, deflatorAndDerivatives_); // get amount to discount cash flow by and amount to multiply its derivatives by
+                        discounters_[cashFlowIndex].getFactors(LIBORRates_, path.Discounts,stepToUse, deflatorAndDerivatives_); // get amount to discount cash flow by and amount to multiply its derivatives by
 
                     for (Size j=0; j < numberProducts_; ++j)
                     {
@@ -989,10 +1014,7 @@ namespace QuantLib {
                                 {
                                     thisDerivative *= deflatorAndDerivatives_[0];
                                     thisDerivative +=  totalCashFlowsThisIndex_[j][cashFlowIndex][0]*deflatorAndDerivatives_[i];
-                                    fullDerivatives_[i-1] = thisDerivative;
                                 }
-                                else
-                                    fullDerivatives_[i-1] = thisDerivative;
 
                                 V_[j][stepToUse][i-1] += thisDerivative; // zeroth row of V is t =0 not t_0
                             } // end of  for (Size i=1; i <= numberRates_; ++i)
@@ -1055,40 +1077,8 @@ namespace QuantLib {
         } // end of  for (Integer currentStep =  numberSteps_-1; currentStep >=0 ; --currentStep)
 
 
-        // all V matrices computed we now compute the elementary vegas for this path 
-
-        for (Size i=0; i < numberProducts_; ++i)
-        {
-                for (Size j=0; j < numberSteps_; ++j)
-                {
-                    Size nextIndex = j+1;
-
-                    // we know V, we need to pair against the senstivity of the rate to the elementary vega
-                    // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step
-
-                    for (Size k=0; k < numberRates_; ++k)
-                        for (Size f=0; f < factors_; ++f)
-                        {
-                                Real sensitivity =0.0;
-
-                                for (Size r=0; r < numberRates_; ++r)
-                                {
-                                        sensitivity += V_[i][nextIndex][r]*jacobiansThisPaths_[j][r][k][f];
-
-                                  }
-/*
-                                  if (j ==distinguishedStep_ && k ==distinguishedRate_ &&f== distinguishedFactor_)
-                                      std::cout << sensitivity << "," <<  jacobiansThisPaths_[j][j][k][f] << "," << gaussians_[j][f] << "," << V_[i][nextIndex][j] << "," << LIBORRates_[nextIndex][j] << "\n";
-  */                
-
-
-                                elementary_vegas_ThisPath_[i][j][k][f] = sensitivity;
-                        }
-                }
-        }
-
-
-        // write answer into values
+        // all V matrices computed we now compute the elementary vegas for this path
+        // and write the answer into values
 
         Size entriesPerProduct = 1+numberRates_+numberElementaryVegas_;
 
@@ -1098,43 +1088,62 @@ namespace QuantLib {
             for (Size j=0; j < numberRates_; ++j)
                 values[i*entriesPerProduct+1+j] = V_[i][0][j]*initialNumeraireValue_;
 
-            for (Size k=0; k < numberSteps_; ++k)
-                for (Size l=0; l < numberRates_; ++l)
-                    for (Size m=0; m < factors_; ++m)
-                        values[i*entriesPerProduct + numberRates_ +1 + m+ l*factors_ + k*numberRates_*factors_] = elementary_vegas_ThisPath_[i][k][l][m]*initialNumeraireValue_;
+            for (Size j=0; j < numberSteps_; ++j)
+            {
+                Size nextIndex = j+1;
+
+                // we know V, we need to pair against the senstivity of the rate to the elementary vega
+                // note the simplification here arising from the fact that the elementary vega affects the evolution on precisely one step
+
+                for (Size k=0; k < numberRates_; ++k)
+                    for (Size f=0; f < factors_; ++f)
+                    {
+                        Real sensitivity =0.0;
+
+                        for (Size r=0; r < numberRates_; ++r)
+                            sensitivity += V_[i][nextIndex][r]*jacobiansThisPaths_[j][r][k][f];
 
+                        values[i*entriesPerProduct + numberRates_ +1 + f+ k*factors_ + j*numberRates_*factors_] = sensitivity*initialNumeraireValue_;
+                    }
+            }
         }
 
-        return 1.0; // we have put the weight in already, this results in lower variance since weight changes along the path
-    
-}
+        // we have put the weight in already, this results in lower variance since weight changes along the path
+    }
 
     void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
         Size numberOfPaths)
     {
-        Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
+        Size numberOfValues = product_->numberOfProducts()*(1+numberRates_+numberElementaryVegas_);
+        means.resize(numberOfValues);
+        errors.resize(numberOfValues);
+        std::vector<Real> sums(numberOfValues,0.0);
+        std::vector<Real> sumsqs(numberOfValues,0.0);
 
-        std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
+        Matrix values(paths_.size(), numberOfValues);
 
+        for (Size first=0; first<numberOfPaths; first+=paths_.size())
+        {
+            Size paths = std::min(paths_.size(), numberOfPaths-first);
+            Size batches = (paths+pathsPerBatch_-1)/pathsPerBatch_;
 
+            // the evolver is shared, so the paths are simulated serially...
+            for (Size i=0; i<paths; ++i)
+                simulatePath(paths_[i]);
 
-        for (Size i=0; i<numberOfPaths; ++i)
-        {
-          singlePathValues(values);
-          
-          for (Size j=0; j < values.size(); ++j)
+            // ...while the backward computations run concurrently
+            #pragma omp parallel for if(batches > 1)
+            for (long b=0; b<long(batches); ++b)
             {
-                sums[j] += values[j];
-                sumsqs[j] += values[j]*values[j];
-
+                Size end = std::min<Size>((b+1)*pathsPerBatch_, paths);
+                for (Size i=b*pathsPerBatch_; i<end; ++i)
+                    singlePathValues(paths_[i], workspaces_[b], values.row_begin(i));
             }
+
+            accumulatePathValues(values, paths, sums, sumsqs);
         }
 
-        for (Size j=0; j < values.size(); ++j)
+        for (Size j=0; j < numberOfValues; ++j)
             {
                 means[j] = sums[j]/numberOfPaths;
                 Real meanSq = sumsqs[j]/numberOfPaths;
@@ -100,6 +100,35 @@ namespace QuantLib {
     };
 
 
+    namespace detail {
+
+        //! quantities recorded along a log-normal Euler path
+        /*! They are collected by the forward simulation and used by the
+            backward computation of the pathwise vega engines; rows are
+            indexed by step, with row 0 corresponding to t=0.
+        */
+        struct PathwiseEulerPath {
+            PathwiseEulerPath() = default;
+            PathwiseEulerPath(Size numberSteps,
+                              Size numberRates,
+                              Size numberFactors,
+                              Size numberProducts,
+                              Size numberCashFlowTimes);
+
+            Matrix LIBORRates;             // step and rate number
+            Matrix LIBORRatios;            // step and rate number
+            Matrix Discounts;              // step and rate number, P(t_0, t_j)
+            Matrix StepsDiscounts;         // step and rate number, P(t_j+1, t_j)
+            Matrix StepsDiscountsSquared;  // step and rate number
+            Matrix brownians;              // step and factor
+            std::vector<std::vector<Size> > numberCashFlowsThisIndex;
+            std::vector<Matrix> totalCashFlowsThisIndex;
+            Integer finalStepDone = 0;
+        };
+
+    }
+
+
    //! Engine collecting cash flows along a market-model simulation for doing pathwise computation of Deltas and vegas
     // using Giles--Glasserman smoking adjoints method
     // note only works with displaced LMM, 
@@ -110,6 +139,11 @@ namespace QuantLib {
     // To compute a vega means changing the pseudo-square root at each time step
     // So for each vega, we have a vector of matrices. So we need a vector of vectors of matrices to compute all the vegas.
     // We do the outermost vector by time step and inner one by which vega.
+    //
+    // Paths are simulated in rounds of concurrentBatches*pathsPerBatch paths;
+    // the forward simulation is performed serially, while the backward
+    // computations of the batches run concurrently when OpenMP is enabled.
+    // Results do not depend on the number of threads.
     // This is tested in MarketModelTest::testPathwiseVegas
 
     class PathwiseVegasAccountingEngine 
@@ -121,13 +155,32 @@ namespace QuantLib {
             ext::shared_ptr<MarketModel>
                 pseudoRootStructure, // we need pseudo-roots and displacements
             const std::vector<std::vector<Matrix> >& VegaBumps,
-            Real initialNumeraireValue);
+            Real initialNumeraireValue,
+            Size pathsPerBatch = 16,
+            Size concurrentBatches = 8);
 
         void multiplePathValues(std::vector<Real>& means,
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
       private:
-          Real singlePathValues(std::vector<Real>& values);
+        // per-batch workspace for the backward computation
+        struct Workspace {
+            std::vector<RatePseudoRootJacobian> jacobianComputers;
+            std::vector<Real> lastForwards, currentForwards;
+            std::vector<Real> stepsDiscounts, brownians;
+            std::vector<Real> numerairesHeld;
+            std::vector<Matrix> V;  // one V for each product, with components for each time step and rate
+            Matrix partials; // dimensions are factor and rate
+            Matrix vegasThisPath; // dimensions are product and which vega
+            std::vector<Matrix> jacobiansThisPaths; // dimensions are step, rate and factor
+            std::vector<Real> deflatorAndDerivatives;
+            std::vector<Real> fullDerivatives;
+        };
+
+        void simulatePath(detail::PathwiseEulerPath& path);
+        void singlePathValues(const detail::PathwiseEulerPath& path,
+                              Workspace& workspace,
+                              Real* values) const;
 
         ext::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -140,43 +193,21 @@ namespace QuantLib {
         Size numberCashFlowTimes_;
         Size numberSteps_;
         Size numberBumps_;
+        Size pathsPerBatch_;
 
-        std::vector<RatePseudoRootJacobian> jacobianComputers_;
-
-        
         bool doDeflation_;
 
 
         // workspace
-        std::vector<Real> currentForwards_, lastForwards_;
-        std::vector<Real> numerairesHeld_;
         std::vector<Size> numberCashFlowsThisStep_;
         std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >
                                                          cashFlowsGenerated_;
         std::vector<MarketModelPathwiseDiscounter> discounters_;
 
-        std::vector<Matrix> V_;  // one V for each product, with components for each time step and rate
-
-        Matrix LIBORRatios_; // dimensions are step and rate number
-        Matrix Discounts_; // dimensions are step and rate number, goes from 0 to n. P(t_0, t_j)
-
-        Matrix StepsDiscountsSquared_; // dimensions are step and rate number
-        std::vector<Real> stepsDiscounts_;
-
-        Matrix LIBORRates_; // dimensions are step and rate number
-        Matrix partials_; // dimensions are factor and rate
-
-        Matrix vegasThisPath_; // dimensions are product and which vega
-        std::vector<Matrix> jacobiansThisPaths_; // dimensions are step, rate and factor
-
-        std::vector<Real> deflatorAndDerivatives_;
-        std::vector<Real> fullDerivatives_;
-        
-        std::vector<std::vector<Size> > numberCashFlowsThisIndex_;
-        std::vector<Matrix> totalCashFlowsThisIndex_; // need product cross times cross which sensitivity
-
         std::vector<std::vector<Size> > cashFlowIndicesThisStep_;
 
+        std::vector<detail::PathwiseEulerPath> paths_;
+        std::vector<Workspace> workspaces_;
     };
 
    //! Engine collecting cash flows along a market-model simulation for doing pathwise computation of Deltas and vegas
@@ -191,6 +222,8 @@ namespace QuantLib {
     // We do the outermost vector by time step and inner one by which vega.
     // This implementation is different in that all the linear combinations by the bumps are done as late as possible,
     // whereas PathwiseVegasAccountingEngine does them as early as possible. 
+    //
+    // Paths are simulated in rounds as in PathwiseVegasAccountingEngine.
     // This is tested in MarketModelTest::testPathwiseVegas
 
     class PathwiseVegasOuterAccountingEngine 
@@ -202,7 +235,9 @@ namespace QuantLib {
             ext::shared_ptr<MarketModel>
                 pseudoRootStructure, // we need pseudo-roots and displacements
             const std::vector<std::vector<Matrix> >& VegaBumps,
-            Real initialNumeraireValue);
+            Real initialNumeraireValue,
+            Size pathsPerBatch = 16,
+            Size concurrentBatches = 8);
 
         //! Use to get vegas with respect to VegaBumps
         void multiplePathValues(std::vector<Real>& means,
@@ -215,7 +250,22 @@ namespace QuantLib {
                                 Size numberOfPaths);
 
       private:
-          Real singlePathValues(std::vector<Real>& values);
+        // per-batch workspace for the backward computation
+        struct Workspace {
+            std::vector<RatePseudoRootJacobianAllElements> jacobianComputers;
+            std::vector<Real> lastForwards, currentForwards;
+            std::vector<Real> stepsDiscounts, brownians;
+            std::vector<Real> numerairesHeld;
+            std::vector<Matrix> V;  // one V for each product, with components for each time step and rate
+            Matrix partials; // dimensions are factor and rate
+            std::vector<std::vector<Matrix> > jacobiansThisPaths; // dimensions are step, rate, rate and factor
+            std::vector<Real> deflatorAndDerivatives;
+        };
+
+        void simulatePath(detail::PathwiseEulerPath& path);
+        void singlePathValues(const detail::PathwiseEulerPath& path,
+                              Workspace& workspace,
+                              Real* values) const;
 
         ext::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
@@ -231,51 +281,21 @@ namespace QuantLib {
         Size factors_;
         Size numberBumps_;
         Size numberElementaryVegas_;
+        Size pathsPerBatch_;
 
-        std::vector<RatePseudoRootJacobianAllElements> jacobianComputers_;
-
-        
         bool doDeflation_;
 
 
         // workspace
-        std::vector<Real> currentForwards_, lastForwards_;
-        std::vector<Real> numerairesHeld_;
         std::vector<Size> numberCashFlowsThisStep_;
         std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >
                                                          cashFlowsGenerated_;
         std::vector<MarketModelPathwiseDiscounter> discounters_;
 
-        std::vector<Matrix> V_;  // one V for each product, with components for each time step and rate
-
-        Matrix LIBORRatios_; // dimensions are step and rate number
-        Matrix Discounts_; // dimensions are step and rate number, goes from 0 to n. P(t_0, t_j)
-
-        Matrix StepsDiscountsSquared_; // dimensions are step and rate number
-        std::vector<Real> stepsDiscounts_;
-
-        Matrix LIBORRates_; // dimensions are step and rate number
-        Matrix partials_; // dimensions are factor and rate
-
-        std::vector<std::vector<Matrix>   > elementary_vegas_ThisPath_;  // dimensions are product, step,  rate and factor
-        std::vector<std::vector<Matrix> > jacobiansThisPaths_;                      // dimensions are step, rate, rate and factor
-
-        std::vector<Real> deflatorAndDerivatives_;
-        std::vector<Real> fullDerivatives_;
-        
-        std::vector<std::vector<Size> > numberCashFlowsThisIndex_;
-        std::vector<Matrix> totalCashFlowsThisIndex_; // need product cross times cross which sensitivity
-
         std::vector<std::vector<Size> > cashFlowIndicesThisStep_;
-/*
-        // experimental
-
-        std::vector<std::vector<Real> > gaussians_;
-        int distinguishedFactor_;
-        int distinguishedRate_;
-        int  distinguishedStep_;
 
-*/
+        std::vector<detail::PathwiseEulerPath> paths_;
+        std::vector<Workspace> workspaces_;
     };
 
 }
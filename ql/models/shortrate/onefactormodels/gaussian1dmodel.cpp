@@ -275,6 +275,23 @@ Real Gaussian1dModel::gaussianShiftedPolynomialIntegral(
         a * h * h * h * h - b * h * h * h + c * h * h - d * h + e, x0, x1);
 }
 
+Array Gaussian1dModel::numerairesImpl(const Time t, const Array& y,
+                                      const Handle<YieldTermStructure>& yts) const {
+    Array result(y.size());
+    for (Size j = 0; j < y.size(); ++j)
+        result[j] = numeraireImpl(t, y[j], yts);
+    return result;
+}
+
+Matrix Gaussian1dModel::zerobondsImpl(const Array& T, const Time t, const Array& y,
+                                      const Handle<YieldTermStructure>& yts) const {
+    Matrix result(T.size(), y.size());
+    for (Size i = 0; i < T.size(); ++i)
+        for (Size j = 0; j < y.size(); ++j)
+            result[i][j] = zerobondImpl(T[i], t, y[j], yts);
+    return result;
+}
+
 Array Gaussian1dModel::yGrid(
     const Real stdDevs, const int gridPoints, const Real T, const Real t, const Real y) const {
 
@@ -28,6 +28,7 @@
 #ifndef quantlib_gaussian1dmodel_hpp
 #define quantlib_gaussian1dmodel_hpp
 
+#include <ql/math/matrix.hpp>
 #include <ql/models/model.hpp>
 #include <ql/models/parameter.hpp>
 #include <ql/indexes/iborindex.hpp>
@@ -94,6 +95,31 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
                   Real y = 0.0,
                   const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
 
+    /*! \name Grid evaluation
+        These methods evaluate the numeraire and zerobonds for all
+        the values of the state variable in a grid (and, possibly,
+        for several maturities) at once.
+    */
+    //@{
+    Array numeraire(Time t,
+                    const Array& y,
+                    const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+
+    Array zerobond(Time T,
+                   Time t,
+                   const Array& y,
+                   const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+
+    /*! The \f$ (i,j) \f$-th element of the returned matrix is the
+        zerobond maturing at \f$ T_i \f$ for the \f$ j \f$-th value
+        of the state variable.
+    */
+    Matrix zerobond(const Array& T,
+                    Time t,
+                    const Array& y,
+                    const Handle<YieldTermStructure>& yts = Handle<YieldTermStructure>()) const;
+    //@}
+
     Real zerobondOption(const Option::Type& type,
                         const Date& expiry,
                         const Date& valueDate,
@@ -197,6 +223,18 @@ class Gaussian1dModel : public TermStructureConsistentModel, public LazyObject {
     virtual Real
     zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const = 0;
 
+    /*! The default implementations of the grid methods call
+        numeraireImpl and zerobondImpl for each point; derived classes
+        can override them with more efficient vector code.
+    */
+    virtual Array
+    numerairesImpl(Time t, const Array& y, const Handle<YieldTermStructure>& yts) const;
+
+    virtual Matrix zerobondsImpl(const Array& T,
+                                 Time t,
+                                 const Array& y,
+                                 const Handle<YieldTermStructure>& yts) const;
+
     void performCalculations() const override {
         evaluationDate_ = Settings::instance().evaluationDate();
         enforcesTodaysHistoricFixings_ =
@@ -266,6 +304,25 @@ Gaussian1dModel::zerobond(const Date &maturity, const Date &referenceDate,
                         : 0.0,
                     y, yts);
 }
+
+inline Array
+Gaussian1dModel::numeraire(const Time t, const Array &y,
+                           const Handle<YieldTermStructure> &yts) const {
+    return numerairesImpl(t, y, yts);
+}
+
+inline Array
+Gaussian1dModel::zerobond(const Time T, const Time t, const Array &y,
+                          const Handle<YieldTermStructure> &yts) const {
+    Matrix p = zerobondsImpl(Array(1, T), t, y, yts);
+    return Array(p.row_begin(0), p.row_end(0));
+}
+
+inline Matrix
+Gaussian1dModel::zerobond(const Array &T, const Time t, const Array &y,
+                          const Handle<YieldTermStructure> &yts) const {
+    return zerobondsImpl(T, t, y, yts);
+}
 }
 
 #endif
@@ -19,6 +19,7 @@
 
 #include <ql/models/shortrate/onefactormodels/gsr.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -220,4 +221,61 @@ Real Gsr::numeraireImpl(const Time t, const Real y,
                    : yts->discount(p->getForwardMeasureTime());
     return zerobond(p->getForwardMeasureTime(), t, y, yts);
 }
+
+Matrix Gsr::zerobondsImpl(const Array& T, const Time t, const Array& y,
+                          const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    Matrix result(T.size(), y.size());
+
+    if (t == 0.0) {
+        for (Size i = 0; i < T.size(); ++i)
+            std::fill(result.row_begin(i), result.row_end(i),
+                      yts.empty() ? this->termStructure()->discount(T[i], true)
+                                  : yts->discount(T[i], true));
+        return result;
+    }
+
+    ext::shared_ptr<GsrProcess> p = ext::static_pointer_cast<GsrProcess>(stateProcess_);
+
+    // the state-dependent part is the same as in zerobondImpl; the
+    // terms depending on t only are computed once for the whole grid
+    Real stdDev = stateProcess_->stdDeviation(0.0, 0.0, t);
+    Real expectation = stateProcess_->expectation(0.0, 0.0, t);
+    Real yt = p->y(t);
+    Real dt = yts.empty() ? termStructure()->discount(t, true)
+                          : yts->discount(t, true);
+
+    Array x(y.size());
+    for (Size j = 0; j < y.size(); ++j)
+        x[j] = y[j] * stdDev + expectation;
+
+    for (Size i = 0; i < T.size(); ++i) {
+        Real gtT = p->G(t, T[i], 0.0);
+        Real d = (yts.empty() ? termStructure()->discount(T[i], true)
+                              : yts->discount(T[i], true)) / dt;
+        Real c = 0.5 * yt * gtT * gtT;
+        for (Size j = 0; j < y.size(); ++j)
+            result[i][j] = d * exp(-x[j] * gtT - c);
+    }
+
+    return result;
+}
+
+Array Gsr::numerairesImpl(const Time t, const Array& y,
+                          const Handle<YieldTermStructure> &yts) const {
+
+    calculate();
+
+    ext::shared_ptr<GsrProcess> p = ext::static_pointer_cast<GsrProcess>(stateProcess_);
+
+    if (t == 0)
+        return Array(y.size(),
+                     yts.empty()
+                         ? this->termStructure()->discount(p->getForwardMeasureTime(),
+                                                           true)
+                         : yts->discount(p->getForwardMeasureTime()));
+    return zerobond(p->getForwardMeasureTime(), t, y, yts);
+}
 }
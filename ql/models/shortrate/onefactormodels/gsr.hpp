@@ -141,6 +141,14 @@ class Gsr : public Gaussian1dModel, public CalibratedModel {
 
     Real zerobondImpl(Time T, Time t, Real y, const Handle<YieldTermStructure>& yts) const override;
 
+    Array
+    numerairesImpl(Time t, const Array& y, const Handle<YieldTermStructure>& yts) const override;
+
+    Matrix zerobondsImpl(const Array& T,
+                         Time t,
+                         const Array& y,
+                         const Handle<YieldTermStructure>& yts) const override;
+
     void generateArguments() override {
         ext::static_pointer_cast<GsrProcess>(stateProcess_)->flushCache();
         ext::static_pointer_cast<GsrProcess>(stateProcess_)->setVols(sigma_.params());
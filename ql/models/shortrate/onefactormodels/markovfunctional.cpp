@@ -28,6 +28,7 @@
 #include <ql/termstructures/volatility/sabrinterpolatedsmilesection.hpp>
 #include <ql/termstructures/volatility/smilesection.hpp>
 #include <ql/termstructures/volatility/smilesectionutils.hpp>
+#include <algorithm>
 #include <utility>
 
 namespace QuantLib {
@@ -753,15 +754,20 @@ namespace QuantLib {
         Real stdDev_0_T = stateProcess_->stdDeviation(0.0, 0.0, T);
         Real stdDev_t_T = stateProcess_->stdDeviation(t, 0.0, T - t);
 
+        // the numeraire is evaluated on all the integration points at
+        // once, so that the interpolation is located only once
+        const Size n = modelSettings_.gaussHermitePoints_;
+        Array ya(y.size() * n);
         for (Size j = 0; j < y.size(); j++) {
-            Array ya(modelSettings_.gaussHermitePoints_);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                ya[i] = (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
-                        stdDev_0_T;
+            for (Size i = 0; i < n; i++) {
+                ya[j * n + i] = (y[j] * stdDev_0_t + stdDev_t_T * normalIntegralX_[i]) /
+                                stdDev_0_T;
             }
-            Array res = numeraireArray(T, ya);
-            for (Size i = 0; i < modelSettings_.gaussHermitePoints_; i++) {
-                result[j] += normalIntegralW_[i] / res[i];
+        }
+        Array res = numeraireArray(T, ya);
+        for (Size j = 0; j < y.size(); j++) {
+            for (Size i = 0; i < n; i++) {
+                result[j] += normalIntegralW_[i] / res[j * n + i];
             }
         }
 
@@ -799,6 +805,50 @@ namespace QuantLib {
                                      termStructure()->discount(T)));
     }
 
+    Array MarkovFunctional::numerairesImpl(
+        const Time t, const Array& y,
+        const Handle<YieldTermStructure> &yts) const {
+
+        if (t == 0)
+            return Array(y.size(),
+                         yts.empty()
+                             ? this->termStructure()->discount(numeraireTime(), true)
+                             : yts->discount(numeraireTime()));
+
+        return numeraireArray(t, y) *
+               (yts.empty() ? Real(1.0)
+                            : (yts->discount(numeraireTime()) /
+                               yts->discount(t) * termStructure()->discount(t) /
+                               termStructure()->discount(numeraireTime())));
+    }
+
+    Matrix
+    MarkovFunctional::zerobondsImpl(const Array& T, const Time t, const Array& y,
+                                    const Handle<YieldTermStructure> &yts) const {
+
+        Matrix result(T.size(), y.size());
+
+        if (t == 0.0) {
+            for (Size i = 0; i < T.size(); ++i)
+                std::fill(result.row_begin(i), result.row_end(i),
+                          yts.empty() ? this->termStructure()->discount(T[i], true)
+                                      : yts->discount(T[i], true));
+            return result;
+        }
+
+        // the numeraire at t is shared by all maturities
+        Array numeraire = numeraireArray(t, y);
+        for (Size i = 0; i < T.size(); ++i) {
+            Array z = deflatedZerobondArray(T[i], t, y) * numeraire *
+                      (yts.empty() ? Real(1.0)
+                                   : (yts->discount(T[i]) / yts->discount(t) *
+                                      termStructure()->discount(t) /
+                                      termStructure()->discount(T[i])));
+            std::copy(z.begin(), z.end(), result.row_begin(i));
+        }
+        return result;
+    }
+
     Real MarkovFunctional::deflatedZerobond(Time T, Time t,
                                             Real y) const {
 
@@ -28,6 +28,7 @@
 #include <ql/math/array.hpp>
 #include <ql/timegrid.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -84,6 +85,18 @@ namespace QuantLib {
         virtual void partialRollback(DiscretizedAsset&,
                                      Time to) const = 0;
 
+        /*! Roll back a set of assets initialized on this lattice until
+            the given time, performing any needed adjustment.  The
+            assets can be at different times; each of them is rolled
+            back from its own time.
+
+            The default implementation rolls back each asset in turn;
+            lattices can override it so that the work needed at each
+            step is shared between the assets.
+        */
+        virtual void rollbackAll(const std::vector<DiscretizedAsset*>& assets,
+                                 Time to) const;
+
         //! computes the present value of an asset.
         virtual Real presentValue(DiscretizedAsset&) const = 0;
 
@@ -2,6 +2,7 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/patterns/curiouslyrecurring.hpp>
+#include <ql/patterns/dependencygraph.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/patterns/observable.hpp>
 #include <ql/patterns/singleton.hpp>
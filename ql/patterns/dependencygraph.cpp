@@ -0,0 +1,276 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/inflationcouponpricer.hpp>
+#include <ql/patterns/dependencygraph.hpp>
+#include <ql/pricingengine.hpp>
+#include <ql/termstructure.hpp>
+#include <boost/core/demangle.hpp>
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+#include <string>
+#include <typeinfo>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class T>
+        void sortAndRemoveDuplicates(std::vector<T>& v) {
+            std::sort(v.begin(), v.end());
+            v.erase(std::unique(v.begin(), v.end()), v.end());
+        }
+
+        // objects storing intermediate results while in use; lazy
+        // term structures are nodes and are calculated beforehand
+        bool isStateful(const Observable* o) {
+            return dynamic_cast<const PricingEngine*>(o) != nullptr ||
+                   dynamic_cast<const FloatingRateCouponPricer*>(o) != nullptr ||
+                   dynamic_cast<const InflationCouponPricer*>(o) != nullptr ||
+                   dynamic_cast<const TermStructure*>(o) != nullptr;
+        }
+
+        Size findRoot(std::vector<Size>& parent, Size i) {
+            while (parent[i] != i)
+                i = parent[i] = parent[parent[i]];
+            return i;
+        }
+
+    }
+
+    DependencyGraph::DependencyGraph(
+                     const std::vector<ext::shared_ptr<Observable>>& roots) {
+        for (const auto& root : roots)
+            add(root);
+    }
+
+    void DependencyGraph::add(const ext::shared_ptr<Observable>& root) {
+        QL_REQUIRE(root, "null object passed");
+        visit(root);
+    }
+
+    const DependencyGraph::Reach&
+    DependencyGraph::visit(const ext::shared_ptr<Observable>& o) {
+        auto found = visited_.find(o.get());
+        if (found != visited_.end())
+            return found->second;
+
+        // The entry stays empty while its observables are visited, so
+        // that notification cycles (if any) are cut here.  References
+        // to map elements are not invalidated by later insertions.
+        Reach& reach = visited_[o.get()];
+
+        Reach reached;
+        auto observer = ext::dynamic_pointer_cast<Observer>(o);
+        if (observer != nullptr) {
+            for (const auto& observable : observer->observables()) {
+                const Reach& r = visit(observable);
+                reached.nodes.insert(reached.nodes.end(),
+                                     r.nodes.begin(), r.nodes.end());
+                reached.observables.insert(reached.observables.end(),
+                                           r.observables.begin(),
+                                           r.observables.end());
+            }
+        }
+        sortAndRemoveDuplicates(reached.nodes);
+        sortAndRemoveDuplicates(reached.observables);
+
+        auto lazy = ext::dynamic_pointer_cast<LazyObject>(o);
+        if (lazy != nullptr) {
+            // dependencies were visited first, so they already have
+            // lower indices; observables are not propagated further
+            // since they can be reached through the dependencies.
+            Size level = 0;
+            for (Size j : reached.nodes)
+                level = std::max(level, levels_[j] + 1);
+            std::vector<const Observable*> stateful;
+            for (const Observable* x : reached.observables) {
+                if (isStateful(x))
+                    stateful.push_back(x);
+            }
+            reach.nodes.push_back(nodes_.size());
+            nodes_.push_back(lazy);
+            dependencies_.push_back(reached.nodes);
+            observables_.push_back(reached.observables);
+            stateful_.push_back(stateful);
+            levels_.push_back(level);
+        } else {
+            reached.observables.insert(
+                std::lower_bound(reached.observables.begin(),
+                                 reached.observables.end(), o.get()),
+                o.get());
+            reach = reached;
+        }
+        return reach;
+    }
+
+    const ext::shared_ptr<LazyObject>& DependencyGraph::node(Size i) const {
+        QL_REQUIRE(i < nodes_.size(),
+                   "node " << i << " out of range [0, " << nodes_.size() << ")");
+        return nodes_[i];
+    }
+
+    const std::vector<Size>& DependencyGraph::dependencies(Size i) const {
+        QL_REQUIRE(i < nodes_.size(),
+                   "node " << i << " out of range [0, " << nodes_.size() << ")");
+        return dependencies_[i];
+    }
+
+    const std::vector<const Observable*>&
+    DependencyGraph::observables(Size i) const {
+        QL_REQUIRE(i < nodes_.size(),
+                   "node " << i << " out of range [0, " << nodes_.size() << ")");
+        return observables_[i];
+    }
+
+    Size DependencyGraph::level(Size i) const {
+        QL_REQUIRE(i < nodes_.size(),
+                   "node " << i << " out of range [0, " << nodes_.size() << ")");
+        return levels_[i];
+    }
+
+    Size DependencyGraph::levels() const {
+        return levels_.empty() ? 0 :
+            *std::max_element(levels_.begin(), levels_.end()) + 1;
+    }
+
+    std::vector<Size> DependencyGraph::nodesAtLevel(Size level) const {
+        std::vector<Size> result;
+        for (Size i=0; i<nodes_.size(); ++i) {
+            if (levels_[i] == level)
+                result.push_back(i);
+        }
+        return result;
+    }
+
+    void DependencyGraph::calculate() const {
+        calculateNeeded(std::vector<bool>(nodes_.size(), true));
+    }
+
+    void DependencyGraph::calculate(const std::vector<Size>& nodes) const {
+        std::vector<bool> needed(nodes_.size(), false);
+        for (Size i : nodes) {
+            QL_REQUIRE(i < nodes_.size(),
+                       "node " << i << " out of range [0, " << nodes_.size() << ")");
+            needed[i] = true;
+        }
+        // dependencies have lower indices, so a single backward
+        // pass marks all of them
+        for (Size i=nodes_.size(); i>0; --i) {
+            if (needed[i-1]) {
+                for (Size j : dependencies_[i-1])
+                    needed[j] = true;
+            }
+        }
+        calculateNeeded(needed);
+    }
+
+    void DependencyGraph::calculateNeeded(const std::vector<bool>& needed) const {
+        auto isDone = [this](Size i) {
+            return nodes_[i]->calculated_ || nodes_[i]->frozen_;
+        };
+        // nodes write their own entries, so that no locking is needed
+        std::vector<std::string> errors(nodes_.size());
+        auto tryCalculate = [this, &errors](Size i) {
+            try {
+                nodes_[i]->calculate();
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        };
+
+        for (Size level=0; level<levels(); ++level) {
+            std::vector<Size> ready, deferred;
+            for (Size i : nodesAtLevel(level)) {
+                if (!needed[i] || isDone(i))
+                    continue;
+                if (std::all_of(dependencies_[i].begin(),
+                                dependencies_[i].end(), isDone))
+                    ready.push_back(i);
+                else
+                    deferred.push_back(i);
+            }
+
+            // nodes sharing a stateful observable are put in the same group
+            std::vector<Size> parent(ready.size());
+            std::iota(parent.begin(), parent.end(), Size(0));
+            std::map<const Observable*, Size> owners;
+            for (Size k=0; k<ready.size(); ++k) {
+                for (const Observable* o : stateful_[ready[k]]) {
+                    auto owner = owners.find(o);
+                    if (owner == owners.end())
+                        owners[o] = k;
+                    else
+                        parent[findRoot(parent, k)] = findRoot(parent, owner->second);
+                }
+            }
+            std::map<Size, std::vector<Size>> groupsByRoot;
+            for (Size k=0; k<ready.size(); ++k)
+                groupsByRoot[findRoot(parent, k)].push_back(ready[k]);
+            std::vector<std::vector<Size>> groups;
+            groups.reserve(groupsByRoot.size());
+            for (auto& g : groupsByRoot)
+                groups.push_back(std::move(g.second));
+
+            #pragma omp parallel for schedule(dynamic)
+            for (long g=0; g<static_cast<long>(groups.size()); ++g) {
+                for (Size i : groups[g])
+                    tryCalculate(i);
+            }
+
+            // nodes depending on failed calculations are calculated
+            // sequentially, since they might trigger the calculation
+            // of shared dependencies.
+            for (Size i : deferred)
+                tryCalculate(i);
+        }
+
+        Size failures = 0, first = nodes_.size();
+        for (Size i=0; i<nodes_.size(); ++i) {
+            if (!errors[i].empty()) {
+                ++failures;
+                first = std::min(first, i);
+            }
+        }
+        if (failures > 0) {
+            const LazyObject& n = *nodes_[first];
+            QL_FAIL(failures << " node(s) failed to calculate; node " << first
+                    << " (" << boost::core::demangle(typeid(n).name())
+                    << "): " << errors[first]);
+        }
+    }
+
+    void DependencyGraph::toGraphviz(std::ostream& out) const {
+        out << "digraph dependencies {\n";
+        for (Size i=0; i<nodes_.size(); ++i) {
+            const LazyObject& n = *nodes_[i];
+            out << "    n" << i << " [label=\""
+                << boost::core::demangle(typeid(n).name())
+                << "\\nlevel " << levels_[i] << "\"];\n";
+        }
+        for (Size i=0; i<nodes_.size(); ++i) {
+            for (Size j : dependencies_[i])
+                out << "    n" << i << " -> n" << j << ";\n";
+        }
+        out << "}\n";
+    }
+
+}
@@ -0,0 +1,135 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file dependencygraph.hpp
+    \brief dependency graph between lazy objects
+*/
+
+#ifndef quantlib_dependency_graph_hpp
+#define quantlib_dependency_graph_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Dependency graph between lazy objects
+    /*! The graph is built by following the registrations of
+        observers with their observables, starting from a given set
+        of roots (usually instruments).  Its nodes are the lazy
+        objects found along the way; an edge goes from a lazy object
+        to each lazy object it depends on, either directly or through
+        non-lazy observers such as handles, indexes or pricing
+        engines, which are traversed but not stored.
+
+        Nodes are numbered in topological order, so that a node only
+        depends on nodes with a lower index, and are assigned a
+        level: nodes at level 0 depend on no other lazy object, and
+        nodes at level \f$ n \f$ depend on at least one node at level
+        \f$ n-1 \f$.  Typically, curves and surfaces end up at the
+        lower levels and instruments at the top.
+
+        \warning The graph is a snapshot of the registrations at the
+                 time of its construction; it must be rebuilt if
+                 objects are added, removed or relinked.
+
+        \ingroup patterns
+    */
+    class DependencyGraph {
+      public:
+        DependencyGraph() = default;
+        explicit DependencyGraph(
+            const std::vector<ext::shared_ptr<Observable>>& roots);
+        template <class Iterator>
+        DependencyGraph(Iterator begin, Iterator end) {
+            for (; begin != end; ++begin)
+                add(*begin);
+        }
+        //! adds the given object and whatever it depends on
+        void add(const ext::shared_ptr<Observable>& root);
+        //! \name Inspectors
+        //@{
+        Size size() const { return nodes_.size(); }
+        const ext::shared_ptr<LazyObject>& node(Size i) const;
+        //! indices of the nodes the i-th node depends on
+        const std::vector<Size>& dependencies(Size i) const;
+        /*! observables other than nodes (e.g., quotes, handles,
+            indexes or engines) the i-th node depends on without
+            going through other nodes; together with those of its
+            dependencies, they are all the observables it reaches.
+        */
+        const std::vector<const Observable*>& observables(Size i) const;
+        Size level(Size i) const;
+        //! number of levels in the graph
+        Size levels() const;
+        //! indices of the nodes at the given level
+        std::vector<Size> nodesAtLevel(Size level) const;
+        //@}
+        //! \name Calculations
+        //@{
+        /*! Calculates the nodes that need it, level by level.  Within
+            a level, nodes whose dependencies are already calculated
+            are independent and are calculated in parallel when
+            OpenMP is enabled.  Nodes reaching the same pricing
+            engine, coupon pricer or term structure that is not
+            itself a node are kept in the same thread, since these
+            objects store intermediate results while in use.
+
+            Calculations continue after a failure, so that the
+            objects not depending on the failed one are calculated;
+            afterwards, an exception reporting the failed nodes is
+            thrown.  Their objects are left uncalculated and will
+            raise the error again when their results are requested.
+
+            \warning Running the calculations in parallel requires
+                     the performCalculations() methods of the nodes
+                     not to modify shared observables other than the
+                     ones listed above; user-defined classes doing so
+                     must not be shared between nodes.  The whole
+                     graph must be left untouched while this method
+                     runs.
+        */
+        void calculate() const;
+        /*! Calculates the given nodes and whatever they depend on,
+            as the overload above; other nodes are not calculated.
+        */
+        void calculate(const std::vector<Size>& nodes) const;
+        //@}
+        //! writes the graph in Graphviz format
+        void toGraphviz(std::ostream& out) const;
+
+      private:
+        struct Reach {
+            std::vector<Size> nodes;
+            std::vector<const Observable*> observables;
+        };
+        const Reach& visit(const ext::shared_ptr<Observable>& o);
+        void calculateNeeded(const std::vector<bool>& needed) const;
+        std::vector<ext::shared_ptr<LazyObject>> nodes_;
+        std::vector<std::vector<Size>> dependencies_;
+        std::vector<std::vector<const Observable*>> observables_;
+        // shared observables that can't be used concurrently
+        std::vector<std::vector<const Observable*>> stateful_;
+        std::vector<Size> levels_;
+        std::map<const Observable*, Reach> visited_;
+    };
+
+}
+
+#endif
@@ -33,6 +33,7 @@ namespace QuantLib {
     /*! \ingroup patterns */
     class LazyObject : public virtual Observable,
                        public virtual Observer {
+        friend class DependencyGraph;
       public:
         LazyObject();
         ~LazyObject() override = default;
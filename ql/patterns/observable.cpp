@@ -60,11 +60,16 @@ namespace QuantLib {
 
 
     void Observable::notifyObservers() {
-        if (!ObservableSettings::instance().updatesEnabled()) {
+        // nothing to do, and no need to look up the settings
+        if (observers_.empty())
+            return;
+
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (!settings.updatesEnabled()) {
             // if updates are only deferred, flag this for later notification
             // these are held centrally by the settings singleton
-            ObservableSettings::instance().registerDeferredObservers(observers_);
-        } else if (!observers_.empty()) {
+            settings.registerDeferredObservers(observers_);
+        } else {
             bool successful = true;
             std::string errMsg;
             for (auto* observer : observers_) {
@@ -117,9 +117,8 @@ namespace QuantLib {
     //! Object that gets notified when a given observable changes
     /*! \ingroup patterns */
     class Observer { // NOLINT(cppcoreguidelines-special-member-functions)
-      private:
-        typedef std::set<ext::shared_ptr<Observable>> set_type;
       public:
+        typedef std::set<ext::shared_ptr<Observable>> set_type;
         typedef set_type::iterator iterator;
 
         // constructors, assignment, destructor
@@ -141,6 +140,9 @@ namespace QuantLib {
         Size unregisterWith(const ext::shared_ptr<Observable>&);
         void unregisterWithAll();
 
+        //! returns the observables this instance is registered with
+        set_type observables() const;
+
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
             instead, it will be called by the observables the instance
@@ -206,9 +208,9 @@ namespace QuantLib {
     }
 
     inline Size Observable::unregisterObserver(Observer* o) {
-        if (ObservableSettings::instance().updatesDeferred() ||
-            ObservableSettings::instance().runningDeferredUpdates())
-            ObservableSettings::instance().unregisterDeferredObserver(o);
+        ObservableSettings& settings = ObservableSettings::instance();
+        if (settings.updatesDeferred() || settings.runningDeferredUpdates())
+            settings.unregisterDeferredObserver(o);
 
         return observers_.erase(o);
     }
@@ -264,6 +266,10 @@ namespace QuantLib {
         observables_.clear();
     }
 
+    inline Observer::set_type Observer::observables() const {
+        return observables_;
+    }
+
     inline void Observer::deepUpdate() {
         update();
     }
@@ -290,9 +296,8 @@ namespace QuantLib {
     class Observer : public ext::enable_shared_from_this<Observer> {
         friend class Observable;
         friend class ObservableSettings;
-      private:
-        typedef std::set<ext::shared_ptr<Observable>> set_type;
       public:
+        typedef std::set<ext::shared_ptr<Observable>> set_type;
         typedef set_type::iterator iterator;
 
         // constructors, assignment, destructor
@@ -312,6 +317,9 @@ namespace QuantLib {
         Size unregisterWith(const ext::shared_ptr<Observable>&);
         void unregisterWithAll();
 
+        //! returns the observables this instance is registered with
+        set_type observables() const;
+
         /*! This method must be implemented in derived classes. An
             instance of %Observer does not call this method directly:
             instead, it will be called by the observables the instance
@@ -586,6 +594,11 @@ namespace QuantLib {
         observables_.clear();
     }
 
+    inline Observer::set_type Observer::observables() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return observables_;
+    }
+
     inline void Observer::deepUpdate() {
         update();
     }
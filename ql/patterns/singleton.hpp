@@ -26,6 +26,11 @@
 
 #include <ql/types.hpp>
 #include <type_traits>
+#ifdef QL_ENABLE_SESSIONS
+#include <atomic>
+#include <memory>
+#include <vector>
+#endif
 
 namespace QuantLib {
 
@@ -52,6 +57,9 @@ namespace QuantLib {
         safe, but obviously subsequent operations on the singleton have to be synchronized within the singleton
         implementation itself.
 
+        When sessions are enabled, local instances belong by default to the running thread; see the Session class
+        for a way to decouple them from threads.
+
         \ingroup patterns
     */
     template <class T, class Global = std::integral_constant<bool, false> >
@@ -71,6 +79,87 @@ namespace QuantLib {
         Singleton() = default;
     };
 
+#ifdef QL_ENABLE_SESSIONS
+
+    //! Explicit session holding local singleton instances
+    /*! By default, each thread works in an implicit session of its own, so that the settings (e.g., the evaluation
+        date), the index fixings and any other local singleton are tied to the thread.  A Session object holds its
+        own set of local singleton instances instead, and can be made current in any thread for the duration of a
+        scope:
+
+        \code
+        Session scenario;
+        // in whatever thread picks up the work
+        {
+            Session::Scope scope(scenario);
+            Settings::instance().evaluationDate() = scenarioDate;
+            // ...price instruments...
+        }
+        \endcode
+
+        This allows a thread pool to work on several sessions without tying each one to a thread, and a single
+        thread to switch between sessions (for instance, between two evaluation dates).  Instances are created
+        lazily the first time they're requested within the session, and destroyed with it.
+
+        \warning A session must not be current in more than one thread at a time, and objects created while it
+                 was current (e.g., term structures observing its evaluation date) should only be used while it's
+                 current.
+
+        \ingroup patterns
+    */
+    class Session {
+        template <class T, class Global>
+        friend class Singleton;
+      public:
+        Session() = default;
+        Session(const Session&) = delete;
+        Session(Session&&) = delete;
+        Session& operator=(const Session&) = delete;
+        Session& operator=(Session&&) = delete;
+        ~Session() {
+            // destroy instances in reverse order of creation; their
+            // destructors might access other local singletons, which
+            // must be the ones of this session
+            Scope scope(*this);
+            while (!created_.empty()) {
+                instances_[created_.back()].reset();
+                created_.pop_back();
+            }
+        }
+
+        //! makes a session current in the running thread until the end of the scope
+        class Scope {  // NOLINT(cppcoreguidelines-special-member-functions)
+          public:
+            explicit Scope(Session& session) : previous_(current_) { current_ = &session; }
+            ~Scope() { current_ = previous_; }
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+          private:
+            Session* previous_;
+        };
+
+        //! the session current in the running thread, or null if the implicit thread session is in use
+        static Session* current() { return current_; }
+
+      private:
+        static Size newSlot() {
+            static std::atomic<Size> slots(0);
+            return slots++;
+        }
+        std::shared_ptr<void>& slot(Size i) {
+            if (i >= instances_.size())
+                instances_.resize(i+1);
+            return instances_[i];
+        }
+        std::vector<std::shared_ptr<void>> instances_;
+        std::vector<Size> created_;
+        static thread_local Session* current_;
+    };
+
+    inline thread_local Session* Session::current_ = nullptr;
+
+#endif
+
     // template definitions
 
 #ifdef QL_ENABLE_SESSIONS
@@ -88,6 +177,17 @@ namespace QuantLib {
         if(Global()) {
             static T global_instance;
             return global_instance;
+        } else if (Session* session = Session::current()) {
+            static const Size id = Session::newSlot();
+            if (!session->slot(id)) {
+                // the constructor might request other local singletons
+                // and resize the slots, so the one for this instance
+                // is only looked up afterwards
+                std::shared_ptr<void> instance(new T);
+                session->slot(id) = std::move(instance);
+                session->created_.push_back(id);
+            }
+            return *static_cast<T*>(session->slot(id).get());
         } else {
             thread_local static T local_instance;
             return local_instance;
@@ -11,8 +11,10 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/pricingengines/greeks.hpp>
 #include <ql/pricingengines/latticeshortratemodelengine.hpp>
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/mclongstaffschwartzengine.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/pricingengines/sharedshortratelattice.hpp>
 
 #include <ql/pricingengines/asian/all.hpp>
 #include <ql/pricingengines/barrier/all.hpp>
@@ -20,6 +20,7 @@
 
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -51,4 +52,51 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+
+
+    ArithmeticAPOPathwiseGreeksPricer::ArithmeticAPOPathwiseGreeksPricer(
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const TimeGrid& timeGrid,
+        Option::Type type,
+        Real strike,
+        Time paymentTime,
+        Real runningSum,
+        Size pastFixings)
+    : BlackScholesPathwiseGreeksPricer(process, timeGrid, strike, paymentTime),
+      type_(type), strike_(strike), runningSum_(runningSum),
+      pastFixings_(pastFixings) {
+        QL_REQUIRE(strike>=0.0,
+            "strike less than zero not allowed");
+    }
+
+    Real ArithmeticAPOPathwiseGreeksPricer::payoff(
+                           const Path& path, std::vector<Real>& gradient) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        // same averaging as ArithmeticAPOPathPricer
+        Size first = path.timeGrid().mandatoryTimes()[0]==0.0 ? 0 : 1;
+        Real sum = std::accumulate(path.begin()+first, path.end(), runningSum_);
+        Size fixings = pastFixings_ + n - first;
+        Real averagePrice = sum/fixings;
+
+        Real omega;
+        switch (type_) {
+          case Option::Call:
+            omega = 1.0;
+            break;
+          case Option::Put:
+            omega = -1.0;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+
+        Real value = omega * (averagePrice - strike_);
+        if (value <= 0.0)
+            return 0.0;
+        std::fill(gradient.begin()+first, gradient.end(), omega/fixings);
+        return value;
+    }
+
 }
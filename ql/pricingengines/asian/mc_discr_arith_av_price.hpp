@@ -28,6 +28,7 @@
 #include <ql/exercise.hpp>
 #include <ql/pricingengines/asian/analytic_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <utility>
 
@@ -40,10 +41,18 @@ namespace QuantLib {
          AnalyticDiscreteGeometricAveragePriceAsianEngine (analytic discrete
          arithmetic average price engine) for control variation.
 
+         Delta, vega, rho and dividend rho can be estimated on the
+         same paths used for the value by means of pathwise
+         estimators.
+
          \ingroup asianengines
 
          \test the correctness of the returned value is tested by
                reproducing results available in literature.
+
+         \test the correctness of the returned greeks is tested by
+               checking them against finite differences on the same
+               random paths.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCDiscreteArithmeticAPEngine
@@ -66,10 +75,15 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             McGreeks::Method greeks = McGreeks::None);
       protected:
+        typedef
+        typename MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>::greeks_pricer_type
+            greeks_pricer_type;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
         ext::shared_ptr<path_pricer_type> controlPathPricer() const override;
+        ext::shared_ptr<greeks_pricer_type> greeksPathPricer() const override;
         ext::shared_ptr<PricingEngine> controlPricingEngine() const override {
             ext::shared_ptr<GeneralizedBlackScholesProcess> process =
                 ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
@@ -77,6 +91,8 @@ namespace QuantLib {
             QL_REQUIRE(process, "Black-Scholes process required");
             return ext::make_shared<AnalyticDiscreteGeometricAveragePriceAsianEngine>(process);
         }
+      private:
+        McGreeks::Method greeks_;
     };
 
 
@@ -97,6 +113,31 @@ namespace QuantLib {
     };
 
 
+    //! pathwise greeks for discrete arithmetic average-price Asian options
+    class ArithmeticAPOPathwiseGreeksPricer
+        : public BlackScholesPathwiseGreeksPricer {
+      public:
+        ArithmeticAPOPathwiseGreeksPricer(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& timeGrid,
+            Option::Type type,
+            Real strike,
+            Time paymentTime,
+            Real runningSum = 0.0,
+            Size pastFixings = 0);
+
+      protected:
+        Real payoff(const Path& path,
+                    std::vector<Real>& gradient) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+        Real runningSum_;
+        Size pastFixings_;
+    };
+
+
     // inline definitions
 
     template <class RNG, class S>
@@ -109,7 +150,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             McGreeks::Method greeks)
     : MCDiscreteAveragingAsianEngineBase<SingleVariate,RNG,S>(process,
                                                               brownianBridge,
                                                               antitheticVariate,
@@ -117,7 +159,12 @@ namespace QuantLib {
                                                               requiredSamples,
                                                               requiredTolerance,
                                                               maxSamples,
-                                                              seed) {}
+                                                              seed),
+      greeks_(greeks) {
+        QL_REQUIRE(greeks_ != McGreeks::LikelihoodRatio,
+                   "likelihood-ratio greeks not available "
+                   "for arithmetic average-price options");
+    }
 
     template <class RNG, class S>
     inline
@@ -178,6 +225,39 @@ namespace QuantLib {
               process->riskFreeRate()->discount(this->timeGrid().back()));
     }
 
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<
+            typename MCDiscreteArithmeticAPEngine<RNG,S>::greeks_pricer_type>
+        MCDiscreteArithmeticAPEngine<RNG,S>::greeksPathPricer() const {
+
+        if (greeks_ == McGreeks::None)
+            return ext::shared_ptr<greeks_pricer_type>();
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<EuropeanExercise> exercise =
+            ext::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        return ext::make_shared<ArithmeticAPOPathwiseGreeksPricer>(
+                    process, this->timeGrid(),
+                    payoff->optionType(),
+                    payoff->strike(),
+                    process->time(exercise->lastDate()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings);
+    }
+
     template <class RNG = PseudoRandom, class S = Statistics>
     class MakeMCDiscreteArithmeticAPEngine {
       public:
@@ -191,6 +271,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withGreeks(McGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -200,6 +281,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_ = true;
         BigNatural seed_ = 0;
+        McGreeks::Method greeks_ = McGreeks::None;
     };
 
     template <class RNG, class S>
@@ -265,6 +347,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withGreeks(McGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -274,7 +363,8 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_);
+                                                seed_,
+                                                greeks_);
     }
 
 
@@ -28,6 +28,7 @@
 
 #include <ql/exercise.hpp>
 #include <ql/instruments/asianoption.hpp>
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <utility>
 
@@ -100,6 +101,10 @@ namespace QuantLib {
                 results_.errorEstimate =
                     this->mcModel_->sampleAccumulator().errorEstimate();
 
+            if (this->mcModel_->hasGreeks())
+                McGreeks::store(this->mcModel_->greeksAccumulator().mean(),
+                                results_);
+
             // Allow inspection of the timeGrid via additional results
             this->results_.additionalResults["TimeGrid"] = this->timeGrid();
         }
@@ -246,4 +246,61 @@ namespace QuantLib {
         }
     }
 
+
+    BarrierLikelihoodRatioGreeksPricer::BarrierLikelihoodRatioGreeksPricer(
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const TimeGrid& timeGrid,
+        Barrier::Type barrierType,
+        Real barrier,
+        Real rebate,
+        Option::Type type,
+        Real strike)
+    : BlackScholesLikelihoodRatioGreeksPricer(process, timeGrid, strike),
+      barrierType_(barrierType), barrier_(barrier), rebate_(rebate),
+      payoff_(type, strike) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+    }
+
+
+    Real BarrierLikelihoodRatioGreeksPricer::payoff(const Path& path,
+                                                    Size& paymentNode) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        bool isUp;
+        switch (barrierType_) {
+          case Barrier::DownIn:
+          case Barrier::DownOut:
+            isUp = false;
+            break;
+          case Barrier::UpIn:
+          case Barrier::UpOut:
+            isUp = true;
+            break;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+
+        Size knockNode = n;
+        for (Size i = 1; i < n && knockNode == n; i++) {
+            if (isUp ? path[i] >= barrier_ : path[i] <= barrier_)
+                knockNode = i;
+        }
+        bool knocked = (knockNode != n);
+
+        switch (barrierType_) {
+          case Barrier::DownIn:
+          case Barrier::UpIn:
+            return knocked ? payoff_(path.back()) : rebate_;
+          default:
+            if (!knocked)
+                return payoff_(path.back());
+            paymentNode = knockNode;
+            return rebate_;
+        }
+    }
+
 }
@@ -28,6 +28,7 @@
 
 #include <ql/exercise.hpp>
 #include <ql/instruments/barrieroption.hpp>
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <utility>
@@ -48,10 +49,21 @@ namespace QuantLib {
         Journal of Derivatives; Winter 1998; 6, 2; pg. 65-83
         </i>
 
+        Likelihood-ratio greeks can be requested for biased
+        simulations, in which the barrier is only monitored on the
+        time grid.  With the Brownian-bridge correction, the crossing
+        of the barrier between two nodes is sampled from a probability
+        depending on the volatility; its weights are not available.
+        Pathwise greeks are not available either, since the payoff is
+        discontinuous in the path values.
+
         \ingroup barrierengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in literature.
+
+        \test the correctness of the returned greeks is tested by
+              checking them against finite differences.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCBarrierEngine : public BarrierOption::engine,
@@ -74,7 +86,8 @@ namespace QuantLib {
                         Real requiredTolerance,
                         Size maxSamples,
                         bool isBiased,
-                        BigNatural seed);
+                        BigNatural seed,
+                        McGreeks::Method greeks = McGreeks::None);
         void calculate() const override {
             Real spot = process_->x0();
             QL_REQUIRE(spot > 0.0, "negative or null underlying given");
@@ -86,9 +99,14 @@ namespace QuantLib {
             if constexpr (RNG::allowsErrorEstimate)
                 results_.errorEstimate =
                     this->mcModel_->sampleAccumulator().errorEstimate();
+            if (this->mcModel_->hasGreeks())
+                McGreeks::store(this->mcModel_->greeksAccumulator().mean(),
+                                results_);
         }
 
       protected:
+        typedef typename McSimulation<SingleVariate,RNG,S>::greeks_pricer_type
+            greeks_pricer_type;
         // McSimulation implementation
         TimeGrid timeGrid() const override;
         ext::shared_ptr<path_generator_type> pathGenerator() const override {
@@ -99,6 +117,7 @@ namespace QuantLib {
                                                  grid, gen, brownianBridge_);
         }
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<greeks_pricer_type> greeksPathPricer() const override;
         // data members
         ext::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
@@ -107,6 +126,7 @@ namespace QuantLib {
         bool isBiased_;
         bool brownianBridge_;
         BigNatural seed_;
+        McGreeks::Method greeks_;
     };
 
 
@@ -125,6 +145,7 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withGreeks(McGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -133,6 +154,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_ = 0;
+        McGreeks::Method greeks_ = McGreeks::None;
     };
 
 
@@ -178,6 +200,33 @@ namespace QuantLib {
     };
 
 
+    //! likelihood-ratio greeks for discretely-monitored barrier options
+    /*! The barrier is checked on the nodes of the time grid, as in
+        BiasedBarrierPathPricer.
+    */
+    class BarrierLikelihoodRatioGreeksPricer
+        : public BlackScholesLikelihoodRatioGreeksPricer {
+      public:
+        BarrierLikelihoodRatioGreeksPricer(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& timeGrid,
+            Barrier::Type barrierType,
+            Real barrier,
+            Real rebate,
+            Option::Type type,
+            Real strike);
+
+      protected:
+        Real payoff(const Path& path, Size& paymentNode) const override;
+
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        PlainVanillaPayoff payoff_;
+    };
+
+
 
     // template definitions
 
@@ -192,11 +241,12 @@ namespace QuantLib {
         Real requiredTolerance,
         Size maxSamples,
         bool isBiased,
-        BigNatural seed)
+        BigNatural seed,
+        McGreeks::Method greeks)
     : McSimulation<SingleVariate, RNG, S>(antitheticVariate, false), process_(std::move(process)),
       timeSteps_(timeSteps), timeStepsPerYear_(timeStepsPerYear), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance), isBiased_(isBiased),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed), greeks_(greeks) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -265,6 +315,35 @@ namespace QuantLib {
     }
 
 
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename MCBarrierEngine<RNG,S>::greeks_pricer_type>
+    MCBarrierEngine<RNG,S>::greeksPathPricer() const {
+
+        if (greeks_ == McGreeks::None)
+            return ext::shared_ptr<greeks_pricer_type>();
+
+        QL_REQUIRE(greeks_ == McGreeks::LikelihoodRatio,
+                   "only likelihood-ratio greeks are available "
+                   "for barrier options");
+        QL_REQUIRE(isBiased_,
+                   "likelihood-ratio greeks require a biased simulation");
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff =
+            ext::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return ext::make_shared<BarrierLikelihoodRatioGreeksPricer>(
+                                                     process_,
+                                                     timeGrid(),
+                                                     arguments_.barrierType,
+                                                     arguments_.barrier,
+                                                     arguments_.rebate,
+                                                     payoff->optionType(),
+                                                     payoff->strike());
+    }
+
+
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG, S>::MakeMCBarrierEngine(
         ext::shared_ptr<GeneralizedBlackScholesProcess> process)
@@ -341,6 +420,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withGreeks(McGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -357,7 +443,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_);
+                                   seed_,
+                                   greeks_);
     }
 
 }
@@ -56,6 +56,20 @@ namespace QuantLib {
                 Time fixingTime =
                     model_->termStructure()->timeFromReference(fixingDate);
 
+                // the zerobonds and the numeraire are evaluated on the
+                // whole grid at once (and shared by caplets and floorlets)
+                Matrix zerobonds;
+                Array discountZerobonds, numeraires;
+                if (fixingDate > settlement) {
+                    Array T = {model_->termStructure()->timeFromReference(valueDate),
+                               model_->termStructure()->timeFromReference(paymentDate)};
+                    zerobonds = model_->zerobond(T, fixingTime, z);
+                    if (iborIndex != nullptr)
+                        discountZerobonds =
+                            model_->zerobond(T[1], fixingTime, z, discountCurve_);
+                    numeraires = model_->numeraire(fixingTime, z, discountCurve_);
+                }
+
                 Real strike;
 
                 if (type == CapFloor::Cap || type == CapFloor::Collar) {
@@ -75,22 +89,15 @@ namespace QuantLib {
                                     arguments_.accrualTimes[i] *
                                     model_->forwardRate(fixingDate, fixingDate,
                                                         z[j], iborIndex) *
-                                    model_->zerobond(paymentDate, fixingDate,
-                                                     z[j], discountCurve_);
+                                    discountZerobonds[j];
                             else
-                                floatingLegNpv =
-                                    (model_->zerobond(valueDate, fixingDate,
-                                                      z[j]) -
-                                     model_->zerobond(paymentDate, fixingDate,
-                                                      z[j]));
+                                floatingLegNpv = zerobonds[0][j] - zerobonds[1][j];
                             Real fixedLegNpv =
                                 arguments_.capRates[i] *
-                                arguments_.accrualTimes[i] *
-                                model_->zerobond(paymentDate, fixingDate, z[j]);
+                                arguments_.accrualTimes[i] * zerobonds[1][j];
                             p[j] =
                                 std::max((floatingLegNpv - fixedLegNpv), 0.0) /
-                                model_->numeraire(fixingTime, z[j],
-                                                  discountCurve_);
+                                numeraires[j];
                         }
                         CubicInterpolation payoff(
                             z.begin(), z.end(), p.begin(),
@@ -147,22 +154,15 @@ namespace QuantLib {
                                     arguments_.accrualTimes[i] *
                                     model_->forwardRate(fixingDate, fixingDate,
                                                         z[j], iborIndex) *
-                                    model_->zerobond(paymentDate, fixingDate,
-                                                     z[j], discountCurve_);
+                                    discountZerobonds[j];
                             else
-                                floatingLegNpv =
-                                    (model_->zerobond(valueDate, fixingDate,
-                                                      z[j]) -
-                                     model_->zerobond(paymentDate, fixingDate,
-                                                      z[j]));
+                                floatingLegNpv = zerobonds[0][j] - zerobonds[1][j];
                             Real fixedLegNpv =
                                 arguments_.floorRates[i] *
-                                arguments_.accrualTimes[i] *
-                                model_->zerobond(paymentDate, fixingDate, z[j]);
+                                arguments_.accrualTimes[i] * zerobonds[1][j];
                             p[j] =
                                 std::max(-(floatingLegNpv - fixedLegNpv), 0.0) /
-                                model_->numeraire(fixingTime, z[j],
-                                                  discountCurve_);
+                                numeraires[j];
                         }
                         CubicInterpolation payoff(
                             z.begin(), z.end(), p.begin(),
@@ -0,0 +1,228 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/mcgreeks.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace QuantLib {
+
+    namespace {
+
+        // increments of log-forward, variance, and derivative of the
+        // variance with respect to the volatility over each step
+        void stepIncrements(const GeneralizedBlackScholesProcess& process,
+                            const std::vector<Time>& times,
+                            Real strike,
+                            std::vector<Real>& dLogForward,
+                            std::vector<Real>& dVariance,
+                            std::vector<Real>& dVarianceVega) {
+            Real logForward = 0.0, variance = 0.0, varianceVega = 0.0;
+            for (Size i=1; i<times.size(); ++i) {
+                Time t = times[i];
+                Real lf = std::log(process.dividendYield()->discount(t) /
+                                   process.riskFreeRate()->discount(t));
+                Real v = process.blackVolatility()->blackVariance(t, strike, true);
+                // d(sigma^2 t)/d(sigma) = 2 sigma t
+                Real vv = 2.0 * std::sqrt(v * t);
+                dLogForward[i] = lf - logForward;
+                dVariance[i] = v - variance;
+                dVarianceVega[i] = vv - varianceVega;
+                logForward = lf;
+                variance = v;
+                varianceVega = vv;
+            }
+        }
+
+    }
+
+    BlackScholesPathwiseGreeksPricer::BlackScholesPathwiseGreeksPricer(
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const TimeGrid& timeGrid,
+        Real strike,
+        Time paymentTime)
+    : x0_(process->x0()),
+      discount_(process->riskFreeRate()->discount(paymentTime)),
+      paymentTime_(paymentTime), times_(timeGrid.begin(), timeGrid.end()),
+      dLogForward_(timeGrid.size(), 0.0), dVariance_(timeGrid.size(), 0.0),
+      dVarianceVega_(timeGrid.size(), 0.0), gradient_(timeGrid.size()) {
+        QL_REQUIRE(!times_.empty(), "empty time grid given");
+        QL_REQUIRE(x0_ > 0.0, "positive initial value required");
+        stepIncrements(*process, times_, strike,
+                       dLogForward_, dVariance_, dVarianceVega_);
+    }
+
+    Array BlackScholesPathwiseGreeksPricer::operator()(const Path& path) const {
+        QL_REQUIRE(path.length() == times_.size(),
+                   "path length (" << path.length()
+                   << ") different from time-grid size ("
+                   << times_.size() << ")");
+
+        std::fill(gradient_.begin(), gradient_.end(), 0.0);
+        Real value = payoff(path, gradient_);
+
+        // at each step, the log-increment is dF - dv/2 + sqrt(dv) w,
+        // so that its derivative with respect to the volatility is
+        // -dv'/2 + dv'/(2 sqrt(dv)) w; the diffusion term sqrt(dv) w
+        // is recovered from the path.
+        Real delta = gradient_[0] * path[0], vega = 0.0, rho = 0.0;
+        Real logVega = 0.0;
+        for (Size i=1; i<times_.size(); ++i) {
+            if (dVariance_[i] > 0.0 && dVarianceVega_[i] != 0.0) {
+                Real diffusion = std::log(path[i] / path[i-1])
+                    - dLogForward_[i] + 0.5 * dVariance_[i];
+                logVega += dVarianceVega_[i] * (0.5 * diffusion / dVariance_[i] - 0.5);
+            }
+            Real g = gradient_[i];
+            if (g != 0.0) {
+                Real s = g * path[i];
+                delta += s;
+                vega += s * logVega;
+                rho += s * times_[i];
+            }
+        }
+
+        Array results(McGreeks::size);
+        results[McGreeks::Delta] = discount_ * delta / x0_;
+        results[McGreeks::Vega] = discount_ * vega;
+        results[McGreeks::Rho] = discount_ * (rho - paymentTime_ * value);
+        results[McGreeks::DividendRho] = -discount_ * rho;
+        return results;
+    }
+
+
+    EuropeanPathwiseGreeksPricer::EuropeanPathwiseGreeksPricer(
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const TimeGrid& timeGrid,
+        Option::Type type,
+        Real strike)
+    : BlackScholesPathwiseGreeksPricer(process, timeGrid, strike, timeGrid.back()),
+      type_(type), strike_(strike) {}
+
+    Real EuropeanPathwiseGreeksPricer::payoff(const Path& path,
+                                              std::vector<Real>& gradient) const {
+        Real s = path.back();
+        switch (type_) {
+          case Option::Call:
+            if (s > strike_) {
+                gradient.back() = 1.0;
+                return s - strike_;
+            }
+            return 0.0;
+          case Option::Put:
+            if (s < strike_) {
+                gradient.back() = -1.0;
+                return strike_ - s;
+            }
+            return 0.0;
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+
+    EuropeanLikelihoodRatioGreeksPricer::EuropeanLikelihoodRatioGreeksPricer(
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        ext::shared_ptr<StrikedTypePayoff> payoff,
+        Time maturity)
+    : payoff_(std::move(payoff)), x0_(process->x0()),
+      discount_(process->riskFreeRate()->discount(maturity)),
+      maturity_(maturity) {
+        QL_REQUIRE(payoff_, "null payoff given");
+        QL_REQUIRE(maturity_ > 0.0, "positive maturity required");
+        logForward_ = std::log(process->dividendYield()->discount(maturity) /
+                               process->riskFreeRate()->discount(maturity));
+        stdDev_ = std::sqrt(process->blackVolatility()->blackVariance(
+                                      maturity, payoff_->strike(), true));
+        QL_REQUIRE(stdDev_ > 0.0, "positive volatility required");
+        volatility_ = stdDev_ / std::sqrt(maturity);
+    }
+
+    Array EuropeanLikelihoodRatioGreeksPricer::operator()(const Path& path) const {
+        QL_REQUIRE(!path.empty(), "the path cannot be empty");
+        Array results(McGreeks::size, 0.0);
+        Real value = discount_ * (*payoff_)(path.back());
+        if (value == 0.0)
+            return results;
+
+        // standardized terminal log-value and its sensitivities
+        Real z = (std::log(path.back() / x0_) - logForward_
+                  + 0.5 * stdDev_ * stdDev_) / stdDev_;
+        Real zRate = z * maturity_ / stdDev_;
+        results[McGreeks::Delta] = value * z / (x0_ * stdDev_);
+        results[McGreeks::Vega] = value * (z * z - 1.0 - z * stdDev_) / volatility_;
+        results[McGreeks::Rho] = value * (zRate - maturity_);
+        results[McGreeks::DividendRho] = -value * zRate;
+        return results;
+    }
+
+
+    BlackScholesLikelihoodRatioGreeksPricer::BlackScholesLikelihoodRatioGreeksPricer(
+        const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+        const TimeGrid& timeGrid,
+        Real strike)
+    : x0_(process->x0()), times_(timeGrid.begin(), timeGrid.end()),
+      discounts_(timeGrid.size()), dLogForward_(timeGrid.size(), 0.0),
+      dVariance_(timeGrid.size(), 0.0), dVarianceVega_(timeGrid.size(), 0.0) {
+        QL_REQUIRE(times_.size() > 1, "at least one time step required");
+        QL_REQUIRE(x0_ > 0.0, "positive initial value required");
+        stepIncrements(*process, times_, strike,
+                       dLogForward_, dVariance_, dVarianceVega_);
+        for (Size i=0; i<times_.size(); ++i) {
+            discounts_[i] = process->riskFreeRate()->discount(times_[i]);
+            QL_REQUIRE(i == 0 || dVariance_[i] > 0.0,
+                       "positive variance required on each time step");
+        }
+    }
+
+    Array BlackScholesLikelihoodRatioGreeksPricer::operator()(const Path& path) const {
+        QL_REQUIRE(path.length() == times_.size(),
+                   "path length (" << path.length()
+                   << ") different from time-grid size ("
+                   << times_.size() << ")");
+
+        Array results(McGreeks::size, 0.0);
+        Size paymentNode = times_.size() - 1;
+        Real cashFlow = payoff(path, paymentNode);
+        if (cashFlow == 0.0)
+            return results;
+        QL_REQUIRE(paymentNode < times_.size(),
+                   "payment node (" << paymentNode << ") out of range");
+        Real value = cashFlow * discounts_[paymentNode];
+
+        // at each step, the log-increment is normal with mean
+        // dF - dv/2 and variance dv; the payoff is weighted with the
+        // derivatives of the log-density of the increments.  Only the
+        // first one depends on the initial value.
+        Real delta = 0.0, vega = 0.0, rate = 0.0;
+        for (Size i=1; i<times_.size(); ++i) {
+            Real w = (std::log(path[i] / path[i-1])
+                      - dLogForward_[i] + 0.5 * dVariance_[i]) / dVariance_[i];
+            if (i == 1)
+                delta = w / x0_;
+            vega += 0.5 * dVarianceVega_[i] * (w * w - w - 1.0 / dVariance_[i]);
+            rate += w * (times_[i] - times_[i-1]);
+        }
+
+        results[McGreeks::Delta] = value * delta;
+        results[McGreeks::Vega] = value * vega;
+        results[McGreeks::Rho] = value * (rate - times_[paymentNode]);
+        results[McGreeks::DividendRho] = -value * rate;
+        return results;
+    }
+
+}
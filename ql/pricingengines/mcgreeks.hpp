@@ -0,0 +1,217 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mcgreeks.hpp
+    \brief Monte Carlo greeks for Black-Scholes processes
+*/
+
+#ifndef quantlib_mc_greeks_hpp
+#define quantlib_mc_greeks_hpp
+
+#include <ql/instruments/payoffs.hpp>
+#include <ql/methods/montecarlo/path.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! conventions for Monte Carlo greeks
+    /*! Engines return the greeks they support when a method other
+        than None is passed:
+        - MCEuropeanEngine: pathwise or likelihood-ratio greeks;
+        - MCDiscreteArithmeticAPEngine: pathwise greeks;
+        - MCBarrierEngine: likelihood-ratio greeks for biased
+          simulations;
+        - MCEuropeanHestonEngine: pathwise delta, rho and dividend
+          rho.
+
+        Greeks are computed from the simulated paths by dedicated
+        path pricers; the path generators are not modified.
+    */
+    struct McGreeks {
+        //! estimator used for the greeks
+        enum Method { None, Pathwise, LikelihoodRatio };
+        //! position of each greek in the results of greeks path pricers
+        enum Index { Delta, Vega, Rho, DividendRho };
+        //! number of greeks returned by greeks path pricers
+        static constexpr Size size = 4;
+        //! copies the averaged greeks into the results of an engine
+        template <class Results>
+        static void store(const std::vector<Real>& greeks, Results& results) {
+            QL_REQUIRE(greeks.size() == size,
+                       "wrong number of greeks (" << greeks.size() << ")");
+            results.delta = greeks[Delta];
+            results.vega = greeks[Vega];
+            results.rho = greeks[Rho];
+            results.dividendRho = greeks[DividendRho];
+        }
+    };
+
+
+    //! base class for pathwise greeks under a Black-Scholes process
+    /*! Derived classes provide the undiscounted payoff on a path
+        together with its gradient with respect to the path values.
+        The base class combines the gradient with the tangent paths,
+        i.e., the derivatives of the path values with respect to the
+        initial value, to a parallel shift of the Black volatility and
+        to parallel shifts of the risk-free and dividend rates; the
+        tangents are obtained from the path itself, so that no
+        additional simulation is needed.
+
+        The results are discounted with the risk-free discount at the
+        given payment time and returned in the order given by
+        McGreeks::Index.
+
+        Pathwise estimators require a payoff that is continuous in
+        the path values; for discontinuous payoffs, likelihood-ratio
+        estimators should be used instead.
+
+        \warning The tangents are exact for the discretization used
+                 by GeneralizedBlackScholesProcess when the
+                 volatility does not depend on the strike; otherwise,
+                 the Black volatility at the given strike is used as
+                 an approximation.
+
+        \ingroup mcarlo
+    */
+    class BlackScholesPathwiseGreeksPricer : public PathPricer<Path, Array> {
+      public:
+        BlackScholesPathwiseGreeksPricer(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& timeGrid,
+            Real strike,
+            Time paymentTime);
+        Array operator()(const Path& path) const override;
+
+      protected:
+        /*! returns the undiscounted payoff on the path and writes its
+            derivatives with respect to each path value into the
+            passed vector, which is zeroed beforehand.
+        */
+        virtual Real payoff(const Path& path,
+                            std::vector<Real>& gradient) const = 0;
+
+      private:
+        Real x0_;
+        DiscountFactor discount_;
+        Time paymentTime_;
+        std::vector<Time> times_;
+        // increments of log-forward, variance, and derivative of the
+        // variance with respect to the volatility over each step
+        std::vector<Real> dLogForward_, dVariance_, dVarianceVega_;
+        mutable std::vector<Real> gradient_;
+    };
+
+
+    //! pathwise greeks for plain-vanilla European payoffs
+    class EuropeanPathwiseGreeksPricer
+        : public BlackScholesPathwiseGreeksPricer {
+      public:
+        EuropeanPathwiseGreeksPricer(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& timeGrid,
+            Option::Type type,
+            Real strike);
+
+      protected:
+        Real payoff(const Path& path,
+                    std::vector<Real>& gradient) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+    };
+
+
+    //! likelihood-ratio greeks for European payoffs
+    /*! The payoff is weighted by the derivatives of the logarithm
+        of the density of the terminal value; thus, any payoff can be
+        used, including discontinuous ones such as digitals.  The
+        estimators have a higher variance than pathwise ones.
+
+        The results are returned in the order given by
+        McGreeks::Index.
+
+        \ingroup mcarlo
+    */
+    class EuropeanLikelihoodRatioGreeksPricer : public PathPricer<Path, Array> {
+      public:
+        EuropeanLikelihoodRatioGreeksPricer(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            ext::shared_ptr<StrikedTypePayoff> payoff,
+            Time maturity);
+        Array operator()(const Path& path) const override;
+
+      private:
+        ext::shared_ptr<StrikedTypePayoff> payoff_;
+        Real x0_;
+        DiscountFactor discount_;
+        Time maturity_;
+        Real logForward_, stdDev_, volatility_;
+    };
+
+
+    //! base class for likelihood-ratio greeks under a Black-Scholes process
+    /*! Derived classes provide the undiscounted cash flow paid on a
+        path and the time-grid node at which it is paid.  The cash
+        flow is weighted by the derivatives of the logarithm of the
+        joint density of the path values; thus, the payoff can depend
+        on the whole path and be discontinuous, as for barrier
+        options.  The estimators have a higher variance than pathwise
+        ones.
+
+        The results are discounted with the risk-free discount at the
+        payment node and returned in the order given by
+        McGreeks::Index.
+
+        \warning The weights are exact for the discretization used by
+                 GeneralizedBlackScholesProcess when the volatility
+                 does not depend on the strike; otherwise, the Black
+                 volatility at the given strike is used as an
+                 approximation.  The payoff must depend on the path
+                 values only, and not on any further random numbers.
+
+        \ingroup mcarlo
+    */
+    class BlackScholesLikelihoodRatioGreeksPricer
+        : public PathPricer<Path, Array> {
+      public:
+        BlackScholesLikelihoodRatioGreeksPricer(
+            const ext::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            const TimeGrid& timeGrid,
+            Real strike);
+        Array operator()(const Path& path) const override;
+
+      protected:
+        /*! returns the undiscounted cash flow paid on the path and
+            writes the index of the time-grid node at which it is
+            paid into the passed variable, which is set to the last
+            node beforehand.
+        */
+        virtual Real payoff(const Path& path, Size& paymentNode) const = 0;
+
+      private:
+        Real x0_;
+        std::vector<Time> times_;
+        std::vector<DiscountFactor> discounts_;
+        std::vector<Real> dLogForward_, dVariance_, dVarianceVega_;
+    };
+
+}
+
+#endif
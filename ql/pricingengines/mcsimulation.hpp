@@ -31,9 +31,10 @@
 namespace QuantLib {
 
     //! base class for Monte Carlo engines
-    /*! Eventually this class might offer greeks methods.  Deriving a
-        class from McSimulation gives an easy way to write a Monte
-        Carlo engine.
+    /*! Deriving a class from McSimulation gives an easy way to write
+        a Monte Carlo engine.  Engines can also provide a greeks path
+        pricer, in which case sensitivities are estimated on the same
+        paths used for the value.
 
         See McVanillaEngine as an example.
     */
@@ -48,6 +49,8 @@ namespace QuantLib {
         typedef typename MonteCarloModel<MC,RNG,S>::stats_type
             stats_type;
         typedef typename MonteCarloModel<MC,RNG,S>::result_type result_type;
+        typedef typename MonteCarloModel<MC,RNG,S>::greeks_pricer_type
+            greeks_pricer_type;
 
         virtual ~McSimulation() = default;
         //! add samples until the required absolute tolerance is reached
@@ -86,6 +89,10 @@ namespace QuantLib {
         virtual result_type controlVariateValue() const {
             return Null<result_type>();
         }
+        //! path pricer returning pathwise or likelihood-ratio greeks
+        virtual ext::shared_ptr<greeks_pricer_type> greeksPathPricer() const {
+            return ext::shared_ptr<greeks_pricer_type>();
+        }
         template <class Sequence>
         static Real maxError(const Sequence& sequence) {
             return *std::max_element(sequence.begin(), sequence.end());
@@ -184,12 +191,16 @@ namespace QuantLib {
                 ext::make_shared<MonteCarloModel<MC,RNG,S>>(
                            pathGenerator(), this->pathPricer(), stats_type(),
                            this->antitheticVariate_, controlPP,
-                           controlVariateValue, controlPG);
+                           controlVariateValue, controlPG,
+                           this->greeksPathPricer());
         } else {
             this->mcModel_ =
                 ext::make_shared<MonteCarloModel<MC,RNG,S>>(
                            pathGenerator(), this->pathPricer(), S(),
-                           this->antitheticVariate_);
+                           this->antitheticVariate_,
+                           ext::shared_ptr<path_pricer_type>(), result_type(),
+                           ext::shared_ptr<path_generator_type>(),
+                           this->greeksPathPricer());
         }
 
         if (requiredTolerance != Null<Real>()) {
@@ -0,0 +1,105 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/sharedshortratelattice.hpp>
+#include <ql/timegrid.hpp>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace QuantLib {
+
+    SharedShortRateLattice::SharedShortRateLattice(
+                                      ext::shared_ptr<ShortRateModel> model,
+                                      Size timeSteps)
+    : model_(std::move(model)), timeSteps_(timeSteps) {
+        QL_REQUIRE(model_, "no model specified");
+        QL_REQUIRE(timeSteps_ > 0,
+                   "timeSteps must be positive, " << timeSteps_ <<
+                   " not allowed");
+    }
+
+    Size SharedShortRateLattice::add(ext::shared_ptr<DiscretizedAsset> asset,
+                                     Time from,
+                                     Time to) {
+        QL_REQUIRE(asset, "null asset given");
+        QL_REQUIRE(to >= 0.0, "negative target time (" << to << ") given");
+        QL_REQUIRE(from >= to,
+                   "initial time (" << from << ") before target time ("
+                   << to << ")");
+        assets_.push_back(std::move(asset));
+        from_.push_back(from);
+        to_.push_back(to);
+        values_.clear();
+        return assets_.size()-1;
+    }
+
+    void SharedShortRateLattice::rollback() {
+        QL_REQUIRE(!assets_.empty(), "no assets given");
+
+        std::vector<Time> times;
+        for (Size k=0; k<assets_.size(); ++k) {
+            std::vector<Time> mandatoryTimes = assets_[k]->mandatoryTimes();
+            for (Time t : mandatoryTimes) {
+                if (t >= 0.0)
+                    times.push_back(t);
+            }
+            times.push_back(from_[k]);
+            times.push_back(to_[k]);
+        }
+        TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
+        lattice_ = model_->tree(timeGrid);
+
+        for (Size k=0; k<assets_.size(); ++k)
+            assets_[k]->initialize(lattice_, from_[k]);
+
+        // the assets are rolled back together to each of the target
+        // times in turn, starting from the latest; each of them
+        // takes part in the rollbacks between its initial time and
+        // its target time.
+        std::vector<Time> targets = to_;
+        std::sort(targets.begin(), targets.end(), std::greater<>());
+        targets.erase(std::unique(targets.begin(), targets.end()),
+                      targets.end());
+        std::vector<bool> done(assets_.size(), false);
+        std::vector<DiscretizedAsset*> assets;
+        for (Time target : targets) {
+            assets.clear();
+            for (Size k=0; k<assets_.size(); ++k) {
+                if (!done[k] && to_[k] <= target &&
+                    assets_[k]->time() >= target) {
+                    assets.push_back(assets_[k].get());
+                    done[k] = (to_[k] == target);
+                }
+            }
+            lattice_->rollbackAll(assets, target);
+        }
+
+        values_.resize(assets_.size());
+        for (Size k=0; k<assets_.size(); ++k)
+            values_[k] = assets_[k]->presentValue();
+    }
+
+    Real SharedShortRateLattice::presentValue(Size i) const {
+        QL_REQUIRE(!values_.empty(), "assets not rolled back yet");
+        QL_REQUIRE(i < values_.size(),
+                   "index (" << i << ") out of range [0,"
+                   << values_.size() << ")");
+        return values_[i];
+    }
+
+}
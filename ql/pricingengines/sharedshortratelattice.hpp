@@ -0,0 +1,88 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sharedshortratelattice.hpp
+    \brief short-rate lattice shared by a set of discretized assets
+*/
+
+#ifndef quantlib_shared_short_rate_lattice_hpp
+#define quantlib_shared_short_rate_lattice_hpp
+
+#include <ql/discretizedasset.hpp>
+#include <ql/models/model.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! short-rate lattice shared by a set of discretized assets
+    /*! When several instruments are priced on the same short-rate
+        model, building a separate lattice for each of them (including
+        the fitting to the term structure) can take most of the time.
+        This class collects discretized assets, builds a single
+        lattice on a time grid including the mandatory times of all
+        of them, and rolls them back together.
+
+        \code
+        SharedShortRateLattice lattice(model, 100);
+        auto swaption = ext::make_shared<DiscretizedSwaption>(...);
+        Size i = lattice.add(swaption, lastExerciseTime, firstExerciseTime);
+        auto bond = ext::make_shared<DiscretizedCallableFixedRateBond>(...);
+        Size j = lattice.add(bond, redemptionTime);
+        lattice.rollback();
+        Real swaptionValue = lattice.presentValue(i);
+        Real bondValue = lattice.presentValue(j);
+        \endcode
+
+        The time steps are distributed over the longest of the
+        periods spanned by the assets; thus, the results are the
+        same as those of the corresponding tree engines using the
+        time grid of the shared lattice.
+
+        \ingroup lattices
+    */
+    class SharedShortRateLattice {
+      public:
+        SharedShortRateLattice(ext::shared_ptr<ShortRateModel> model,
+                               Size timeSteps);
+        /*! adds an asset, to be initialized at time \p from and
+            rolled back to time \p to; returns its index.
+        */
+        Size add(ext::shared_ptr<DiscretizedAsset> asset,
+                 Time from,
+                 Time to = 0.0);
+        //! builds the lattice and rolls back all the assets
+        void rollback();
+        //! \name Inspectors
+        //@{
+        Size size() const { return assets_.size(); }
+        //! present value of the i-th asset after the rollback
+        Real presentValue(Size i) const;
+        //! the lattice built by the last rollback
+        const ext::shared_ptr<Lattice>& lattice() const { return lattice_; }
+        //@}
+      private:
+        ext::shared_ptr<ShortRateModel> model_;
+        Size timeSteps_;
+        std::vector<ext::shared_ptr<DiscretizedAsset> > assets_;
+        std::vector<Time> from_, to_;
+        std::vector<Real> values_;
+        ext::shared_ptr<Lattice> lattice_;
+    };
+
+}
+
+#endif
@@ -221,6 +221,34 @@ namespace QuantLib {
                                  arguments_.floatingResetDates.end(), expiry0 - 1) -
                 arguments_.floatingResetDates.begin();
 
+            // the zerobonds and the numeraire are evaluated on the whole
+            // grid at once, outside the loop below
+            Matrix floatingZerobonds, fixedZerobonds;
+            Array numeraires, rebateZerobonds;
+            Real zerobond0 = 0.0;
+            if (expiry0 > settlement) {
+                Time t0 = model_->termStructure()->timeFromReference(expiry0);
+                Array floatingPayTimes(arguments_.floatingCoupons.size() - k1);
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++)
+                    floatingPayTimes[l - k1] = model_->termStructure()->timeFromReference(
+                        arguments_.floatingPayDates[l]);
+                Array fixedPayTimes(arguments_.fixedCoupons.size() - j1);
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++)
+                    fixedPayTimes[l - j1] = model_->termStructure()->timeFromReference(
+                        arguments_.fixedPayDates[l]);
+                floatingZerobonds =
+                    model_->zerobond(floatingPayTimes, t0, z, discountCurve_);
+                fixedZerobonds = model_->zerobond(fixedPayTimes, t0, z, discountCurve_);
+                if (rebatedExercise != nullptr)
+                    rebateZerobonds = model_->zerobond(
+                        model_->termStructure()->timeFromReference(
+                            rebatedExercise->rebatePaymentDate(idx)),
+                        t0, z, discountCurve_);
+                numeraires = model_->numeraire(expiry0Time, z, discountCurve_);
+                if (probabilities_ != None)
+                    zerobond0 = model_->zerobond(expiry0Time, 0.0, 0.0, discountCurve_);
+            }
+
             // todo add openmp support later on (as in gaussian1dswaptionengine)
 
             for (Size k = 0; k < (expiry0 > settlement ? npv0.size() : 1);
@@ -411,10 +439,7 @@ namespace QuantLib {
                                       arguments_.floatingSpreads[l]);
                         }
                         floatingLegNpv +=
-                            amount *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
-                            zSpreadDf;
+                            amount * floatingZerobonds[l - k1][k] * zSpreadDf;
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
@@ -429,9 +454,7 @@ namespace QuantLib {
                                                 expiry0,
                                                 arguments_.fixedPayDates[l])));
                         fixedLegNpv +=
-                            arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_) *
+                            arguments_.fixedCoupons[l] * fixedZerobonds[l - j1][k] *
                             zSpreadDf;
                     }
                     Real rebate = 0.0;
@@ -452,10 +475,9 @@ namespace QuantLib {
                     Real exerciseValue =
                         ((type == Option::Call ? 1.0 : -1.0) *
                              (floatingLegNpv - fixedLegNpv) +
-                         rebate * model_->zerobond(rebateDate, expiry0, z[k],
-                                                   discountCurve_) *
+                         rebate * (rebatedExercise != nullptr ? rebateZerobonds[k] : 1.0) *
                              zSpreadDf) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -467,21 +489,12 @@ namespace QuantLib {
                             npvp0.back()[k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 / (model_->zerobond(expiry0Time, 0.0,
-                                                              0.0,
-                                                              discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 /
-                                          (model_->zerobond(expiry0Time, 0.0,
-                                                            0.0,
-                                                            discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
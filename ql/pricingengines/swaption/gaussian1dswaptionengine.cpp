@@ -104,6 +104,29 @@ namespace QuantLib {
                                  floatSchedule.dates().end(), expiry0 - 1) -
                 floatSchedule.dates().begin();
 
+            // the zerobonds and the numeraire are evaluated on the whole
+            // grid at once, outside the loop below
+            Matrix floatingZerobonds, fixedZerobonds;
+            Array numeraires;
+            Real zerobond0 = 0.0;
+            if (expiry0 > settlement) {
+                Time t0 = model_->termStructure()->timeFromReference(expiry0);
+                Array floatingPayTimes(arguments_.floatingCoupons.size() - k1);
+                for (Size l = k1; l < arguments_.floatingCoupons.size(); l++)
+                    floatingPayTimes[l - k1] = model_->termStructure()->timeFromReference(
+                        arguments_.floatingPayDates[l]);
+                Array fixedPayTimes(arguments_.fixedCoupons.size() - j1);
+                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++)
+                    fixedPayTimes[l - j1] = model_->termStructure()->timeFromReference(
+                        arguments_.fixedPayDates[l]);
+                floatingZerobonds =
+                    model_->zerobond(floatingPayTimes, t0, z, discountCurve_);
+                fixedZerobonds = model_->zerobond(fixedPayTimes, t0, z, discountCurve_);
+                numeraires = model_->numeraire(expiry0Time, z, discountCurve_);
+                if (probabilities_ != None)
+                    zerobond0 = model_->zerobond(expiry0Time, 0.0, 0.0, discountCurve_);
+            }
+
             // a lazy object is not thread safe, neither is the caching
             // in gsrprocess. therefore we trigger computations here such
             // that neither lazy object recalculation nor write access
@@ -122,14 +145,7 @@ namespace QuantLib {
                     else
                         model_->forwardRate(arguments_.floatingFixingDates[l],
                                             expiry0, 0.0, swap->iborIndex());
-                    model_->zerobond(arguments_.floatingPayDates[l], expiry0,
-                                     0.0, discountCurve_);
-                }
-                for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
-                    model_->zerobond(arguments_.fixedPayDates[l], expiry0, 0.0,
-                                     discountCurve_);
                 }
-                model_->numeraire(expiry0Time, 0.0, discountCurve_);
             }
 #endif
 
@@ -283,20 +299,18 @@ namespace QuantLib {
                             arguments_.floatingAccrualTimes[l] *
                             (arguments_.floatingSpreads[l] +
                              floatingRate) *
-                            model_->zerobond(arguments_.floatingPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            floatingZerobonds[l - k1][k];
                     }
                     Real fixedLegNpv = 0.0;
                     for (Size l = j1; l < arguments_.fixedCoupons.size(); l++) {
                         fixedLegNpv +=
                             arguments_.fixedCoupons[l] *
-                            model_->zerobond(arguments_.fixedPayDates[l],
-                                             expiry0, z[k], discountCurve_);
+                            fixedZerobonds[l - j1][k];
                     }
                     Real exerciseValue =
                         (type == Option::Call ? 1.0 : -1.0) *
                         (floatingLegNpv - fixedLegNpv) /
-                        model_->numeraire(expiry0Time, z[k], discountCurve_);
+                        numeraires[k];
 
                     // for probability computation
                     if (probabilities_ != None) {
@@ -308,21 +322,12 @@ namespace QuantLib {
                             npvp0.back()[k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 / (model_->zerobond(expiry0Time, 0.0,
-                                                              0.0,
-                                                              discountCurve_) *
-                                             model_->numeraire(expiry0, z[k],
-                                                               discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                         if (exerciseValue >= npv0[k]) {
                             npvp0[idx - minIdxAlive][k] =
                                 probabilities_ == Naive
                                     ? Real(1.0)
-                                    : 1.0 /
-                                          (model_->zerobond(expiry0Time, 0.0,
-                                                            0.0,
-                                                            discountCurve_) *
-                                           model_->numeraire(expiry0Time, z[k],
-                                                             discountCurve_));
+                                    : 1.0 / (zerobond0 * numeraires[k]);
                             for (Size ii = idx - minIdxAlive + 1;
                                  ii < npvp0.size(); ii++)
                                 npvp0[ii][k] = 0.0;
@@ -30,14 +30,24 @@
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
+#include <utility>
 
 namespace QuantLib {
 
     //! European option pricing engine using Monte Carlo simulation
-    /*! \ingroup vanillaengines
+    /*! Any striked payoff can be priced.  Delta, vega, rho and
+        dividend rho can be estimated on the same paths used for the
+        value, using either pathwise estimators (plain-vanilla payoffs
+        only) or likelihood-ratio estimators (any striked payoff,
+        including digitals).
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               checking it against analytic results.
+
+        \test the correctness of the returned greeks is tested by
+              checking them against analytic results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -60,9 +70,15 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             McGreeks::Method greeks = McGreeks::None);
       protected:
+        typedef typename MCVanillaEngine<SingleVariate,RNG,S>::greeks_pricer_type
+            greeks_pricer_type;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<greeks_pricer_type> greeksPathPricer() const override;
+      private:
+        McGreeks::Method greeks_;
     };
 
     //! Monte Carlo European engine factory
@@ -79,6 +95,7 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withGreeks(McGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -88,6 +105,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_ = false;
         BigNatural seed_ = 0;
+        McGreeks::Method greeks_ = McGreeks::None;
     };
 
     class EuropeanPathPricer : public PathPricer<Path> {
@@ -95,10 +113,12 @@ namespace QuantLib {
         EuropeanPathPricer(Option::Type type,
                            Real strike,
                            DiscountFactor discount);
+        EuropeanPathPricer(ext::shared_ptr<Payoff> payoff,
+                           DiscountFactor discount);
         Real operator()(const Path& path) const override;
 
       private:
-        PlainVanillaPayoff payoff_;
+        ext::shared_ptr<Payoff> payoff_;
         DiscountFactor discount_;
     };
 
@@ -116,7 +136,8 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             McGreeks::Method greeks)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +147,8 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed),
+      greeks_(greeks) {}
 
 
     template <class RNG, class S>
@@ -134,10 +156,10 @@ namespace QuantLib {
     ext::shared_ptr<typename MCEuropeanEngine<RNG,S>::path_pricer_type>
     MCEuropeanEngine<RNG,S>::pathPricer() const {
 
-        ext::shared_ptr<PlainVanillaPayoff> payoff =
-            ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+        ext::shared_ptr<StrikedTypePayoff> payoff =
+            ext::dynamic_pointer_cast<StrikedTypePayoff>(
                 this->arguments_.payoff);
-        QL_REQUIRE(payoff, "non-plain payoff given");
+        QL_REQUIRE(payoff, "non-striked payoff given");
 
         ext::shared_ptr<GeneralizedBlackScholesProcess> process =
             ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
@@ -145,11 +167,44 @@ namespace QuantLib {
         QL_REQUIRE(process, "Black-Scholes process required");
 
         return ext::make_shared<EuropeanPathPricer>(
-              payoff->optionType(),
-              payoff->strike(),
+              payoff,
               process->riskFreeRate()->discount(this->timeGrid().back()));
     }
 
+    template <class RNG, class S>
+    inline
+    ext::shared_ptr<typename MCEuropeanEngine<RNG,S>::greeks_pricer_type>
+    MCEuropeanEngine<RNG,S>::greeksPathPricer() const {
+
+        if (greeks_ == McGreeks::None)
+            return ext::shared_ptr<greeks_pricer_type>();
+
+        ext::shared_ptr<StrikedTypePayoff> payoff =
+            ext::dynamic_pointer_cast<StrikedTypePayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-striked payoff given");
+
+        ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+            ext::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        TimeGrid grid = this->timeGrid();
+        switch (greeks_) {
+          case McGreeks::Pathwise:
+            // pathwise estimators need a continuous payoff
+            QL_REQUIRE(ext::dynamic_pointer_cast<PlainVanillaPayoff>(payoff),
+                       "pathwise greeks require a plain-vanilla payoff");
+            return ext::make_shared<EuropeanPathwiseGreeksPricer>(
+                process, grid, payoff->optionType(), payoff->strike());
+          case McGreeks::LikelihoodRatio:
+            return ext::make_shared<EuropeanLikelihoodRatioGreeksPricer>(
+                process, payoff, grid.back());
+          default:
+            QL_FAIL("unknown greeks method");
+        }
+    }
+
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG, S>::MakeMCEuropeanEngine(
@@ -220,6 +275,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withGreeks(McGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator ext::shared_ptr<PricingEngine>()
@@ -235,7 +297,8 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_);
+                                    seed_,
+                                    greeks_);
     }
 
 
@@ -243,14 +306,21 @@ namespace QuantLib {
     inline EuropeanPathPricer::EuropeanPathPricer(Option::Type type,
                                                   Real strike,
                                                   DiscountFactor discount)
-    : payoff_(type, strike), discount_(discount) {
+    : payoff_(ext::make_shared<PlainVanillaPayoff>(type, strike)),
+      discount_(discount) {
         QL_REQUIRE(strike>=0.0,
                    "strike less than zero not allowed");
     }
 
+    inline EuropeanPathPricer::EuropeanPathPricer(ext::shared_ptr<Payoff> payoff,
+                                                  DiscountFactor discount)
+    : payoff_(std::move(payoff)), discount_(discount) {
+        QL_REQUIRE(payoff_, "null payoff given");
+    }
+
     inline Real EuropeanPathPricer::operator()(const Path& path) const {
         QL_REQUIRE(!path.empty(), "the path cannot be empty");
-        return payoff_(path.back()) * discount_;
+        return (*payoff_)(path.back()) * discount_;
     }
 
 }
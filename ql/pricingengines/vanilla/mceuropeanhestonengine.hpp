@@ -25,6 +25,7 @@
 #ifndef quantlib_mc_european_heston_engine_hpp
 #define quantlib_mc_european_heston_engine_hpp
 
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
 #include <ql/processes/hestonprocess.hpp>
 #include <utility>
@@ -32,10 +33,22 @@
 namespace QuantLib {
 
     //! Monte Carlo Heston-model engine for European options
-    /*! \ingroup vanillaengines
+    /*! Pathwise delta, rho and dividend rho can be requested.  The
+        discretizations of HestonProcess scale the simulated spot with
+        its initial value and with the forward, so that the tangents
+        are obtained from the path itself.  Vega is not returned,
+        since the model has no Black volatility to shift; likelihood-
+        ratio greeks are not available, since the density of the
+        discretized spot is not known in closed form.
+
+        \ingroup vanillaengines
 
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
+
+        \test the correctness of the returned greeks is tested by
+              checking them against finite differences of
+              analytic results.
     */
     template <class RNG = PseudoRandom,
               class S = Statistics, class P = HestonProcess>
@@ -51,9 +64,20 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               McGreeks::Method greeks = McGreeks::None);
+        void calculate() const override {
+            MCVanillaEngine<MultiVariate,RNG,S>::calculate();
+            if (this->mcModel_->hasGreeks())
+                this->results_.vega = Null<Real>();
+        }
       protected:
+        typedef typename MCVanillaEngine<MultiVariate,RNG,S>::greeks_pricer_type
+            greeks_pricer_type;
         ext::shared_ptr<path_pricer_type> pathPricer() const override;
+        ext::shared_ptr<greeks_pricer_type> greeksPathPricer() const override;
+      private:
+        McGreeks::Method greeks_;
     };
 
     //! Monte Carlo Heston European engine factory
@@ -70,6 +94,7 @@ namespace QuantLib {
         MakeMCEuropeanHestonEngine& withMaxSamples(Size samples);
         MakeMCEuropeanHestonEngine& withSeed(BigNatural seed);
         MakeMCEuropeanHestonEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanHestonEngine& withGreeks(McGreeks::Method method);
         // conversion to pricing engine
         operator ext::shared_ptr<PricingEngine>() const;
       private:
@@ -78,6 +103,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_ = 0;
+        McGreeks::Method greeks_ = McGreeks::None;
     };
 
 
@@ -94,6 +120,29 @@ namespace QuantLib {
     };
 
 
+    //! pathwise greeks for European options under a Heston process
+    /*! The results are returned in the order given by McGreeks::Index;
+        the vega is set to zero.
+    */
+    class EuropeanHestonPathwiseGreeksPricer
+        : public PathPricer<MultiPath, Array> {
+      public:
+        EuropeanHestonPathwiseGreeksPricer(Option::Type type,
+                                           Real strike,
+                                           Real x0,
+                                           DiscountFactor discount,
+                                           Time maturity);
+        Array operator()(const MultiPath& multiPath) const override;
+
+      private:
+        Option::Type type_;
+        Real strike_;
+        Real x0_;
+        DiscountFactor discount_;
+        Time maturity_;
+    };
+
+
     // template definitions
 
     template <class RNG, class S, class P>
@@ -101,11 +150,12 @@ namespace QuantLib {
                 const ext::shared_ptr<P>& process,
                 Size timeSteps, Size timeStepsPerYear, bool antitheticVariate,
                 Size requiredSamples, Real requiredTolerance,
-                Size maxSamples, BigNatural seed)
+                Size maxSamples, BigNatural seed, McGreeks::Method greeks)
     : MCVanillaEngine<MultiVariate,RNG,S>(process, timeSteps, timeStepsPerYear,
                                           false, antitheticVariate, false,
                                           requiredSamples, requiredTolerance,
-                                          maxSamples, seed) {}
+                                          maxSamples, seed),
+      greeks_(greeks) {}
 
 
     template <class RNG, class S, class P>
@@ -130,6 +180,37 @@ namespace QuantLib {
     }
 
 
+    template <class RNG, class S, class P>
+    ext::shared_ptr<
+        typename MCEuropeanHestonEngine<RNG,S,P>::greeks_pricer_type>
+    MCEuropeanHestonEngine<RNG,S,P>::greeksPathPricer() const {
+
+        if (greeks_ == McGreeks::None)
+            return ext::shared_ptr<greeks_pricer_type>();
+
+        QL_REQUIRE(greeks_ == McGreeks::Pathwise,
+                   "only pathwise greeks are available "
+                   "for the Heston model");
+
+        ext::shared_ptr<PlainVanillaPayoff> payoff(
+                  ext::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                    this->arguments_.payoff));
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        ext::shared_ptr<P> process =
+            ext::dynamic_pointer_cast<P>(this->process_);
+        QL_REQUIRE(process, "Heston like process required");
+
+        Time maturity = this->timeGrid().back();
+        return ext::make_shared<EuropeanHestonPathwiseGreeksPricer>(
+                                payoff->optionType(),
+                                payoff->strike(),
+                                process->s0()->value(),
+                                process->riskFreeRate()->discount(maturity),
+                                maturity);
+    }
+
+
     template <class RNG, class S, class P>
     inline MakeMCEuropeanHestonEngine<RNG, S, P>::MakeMCEuropeanHestonEngine(
         ext::shared_ptr<P> process)
@@ -196,6 +277,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class P>
+    inline MakeMCEuropeanHestonEngine<RNG,S,P>&
+    MakeMCEuropeanHestonEngine<RNG,S,P>::withGreeks(McGreeks::Method method) {
+        greeks_ = method;
+        return *this;
+    }
+
     template <class RNG, class S, class P>
     inline
     MakeMCEuropeanHestonEngine<RNG,S,P>::
@@ -208,7 +296,8 @@ namespace QuantLib {
                                                    antithetic_,
                                                    samples_, tolerance_,
                                                    maxSamples_,
-                                                   seed_);
+                                                   seed_,
+                                                   greeks_);
     }
 
 
@@ -231,6 +320,56 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+
+    inline EuropeanHestonPathwiseGreeksPricer::EuropeanHestonPathwiseGreeksPricer(
+                                                 Option::Type type,
+                                                 Real strike,
+                                                 Real x0,
+                                                 DiscountFactor discount,
+                                                 Time maturity)
+    : type_(type), strike_(strike), x0_(x0), discount_(discount),
+      maturity_(maturity) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(x0>0.0,
+                   "positive initial value required");
+    }
+
+    inline Array EuropeanHestonPathwiseGreeksPricer::operator()(
+                                           const MultiPath& multiPath) const {
+        const Path& path = multiPath[0];
+        QL_REQUIRE(multiPath.pathSize()>0, "the path cannot be empty");
+
+        // the terminal spot is proportional to the initial value and
+        // to exp((r-q)T), so that its tangents are S_T/S_0 and +/- T S_T
+        Real s = path.back();
+        Real value = 0.0, gradient = 0.0;
+        switch (type_) {
+          case Option::Call:
+            if (s > strike_) {
+                value = s - strike_;
+                gradient = 1.0;
+            }
+            break;
+          case Option::Put:
+            if (s < strike_) {
+                value = strike_ - s;
+                gradient = -1.0;
+            }
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+
+        Array results(McGreeks::size, 0.0);
+        results[McGreeks::Delta] = discount_ * gradient * s / x0_;
+        results[McGreeks::Rho] =
+            discount_ * maturity_ * (gradient * s - value);
+        results[McGreeks::DividendRho] =
+            -discount_ * maturity_ * gradient * s;
+        return results;
+    }
+
 }
 
 
@@ -25,6 +25,7 @@
 #ifndef quantlib_mcvanilla_engine_hpp
 #define quantlib_mcvanilla_engine_hpp
 
+#include <ql/pricingengines/mcgreeks.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
 #include <ql/instruments/vanillaoption.hpp>
 
@@ -45,6 +46,9 @@ namespace QuantLib {
             if constexpr (RNG::allowsErrorEstimate)
                 this->results_.errorEstimate =
                     this->mcModel_->sampleAccumulator().errorEstimate();
+            if (this->mcModel_->hasGreeks())
+                McGreeks::store(this->mcModel_->greeksAccumulator().mean(),
+                                this->results_);
         }
 
       protected:
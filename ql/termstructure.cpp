@@ -45,6 +45,12 @@ namespace QuantLib {
         return referenceDate_;
     }
 
+    void TermStructure::timesFromReference(const Date* dates,
+                                           Time* times,
+                                           Size n) const {
+        dayCounter().yearFractions(referenceDate(), dates, times, n);
+    }
+
     void TermStructure::update() {
         if (moving_)
             updated_ = false;
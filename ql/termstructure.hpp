@@ -79,6 +79,8 @@ namespace QuantLib {
         virtual DayCounter dayCounter() const;
         //! date/time conversion
         Time timeFromReference(const Date& date) const;
+        //! date/time conversion of n dates
+        void timesFromReference(const Date* dates, Time* times, Size n) const;
         //! the latest date for which the curve can return values
         virtual Date maxDate() const = 0;
         //! the latest time for which the curve can return values
@@ -100,13 +100,14 @@ namespace QuantLib {
         void setupTimes(const std::vector<Date>& dates,
                         Date referenceDate,
                         const DayCounter& dayCounter) {
-            times_.resize(dates.size());
-            times_[0] = dayCounter.yearFraction(referenceDate, dates[0]);
             for (Size i = 1; i < dates.size(); i++) {
                 QL_REQUIRE(dates[i] > dates[i-1],
                            "dates not sorted: " << dates[i] << " passed after " << dates[i-1]);
-
-                times_[i] = dayCounter.yearFraction(referenceDate, dates[i]);
+            }
+            times_.resize(dates.size());
+            dayCounter.yearFractions(referenceDate, dates.data(),
+                                     times_.data(), dates.size());
+            for (Size i = 1; i < dates.size(); i++) {
                 QL_REQUIRE(!close(this->times_[i], this->times_[i-1]),
                            "two passed dates (" << dates[i-1] << " and " << dates[i]
                            << ") correspond to the same time "
@@ -177,7 +177,6 @@ namespace detail {
         dates.resize(alive_+1);
         times.resize(alive_+1);
         dates[0] = firstDate;
-        times[0] = ts_->timeFromReference(dates[0]);
 
         Date maxDate = firstDate;
         // pillar counter: i
@@ -185,7 +184,6 @@ namespace detail {
         for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
             const auto& helper = ts_->instruments_[j];
             dates[i] = helper->pillarDate();
-            times[i] = ts_->timeFromReference(dates[i]);
             // check for duplicated pillars
             QL_REQUIRE(dates[i-1]!=dates[i],
                        "more than one instrument with pillar " << dates[i]);
@@ -207,6 +205,7 @@ namespace detail {
                 loopRequired_ = true;
         }
         ts_->maxDate_ = maxDate;
+        ts_->timesFromReference(dates.data(), times.data(), dates.size());
 
         // set initial guess only if the current curve cannot be used as guess
         if (!validCurve_ || ts_->data_.size()!=alive_+1) {
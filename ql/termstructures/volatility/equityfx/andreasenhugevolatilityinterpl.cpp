@@ -69,7 +69,30 @@ namespace QuantLib {
                                  AndreasenHugeVolatilityInterpl::PiecewiseConstant),
           dxMap_(FirstDerivativeOp(0, mesher_)), dxxMap_(SecondDerivativeOp(0, mesher_)),
           d2CdK2_(dxMap_.mult(Array(mesher->layout()->size(), -1.0)).add(dxxMap_)),
-          mapT_(0, mesher_) {}
+          mapT_(0, mesher_) {
+
+            if (interpolationType_ == AndreasenHugeVolatilityInterpl::PiecewiseConstant) {
+                sigNodes_ = Array(lnMarketStrikes_.size());
+                for (Size i=0; i < sigNodes_.size()-1; ++i)
+                    sigNodes_[i] = 0.5*(lnMarketStrikes_[i] + lnMarketStrikes_[i+1]);
+                sigNodes_.back() = lnMarketStrikes_.back();
+            }
+
+            // the local vol on the grid is linear in the node values
+            // for all interpolation types; the weights are used
+            // for the analytic Jacobian
+            const Array lnStrikes = mesher_->locations(0);
+            weights_ = Matrix(lnMarketStrikes_.size(), nGridPoints_);
+            for (Size k=0; k < weights_.rows(); ++k) {
+                Array e(lnMarketStrikes_.size(), 0.0);
+                e[k] = 1.0;
+                const Interpolation sigInterpl = sigInterpolation(e);
+                for (Size i=0; i < nGridPoints_; ++i)
+                    weights_[k][i] = sigInterpl(
+                        std::min(std::max(lnStrikes[i], lnMarketStrikes_.front()),
+                                 lnMarketStrikes_.back()), true);
+            }
+        }
 
         Array d2CdK2(const Array& c) const {
             return d2CdK2_.apply(c);
@@ -77,31 +100,7 @@ namespace QuantLib {
 
         Array solveFor(Time dT, const Array& sig, const Array& b) const {
 
-            Array x(lnMarketStrikes_.size());
-            Interpolation sigInterpl;
-
-            switch (interpolationType_) {
-              case AndreasenHugeVolatilityInterpl::CubicSpline:
-                sigInterpl = CubicNaturalSpline(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::Linear:
-                sigInterpl = LinearInterpolation(
-                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
-                    sig.begin());
-                break;
-              case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
-                for (Size i=0; i < x.size()-1; ++i)
-                    x[i] = 0.5*(lnMarketStrikes_[i] + lnMarketStrikes_[i+1]);
-                x.back() = lnMarketStrikes_.back();
-
-                sigInterpl = BackwardFlatInterpolation(
-                    x.begin(), x.end(), sig.begin());
-                break;
-              default:
-                QL_FAIL("unknown interpolation type");
-            }
+            const Interpolation sigInterpl = sigInterpolation(sig);
 
             Array z(mesher_->layout()->size());
             for (const auto& iter : *mesher_->layout()) {
@@ -141,6 +140,47 @@ namespace QuantLib {
             return retVal;
         }
 
+        /*! The derivative of the implicit step
+            (1 - dT z D) c = b with respect to the node sig_k is
+            (1 - dT z D) dc/dsig_k = dT dz/dsig_k D c, i.e., one
+            tridiagonal solve per node, which are carried out
+            concurrently if OpenMP is enabled.  The final
+            interpolation onto the market strikes is linearized
+            without the monotonicity filter.
+        */
+        void jacobian(Matrix& jac, const Array& sig) const override {
+            const Size n = lnMarketStrikes_.size();
+
+            const Array c = solveFor(dT_, sig, previousNPVs_);
+            const Array d2c = d2CdK2(c);
+            const TripleBandLinearOp op = mapT_.mult(Array(nGridPoints_, dT_));
+
+            Array vol(nGridPoints_, 0.0);
+            for (Size k=0; k < n; ++k)
+                for (Size i=0; i < nGridPoints_; ++i)
+                    vol[i] += weights_[k][i]*sig[k];
+
+            const std::vector<Real>& gridPoints =
+                mesher_->getFdm1dMeshers().front()->locations();
+
+            // the system was solved above already, so that
+            // no exception is expected in the parallel region
+            #pragma omp parallel for if(n > 1)
+            for (long k=0; k < long(n); ++k) {
+                Array rhs(nGridPoints_);
+                for (Size i=0; i < nGridPoints_; ++i)
+                    rhs[i] = dT_*vol[i]*weights_[k][i]*d2c[i];
+
+                // solve_splitting uses a workspace, hence the copy
+                const Array dc = TripleBandLinearOp(op).solve_splitting(rhs, 1.0);
+
+                const CubicNaturalSpline interpl(
+                    gridPoints.begin(), gridPoints.end(), dc.begin());
+                for (Size j=0; j < n; ++j)
+                    jac[j][k] = interpl(lnMarketStrikes_[j]);
+            }
+        }
+
         Array vegaCalibrationError(const Array& sig) const {
             return values(sig)/marketVegas_;
         }
@@ -151,6 +191,24 @@ namespace QuantLib {
 
 
       private:
+        Interpolation sigInterpolation(const Array& sig) const {
+            switch (interpolationType_) {
+              case AndreasenHugeVolatilityInterpl::CubicSpline:
+                return CubicNaturalSpline(
+                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                    sig.begin());
+              case AndreasenHugeVolatilityInterpl::Linear:
+                return LinearInterpolation(
+                    lnMarketStrikes_.begin(), lnMarketStrikes_.end(),
+                    sig.begin());
+              case AndreasenHugeVolatilityInterpl::PiecewiseConstant:
+                return BackwardFlatInterpolation(
+                    sigNodes_.begin(), sigNodes_.end(), sig.begin());
+              default:
+                QL_FAIL("unknown interpolation type");
+            }
+        }
+
         const Array marketNPVs_, marketVegas_;
         const Array lnMarketStrikes_, previousNPVs_;
         const ext::shared_ptr<FdmMesherComposite> mesher_;
@@ -163,6 +221,8 @@ namespace QuantLib {
         const TripleBandLinearOp dxxMap_;
         const TripleBandLinearOp d2CdK2_;
         mutable TripleBandLinearOp mapT_;
+        Array sigNodes_;
+        Matrix weights_;
     };
 
     class CombinedCostFunction : public CostFunction {
@@ -189,6 +249,33 @@ namespace QuantLib {
                 QL_FAIL("internal error: cost function not set");
         }
 
+        void jacobian(Matrix& jac, const Array& sig) const override {
+            if ((putCostFct_ != nullptr) && (callCostFct_ != nullptr)) {
+                const Size n = sig.size();
+                Matrix pj(n, n), cj(n, n);
+                putCostFct_->jacobian(pj, sig);
+                callCostFct_->jacobian(cj, sig);
+
+                std::copy(pj.begin(), pj.end(), jac.begin());
+                std::copy(cj.begin(), cj.end(), jac.row_begin(n));
+            } else if (putCostFct_ != nullptr)
+                putCostFct_->jacobian(jac, sig);
+            else if (callCostFct_ != nullptr)
+                callCostFct_->jacobian(jac, sig);
+            else
+                QL_FAIL("internal error: cost function not set");
+        }
+
+        void gradient(Array& grad, const Array& sig) const override {
+            const Array v = values(sig);
+            Matrix jac(v.size(), sig.size());
+            jacobian(jac, sig);
+
+            const Real f = std::sqrt(DotProduct(v, v)/v.size());
+            grad = (f > 0.0) ? Array(transpose(jac)*v/(v.size()*f))
+                             : Array(sig.size(), 0.0);
+        }
+
         Array initialValues() const {
             if ((putCostFct_ != nullptr) && (callCostFct_ != nullptr))
                 return 0.5*(  putCostFct_->initialValues()
@@ -48,6 +48,14 @@ namespace QuantLib {
 
         Andreasen J., Huge B., 2010. Volatility Interpolation
         https://ssrn.com/abstract=1694972
+
+        The cost functions provide the analytic Jacobian of the
+        one-step implicit scheme with respect to the local volatility
+        nodes; it is used by optimization methods asking for it, e.g.
+        LevenbergMarquardt when its useCostFunctionsJacobian argument
+        is set.  This is faster, but it can converge to a different
+        local-volatility surface than the default Levenberg-Marquardt
+        method, which uses finite differences.
     */
 
     class AndreasenHugeVolatilityInterpl : public LazyObject {
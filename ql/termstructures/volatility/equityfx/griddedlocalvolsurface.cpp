@@ -0,0 +1,152 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
+#include <algorithm>
+#include <string>
+#include <utility>
+
+namespace QuantLib {
+
+    GriddedLocalVolSurface::GriddedLocalVolSurface(
+                                     Handle<LocalVolTermStructure> localVol,
+                                     std::vector<Time> times,
+                                     std::vector<Real> strikes,
+                                     StrikeInterpolation interpolation,
+                                     bool concurrentSlices)
+    : localVol_(std::move(localVol)), times_(std::move(times)),
+      strikes_(std::move(strikes)), interpolation_(interpolation),
+      concurrentSlices_(concurrentSlices) {
+        QL_REQUIRE(!times_.empty(), "no times given");
+        QL_REQUIRE(times_.front() >= 0.0, "negative time given");
+        QL_REQUIRE(strikes_.size() >= 2, "at least two strikes required");
+        for (Size j=1; j<times_.size(); ++j)
+            QL_REQUIRE(times_[j] > times_[j-1], "times must be increasing");
+        for (Size i=1; i<strikes_.size(); ++i)
+            QL_REQUIRE(strikes_[i] > strikes_[i-1],
+                       "strikes must be increasing");
+
+        registerWith(localVol_);
+    }
+
+    const Date& GriddedLocalVolSurface::referenceDate() const {
+        return localVol_->referenceDate();
+    }
+
+    Calendar GriddedLocalVolSurface::calendar() const {
+        return localVol_->calendar();
+    }
+
+    DayCounter GriddedLocalVolSurface::dayCounter() const {
+        return localVol_->dayCounter();
+    }
+
+    Natural GriddedLocalVolSurface::settlementDays() const {
+        return localVol_->settlementDays();
+    }
+
+    Date GriddedLocalVolSurface::maxDate() const {
+        calculate();
+        return surface_->maxDate();
+    }
+
+    Time GriddedLocalVolSurface::maxTime() const {
+        return times_.back();
+    }
+
+    Real GriddedLocalVolSurface::minStrike() const {
+        return strikes_.front();
+    }
+
+    Real GriddedLocalVolSurface::maxStrike() const {
+        return strikes_.back();
+    }
+
+    void GriddedLocalVolSurface::update() {
+        // the reference date is managed by the underlying surface,
+        // so there's no need for TermStructure::update()
+        LazyObject::update();
+    }
+
+    const Matrix& GriddedLocalVolSurface::localVolMatrix() const {
+        calculate();
+        return *localVolMatrix_;
+    }
+
+    void GriddedLocalVolSurface::performCalculations() const {
+        QL_REQUIRE(!localVol_.empty(), "no local vol surface given");
+
+        const ext::shared_ptr<LocalVolTermStructure>& localVol =
+            localVol_.currentLink();
+        const Size nTimes = times_.size();
+        localVolMatrix_ = ext::make_shared<Matrix>(strikes_.size(), nTimes);
+        Matrix& m = *localVolMatrix_;
+
+        const auto sample = [&](Size j) {
+            const std::vector<Volatility> vols =
+                localVol->localVols(times_[j], strikes_, true);
+            std::copy(vols.begin(), vols.end(), m.column_begin(j));
+        };
+
+        // the first slice is always sampled serially, so that any lazy
+        // calculation in the underlying structures is done only once...
+        sample(0);
+
+        // ...and the others can then be sampled concurrently if so
+        // required.  Exceptions cannot leave the parallel region; they
+        // are collected and the first one (in time order) is rethrown.
+        std::vector<std::string> errors(nTimes);
+        std::vector<char> failed(nTimes, 0);
+        #pragma omp parallel for if(concurrentSlices_ && nTimes > 2)
+        for (long j=1; j<long(nTimes); ++j) {
+            try {
+                sample(j);
+            } catch (std::exception& e) {
+                errors[j] = e.what();
+                failed[j] = 1;
+            }
+        }
+        for (Size j=1; j<nTimes; ++j)
+            QL_REQUIRE(failed[j] == 0,
+                       "could not sample local vol at time " << times_[j]
+                       << ": " << errors[j]);
+
+        surface_ = ext::make_shared<FixedLocalVolSurface>(
+            localVol->referenceDate(), times_, strikes_, localVolMatrix_,
+            localVol->dayCounter());
+        if (interpolation_ == CubicInStrike)
+            surface_->setInterpolation<Cubic>(
+                Cubic(CubicInterpolation::Spline, false,
+                      CubicInterpolation::SecondDerivative, 0.0,
+                      CubicInterpolation::SecondDerivative, 0.0));
+    }
+
+    Volatility GriddedLocalVolSurface::localVolImpl(Time t,
+                                                    Real strike) const {
+        calculate();
+        return surface_->localVol(t, strike, true);
+    }
+
+    std::vector<Volatility>
+    GriddedLocalVolSurface::localVolsImpl(Time t,
+                                          const std::vector<Real>& strikes) const {
+        calculate();
+        return surface_->localVols(t, strikes, true);
+    }
+
+}
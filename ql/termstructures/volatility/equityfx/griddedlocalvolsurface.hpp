@@ -0,0 +1,105 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file griddedlocalvolsurface.hpp
+    \brief local volatility surface sampled once on a time/strike grid
+*/
+
+#ifndef quantlib_gridded_local_vol_surface_hpp
+#define quantlib_gridded_local_vol_surface_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
+
+namespace QuantLib {
+
+    //! Local volatility surface sampled once on a time/strike grid
+    /*! The underlying local volatility (e.g., a Dupire LocalVolSurface)
+        is evaluated once on the given grid, one time slice at a time,
+        and stored in a FixedLocalVolSurface; further requests are
+        served by interpolating the stored values, linearly in time
+        and linearly or with a natural cubic spline in strike.  The
+        grid is sampled again whenever the underlying surface changes.
+
+        This is useful when a pricer (e.g., a finite-difference engine
+        on a given mesher) asks for the local volatility many times on
+        the same points, and each evaluation of the underlying surface
+        is expensive.
+
+        When \c concurrentSlices is \c true and OpenMP is enabled, the
+        time slices are sampled in parallel; the underlying surface
+        must then be safe to use concurrently once it was evaluated
+        on the first slice.
+
+        \warning the surface is extrapolated flat outside the grid.
+    */
+    class GriddedLocalVolSurface : public LocalVolTermStructure,
+                                   public LazyObject {
+      public:
+        enum StrikeInterpolation { LinearInStrike, CubicInStrike };
+
+        GriddedLocalVolSurface(Handle<LocalVolTermStructure> localVol,
+                               std::vector<Time> times,
+                               std::vector<Real> strikes,
+                               StrikeInterpolation interpolation = LinearInStrike,
+                               bool concurrentSlices = false);
+
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const override;
+        Calendar calendar() const override;
+        DayCounter dayCounter() const override;
+        Natural settlementDays() const override;
+        Date maxDate() const override;
+        Time maxTime() const override;
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const override;
+        Real maxStrike() const override;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update() override;
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const { return times_; }
+        const std::vector<Real>& strikes() const { return strikes_; }
+        //! the local volatility values on the grid (strikes x times)
+        const Matrix& localVolMatrix() const;
+        //@}
+
+      protected:
+        void performCalculations() const override;
+        Volatility localVolImpl(Time t, Real strike) const override;
+        std::vector<Volatility>
+        localVolsImpl(Time t, const std::vector<Real>& strikes) const override;
+
+      private:
+        Handle<LocalVolTermStructure> localVol_;
+        std::vector<Time> times_;
+        std::vector<Real> strikes_;
+        StrikeInterpolation interpolation_;
+        bool concurrentSlices_;
+        mutable ext::shared_ptr<Matrix> localVolMatrix_;
+        mutable ext::shared_ptr<FixedLocalVolSurface> surface_;
+    };
+
+}
+
+#endif
@@ -21,6 +21,7 @@
 #include <ql/termstructures/volatility/equityfx/blackvoltermstructure.hpp>
 #include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/utilities/null.hpp>
 #include <utility>
 
 namespace QuantLib {
@@ -79,13 +80,58 @@ namespace QuantLib {
             LocalVolTermStructure::accept(v);
     }
 
+    // discount factors and forward at the slice time and at the
+    // neighboring times used for the time derivative
+    struct LocalVolSurface::Slice {
+        Time t, dt;
+        DiscountFactor dr, dq, drpt, dqpt, drmt, dqmt;
+        Real forwardValue;
+    };
+
+    LocalVolSurface::Slice LocalVolSurface::slice(Time t) const {
+        Slice s;
+        s.t = t;
+        s.dr = riskFreeTS_->discount(t, true);
+        s.dq = dividendTS_->discount(t, true);
+        s.forwardValue = underlying_->value()*s.dq/s.dr;
+
+        if (t==0.0) {
+            s.dt = 0.0001;
+            s.drpt = riskFreeTS_->discount(t+s.dt, true);
+            s.dqpt = dividendTS_->discount(t+s.dt, true);
+            s.drmt = s.dqmt = Null<Real>();
+        } else {
+            s.dt = std::min<Time>(0.0001, t/2.0);
+            s.drpt = riskFreeTS_->discount(t+s.dt, true);
+            s.drmt = riskFreeTS_->discount(t-s.dt, true);
+            s.dqpt = dividendTS_->discount(t+s.dt, true);
+            s.dqmt = dividendTS_->discount(t-s.dt, true);
+        }
+        return s;
+    }
+
     Volatility LocalVolSurface::localVolImpl(Time t, Real underlyingLevel)
                                                                      const {
+        return sliceLocalVol(slice(t), underlyingLevel);
+    }
+
+    std::vector<Volatility>
+    LocalVolSurface::localVolsImpl(Time t,
+                                   const std::vector<Real>& strikes) const {
+        const Slice s = slice(t);
+        std::vector<Volatility> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = sliceLocalVol(s, strikes[i]);
+        return result;
+    }
+
+    Volatility LocalVolSurface::sliceLocalVol(const Slice& s,
+                                              Real underlyingLevel) const {
+
+        const Time t = s.t;
+        const DiscountFactor dr = s.dr, dq = s.dq;
+        const Real forwardValue = s.forwardValue;
 
-        DiscountFactor dr = riskFreeTS_->discount(t, true);
-        DiscountFactor dq = dividendTS_->discount(t, true);
-        Real forwardValue = underlying_->value()*dq/dr;
-        
         // strike derivatives
         Real strike, y, dy, strikep, strikem;
         Real w, wp, wm, dwdy, d2wdy2;
@@ -101,12 +147,9 @@ namespace QuantLib {
         d2wdy2 = (wp-2.0*w+wm)/(dy*dy);
 
         // time derivative
-        Real dt, wpt, wmt, dwdt;
+        Real dt = s.dt, wpt, wmt, dwdt;
         if (t==0.0) {
-            dt = 0.0001;
-            DiscountFactor drpt = riskFreeTS_->discount(t+dt, true);
-            DiscountFactor dqpt = dividendTS_->discount(t+dt, true);           
-            Real strikept = strike*dr*dqpt/(drpt*dq);
+            Real strikept = strike*dr*s.dqpt/(s.drpt*dq);
         
             wpt = blackTS_->blackVariance(t+dt, strikept, true);
             QL_ENSURE(wpt>=w,
@@ -114,14 +157,8 @@ namespace QuantLib {
                       << " between time " << t << " and time " << t+dt);
             dwdt = (wpt-w)/dt;
         } else {
-            dt = std::min<Time>(0.0001, t/2.0);
-            DiscountFactor drpt = riskFreeTS_->discount(t+dt, true);
-            DiscountFactor drmt = riskFreeTS_->discount(t-dt, true);
-            DiscountFactor dqpt = dividendTS_->discount(t+dt, true);
-            DiscountFactor dqmt = dividendTS_->discount(t-dt, true);
-            
-            Real strikept = strike*dr*dqpt/(drpt*dq);
-            Real strikemt = strike*dr*dqmt/(drmt*dq);
+            Real strikept = strike*dr*s.dqpt/(s.drpt*dq);
+            Real strikemt = strike*dr*s.dqmt/(s.drmt*dq);
             
             wpt = blackTS_->blackVariance(t+dt, strikept, true);
             wmt = blackTS_->blackVariance(t-dt, strikemt, true);
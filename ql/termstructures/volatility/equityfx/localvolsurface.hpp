@@ -69,8 +69,14 @@ namespace QuantLib {
         //@}
       protected:
         Volatility localVolImpl(Time, Real) const override;
+        std::vector<Volatility>
+        localVolsImpl(Time t, const std::vector<Real>& strikes) const override;
 
       private:
+        struct Slice;
+        Slice slice(Time t) const;
+        Volatility sliceLocalVol(const Slice& slice, Real strike) const;
+
         Handle<BlackVolTermStructure> blackTS_;
         Handle<YieldTermStructure> riskFreeTS_, dividendTS_;
         Handle<Quote> underlying_;
@@ -54,6 +54,25 @@ namespace QuantLib {
         return localVolImpl(t, underlyingLevel);
     }
 
+    std::vector<Volatility>
+    LocalVolTermStructure::localVols(Time t,
+                                     const std::vector<Real>& underlyingLevels,
+                                     bool extrapolate) const {
+        checkRange(t, extrapolate);
+        for (Real underlyingLevel : underlyingLevels)
+            checkStrike(underlyingLevel, extrapolate);
+        return localVolsImpl(t, underlyingLevels);
+    }
+
+    std::vector<Volatility>
+    LocalVolTermStructure::localVolsImpl(Time t,
+                                         const std::vector<Real>& strikes) const {
+        std::vector<Volatility> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = localVolImpl(t, strikes[i]);
+        return result;
+    }
+
     void LocalVolTermStructure::accept(AcyclicVisitor& v) {
         auto* v1 = dynamic_cast<Visitor<LocalVolTermStructure>*>(&v);
         if (v1 != nullptr)
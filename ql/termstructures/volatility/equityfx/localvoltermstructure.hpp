@@ -27,6 +27,7 @@
 
 #include <ql/termstructures/voltermstructure.hpp>
 #include <ql/patterns/visitor.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -69,6 +70,10 @@ namespace QuantLib {
         Volatility localVol(Time t,
                             Real underlyingLevel,
                             bool extrapolate = false) const;
+        //! local vols at time t for a whole slice of underlying levels
+        std::vector<Volatility> localVols(Time t,
+                                          const std::vector<Real>& underlyingLevels,
+                                          bool extrapolate = false) const;
         //@}
         //! \name Visitability
         //@{
@@ -85,6 +90,13 @@ namespace QuantLib {
         //@{
         //! local vol calculation
         virtual Volatility localVolImpl(Time t, Real strike) const = 0;
+        /*! local vols for a slice of strikes; the default
+            implementation calls localVolImpl for each of them,
+            derived classes can share the calculations which do
+            not depend on the strike.
+        */
+        virtual std::vector<Volatility>
+        localVolsImpl(Time t, const std::vector<Real>& strikes) const;
         //@}
     };
 
@@ -59,6 +59,16 @@ namespace QuantLib {
             return vol;
         }
 
+        std::vector<Volatility>
+        localVolsImpl(Time t, const std::vector<Real>& strikes) const override {
+            try {
+                return LocalVolSurface::localVolsImpl(t, strikes);
+            } catch (Error&) {
+                // fall back to the single strikes to find the illegal ones
+                return LocalVolTermStructure::localVolsImpl(t, strikes);
+            }
+        }
+
       private:
         const Real illegalLocalVolOverwrite_;
     };
@@ -34,6 +34,140 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // The terms not depending on the strike are computed once, so
+        // that a whole smile can be evaluated with a tight loop.  The
+        // remaining expressions are kept in the same form (and order
+        // of evaluation) as in the original formulas.
+
+        class SabrLogNormalKernel {
+          public:
+            SabrLogNormalKernel(Rate forward, Time expiryTime,
+                                Real alpha, Real beta, Real nu, Real rho)
+            : forward_(forward), expiryTime_(expiryTime),
+              alpha_(alpha), rho_(rho),
+              oneMinusBeta_(1.0-beta),
+              oneMinusBeta2_(oneMinusBeta_*oneMinusBeta_),
+              nuOverAlpha_(nu/alpha),
+              twoRho_(2.0*rho), oneMinusRho_(1.0-rho),
+              halfRho_(0.5*rho), c3_(3.0*rho*rho-2.0),
+              d0_(oneMinusBeta_*oneMinusBeta_*alpha*alpha),
+              d1_(0.25*rho*beta*nu*alpha),
+              d2_((2.0-3.0*rho*rho)*(nu*nu/24.0)) {}
+
+            Real operator()(Rate strike) const {
+                const Real A = std::pow(forward_*strike, oneMinusBeta_);
+                const Real sqrtA= std::sqrt(A);
+                Real logM;
+                if (!close(forward_, strike))
+                    logM = std::log(forward_/strike);
+                else {
+                    const Real epsilon = (forward_-strike)/strike;
+                    logM = epsilon - .5 * epsilon * epsilon ;
+                }
+                const Real z = nuOverAlpha_*sqrtA*logM;
+                const Real B = 1.0-twoRho_*z+z*z;
+                const Real C = oneMinusBeta2_*logM*logM;
+                const Real tmp = (std::sqrt(B)+z-rho_)/oneMinusRho_;
+                const Real xx = std::log(tmp);
+                const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
+                const Real d = 1.0 + expiryTime_ *
+                    (d0_/(24.0*A) + d1_/sqrtA + d2_);
+
+                Real multiplier;
+                // computations become precise enough if the square of z worth
+                // slightly more than the precision machine (hence the m)
+                static const Real m = 10;
+                if (std::fabs(z*z)>QL_EPSILON * m)
+                    multiplier = z/xx;
+                else {
+                    multiplier = 1.0 - halfRho_*z - c3_*z*z/12.0;
+                }
+                return (alpha_/D)*multiplier*d;
+            }
+
+          private:
+            Real forward_, expiryTime_, alpha_, rho_;
+            Real oneMinusBeta_, oneMinusBeta2_, nuOverAlpha_;
+            Real twoRho_, oneMinusRho_, halfRho_, c3_;
+            Real d0_, d1_, d2_;
+        };
+
+        /* Normal SABR implemented according to
+           https://www2.deloitte.com/content/dam/Deloitte/global/Documents/Financial-Services/be-aers-fsi-sabr-sensitivities.pdf
+        */
+        class SabrNormalKernel {
+          public:
+            SabrNormalKernel(Rate forward, Time expiryTime,
+                             Real alpha, Real beta, Real nu, Real rho)
+            : forward_(forward), expiryTime_(expiryTime),
+              alpha_(alpha), rho_(rho),
+              oneMinusBeta_(1.0 - beta),
+              oneMinusBeta2_(oneMinusBeta_ * oneMinusBeta_),
+              halfBeta_(beta / 2.0),
+              nuOverAlpha_(nu / alpha),
+              twoRho_(2.0 * rho), oneMinusRho_(1.0 - rho),
+              halfRho_(0.5 * rho), c3_(3.0 * rho * rho - 2.0),
+              d0_(-1.0 * beta * (2 - beta) * alpha * alpha),
+              d1_(0.25 * rho * beta * nu * alpha),
+              d2_((2.0 - 3.0 * rho * rho) * (nu * nu / 24.0)) {}
+
+            Real operator()(Rate strike) const {
+                const Real A = std::pow(forward_ * strike, oneMinusBeta_);
+                const Real sqrtA = std::sqrt(A);
+                Real logM;
+                if (!close(forward_, strike))
+                    logM = std::log(forward_ / strike);
+                else {
+                    const Real epsilon = (forward_ - strike) / strike;
+                    logM = epsilon - .5 * epsilon * epsilon;
+                }
+                const Real z = nuOverAlpha_ * sqrtA * logM;
+                const Real B = 1.0 - twoRho_ * z + z * z;
+                const Real C = oneMinusBeta2_ * logM * logM;
+                const Real D = logM * logM;
+                const Real tmp = (std::sqrt(B) + z - rho_) / oneMinusRho_;
+                const Real xx = std::log(tmp);
+                const Real E_1 = (1.0 + D / 24.0 + D * D / 1920.0);
+                const Real E_2 = (1.0 + C / 24.0 + C * C / 1920.0);
+                const Real E = E_1 / E_2;
+                const Real d = 1.0 + expiryTime_ * (d0_ / (24.0 * A) +
+                                                    d1_ / sqrtA + d2_);
+
+                Real multiplier;
+                // computations become precise enough if the square of z worth
+                // slightly more than the precision machine (hence the m)
+                static const Real m = 10;
+                if (std::fabs(z * z) > QL_EPSILON * m)
+                    multiplier = z / xx;
+                else {
+                    multiplier = 1.0 - halfRho_ * z - c3_ * z * z / 12.0;
+                }
+                const Real F = alpha_ * std::pow(forward_ * strike, halfBeta_);
+
+                return F * E * multiplier * d;
+            }
+
+          private:
+            Real forward_, expiryTime_, alpha_, rho_;
+            Real oneMinusBeta_, oneMinusBeta2_, halfBeta_, nuOverAlpha_;
+            Real twoRho_, oneMinusRho_, halfRho_, c3_;
+            Real d0_, d1_, d2_;
+        };
+
+        template <class Kernel>
+        std::vector<Real> sabrVolatilities(const std::vector<Rate>& strikes,
+                                           Real shift,
+                                           const Kernel& kernel) {
+            std::vector<Real> result(strikes.size());
+            for (Size i=0; i<strikes.size(); ++i)
+                result[i] = kernel(strikes[i] + shift);
+            return result;
+        }
+
+    }
+
     Real unsafeSabrLogNormalVolatility(
                               Rate strike,
                               Rate forward,
@@ -42,37 +176,8 @@ namespace QuantLib {
                               Real beta,
                               Real nu,
                               Real rho) {
-        const Real oneMinusBeta = 1.0-beta;
-        const Real A = std::pow(forward*strike, oneMinusBeta);
-        const Real sqrtA= std::sqrt(A);
-        Real logM;
-        if (!close(forward, strike))
-            logM = std::log(forward/strike);
-        else {
-            const Real epsilon = (forward-strike)/strike;
-            logM = epsilon - .5 * epsilon * epsilon ;
-        }
-        const Real z = (nu/alpha)*sqrtA*logM;
-        const Real B = 1.0-2.0*rho*z+z*z;
-        const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
-        const Real tmp = (std::sqrt(B)+z-rho)/(1.0-rho);
-        const Real xx = std::log(tmp);
-        const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
-        const Real d = 1.0 + expiryTime *
-            (oneMinusBeta*oneMinusBeta*alpha*alpha/(24.0*A)
-                                + 0.25*rho*beta*nu*alpha/sqrtA
-                                    +(2.0-3.0*rho*rho)*(nu*nu/24.0));
-
-        Real multiplier;
-        // computations become precise enough if the square of z worth
-        // slightly more than the precision machine (hence the m)
-        static const Real m = 10;
-        if (std::fabs(z*z)>QL_EPSILON * m)
-            multiplier = z/xx;
-        else {
-            multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
-        }
-        return (alpha/D)*multiplier*d;
+        return SabrLogNormalKernel(forward, expiryTime,
+                                   alpha, beta, nu, rho)(strike);
     }
 
     Real unsafeShiftedSabrVolatility(Rate strike,
@@ -93,42 +198,8 @@ namespace QuantLib {
 
     Real unsafeSabrNormalVolatility(
         Rate strike, Rate forward, Time expiryTime, Real alpha, Real beta, Real nu, Real rho) {
-        const Real oneMinusBeta = 1.0 - beta;
-        const Real minusBeta = -1.0 * beta;
-        const Real A = std::pow(forward * strike, oneMinusBeta);
-        const Real sqrtA = std::sqrt(A);
-        Real logM;
-        if (!close(forward, strike))
-            logM = std::log(forward / strike);
-        else {
-            const Real epsilon = (forward - strike) / strike;
-            logM = epsilon - .5 * epsilon * epsilon;
-        }
-        const Real z = (nu / alpha) * sqrtA * logM;
-        const Real B = 1.0 - 2.0 * rho * z + z * z;
-        const Real C = oneMinusBeta * oneMinusBeta * logM * logM;
-        const Real D = logM * logM;
-        const Real tmp = (std::sqrt(B) + z - rho) / (1.0 - rho);
-        const Real xx = std::log(tmp);
-        const Real E_1 = (1.0 + D / 24.0 + D * D / 1920.0);
-        const Real E_2 = (1.0 + C / 24.0 + C * C / 1920.0);
-        const Real E = E_1 / E_2;
-        const Real d = 1.0 + expiryTime * (minusBeta * (2 - beta) * alpha * alpha / (24.0 * A) +
-                                0.25 * rho * beta * nu * alpha / sqrtA +
-                                (2.0 - 3.0 * rho * rho) * (nu * nu / 24.0));
-
-        Real multiplier;
-        // computations become precise enough if the square of z worth
-        // slightly more than the precision machine (hence the m)
-        static const Real m = 10;
-        if (std::fabs(z * z) > QL_EPSILON * m)
-            multiplier = z / xx;
-        else {
-            multiplier = 1.0 - 0.5 * rho * z - (3.0 * rho * rho - 2.0) * z * z / 12.0;
-        }
-        const Real F = alpha * std::pow(forward * strike, beta / 2.0);
-
-       return F * E * multiplier * d;
+        return SabrNormalKernel(forward, expiryTime,
+                                alpha, beta, nu, rho)(strike);
     }
 
      Real unsafeSabrVolatility(Rate strike,
@@ -146,6 +217,39 @@ namespace QuantLib {
         }
      }
 
+    std::vector<Real> unsafeShiftedSabrVolatility(const std::vector<Rate>& strikes,
+                                                  Rate forward,
+                                                  Time expiryTime,
+                                                  Real alpha,
+                                                  Real beta,
+                                                  Real nu,
+                                                  Real rho,
+                                                  Real shift,
+                                                  VolatilityType volatilityType) {
+        if (volatilityType == VolatilityType::Normal) {
+            return sabrVolatilities(strikes, shift,
+                                    SabrNormalKernel(forward + shift, expiryTime,
+                                                     alpha, beta, nu, rho));
+        } else {
+            return sabrVolatilities(strikes, shift,
+                                    SabrLogNormalKernel(forward + shift, expiryTime,
+                                                        alpha, beta, nu, rho));
+        }
+    }
+
+    std::vector<Real> unsafeSabrVolatility(const std::vector<Rate>& strikes,
+                                           Rate forward,
+                                           Time expiryTime,
+                                           Real alpha,
+                                           Real beta,
+                                           Real nu,
+                                           Real rho,
+                                           VolatilityType volatilityType) {
+        return unsafeShiftedSabrVolatility(strikes, forward, expiryTime,
+                                           alpha, beta, nu, rho, 0.0,
+                                           volatilityType);
+    }
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
@@ -199,6 +303,27 @@ namespace QuantLib {
                                              alpha, beta, nu, rho,shift, volatilityType);
     }
 
+    std::vector<Real> shiftedSabrVolatility(const std::vector<Rate>& strikes,
+                                            Rate forward,
+                                            Time expiryTime,
+                                            Real alpha,
+                                            Real beta,
+                                            Real nu,
+                                            Real rho,
+                                            Real shift,
+                                            VolatilityType volatilityType) {
+        for (Rate strike : strikes)
+            QL_REQUIRE(strike + shift > 0.0, "strike+shift must be positive: "
+                       << io::rate(strike) << "+" << io::rate(shift) << " not allowed");
+        QL_REQUIRE(forward + shift > 0.0, "at the money forward rate + shift must be "
+                   "positive: " << io::rate(forward) << " " << io::rate(shift) << " not allowed");
+        QL_REQUIRE(expiryTime>=0.0, "expiry time must be non-negative: "
+                                   << expiryTime << " not allowed");
+        validateSabrParameters(alpha, beta, nu, rho);
+        return unsafeShiftedSabrVolatility(strikes, forward, expiryTime,
+                                           alpha, beta, nu, rho, shift, volatilityType);
+    }
+
     namespace {
         struct SabrFlochKennedyVolatility {
             Real F, alpha, beta, nu, rho, t;
@@ -31,6 +31,7 @@
 #include <ql/types.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
 #include <array>
+#include <vector>
 
 namespace QuantLib {
 
@@ -72,6 +73,46 @@ namespace QuantLib {
                               Real rho,
                               VolatilityType volatilityType = VolatilityType::ShiftedLognormal);
 
+    //! \name Smile evaluation
+    /*! These overloads return the volatilities for a number of strikes
+        (and the same parameters), computing the terms that don't
+        depend on the strike only once.  They return the same results
+        as the corresponding functions for a single strike.
+    */
+    //@{
+    std::vector<Real> unsafeShiftedSabrVolatility(
+                              const std::vector<Rate>& strikes,
+                              Rate forward,
+                              Time expiryTime,
+                              Real alpha,
+                              Real beta,
+                              Real nu,
+                              Real rho,
+                              Real shift,
+                              VolatilityType volatilityType = VolatilityType::ShiftedLognormal);
+
+    std::vector<Real> unsafeSabrVolatility(
+                              const std::vector<Rate>& strikes,
+                              Rate forward,
+                              Time expiryTime,
+                              Real alpha,
+                              Real beta,
+                              Real nu,
+                              Real rho,
+                              VolatilityType volatilityType = VolatilityType::ShiftedLognormal);
+
+    std::vector<Real> shiftedSabrVolatility(
+                              const std::vector<Rate>& strikes,
+                              Rate forward,
+                              Time expiryTime,
+                              Real alpha,
+                              Real beta,
+                              Real nu,
+                              Real rho,
+                              Real shift,
+                              VolatilityType volatilityType = VolatilityType::ShiftedLognormal);
+    //@}
+
     Real sabrVolatility(Rate strike,
                         Rate forward,
                         Time expiryTime,
@@ -74,4 +74,13 @@ namespace QuantLib {
         return unsafeShiftedSabrVolatility(strike, forward_, exerciseTime(),
                                            alpha_, beta_, nu_, rho_, shift_, volatilityType());
      }
+
+     std::vector<Volatility>
+     SabrSmileSection::volatilitiesImpl(const std::vector<Rate>& strikes) const {
+        std::vector<Rate> k(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            k[i] = std::max(0.00001 - shift(), strikes[i]);
+        return unsafeShiftedSabrVolatility(k, forward_, exerciseTime(),
+                                           alpha_, beta_, nu_, rho_, shift_, volatilityType());
+     }
 }
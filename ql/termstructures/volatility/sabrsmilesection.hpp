@@ -56,6 +56,8 @@ namespace QuantLib {
       protected:
         Real varianceImpl(Rate strike) const override;
         Volatility volatilityImpl(Rate strike) const override;
+        std::vector<Volatility>
+        volatilitiesImpl(const std::vector<Rate>& strikes) const override;
 
       private:
         Real alpha_, beta_, nu_, rho_, forward_, shift_;
@@ -141,4 +141,24 @@ namespace QuantLib {
                                                        exerciseTime(), premium);
             }
     }
+
+    std::vector<Volatility>
+    SmileSection::volatilities(const std::vector<Rate>& strikes,
+                               VolatilityType volatilityType,
+                               Real shift) const {
+        if (volatilityType == volatilityType_ && close(shift, this->shift()))
+            return volatilities(strikes);
+        std::vector<Volatility> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = volatility(strikes[i], volatilityType, shift);
+        return result;
+    }
+
+    std::vector<Volatility>
+    SmileSection::volatilitiesImpl(const std::vector<Rate>& strikes) const {
+        std::vector<Volatility> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = volatilityImpl(strikes[i]);
+        return result;
+    }
 }
@@ -30,6 +30,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/option.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -78,10 +79,21 @@ namespace QuantLib {
                              Real discount=1.0,
                              Real gap=1.0E-4) const;
         Volatility volatility(Rate strike, VolatilityType type, Real shift=0.0) const;
+        //! volatilities for a number of strikes
+        std::vector<Volatility> volatilities(const std::vector<Rate>& strikes) const;
+        std::vector<Volatility> volatilities(const std::vector<Rate>& strikes,
+                                             VolatilityType type,
+                                             Real shift=0.0) const;
       protected:
         virtual void initializeExerciseTime() const;
         virtual Real varianceImpl(Rate strike) const;
         virtual Volatility volatilityImpl(Rate strike) const = 0;
+        /*! The default implementation calls volatilityImpl for each
+            strike; derived classes can override it to evaluate the
+            whole smile at once.
+        */
+        virtual std::vector<Volatility>
+        volatilitiesImpl(const std::vector<Rate>& strikes) const;
       private:
         bool isFloating_;
         mutable Date referenceDate_;
@@ -103,6 +115,11 @@ namespace QuantLib {
         return volatilityImpl(strike);
     }
 
+    inline std::vector<Volatility>
+    SmileSection::volatilities(const std::vector<Rate>& strikes) const {
+        return volatilitiesImpl(strikes);
+    }
+
     inline const Date& SmileSection::referenceDate() const {
         QL_REQUIRE(referenceDate_!=Date(),
                    "referenceDate not available for this instance");
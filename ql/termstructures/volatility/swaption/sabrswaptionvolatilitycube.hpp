@@ -124,6 +124,13 @@ namespace QuantLib {
         - \c Interpolation: the interpolation type
         - \c SmileSection: the smile section type
 
+        When no optimization method is passed, the smiles are
+        calibrated concurrently if OpenMP is enabled.  If \c warmStart
+        is true, the calibration of each smile starts from the
+        parameters calibrated for the previous option tenor (the
+        guesses passed are still used for the first option tenor and
+        for fixed parameters).
+
         \see XabrModelTraits for customization points
     */
     template<class Model>
@@ -203,7 +210,8 @@ namespace QuantLib {
             Size maxGuesses = 50,
             bool backwardFlat = false,
             Real cutoffStrike = 0.0001,
-            bool singlePassCalibration = false);
+            bool singlePassCalibration = false,
+            bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const override;
@@ -282,6 +290,7 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        const bool warmStart_;
         VolatilityType volatilityType_;
 
         class PrivateObserver : public Observer {
@@ -326,7 +335,8 @@ namespace QuantLib {
         const Size maxGuesses,
         const bool backwardFlat,
         const Real cutoffStrike,
-        const bool singlePassCalibration)
+        const bool singlePassCalibration,
+        const bool warmStart)
     : SwaptionVolatilityCube(atmVolStructure,
                              optionTenors,
                              swapTenors,
@@ -340,7 +350,8 @@ namespace QuantLib {
       singlePassCalibration_(singlePassCalibration),
       endCriteria_(std::move(endCriteria)), optMethod_(std::move(optMethod)),
       useMaxError_(useMaxError), maxGuesses_(maxGuesses), backwardFlat_(backwardFlat),
-      cutoffStrike_(cutoffStrike), volatilityType_(atmVolStructure->volatilityType()) {
+      cutoffStrike_(cutoffStrike), warmStart_(warmStart),
+      volatilityType_(atmVolStructure->volatilityType()) {
 
         if (maxErrorTolerance != Null<Rate>()) {
             maxErrorTolerance_ = maxErrorTolerance;
@@ -505,30 +516,49 @@ namespace QuantLib {
 
         const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
+        struct Node {
+            // calibration input
+            Rate atmForward;
+            Real shift;
+            Volatility atmVol;
+            std::vector<Real> strikes, volatilities, guess;
+            // calibration results
+            std::vector<Real> parameters;
+            Real rmsError, maxError, endCriteria;
+            std::string error;
+        };
 
-        for (Size j=0; j<optionTimes.size(); j++) {
-            for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
+        const Size nOptions = optionTimes.size(), nSwaps = swapLengths.size();
+        std::vector<Node> nodes(nOptions * nSwaps);
+
+        // market data and guesses are collected here, since the
+        // underlying term structures and indexes are not thread safe
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                Node& node = nodes[j*nSwaps+k];
+                node.atmForward = atmStrike(optionDates[j], swapTenors[k]);
+                node.shift = atmVol_->shift(optionTimes[j], swapLengths[k]);
                 for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
+                    Real strike = node.atmForward+strikeSpreads_[i];
+                    if(strike + node.shift >=cutoffStrike_) {
+                        node.strikes.push_back(strike);
+                        node.volatilities.push_back(tmpMarketVolCube[i][j][k]);
                     }
                 }
+                node.guess = parametersGuess_(optionTimes[j], swapLengths[k]);
+                if (singlePassCalibration_ && isAtmCalibrated_)
+                    node.atmVol = atmVol_->volatility(
+                        optionDates[j], swapTenors[k], node.atmForward, true);
+            }
+        }
 
-                const std::vector<Real>& guess =
-                    parametersGuess_(optionTimes[j], swapLengths[k]);
-
+        const auto calibrate = [&](Size j, Size k, const std::vector<Real>& guess) {
+            Node& node = nodes[j*nSwaps+k];
+            try {
                 const ext::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    Traits::createInterpolation(strikes.begin(), strikes.end(),
-                                                volatilities.begin(),
-                                                optionTimes[j], atmForward,
+                    Traits::createInterpolation(node.strikes.begin(), node.strikes.end(),
+                                                node.volatilities.begin(),
+                                                optionTimes[j], node.atmForward,
                                                 guess,
                                                 isParameterFixed_,
                                                 vegaWeightedSmileFit_,
@@ -537,7 +567,7 @@ namespace QuantLib {
                                                 errorAccept_,
                                                 useMaxError_,
                                                 maxGuesses_,
-                                                shiftTmp,
+                                                node.shift,
                                                 volatilityType_);
                 sabrInterpolation->update();
 
@@ -545,48 +575,40 @@ namespace QuantLib {
                 Real maxError = sabrInterpolation->maxError();
                 const Real calibrationRmsError = rmsError;
                 const Real calibrationMaxError = maxError;
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
+                std::vector<Real>& parameters = node.parameters;
+                parameters = { sabrInterpolation->alpha(), sabrInterpolation->beta(),
+                               sabrInterpolation->nu(), sabrInterpolation->rho() };
                 if constexpr (Traits::nParams >= 5)
-                    gammas[j][k] = Traits::extractGamma(sabrInterpolation);
+                    parameters.push_back(Traits::extractGamma(sabrInterpolation));
                 if (singlePassCalibration_ && isAtmCalibrated_) {
-                    std::vector<Real> parameters = { alphas[j][k], betas[j][k],
-                                                     nus[j][k], rhos[j][k] };
-                    if constexpr (Traits::nParams >= 5)
-                        parameters.push_back(gammas[j][k]);
-                    const Volatility atmVol = atmVol_->volatility(
-                        optionDates[j], swapTenors[k], atmForward, true);
-                    alphas[j][k] = calibratedAtmAlpha(
-                        optionTimes[j], atmForward, atmVol, parameters, shiftTmp);
-                    parameters[0] = alphas[j][k];
+                    parameters[0] = calibratedAtmAlpha(
+                        optionTimes[j], node.atmForward, node.atmVol, parameters, node.shift);
                     std::tie(rmsError, maxError) = smileErrors(
-                        optionTimes[j], atmForward, parameters, shiftTmp, strikes,
-                        volatilities, sabrInterpolation->interpolationWeights());
+                        optionTimes[j], node.atmForward, parameters, node.shift,
+                        node.strikes, node.volatilities,
+                        sabrInterpolation->interpolationWeights());
                 }
-                forwards   [j][k] = atmForward;
-                errors     [j][k] = rmsError;
-                maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                node.rmsError = rmsError;
+                node.maxError = maxError;
+                node.endCriteria = sabrInterpolation->endCriteria();
 
                 // Build gamma diagnostic string only for models that have gamma (ZABR).
                 // if constexpr guarantees dead-branch elimination for 4-param models.
                 std::string gammaInfo;
                 if constexpr (Traits::nParams >= 5)
-                    gammaInfo = "\n   gamma = " + std::to_string(gammas[j][k]);
+                    gammaInfo = "\n   gamma = " + std::to_string(parameters[4]);
 
-                QL_ENSURE(endCriteria[j][k] != Integer(EndCriteria::MaxIterations),
+                QL_ENSURE(node.endCriteria != Integer(EndCriteria::MaxIterations),
                           "global swaptions calibration failed: "
                           "MaxIterations reached: " << "\n" <<
                           "option maturity = " << optionDates[j] << ", \n" <<
                           "swap tenor = " << swapTenors[k] << ", \n" <<
                           "rms error = " << io::rate(calibrationRmsError)  << ", \n" <<
                           "max error = " << io::rate(calibrationMaxError) << ", \n" <<
-                          "   alpha = " <<  alphas[j][k] << "\n" <<
-                          "   beta = " <<  betas[j][k] << "\n" <<
-                          "   nu = " <<  nus[j][k]   << "\n" <<
-                          "   rho = " <<  rhos[j][k]  << gammaInfo << "\n"
+                          "   alpha = " <<  parameters[0] << "\n" <<
+                          "   beta = " <<  parameters[1] << "\n" <<
+                          "   nu = " <<  parameters[2]   << "\n" <<
+                          "   rho = " <<  parameters[3]  << gammaInfo << "\n"
                           );
 
                 QL_ENSURE((useMaxError_ ? calibrationMaxError : calibrationRmsError) <
@@ -600,10 +622,55 @@ namespace QuantLib {
                               << "swap tenor = " << swapTenors[k] << ", \n"
                               << "rms error = " << io::rate(calibrationRmsError) << ", \n"
                               << "max error = " << io::rate(calibrationMaxError) << ", \n"
-                              << "   alpha = " << alphas[j][k] << "\n"
-                              << "   beta = " << betas[j][k] << "\n"
-                              << "   nu = " << nus[j][k] << "\n"
-                              << "   rho = " << rhos[j][k] << gammaInfo << "\n");
+                              << "   alpha = " << parameters[0] << "\n"
+                              << "   beta = " << parameters[1] << "\n"
+                              << "   nu = " << parameters[2] << "\n"
+                              << "   rho = " << parameters[3] << gammaInfo << "\n");
+            } catch (std::exception& e) {
+                node.error = e.what();
+            }
+        };
+
+        // The smiles are calibrated concurrently; optimization methods
+        // are not thread safe, though, so that this only happens when
+        // each interpolation creates its own.  With warm starts, the
+        // smiles of each option expiry start from the parameters
+        // calibrated for the previous one and only the smiles of the
+        // same expiry are calibrated concurrently.  In both cases, the
+        // results don't depend on the number of threads.
+        const Size rows = warmStart_ ? nOptions : 1;
+        const Size rowSize = warmStart_ ? nSwaps : nOptions * nSwaps;
+        for (Size r=0; r<rows; ++r) {
+            #pragma omp parallel for if(!optMethod_ && rowSize > 1)
+            for (long n=0; n<long(rowSize); ++n) {
+                const Size j = (r*rowSize + n) / nSwaps, k = (r*rowSize + n) % nSwaps;
+                std::vector<Real> guess = nodes[j*nSwaps+k].guess;
+                if (warmStart_ && j > 0) {
+                    const Node& previous = nodes[(j-1)*nSwaps+k];
+                    if (previous.error.empty()) {
+                        for (Size i=0; i<Traits::nParams; ++i)
+                            if (!isParameterFixed_[i])
+                                guess[i] = previous.parameters[i];
+                    }
+                }
+                calibrate(j, k, guess);
+            }
+        }
+
+        for (Size j=0; j<nOptions; j++) {
+            for (Size k=0; k<nSwaps; k++) {
+                const Node& node = nodes[j*nSwaps+k];
+                QL_ENSURE(node.error.empty(), node.error);
+                alphas     [j][k] = node.parameters[0];
+                betas      [j][k] = node.parameters[1];
+                nus        [j][k] = node.parameters[2];
+                rhos       [j][k] = node.parameters[3];
+                if constexpr (Traits::nParams >= 5)
+                    gammas[j][k] = node.parameters[4];
+                forwards   [j][k] = node.atmForward;
+                errors     [j][k] = node.rmsError;
+                maxErrors  [j][k] = node.maxError;
+                endCriteria[j][k] = node.endCriteria;
             }
         }
         // Cube has Traits::nParams parameter layers + 4 metadata layers
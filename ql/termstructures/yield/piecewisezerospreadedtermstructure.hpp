@@ -175,10 +175,9 @@ namespace QuantLib {
 
     template <class T>
     inline void InterpolatedPiecewiseZeroSpreadedTermStructure<T>::updateInterpolation() {
-        for (Size i = 0; i < dates_.size(); i++) {
-            times_[i] = timeFromReference(dates_[i]);
+        timesFromReference(dates_.data(), times_.data(), dates_.size());
+        for (Size i = 0; i < dates_.size(); i++)
             spreadValues_[i] = spreads_[i]->value();
-        }
         interpolator_.update();
     }
 
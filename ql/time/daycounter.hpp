@@ -57,6 +57,22 @@ namespace QuantLib {
                                       const Date& d2,
                                       const Date& refPeriodStart,
                                       const Date& refPeriodEnd) const = 0;
+            //! to be overloaded by day counters with a faster batch calculation
+            virtual void yearFractions(const Date* d1,
+                                       const Date* d2,
+                                       Time* fractions,
+                                       Size n) const {
+                for (Size i=0; i<n; ++i)
+                    fractions[i] = yearFraction(d1[i], d2[i], Date(), Date());
+            }
+            //! as above, with the same first date for all fractions
+            virtual void yearFractions(const Date& d1,
+                                       const Date* d2,
+                                       Time* fractions,
+                                       Size n) const {
+                for (Size i=0; i<n; ++i)
+                    fractions[i] = yearFraction(d1, d2[i], Date(), Date());
+            }
         };
         ext::shared_ptr<Impl> impl_;
         /*! This constructor can be invoked by derived classes which
@@ -87,6 +103,23 @@ namespace QuantLib {
         Time yearFraction(const Date&, const Date&,
                           const Date& refPeriodStart = Date(),
                           const Date& refPeriodEnd = Date()) const;
+        //! Returns the year fractions between the n pairs of given dates.
+        /*! The results are the same as those of yearFraction with no
+            reference period; day counters using the reference period
+            shouldn't be passed to this method.
+        */
+        void yearFractions(const Date* d1,
+                           const Date* d2,
+                           Time* fractions,
+                           Size n) const;
+        //! Returns the year fractions between a date and n given dates.
+        /*! This is equivalent to the method above with n copies of
+            the first date, which don't need to be built.
+        */
+        void yearFractions(const Date& d1,
+                           const Date* d2,
+                           Time* fractions,
+                           Size n) const;
         //@}
     };
 
@@ -131,6 +164,18 @@ namespace QuantLib {
             return impl_->yearFraction(d1,d2,refPeriodStart,refPeriodEnd);
     }
 
+    inline void DayCounter::yearFractions(const Date* d1, const Date* d2,
+                                          Time* fractions, Size n) const {
+        QL_REQUIRE(impl_, "no day counter implementation provided");
+        impl_->yearFractions(d1, d2, fractions, n);
+    }
+
+    inline void DayCounter::yearFractions(const Date& d1, const Date* d2,
+                                          Time* fractions, Size n) const {
+        QL_REQUIRE(impl_, "no day counter implementation provided");
+        impl_->yearFractions(d1, d2, fractions, n);
+    }
+
 
     inline bool operator==(const DayCounter& d1, const DayCounter& d2) {
         return (d1.empty() && d2.empty())
@@ -55,6 +55,18 @@ namespace QuantLib {
                 return (daysBetween(d1,d2)
                         + (includeLastDay_ ? 1.0 : 0.0))/360.0;
             }
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override {
+                const Real lastDay = includeLastDay_ ? 1.0 : 0.0;
+                for (Size i=0; i<n; ++i)
+                    fractions[i] = (daysBetween(d1[i],d2[i]) + lastDay)/360.0;
+            }
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override {
+                const Real lastDay = includeLastDay_ ? 1.0 : 0.0;
+                for (Size i=0; i<n; ++i)
+                    fractions[i] = (daysBetween(d1,d2[i]) + lastDay)/360.0;
+            }
         };
       public:
         explicit Actual360(const bool includeLastDay = false)
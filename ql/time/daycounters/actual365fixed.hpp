@@ -56,6 +56,16 @@ namespace QuantLib {
             yearFraction(const Date& d1, const Date& d2, const Date&, const Date&) const override {
                 return daysBetween(d1,d2)/365.0;
             }
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override {
+                for (Size i=0; i<n; ++i)
+                    fractions[i] = daysBetween(d1[i],d2[i])/365.0;
+            }
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override {
+                for (Size i=0; i<n; ++i)
+                    fractions[i] = daysBetween(d1,d2[i])/365.0;
+            }
         };
         class CA_Impl final : public DayCounter::Impl {
           public:
@@ -19,6 +19,7 @@
 */
 
 #include <ql/time/daycounters/business252.hpp>
+#include <algorithm>
 #include <map>
 
 namespace QuantLib {
@@ -77,7 +78,9 @@ namespace QuantLib {
 
     Date::serial_type Business252::Impl::dayCount(const Date& d1,
                                                   const Date& d2) const {
-        if (sameMonth(d1,d2) || d1 >= d2) {
+        if (inTable(d1) && inTable(d2)) {
+            return tableDayCount(d1, d2);
+        } else if (sameMonth(d1,d2) || d1 >= d2) {
             // we treat the case of d1 > d2 here, since we'd need a
             // second cache to get it right (our cached figures are
             // for first included, last excluded and might have to be
@@ -141,4 +144,75 @@ namespace QuantLib {
         return dayCount(d1, d2)/252.0;
     }
 
+    void Business252::Impl::yearFractions(const Date* d1,
+                                          const Date* d2,
+                                          Time* fractions,
+                                          Size n) const {
+        if (n == 0)
+            return;
+        Date first = std::min(d1[0], d2[0]), last = std::max(d1[0], d2[0]);
+        for (Size i=1; i<n; ++i) {
+            first = std::min({first, d1[i], d2[i]});
+            last = std::max({last, d1[i], d2[i]});
+        }
+        extendTable(first, last);
+        for (Size i=0; i<n; ++i)
+            fractions[i] = tableDayCount(d1[i], d2[i])/252.0;
+    }
+
+    void Business252::Impl::yearFractions(const Date& d1,
+                                          const Date* d2,
+                                          Time* fractions,
+                                          Size n) const {
+        if (n == 0)
+            return;
+        Date first = d1, last = d1;
+        for (Size i=0; i<n; ++i) {
+            first = std::min(first, d2[i]);
+            last = std::max(last, d2[i]);
+        }
+        extendTable(first, last);
+        for (Size i=0; i<n; ++i)
+            fractions[i] = tableDayCount(d1, d2[i])/252.0;
+    }
+
+    bool Business252::Impl::inTable(const Date& d) const {
+        return !businessDays_.empty() && d >= firstDate_ &&
+            d - firstDate_ < Date::serial_type(businessDays_.size()) - 1;
+    }
+
+    void Business252::Impl::extendTable(const Date& first,
+                                        const Date& last) const {
+        if (inTable(first) && inTable(last))
+            return;
+        Date from = first, to = last;
+        if (!businessDays_.empty()) {
+            from = std::min(from, firstDate_);
+            to = std::max(to, firstDate_ + Date::serial_type(
+                                               businessDays_.size()) - 2);
+        }
+        // the table must also include the day after the last date
+        std::vector<Date::serial_type> businessDays(to - from + 2);
+        businessDays[0] = 0;
+        for (Size i=1; i<businessDays.size(); ++i) {
+            const Date d = from + Date::serial_type(i-1);
+            businessDays[i] = businessDays[i-1] +
+                (calendar_.isBusinessDay(d) ? 1 : 0);
+        }
+        firstDate_ = from;
+        businessDays_.swap(businessDays);
+    }
+
+    Date::serial_type Business252::Impl::tableDayCount(const Date& d1,
+                                                       const Date& d2) const {
+        // same as calendar_.businessDaysBetween(d1, d2), i.e., the first
+        // date is included and the last one excluded when d1 < d2, and
+        // the other way around when d1 > d2
+        const Date::serial_type i1 = d1 - firstDate_, i2 = d2 - firstDate_;
+        if (i1 <= i2)
+            return businessDays_[i2] - businessDays_[i1];
+        else
+            return businessDays_[i2+1] - businessDays_[i1+1];
+    }
+
 }
@@ -29,6 +29,7 @@
 #include <ql/time/calendars/brazil.hpp>
 #include <ql/time/daycounter.hpp>
 #include <utility>
+#include <vector>
 
 namespace QuantLib {
 
@@ -39,11 +40,23 @@ namespace QuantLib {
         class Impl final : public DayCounter::Impl {
           private:
             Calendar calendar_;
+            // number of business days between the first date in the
+            // table (included) and each following date (excluded)
+            mutable Date firstDate_;
+            mutable std::vector<Date::serial_type> businessDays_;
+            bool inTable(const Date& d) const;
+            void extendTable(const Date& first, const Date& last) const;
+            Date::serial_type tableDayCount(const Date& d1,
+                                            const Date& d2) const;
           public:
             std::string name() const override;
             Date::serial_type dayCount(const Date& d1, const Date& d2) const override;
             Time
             yearFraction(const Date& d1, const Date& d2, const Date&, const Date&) const override;
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override;
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override;
             explicit Impl(Calendar c) : calendar_(std::move(c)) {}
         };
       public:
@@ -29,6 +29,24 @@ namespace QuantLib {
             return m == 2 && d == 28 + (Date::isLeap(y) ? 1 : 0);
         }
 
+        // the implementations are final, so that their day counts
+        // aren't dispatched virtually within the loop
+        template <class Impl>
+        void thirty360YearFractions(const Impl& impl,
+                                    const Date* d1, const Date* d2,
+                                    Time* fractions, Size n) {
+            for (Size i=0; i<n; ++i)
+                fractions[i] = impl.dayCount(d1[i], d2[i])/360.0;
+        }
+
+        template <class Impl>
+        void thirty360YearFractions(const Impl& impl,
+                                    const Date& d1, const Date* d2,
+                                    Time* fractions, Size n) {
+            for (Size i=0; i<n; ++i)
+                fractions[i] = impl.dayCount(d1, d2[i])/360.0;
+        }
+
     }
 
     ext::shared_ptr<DayCounter::Impl>
@@ -140,4 +158,64 @@ namespace QuantLib {
         return 360*(yy2-yy1) + 30*(mm2-mm1) + (dd2-dd1);
     }
 
+    void Thirty360::US_Impl::yearFractions(const Date* d1, const Date* d2,
+                                           Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::US_Impl::yearFractions(const Date& d1, const Date* d2,
+                                           Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::ISMA_Impl::yearFractions(const Date* d1, const Date* d2,
+                                             Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::ISMA_Impl::yearFractions(const Date& d1, const Date* d2,
+                                             Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::EU_Impl::yearFractions(const Date* d1, const Date* d2,
+                                           Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::EU_Impl::yearFractions(const Date& d1, const Date* d2,
+                                           Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::IT_Impl::yearFractions(const Date* d1, const Date* d2,
+                                           Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::IT_Impl::yearFractions(const Date& d1, const Date* d2,
+                                           Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::ISDA_Impl::yearFractions(const Date* d1, const Date* d2,
+                                             Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::ISDA_Impl::yearFractions(const Date& d1, const Date* d2,
+                                             Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::NASD_Impl::yearFractions(const Date* d1, const Date* d2,
+                                             Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
+    void Thirty360::NASD_Impl::yearFractions(const Date& d1, const Date* d2,
+                                             Time* fractions, Size n) const {
+        thirty360YearFractions(*this, d1, d2, fractions, n);
+    }
+
 }
@@ -98,21 +98,37 @@ namespace QuantLib {
           public:
             std::string name() const override { return std::string("30/360 (US)"); }
             Date::serial_type dayCount(const Date& d1, const Date& d2) const override;
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override;
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override;
         };
         class ISMA_Impl final : public Thirty360_Impl {
           public:
             std::string name() const override { return std::string("30/360 (Bond Basis)"); }
             Date::serial_type dayCount(const Date& d1, const Date& d2) const override;
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override;
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override;
         };
         class EU_Impl final : public Thirty360_Impl {
           public:
             std::string name() const override { return std::string("30E/360 (Eurobond Basis)"); }
             Date::serial_type dayCount(const Date& d1, const Date& d2) const override;
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override;
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override;
         };
         class IT_Impl final : public Thirty360_Impl {
           public:
             std::string name() const override { return std::string("30/360 (Italian)"); }
             Date::serial_type dayCount(const Date& d1, const Date& d2) const override;
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override;
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override;
         };
         class ISDA_Impl final : public Thirty360_Impl {
           public:
@@ -120,6 +136,10 @@ namespace QuantLib {
             : terminationDate_(terminationDate) {}
             std::string name() const override { return std::string("30E/360 (ISDA)"); }
             Date::serial_type dayCount(const Date& d1, const Date& d2) const override;
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override;
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override;
           private:
             Date terminationDate_;
         };
@@ -127,6 +147,10 @@ namespace QuantLib {
           public:
             std::string name() const override { return std::string("30/360 (NASD)"); }
             Date::serial_type dayCount(const Date& d1, const Date& d2) const override;
+            void yearFractions(const Date* d1, const Date* d2,
+                               Time* fractions, Size n) const override;
+            void yearFractions(const Date& d1, const Date* d2,
+                               Time* fractions, Size n) const override;
         };
         static ext::shared_ptr<DayCounter::Impl>
         implementation(Convention c, const Date& terminationDate);
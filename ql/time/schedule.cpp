@@ -636,6 +636,191 @@ namespace QuantLib {
                         rule_, endOfMonth_, firstDate_, nextToLastDate_);
     }
 
+    ScheduleGenerator::ScheduleGenerator(
+                               const Period& tenor,
+                               Calendar calendar,
+                               BusinessDayConvention convention,
+                               BusinessDayConvention terminationDateConvention,
+                               DateGeneration::Rule rule,
+                               bool endOfMonth)
+    : tenor_(tenor), calendar_(std::move(calendar)), convention_(convention),
+      terminationDateConvention_(terminationDateConvention), rule_(rule),
+      endOfMonth_(allowsEndOfMonth(tenor) ? endOfMonth : false) {}
+
+    Schedule ScheduleGenerator::operator()(const Date& effectiveDate,
+                                           const Date& terminationDate) const {
+        if ((rule_ != DateGeneration::Backward &&
+             rule_ != DateGeneration::Forward) ||
+            tenor_.length() <= 0 || effectiveDate == Date())
+            return Schedule(effectiveDate, terminationDate, tenor_, calendar_,
+                            convention_, terminationDateConvention_, rule_,
+                            endOfMonth_);
+
+        QL_REQUIRE(terminationDate != Date(), "null termination date");
+        QL_REQUIRE(effectiveDate < terminationDate,
+                   "effective date (" << effectiveDate
+                   << ") later than or equal to termination date ("
+                   << terminationDate << ")");
+
+        std::vector<Date>& table = adjusted_;
+        std::vector<Date>& terminationTable =
+            terminationDateConvention_ == convention_ ?
+            adjusted_ : terminationAdjusted_;
+        // the same steps as in the Schedule constructor, with the
+        // calendar adjustments and the rolls looked up in the tables
+        Calendar nullCalendar = NullCalendar();
+        std::vector<Date> dates;
+        std::vector<bool> isRegular;
+        Date seed, exitDate;
+        if (rule_ == DateGeneration::Backward) {
+            dates.push_back(terminationDate);
+            seed = terminationDate;
+            exitDate = effectiveDate;
+            for (Integer periods = 1;; ++periods) {
+                Date temp = rolled(seed, periods);
+                if (temp < exitDate)
+                    break;
+                // skip dates that would result in duplicates
+                // after adjustment
+                if (adjust(dates.back(), convention_, table) !=
+                    adjust(temp, convention_, table)) {
+                    dates.push_back(temp);
+                    isRegular.push_back(true);
+                }
+            }
+            if (adjust(dates.back(), convention_, table) !=
+                adjust(effectiveDate, convention_, table)) {
+                dates.push_back(effectiveDate);
+                isRegular.push_back(
+                    nullCalendar.advance(dates[dates.size()-2], -1*tenor_,
+                                         convention_, endOfMonth_) ==
+                    effectiveDate);
+            }
+            std::reverse(dates.begin(), dates.end());
+            std::reverse(isRegular.begin(), isRegular.end());
+        } else {
+            dates.push_back(effectiveDate);
+            seed = effectiveDate;
+            exitDate = terminationDate;
+            for (Integer periods = 1;; ++periods) {
+                Date temp = rolled(seed, periods);
+                if (temp > exitDate)
+                    break;
+                if (adjust(dates.back(), convention_, table) !=
+                    adjust(temp, convention_, table)) {
+                    dates.push_back(temp);
+                    isRegular.push_back(true);
+                }
+            }
+            if (adjust(dates.back(), terminationDateConvention_,
+                       terminationTable) !=
+                adjust(terminationDate, terminationDateConvention_,
+                       terminationTable)) {
+                dates.push_back(terminationDate);
+                isRegular.push_back(false);
+            }
+        }
+
+        // adjustments
+        dates.front() = adjust(dates.front(), convention_, table);
+        dates.back() = adjust(dates.back(), terminationDateConvention_,
+                              terminationTable);
+        if (endOfMonth_ && calendar_.isEndOfMonth(seed)) {
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = adjust(Date::endOfMonth(dates[i]), convention_,
+                                  table);
+        } else {
+            for (Size i=1; i<dates.size()-1; ++i)
+                dates[i] = adjust(dates[i], convention_, table);
+        }
+
+        // final safety checks, see the Schedule constructor
+        if (dates.size() >= 2 && dates[dates.size()-2] >= dates.back()) {
+            if (isRegular.size() >= 2) {
+                isRegular[isRegular.size() - 2] =
+                    (dates[dates.size() - 2] == dates.back());
+            }
+            dates[dates.size() - 2] = dates.back();
+            dates.pop_back();
+            isRegular.pop_back();
+        }
+        if (dates.size() >= 2 && dates[1] <= dates.front()) {
+            isRegular[1] = (dates[1] == dates.front());
+            dates[1] = dates.front();
+            dates.erase(dates.begin());
+            isRegular.erase(isRegular.begin());
+        }
+
+        QL_ENSURE(dates.size()>1,
+            "degenerate single date (" << dates[0] << ") schedule" <<
+            "\n seed date: " << seed <<
+            "\n exit date: " << exitDate <<
+            "\n effective date: " << effectiveDate <<
+            "\n termination date: " << terminationDate <<
+            "\n generation rule: " << rule_ <<
+            "\n end of month: " << endOfMonth_);
+
+        return Schedule(dates, calendar_, convention_,
+                        terminationDateConvention_, tenor_, rule_,
+                        endOfMonth_, std::move(isRegular));
+    }
+
+    std::vector<Schedule> ScheduleGenerator::operator()(
+                         const std::vector<Date>& effectiveDates,
+                         const std::vector<Date>& terminationDates) const {
+        QL_REQUIRE(effectiveDates.size() == terminationDates.size(),
+                   "mismatch between number of effective dates ("
+                   << effectiveDates.size()
+                   << ") and number of termination dates ("
+                   << terminationDates.size() << ")");
+        std::vector<Schedule> schedules;
+        schedules.reserve(effectiveDates.size());
+        for (Size i=0; i<effectiveDates.size(); ++i)
+            schedules.push_back((*this)(effectiveDates[i],
+                                        terminationDates[i]));
+        return schedules;
+    }
+
+    Date ScheduleGenerator::adjust(const Date& d,
+                                   BusinessDayConvention convention,
+                                   std::vector<Date>& table) const {
+        if (convention == Unadjusted)
+            return d;
+        const Date::serial_type serial = d.serialNumber();
+        if (adjusted_.empty() && terminationAdjusted_.empty()) {
+            firstSerial_ = serial;
+        } else if (serial < firstSerial_) {
+            // grow the tables downwards by at least a year
+            const Date::serial_type first = std::max(
+                std::min(serial, firstSerial_ - 366),
+                Date::minDate().serialNumber());
+            const auto offset = static_cast<Size>(firstSerial_ - first);
+            if (!adjusted_.empty())
+                adjusted_.insert(adjusted_.begin(), offset, Date());
+            if (!terminationAdjusted_.empty())
+                terminationAdjusted_.insert(terminationAdjusted_.begin(),
+                                            offset, Date());
+            firstSerial_ = first;
+        }
+        const auto i = static_cast<Size>(serial - firstSerial_);
+        if (i >= table.size())
+            table.resize(std::max<Size>(i + 1, table.size() + 366));
+        if (table[i] == Date())
+            table[i] = calendar_.adjust(d, convention);
+        return table[i];
+    }
+
+    Date ScheduleGenerator::rolled(const Date& seed, Integer periods) const {
+        std::vector<Date>& dates = rolls_[seed.serialNumber()];
+        const Integer sign = rule_ == DateGeneration::Backward ? -1 : 1;
+        while (Integer(dates.size()) < periods) {
+            const Integer n = sign * Integer(dates.size() + 1);
+            dates.push_back(NullCalendar().advance(seed, n*tenor_, convention_,
+                                                   endOfMonth_));
+        }
+        return dates[periods-1];
+    }
+
     Date previousTwentieth(const Date& d, DateGeneration::Rule rule) {
         Date result = Date(20, d.month(), d.year());
         if (result > d)
@@ -32,6 +32,7 @@
 #include <ql/time/dategenerationrule.hpp>
 #include <ql/errors.hpp>
 #include <ql/optional.hpp>
+#include <unordered_map>
 
 namespace QuantLib {
 
@@ -152,6 +153,58 @@ namespace QuantLib {
         Date firstDate_, nextToLastDate_;
     };
 
+    //! bulk generation of rule-based schedules
+    /*! This class builds many schedules sharing the same tenor,
+        calendar, conventions, rule and end-of-month flag, as is the
+        case for the legs of a portfolio of standard swaps.  The
+        results are the same as those of the rule-based Schedule
+        constructor; however, the adjusted dates are stored in a
+        table indexed by serial number and the unadjusted dates rolled
+        from each seed date are memoized, so that the calendar is
+        queried once per distinct date rather than several times per
+        schedule.
+
+        The optimization applies to the Backward and Forward rules
+        with a positive tenor; other rules, as well as null effective
+        dates, are delegated to the Schedule constructor.
+
+        \warning the tables are filled lazily, therefore an instance
+                 can't be shared among threads.
+    */
+    class ScheduleGenerator {
+      public:
+        ScheduleGenerator(const Period& tenor,
+                          Calendar calendar,
+                          BusinessDayConvention convention,
+                          BusinessDayConvention terminationDateConvention,
+                          DateGeneration::Rule rule,
+                          bool endOfMonth);
+        //! a single schedule
+        Schedule operator()(const Date& effectiveDate,
+                            const Date& terminationDate) const;
+        //! one schedule for each pair of effective and termination dates
+        std::vector<Schedule> operator()(
+                               const std::vector<Date>& effectiveDates,
+                               const std::vector<Date>& terminationDates) const;
+      private:
+        Date adjust(const Date& d,
+                    BusinessDayConvention convention,
+                    std::vector<Date>& table) const;
+        Date rolled(const Date& seed, Integer periods) const;
+        Period tenor_;
+        Calendar calendar_;
+        BusinessDayConvention convention_, terminationDateConvention_;
+        DateGeneration::Rule rule_;
+        bool endOfMonth_;
+        // adjusted dates, indexed by serial number from firstSerial_;
+        // null entries are not calculated yet
+        mutable Date::serial_type firstSerial_ = 0;
+        mutable std::vector<Date> adjusted_, terminationAdjusted_;
+        // unadjusted dates rolled from each seed date
+        mutable std::unordered_map<Date::serial_type,
+                                   std::vector<Date> > rolls_;
+    };
+
     /*! Helper function for returning the date on or before date \p d that is the 20th of the month and obeserves the 
         given date generation \p rule if it is relevant.
     */
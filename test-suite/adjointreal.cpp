@@ -0,0 +1,162 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include "utilities.hpp"
+#include <ql/math/adjointreal.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantLibTests, TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(AdjointRealTests)
+
+namespace {
+
+    AdjointReal cumNormal(const AdjointReal& x) {
+        return 0.5 * erfc(-x / std::sqrt(2.0));
+    }
+
+    AdjointReal blackScholesCall(const AdjointReal& spot,
+                                 const AdjointReal& strike,
+                                 const AdjointReal& vol,
+                                 const AdjointReal& maturity,
+                                 const AdjointReal& rate) {
+        // as in generic code; the overloads for AdjointReal are
+        // found by argument-dependent lookup
+        using std::exp;
+        using std::log;
+        using std::sqrt;
+        AdjointReal stdDev = vol * sqrt(maturity);
+        AdjointReal d1 = (log(spot / strike) +
+                          (rate + 0.5 * vol * vol) * maturity) / stdDev;
+        AdjointReal d2 = d1 - stdDev;
+        return spot * cumNormal(d1)
+            - strike * exp(-rate * maturity) * cumNormal(d2);
+    }
+
+}
+
+BOOST_AUTO_TEST_CASE(testDerivativesAgainstFiniteDifferences) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing adjoint derivatives against finite differences...");
+
+    const double spot = 100.0, strike = 105.0, vol = 0.2,
+        maturity = 1.5, rate = 0.03;
+    const double inputs[] = { spot, strike, vol, maturity, rate };
+    const char* names[] = { "spot", "strike", "vol", "maturity", "rate" };
+
+    AdjointTape tape;
+    AdjointReal x[5];
+    for (Size i=0; i<5; ++i) {
+        x[i] = inputs[i];
+        tape.registerInput(x[i]);
+    }
+    AdjointReal price = blackScholesCall(x[0], x[1], x[2], x[3], x[4]);
+    tape.computeAdjoints(price);
+
+    const double h = 1.0e-5, tolerance = 1.0e-6;
+    for (Size i=0; i<5; ++i) {
+        double up[5], down[5];
+        std::copy(inputs, inputs+5, up);
+        std::copy(inputs, inputs+5, down);
+        up[i] += h;
+        down[i] -= h;
+        double expected =
+            (blackScholesCall(up[0], up[1], up[2], up[3], up[4]).value() -
+             blackScholesCall(down[0], down[1], down[2], down[3], down[4]).value())
+            / (2.0*h);
+        double calculated = tape.derivative(x[i]);
+        if (std::fabs(calculated - expected) > tolerance)
+            BOOST_ERROR("failed to reproduce derivative w.r.t. " << names[i]
+                        << std::setprecision(10)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testTapeRewind) {
+
+    BOOST_TEST_MESSAGE("Testing adjoint tape rewinding...");
+
+    AdjointTape tape;
+    AdjointReal x = 2.0, y = 3.0;
+    tape.registerInput(x);
+    tape.registerInput(y);
+
+    AdjointTape::Position start = tape.position();
+
+    // first recording, later discarded
+    AdjointReal f = x * x * y;
+    tape.computeAdjoints(f);
+    if (std::fabs(tape.derivative(x) - 12.0) > 1.0e-15 ||
+        std::fabs(tape.derivative(y) - 4.0) > 1.0e-15)
+        BOOST_ERROR("wrong derivatives of x^2 y:"
+                    << "\n    df/dx: " << tape.derivative(x) << " (expected 12)"
+                    << "\n    df/dy: " << tape.derivative(y) << " (expected 4)");
+
+    tape.rewind(start);
+    if (tape.position() != start)
+        BOOST_ERROR("tape not rewound to the given position");
+
+    // second recording on the same inputs
+    AdjointReal g = sin(x) + y / x;
+    tape.computeAdjoints(g);
+    double dgdx = std::cos(2.0) - 3.0/4.0, dgdy = 0.5;
+    if (std::fabs(tape.derivative(x) - dgdx) > 1.0e-15 ||
+        std::fabs(tape.derivative(y) - dgdy) > 1.0e-15)
+        BOOST_ERROR("wrong derivatives after rewinding:"
+                    << "\n    dg/dx: " << tape.derivative(x)
+                    << " (expected " << dgdx << ")"
+                    << "\n    dg/dy: " << tape.derivative(y)
+                    << " (expected " << dgdy << ")");
+
+    // passive variables are not recorded
+    AdjointTape::Position before = tape.position();
+    AdjointReal p = 1.0, q = exp(p) * 2.0;
+    if (q.isActive() || tape.position() != before)
+        BOOST_ERROR("operations on passive variables were recorded");
+}
+
+BOOST_AUTO_TEST_CASE(testMixedOperations) {
+
+    BOOST_TEST_MESSAGE("Testing adjoint operations with double operands...");
+
+    AdjointTape tape;
+    AdjointReal x = 3.0;
+    tape.registerInput(x);
+
+    // the overloads are found by argument-dependent lookup
+    AdjointReal f = max(x, 0.0) * min(2.0, x) + pow(x, 2);
+    tape.computeAdjoints(f);
+    if (std::fabs(f.value() - 15.0) > 1.0e-15 ||
+        std::fabs(tape.derivative(x) - 8.0) > 1.0e-15)
+        BOOST_ERROR("wrong value or derivative of max(x,0) min(2,x) + x^2:"
+                    << "\n    value: " << f << " (expected 15)"
+                    << "\n    df/dx: " << tape.derivative(x) << " (expected 8)");
+
+    // calls on doubles are not affected
+    double e = exp(1.0);
+    if (e != std::exp(1.0))
+        BOOST_ERROR("wrong exponential of a double: " << e);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -879,6 +879,79 @@ BOOST_AUTO_TEST_CASE(testDifferentOptimizers) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testDenseSurfaceCalibration) {
+    BOOST_TEST_MESSAGE(
+        "Testing Andreasen-Huge calibration to a dense Heston surface...");
+
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(4, January, 2018);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.02, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.015, dc));
+
+    const Handle<Quote> spot(ext::make_shared<SimpleQuote>(2700.0));
+
+    // equity index like Heston parameters
+    const ext::shared_ptr<HestonModel> hestonModel(
+        ext::make_shared<HestonModel>(
+            ext::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.025, 2.5, 0.05, 0.9, -0.8)));
+
+    const ext::shared_ptr<BlackVolTermStructure> hestonVol =
+        ext::make_shared<HestonBlackVolSurface>(
+            Handle<HestonModel>(hestonModel));
+
+    const Period maturities[] = {
+        1*Weeks, 2*Weeks, 1*Months, 2*Months, 3*Months, 6*Months,
+        9*Months, 1*Years, 18*Months, 2*Years, 3*Years, 5*Years
+    };
+
+    AndreasenHugeVolatilityInterpl::CalibrationSet calibrationSet;
+    for (const auto& maturity : maturities) {
+        const Date maturityDate = today + maturity;
+        const Time t = dc.yearFraction(today, maturityDate);
+        const Real fwd = spot->value()*qTS->discount(t)/rTS->discount(t);
+
+        for (Real m = 0.5; m < 1.51; m += 0.025) {
+            const Real strike = m*spot->value();
+            const Volatility vol = hestonVol->blackVol(t, strike);
+            const Real mn = std::log(fwd/strike)/std::sqrt(t);
+
+            if (std::fabs(mn) < 3.0*vol) {
+                calibrationSet.emplace_back(
+                    ext::make_shared<VanillaOption>(
+                        ext::make_shared<PlainVanillaPayoff>(
+                            (strike > fwd)? Option::Call : Option::Put, strike),
+                        ext::make_shared<EuropeanExercise>(maturityDate)),
+                    ext::make_shared<SimpleQuote>(vol));
+            }
+        }
+    }
+
+    const ext::shared_ptr<OptimizationMethod> optimizationMethods[] = {
+        // analytic and finite-difference Jacobian
+        ext::make_shared<LevenbergMarquardt>(1e-8, 1e-8, 1e-8, true),
+        ext::make_shared<LevenbergMarquardt>(1e-8, 1e-8, 1e-8, false)
+    };
+
+    for (const auto& optimizationMethod : optimizationMethods) {
+        const std::tuple<Real, Real, Real> error =
+            AndreasenHugeVolatilityInterpl(
+                calibrationSet, spot, rTS, qTS,
+                AndreasenHugeVolatilityInterpl::CubicSpline,
+                AndreasenHugeVolatilityInterpl::CallPut, 500, Null<Real>(),
+                Null<Real>(), optimizationMethod).calibrationError();
+
+        const Real maxError = std::get<1>(error), avgError = std::get<2>(error);
+        if (std::isnan(avgError) || avgError > 0.0005 || maxError > 0.005)
+            BOOST_FAIL("failed to calibrate Andreasen-Huge volatility "
+                       "interpolation to a dense surface"
+                       << "\n    max calibration error:     " << maxError
+                       << "\n    average calibration error: " << avgError);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testMovingReferenceDate) {
     BOOST_TEST_MESSAGE(
         "Testing that reference date of adapter surface moves along with "
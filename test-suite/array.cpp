@@ -20,6 +20,7 @@
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
 #include <ql/math/array.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using namespace QuantLib;
@@ -341,6 +342,84 @@ BOOST_AUTO_TEST_CASE(testArrayOperators) {
     QL_CHECK_CLOSE_ARRAY(real_rvalue_quotient, scalar_quotient_2);
 }
 
+BOOST_AUTO_TEST_CASE(testInPlaceOperations) {
+
+    BOOST_TEST_MESSAGE("Testing in-place array operations...");
+
+    const Array x = {1.0, 2.0, 3.0};
+    const Array y = {0.5, -1.0, 4.0};
+
+    Array axpy = y;
+    Axpy(2.0, x, axpy);
+    QL_CHECK_CLOSE_ARRAY(axpy, Array(y + 2.0*x));
+
+    Array r;
+    MultiplyAdd(y, x, x, r);
+    QL_CHECK_CLOSE_ARRAY(r, Array(y + x*x));
+
+    MultiplyAdd(y, 3.0, x, r);
+    QL_CHECK_CLOSE_ARRAY(r, Array(y + 3.0*x));
+
+    // the result can be one of the operands
+    Array c = x;
+    MultiplyAdd(y, -0.5, c, c);
+    QL_CHECK_CLOSE_ARRAY(c, Array(y - 0.5*x));
+
+    Array shorter(2);
+    BOOST_CHECK_THROW(Axpy(1.0, x, shorter), Error);
+    BOOST_CHECK_THROW(MultiplyAdd(x, 1.0, shorter, r), Error);
+}
+
+BOOST_AUTO_TEST_CASE(testArrayPool) {
+
+    BOOST_TEST_MESSAGE("Testing pooled array storage...");
+
+    const Size size = 1000, steps = 100;
+    const Array a(size, 1.0);
+
+    auto step = [&](const Array& v) {
+        // a few temporaries, as in a finite-difference step
+        Array y = v + 0.5 * a;
+        Matrix m(10, 100, 0.0);
+        return Array(y * (1.0 - 1e-3) - 0.5 * a);
+    };
+
+    ArrayPool::resetHeapAllocations();
+    Array v = a;
+    for (Size i=0; i<steps; ++i)
+        v = step(v);
+    Size unpooled = ArrayPool::heapAllocations();
+    if (unpooled < steps)
+        BOOST_ERROR("too few heap allocations counted without a pool: "
+                    << unpooled);
+
+    Array w = a;
+    ArrayPool pool;
+    {
+        ArrayPool::Scope scope(pool);
+        if (ArrayPool::current() != &pool)
+            BOOST_FAIL("pool not installed");
+
+        ArrayPool::resetHeapAllocations();
+        for (Size i=0; i<steps; ++i)
+            w = step(w);
+        Size pooled = ArrayPool::heapAllocations();
+        // after the first steps, storage should only come from the pool
+        if (pooled > 10)
+            BOOST_ERROR("too many heap allocations with a pool: " << pooled
+                        << " (" << unpooled << " without)");
+        if (pool.reused() == 0)
+            BOOST_ERROR("no storage reused");
+    }
+    if (ArrayPool::current() != nullptr)
+        BOOST_ERROR("pool not uninstalled");
+
+    // the results don't depend on the pool, and arrays created
+    // within the scope can outlive it
+    QL_CHECK_CLOSE_ARRAY(w, v);
+    BOOST_CHECK(pool.cached() > 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
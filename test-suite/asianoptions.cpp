@@ -2151,6 +2151,109 @@ BOOST_AUTO_TEST_CASE(testVecerEngine) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMCDiscreteArithmeticAveragePriceGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing pathwise greeks of the Monte Carlo discrete "
+                       "arithmetic average-price engine...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.02));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    ext::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.05));
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(qTS),
+            Handle<YieldTermStructure>(rTS),
+            Handle<BlackVolTermStructure>(volTS));
+
+    std::vector<Date> fixingDates;
+    for (Size i=1; i<=12; ++i)
+        fixingDates.push_back(today + Period(i, Months));
+    ext::shared_ptr<Exercise> exercise(new EuropeanExercise(fixingDates.back()));
+
+    Average::Type averageType = Average::Arithmetic;
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real runningSums[] = { 0.0, 300.0 };
+    Size pastFixingsList[] = { 0, 3 };
+
+    for (auto type : types) {
+        for (Size k=0; k<2; ++k) {
+            Real runningSum = runningSums[k];
+            Size pastFixings = pastFixingsList[k];
+            ext::shared_ptr<StrikedTypePayoff> payoff(
+                new PlainVanillaPayoff(type, 100.0));
+            DiscreteAveragingAsianOption option(averageType, runningSum,
+                                                pastFixings, fixingDates,
+                                                payoff, exercise);
+
+            // finite differences on the same random paths
+            option.setPricingEngine(
+                MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+                .withSamples(20000)
+                .withAntitheticVariate()
+                .withSeed(42));
+            auto centralDifference = [&](const ext::shared_ptr<SimpleQuote>& q,
+                                         Real h) {
+                Real q0 = q->value();
+                q->setValue(q0 + h);
+                Real up = option.NPV();
+                q->setValue(q0 - h);
+                Real down = option.NPV();
+                q->setValue(q0);
+                return (up - down) / (2.0 * h);
+            };
+            std::map<std::string, Real> expected;
+            expected["delta"] = centralDifference(spot, 0.01);
+            expected["vega"] = centralDifference(vol, 1.0e-4);
+            expected["rho"] = centralDifference(rRate, 1.0e-5);
+            expected["divRho"] = centralDifference(qRate, 1.0e-5);
+
+            option.setPricingEngine(
+                MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+                .withSamples(20000)
+                .withAntitheticVariate()
+                .withSeed(42)
+                .withGreeks(McGreeks::Pathwise));
+            std::map<std::string, Real> calculated;
+            calculated["delta"] = option.delta();
+            calculated["vega"] = option.vega();
+            calculated["rho"] = option.rho();
+            calculated["divRho"] = option.dividendRho();
+
+            Real tolerance = 1.0e-3;
+            for (const auto& greek : expected) {
+                Real error = relativeError(greek.second,
+                                           calculated[greek.first],
+                                           greek.second);
+                if (error > tolerance) {
+                    REPORT_FAILURE(greek.first, averageType, runningSum,
+                                   pastFixings, fixingDates, payoff, exercise,
+                                   spot->value(), qRate->value(),
+                                   rRate->value(), today, vol->value(),
+                                   greek.second, calculated[greek.first],
+                                   tolerance);
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK_THROW(
+        ext::shared_ptr<PricingEngine>(
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(1000)
+            .withGreeks(McGreeks::LikelihoodRatio)),
+        Error);
+}
+
 BOOST_AUTO_TEST_CASE(testAnalyticContinuousGeometricAveragePriceHeston) {
 
     BOOST_TEST_MESSAGE("Testing analytic continuous geometric Asians under Heston...");
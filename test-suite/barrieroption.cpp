@@ -45,7 +45,10 @@
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/volatility/equityfx/griddedlocalvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <map>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -778,6 +781,126 @@ BOOST_AUTO_TEST_CASE(testBeagleholeValues) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMcLikelihoodRatioGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo likelihood-ratio greeks for "
+                       "discretely-monitored barrier options...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.02));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    ext::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.05));
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    ext::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    ext::shared_ptr<BlackScholesMertonProcess> process =
+        ext::make_shared<BlackScholesMertonProcess>(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(qTS),
+            Handle<YieldTermStructure>(rTS),
+            Handle<BlackVolTermStructure>(volTS));
+
+    ext::shared_ptr<Exercise> exercise =
+        ext::make_shared<EuropeanExercise>(today + 360);
+
+    struct {
+        Barrier::Type barrierType;
+        Real barrier;
+        Real rebate;
+        Option::Type type;
+    } cases[] = {
+        { Barrier::DownOut, 90.0, 3.0, Option::Call },
+        { Barrier::UpOut, 120.0, 3.0, Option::Call },
+        { Barrier::DownIn, 90.0, 0.0, Option::Put },
+        { Barrier::UpIn, 110.0, 2.0, Option::Put }
+    };
+
+    for (const auto& c : cases) {
+        ext::shared_ptr<StrikedTypePayoff> payoff =
+            ext::make_shared<PlainVanillaPayoff>(c.type, 100.0);
+        BarrierOption option(c.barrierType, c.barrier, c.rebate,
+                             payoff, exercise);
+
+        // finite differences on the same random paths
+        option.setPricingEngine(
+            MakeMCBarrierEngine<PseudoRandom>(process)
+            .withSteps(12)
+            .withBias()
+            .withAntitheticVariate()
+            .withSamples(40000)
+            .withSeed(42));
+        auto centralDifference = [&](const ext::shared_ptr<SimpleQuote>& q,
+                                     Real h) {
+            Real q0 = q->value();
+            q->setValue(q0 + h);
+            Real up = option.NPV();
+            q->setValue(q0 - h);
+            Real down = option.NPV();
+            q->setValue(q0);
+            return (up - down) / (2.0 * h);
+        };
+        std::map<std::string, Real> expected;
+        expected["delta"] = centralDifference(spot, 1.0);
+        expected["vega"] = centralDifference(vol, 0.01);
+        expected["rho"] = centralDifference(rRate, 0.001);
+        expected["divRho"] = centralDifference(qRate, 0.001);
+
+        option.setPricingEngine(
+            MakeMCBarrierEngine<PseudoRandom>(process)
+            .withSteps(12)
+            .withBias()
+            .withAntitheticVariate()
+            .withSamples(40000)
+            .withSeed(42)
+            .withGreeks(McGreeks::LikelihoodRatio));
+        std::map<std::string, Real> calculated;
+        calculated["delta"] = option.delta();
+        calculated["vega"] = option.vega();
+        calculated["rho"] = option.rho();
+        calculated["divRho"] = option.dividendRho();
+
+        // the tolerance is relative to the spot for all greeks but
+        // delta, since some of them can be close to zero
+        Real tolerance = 0.015;
+        for (const auto& greek : expected) {
+            Real error = std::fabs(greek.second - calculated[greek.first]);
+            Real scale = greek.first == "delta" ? 1.0 : spot->value();
+            if (error > tolerance * scale) {
+                REPORT_FAILURE(greek.first, c.barrierType, c.barrier,
+                               c.rebate, payoff, exercise, spot->value(),
+                               qRate->value(), rRate->value(), today,
+                               vol->value(), greek.second,
+                               calculated[greek.first], error,
+                               tolerance * scale);
+            }
+        }
+
+        // the Brownian-bridge correction depends on the volatility
+        option.setPricingEngine(
+            MakeMCBarrierEngine<PseudoRandom>(process)
+            .withSteps(12)
+            .withSamples(1000)
+            .withSeed(42)
+            .withGreeks(McGreeks::LikelihoodRatio));
+        BOOST_CHECK_THROW(option.delta(), Error);
+
+        // pathwise greeks are not available for discontinuous payoffs
+        option.setPricingEngine(
+            MakeMCBarrierEngine<PseudoRandom>(process)
+            .withSteps(12)
+            .withBias()
+            .withSamples(1000)
+            .withSeed(42)
+            .withGreeks(McGreeks::Pathwise));
+        BOOST_CHECK_THROW(option.delta(), Error);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testLocalVolAndHestonComparison) {
     BOOST_TEST_MESSAGE("Testing local volatility and Heston FD engines "
                        "for barrier options...");
@@ -913,6 +1036,126 @@ BOOST_AUTO_TEST_CASE(testLocalVolAndHestonComparison) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testGriddedLocalVolSurface) {
+    BOOST_TEST_MESSAGE("Testing barrier options with a gridded local "
+                       "volatility surface...");
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual365Fixed();
+
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(today, 0.03, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(today, 0.01, dc));
+
+    std::vector<Date> dates;
+    for (Size j=1; j <= 8; ++j)
+        dates.push_back(today + Period(3*j, Months));
+    std::vector<Real> strikes;
+    for (Size i=0; i <= 30; ++i)
+        strikes.push_back(40.0 + 6.0*i);
+
+    Matrix blackVols(strikes.size(), dates.size());
+    for (Size i=0; i < strikes.size(); ++i)
+        for (Size j=0; j < dates.size(); ++j) {
+            const Real y = std::log(strikes[i]/100.0);
+            const Time t = dc.yearFraction(today, dates[j]);
+            blackVols[i][j] = 0.2 + (0.1*y*y - 0.05*y)*std::exp(-0.5*t);
+        }
+    const ext::shared_ptr<BlackVarianceSurface> volTS =
+        ext::make_shared<BlackVarianceSurface>(
+            today, NullCalendar(), dates, strikes, blackVols, dc,
+            BlackVarianceSurface::ConstantExtrapolation,
+            BlackVarianceSurface::ConstantExtrapolation);
+    volTS->setInterpolation<Bicubic>();
+    const Handle<BlackVolTermStructure> blackVol(volTS);
+
+    const ext::shared_ptr<LocalVolSurface> dupire =
+        ext::make_shared<LocalVolSurface>(blackVol, rTS, qTS, s0);
+    const Handle<LocalVolTermStructure> dupireHandle(dupire);
+
+    std::vector<Real> spots;
+    for (Real x = 60.0; x <= 160.0; x += 2.5)
+        spots.push_back(x);
+    const Time sliceTimes[] = { 0.0, 0.01, 0.5, 1.3, 2.0 };
+    for (Time t : sliceTimes) {
+        const std::vector<Volatility> vols = dupire->localVols(t, spots, true);
+        for (Size i=0; i < spots.size(); ++i) {
+            const Volatility expected = dupire->localVol(t, spots[i], true);
+            if (vols[i] != expected)
+                BOOST_ERROR("local vol slice differs from single values"
+                            << "\n    time:       " << t
+                            << "\n    underlying: " << spots[i]
+                            << "\n    slice:      " << vols[i]
+                            << "\n    single:     " << expected);
+        }
+    }
+
+    std::vector<Time> times;
+    for (Size j=0; j <= 80; ++j)
+        times.push_back(0.025*j);
+    std::vector<Real> grid;
+    for (Size i=0; i <= 200; ++i)
+        grid.push_back(50.0 + 0.75*i);
+
+    const ext::shared_ptr<GriddedLocalVolSurface> gridded =
+        ext::make_shared<GriddedLocalVolSurface>(
+            dupireHandle, times, grid,
+            GriddedLocalVolSurface::CubicInStrike, true);
+
+    for (Size j=0; j < times.size(); j+=7)
+        for (Size i=0; i < grid.size(); i+=13) {
+            const Volatility expected = dupire->localVol(times[j], grid[i], true);
+            const Volatility calculated = gridded->localVol(times[j], grid[i], true);
+            if (std::fabs(calculated - expected) > 1e-12)
+                BOOST_ERROR("gridded local vol does not reproduce grid values"
+                            << "\n    time:       " << times[j]
+                            << "\n    underlying: " << grid[i]
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+    for (Real t = 0.1; t < 2.0; t += 0.3)
+        for (Real x = 60.3; x < 190.0; x += 7.1) {
+            const Volatility expected = dupire->localVol(t, x, true);
+            const Volatility calculated = gridded->localVol(t, x, true);
+            if (std::fabs(calculated - expected) > 1e-3)
+                BOOST_ERROR("gridded local vol too far from Dupire local vol"
+                            << "\n    time:       " << t
+                            << "\n    underlying: " << x
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+        }
+
+    const Date exDate = today + Period(18, Months);
+    BarrierOption barrierOption(
+        Barrier::DownOut, 80.0, 0.0,
+        ext::make_shared<PlainVanillaPayoff>(Option::Call, 100.0),
+        ext::make_shared<EuropeanExercise>(exDate));
+
+    barrierOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesBarrierEngine>(
+            ext::make_shared<GeneralizedBlackScholesProcess>(
+                s0, qTS, rTS, blackVol, dupireHandle),
+            100, 200, 0, FdmSchemeDesc::Douglas(), true));
+    const Real expected = barrierOption.NPV();
+
+    barrierOption.setPricingEngine(
+        ext::make_shared<FdBlackScholesBarrierEngine>(
+            ext::make_shared<GeneralizedBlackScholesProcess>(
+                s0, qTS, rTS, blackVol,
+                Handle<LocalVolTermStructure>(gridded)),
+            100, 200, 0, FdmSchemeDesc::Douglas(), true));
+    const Real calculated = barrierOption.NPV();
+
+    const Real tol = 1e-3;
+    if (std::fabs(calculated - expected) > tol*expected)
+        BOOST_ERROR("failed to reproduce local vol barrier price "
+                    "with gridded local vol surface"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
 BOOST_AUTO_TEST_CASE(testDividendBarrierOption) {
     BOOST_TEST_MESSAGE("Testing barrier option pricing with discrete dividends...");
 
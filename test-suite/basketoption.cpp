@@ -53,6 +53,7 @@
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 
+#include <boost/mpl/vector.hpp>
 #include <cmath>
 
 using namespace QuantLib;
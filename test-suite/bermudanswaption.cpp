@@ -23,6 +23,9 @@
 #include "utilities.hpp"
 #include <ql/cashflows/coupon.hpp>
 #include <ql/cashflows/iborcoupon.hpp>
+#include <ql/experimental/callablebonds/callablebond.hpp>
+#include <ql/experimental/callablebonds/discretizedcallablefixedratebond.hpp>
+#include <ql/experimental/callablebonds/treecallablebondengine.hpp>
 #include <ql/indexes/ibor/eonia.hpp>
 #include <ql/indexes/ibor/euribor.hpp>
 #include <ql/instruments/makevanillaswap.hpp>
@@ -30,8 +33,10 @@
 #include <ql/instruments/swaption.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/models/shortrate/twofactormodels/g2.hpp>
+#include <ql/pricingengines/sharedshortratelattice.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdg2swaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
 #include <ql/pricingengines/swaption/treeswaptionengine.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -371,6 +376,105 @@ BOOST_AUTO_TEST_CASE(testTreeEngineTimeSnapping) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testSharedLattice) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Bermudan swaptions rolled back on a shared lattice...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+    Settings::instance().evaluationDate() = vars.today;
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                       0.04875825,
+                                       Actual365Fixed()));
+    Date referenceDate = vars.termStructure->referenceDate();
+    DayCounter dayCounter = vars.termStructure->dayCounter();
+
+    ext::shared_ptr<HullWhite> model =
+        ext::make_shared<HullWhite>(vars.termStructure, 0.048696, 0.0058904);
+
+    // swaptions with different strikes, starts and lengths
+    Integer startYears[] = { 1, 2, 1 };
+    Integer lengths[] = { 5, 3, 7 };
+    Real strikes[] = { 0.04, 0.05, 0.06 };
+
+    SharedShortRateLattice lattice(model, 50);
+    std::vector<ext::shared_ptr<Swaption> > swaptions;
+    for (Size i=0; i<3; ++i) {
+        vars.startYears = startYears[i];
+        vars.length = lengths[i];
+        ext::shared_ptr<VanillaSwap> swap = vars.makeSwap(strikes[i]);
+        std::vector<Date> exerciseDates;
+        for (const auto& cf : swap->fixedLeg())
+            exerciseDates.push_back(coupon_cast(cf)->accrualStartDate());
+        auto swaption = ext::make_shared<Swaption>(
+            swap, ext::make_shared<BermudanExercise>(exerciseDates));
+        swaptions.push_back(swaption);
+
+        Swaption::arguments arguments;
+        swaption->setupArguments(&arguments);
+        Size index = lattice.add(
+            ext::make_shared<DiscretizedSwaption>(arguments, referenceDate,
+                                                  dayCounter),
+            dayCounter.yearFraction(referenceDate, exerciseDates.back()),
+            dayCounter.yearFraction(referenceDate, exerciseDates.front()));
+        BOOST_CHECK_EQUAL(index, i);
+    }
+
+    // a callable bond on the same lattice
+    Schedule schedule =
+        MakeSchedule()
+        .from(vars.settlement)
+        .to(vars.settlement + 6*Years)
+        .withCalendar(vars.calendar)
+        .withFrequency(Annual)
+        .withConvention(Unadjusted);
+    CallabilitySchedule callabilities;
+    for (Size i=2; i<schedule.size()-1; ++i)
+        callabilities.push_back(ext::make_shared<Callability>(
+            Bond::Price(100.0, Bond::Price::Clean), Callability::Call,
+            schedule.date(i)));
+    CallableFixedRateBond bond(2, 100.0, schedule,
+                               std::vector<Rate>(1, 0.05),
+                               Thirty360(Thirty360::BondBasis), Unadjusted,
+                               100.0, vars.settlement, callabilities);
+    CallableBond::arguments bondArguments;
+    bond.setupArguments(&bondArguments);
+    Size bondIndex = lattice.add(
+        ext::make_shared<DiscretizedCallableFixedRateBond>(bondArguments,
+                                                           vars.termStructure),
+        dayCounter.yearFraction(referenceDate, bondArguments.redemptionDate));
+
+    lattice.rollback();
+
+    // tree engines on the same time grid must give the same results
+    auto engine = ext::make_shared<TreeSwaptionEngine>(
+                                      model, lattice.lattice()->timeGrid());
+    for (Size i=0; i<swaptions.size(); ++i) {
+        swaptions[i]->setPricingEngine(engine);
+        Real expected = swaptions[i]->NPV();
+        Real calculated = lattice.presentValue(i);
+        if (std::fabs(calculated - expected) > 1.0e-10)
+            BOOST_ERROR("failed to reproduce swaption value on shared lattice:"
+                        << std::setprecision(12)
+                        << "\n    swaption:   #" << i+1
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+    }
+
+    bond.setPricingEngine(ext::make_shared<TreeCallableFixedRateBondEngine>(
+                                      model, lattice.lattice()->timeGrid()));
+    Real expected = bond.NPV();
+    Real calculated = lattice.presentValue(bondIndex);
+    if (std::fabs(calculated - expected) > 1.0e-10)
+        BOOST_ERROR("failed to reproduce callable-bond value on shared lattice:"
+                    << std::setprecision(12)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+}
+
 BOOST_AUTO_TEST_CASE(testBermudanOISSwaptionWithHW) {
 
     BOOST_TEST_MESSAGE(
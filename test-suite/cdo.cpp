@@ -28,6 +28,7 @@
 #include <ql/experimental/credit/midpointcdoengine.hpp>
 #include <ql/experimental/credit/pool.hpp>
 #include <ql/experimental/credit/randomdefaultlatentmodel.hpp>
+#include <ql/experimental/credit/recursivelossmodel.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
@@ -213,7 +214,13 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(testHW, T, dataSets) {
         relativeTolerancePeriod.push_back(0.5);
         // Binomial...
         // Saddle point...
-        // Recursive ...
+        // Recursive gaussian
+        modelNames.emplace_back("Recursive gaussian");
+        basketModels.push_back(ext::shared_ptr<DefaultLossModel>(
+            new RecursiveGaussLossModel(gaussKtLossLM)));
+        absoluteTolerance.push_back(1.);
+        relativeToleranceMidp.push_back(0.04);
+        relativeTolerancePeriod.push_back(0.04);
     } else if (hwData7[i].nm > 0 && hwData7[i].nz > 0) {
         TCopulaPolicy::initTraits initTG;
         initTG.tOrders.push_back(hwData7[i].nm);
@@ -346,6 +353,72 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(testHW, T, dataSets) {
 }
 #endif
 
+BOOST_AUTO_TEST_CASE(testStreamedRandomDefaultStatistics) {
+
+    BOOST_TEST_MESSAGE("Testing streamed random default statistics...");
+
+    Size poolSize = 20;
+    // more than a streaming block
+    Size numSims = 70000;
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    Handle<Quote> hazardRate(ext::shared_ptr<Quote>(new SimpleQuote(0.02)));
+    ext::shared_ptr<DefaultProbabilityTermStructure> ptr(
+        new FlatHazardRate(asofDate, hazardRate, ActualActual(ActualActual::ISDA)));
+    std::vector<std::pair<DefaultProbKey, Handle<DefaultProbabilityTermStructure>>>
+        probabilities;
+    probabilities.emplace_back(
+        NorthAmericaCorpDefaultKey(EURCurrency(), SeniorSec, Period(0, Weeks), 10.),
+        Handle<DefaultProbabilityTermStructure>(ptr));
+    ext::shared_ptr<Pool> pool(new Pool());
+    std::vector<std::string> names;
+    for (Size i = 0; i < poolSize; ++i) {
+        std::ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(EURCurrency(), QuantLib::SeniorSec, Period(), 1.));
+    }
+    ext::shared_ptr<Basket> basket(new Basket(
+        asofDate, names, std::vector<Real>(poolSize, 100.0), pool, 0.03, 0.10));
+
+    Handle<Quote> correlation(ext::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    ext::shared_ptr<GaussianConstantLossLM> lm(
+        new GaussianConstantLossLM(correlation, std::vector<Real>(poolSize, 0.4),
+                                   LatentModelIntegrationType::GaussianQuadrature, poolSize,
+                                   GaussianCopulaPolicy::initTraits()));
+    ext::shared_ptr<RandomDefaultLM<GaussianCopulaPolicy>> model(
+        new RandomDefaultLM<GaussianCopulaPolicy>(lm, numSims));
+    basket->setLossModel(model);
+
+    std::vector<Date> dates = { asofDate + 1 * Years, asofDate + 5 * Years };
+    std::vector<Real> losses, probabilitiesOfTwo;
+    for (const auto& d : dates) {
+        losses.push_back(basket->expectedTrancheLoss(d));
+        probabilitiesOfTwo.push_back(basket->probAtLeastNEvents(2, d));
+    }
+
+    model->streamStatistics(dates);
+    for (Size i = 0; i < dates.size(); ++i) {
+        Real streamedLoss = basket->expectedTrancheLoss(dates[i]);
+        Probability streamedProbability = basket->probAtLeastNEvents(2, dates[i]);
+        if (std::fabs(streamedLoss - losses[i]) > 1.0e-8)
+            BOOST_ERROR("streamed expected tranche loss differs from stored one"
+                        << std::setprecision(12) << "\n    date:     " << dates[i]
+                        << "\n    streamed: " << streamedLoss
+                        << "\n    stored:   " << losses[i]);
+        if (std::fabs(streamedProbability - probabilitiesOfTwo[i]) > 1.0e-12)
+            BOOST_ERROR("streamed default probability differs from stored one"
+                        << std::setprecision(12) << "\n    date:     " << dates[i]
+                        << "\n    streamed: " << streamedProbability
+                        << "\n    stored:   " << probabilitiesOfTwo[i]);
+    }
+
+    // statistics not registered
+    BOOST_CHECK_THROW(basket->expectedTrancheLoss(asofDate + 2 * Years), Error);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
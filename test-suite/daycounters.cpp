@@ -1383,6 +1383,79 @@ BOOST_AUTO_TEST_CASE(testYearFraction2DateRounding) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testBatchedYearFractions) {
+    BOOST_TEST_MESSAGE("Testing batched year fractions...");
+
+    const auto dayCounters = std::vector<DayCounter>{
+        Actual365Fixed(),
+        Actual365Fixed(Actual365Fixed::NoLeap),
+        Actual360(), Actual360(true),
+        ActualActual(ActualActual::ISDA),
+        Business252(),
+        Business252(UnitedStates(UnitedStates::NYSE)),
+        Thirty360(Thirty360::USA),
+        Thirty360(Thirty360::BondBasis),
+        Thirty360(Thirty360::European),
+        Thirty360(Thirty360::Italian),
+        Thirty360(Thirty360::ISDA, Date(29, February, 2028)),
+        Thirty360(Thirty360::NASD),
+        Thirty365()
+    };
+
+    // ordered, reversed and equal pairs of dates, including
+    // end-of-month dates and holidays
+    std::vector<Date> d1, d2;
+    const Date start(1, January, 2024);
+    for (Integer i=0; i<1500; i+=7) {
+        for (Integer j : {0, 1, 29, 31, 59, 366, 1827, -3, -400}) {
+            d1.push_back(start + i);
+            d2.push_back(start + (i + j));
+        }
+    }
+    const Size n = d1.size();
+
+    for (const auto& dc : dayCounters) {
+        std::vector<Time> expected(n);
+        for (Size i=0; i<n; ++i)
+            expected[i] = dc.yearFraction(d1[i], d2[i]);
+
+        std::vector<Time> calculated(n);
+        dc.yearFractions(d1.data(), d2.data(), calculated.data(), n);
+
+        for (Size i=0; i<n; ++i) {
+            // single calls might use the tables set up by the batch
+            const Time t = dc.yearFraction(d1[i], d2[i]);
+            if (calculated[i] != expected[i] || t != expected[i]) {
+                BOOST_FAIL(
+                       "\nstart date : " << d1[i]
+                    << "\nend date   : " << d2[i]
+                    << "\nday counter: " << dc.name()
+                    << std::setprecision(16)
+                    << "\nexpected   : " << expected[i]
+                    << "\nbatched    : " << calculated[i]
+                    << "\nsingle     : " << t
+                );
+            }
+        }
+
+        // same first date for all fractions
+        dc.yearFractions(start, d2.data(), calculated.data(), n);
+        for (Size i=0; i<n; ++i) {
+            const Time t = dc.yearFraction(start, d2[i]);
+            if (calculated[i] != t) {
+                BOOST_FAIL(
+                       "\nstart date : " << start
+                    << "\nend date   : " << d2[i]
+                    << "\nday counter: " << dc.name()
+                    << std::setprecision(16)
+                    << "\nexpected   : " << t
+                    << "\nbatched    : " << calculated[i]
+                );
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -1292,6 +1292,163 @@ BOOST_AUTO_TEST_CASE(testQmcEngines) {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+BOOST_AUTO_TEST_CASE(testMcGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo greeks for European options "
+                       "against analytic results...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 90.0, 110.0 };
+    McGreeks::Method methods[] = { McGreeks::Pathwise,
+                                   McGreeks::LikelihoodRatio };
+    // relative tolerances; likelihood-ratio estimators are noisier
+    Real tolerances[] = { 0.01, 0.04 };
+
+    ext::shared_ptr<Exercise> exercise(
+        new EuropeanExercise(today + Period(1, Years)));
+
+    for (auto type : types) {
+        for (Real strike : strikes) {
+            ext::shared_ptr<StrikedTypePayoff> payoff(
+                new PlainVanillaPayoff(type, strike));
+            EuropeanOption option(payoff, exercise);
+
+            option.setPricingEngine(
+                ext::make_shared<AnalyticEuropeanEngine>(process));
+            std::map<std::string, Real> expected;
+            expected["delta"] = option.delta();
+            expected["vega"] = option.vega();
+            expected["rho"] = option.rho();
+            expected["divRho"] = option.dividendRho();
+
+            for (Size k=0; k<2; ++k) {
+                option.setPricingEngine(
+                    MakeMCEuropeanEngine<PseudoRandom>(process)
+                    .withSteps(10)
+                    .withAntitheticVariate()
+                    .withSamples(50000)
+                    .withSeed(42)
+                    .withGreeks(methods[k]));
+                std::map<std::string, Real> calculated;
+                calculated["delta"] = option.delta();
+                calculated["vega"] = option.vega();
+                calculated["rho"] = option.rho();
+                calculated["divRho"] = option.dividendRho();
+
+                for (const auto& greek : expected) {
+                    Real error = relativeError(greek.second,
+                                               calculated[greek.first],
+                                               greek.second);
+                    if (error > tolerances[k]) {
+                        REPORT_FAILURE(
+                            greek.first + (k == 0 ? " (pathwise)"
+                                                  : " (likelihood ratio)"),
+                            payoff, exercise, spot->value(), 0.02, 0.05,
+                            today, 0.25, greek.second,
+                            calculated[greek.first], error, tolerances[k]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(testMcDigitalGreeks) {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo likelihood-ratio greeks for "
+                       "European digital options against analytic results...");
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    ext::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    ext::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    ext::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, 0.25, dc);
+    ext::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(Handle<Quote>(spot),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS)));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 90.0, 120.0 };
+    Real cash = 10.0;
+    // the greeks are compared with a tolerance relative to the cash
+    // amount, since some of them can be close to zero
+    Real tolerance = 0.02;
+
+    ext::shared_ptr<Exercise> exercise(
+        new EuropeanExercise(today + Period(1, Years)));
+
+    for (auto type : types) {
+        for (Real strike : strikes) {
+            ext::shared_ptr<StrikedTypePayoff> payoff(
+                new CashOrNothingPayoff(type, strike, cash));
+            EuropeanOption option(payoff, exercise);
+
+            option.setPricingEngine(
+                ext::make_shared<AnalyticEuropeanEngine>(process));
+            std::map<std::string, Real> expected;
+            expected["value"] = option.NPV();
+            expected["delta"] = option.delta();
+            expected["vega"] = option.vega();
+            expected["rho"] = option.rho();
+            expected["divRho"] = option.dividendRho();
+
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(1)
+                .withAntitheticVariate()
+                .withSamples(100000)
+                .withSeed(42)
+                .withGreeks(McGreeks::LikelihoodRatio));
+            std::map<std::string, Real> calculated;
+            calculated["value"] = option.NPV();
+            calculated["delta"] = option.delta();
+            calculated["vega"] = option.vega();
+            calculated["rho"] = option.rho();
+            calculated["divRho"] = option.dividendRho();
+
+            for (const auto& greek : expected) {
+                Real error = std::fabs(greek.second - calculated[greek.first]);
+                Real scale = greek.first == "delta" ? cash / spot->value() : cash;
+                if (error > tolerance * scale) {
+                    REPORT_FAILURE(greek.first + " (likelihood ratio)",
+                                   payoff, exercise, spot->value(), 0.02, 0.05,
+                                   today, 0.25, greek.second,
+                                   calculated[greek.first], error,
+                                   tolerance * scale);
+                }
+            }
+
+            // pathwise greeks are not available for discontinuous payoffs
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(1)
+                .withSamples(1000)
+                .withSeed(42)
+                .withGreeks(McGreeks::Pathwise));
+            BOOST_CHECK_THROW(option.delta(), Error);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testLocalVolatility) {
     BOOST_TEST_MESSAGE("Testing finite-differences with local volatility...");
 
@@ -0,0 +1,394 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include "utilities.hpp"
+#include <ql/currencies/america.hpp>
+#include <ql/currencies/europe.hpp>
+#include <ql/exercise.hpp>
+#include <ql/experimental/credit/exposuresimulation.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/fxforward.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/instruments/swaption.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/models/shortrate/onefactormodels/gsr.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/pricingengines/swaption/jamshidianswaptionengine.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantLibTests, TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(ExposureSimulationTests)
+
+namespace {
+
+    struct CommonVars {
+        Date today;
+        Handle<YieldTermStructure> curve;
+        ext::shared_ptr<IborIndex> index;
+        ext::shared_ptr<PricingEngine> swapEngine;
+        ext::shared_ptr<HullWhite> hullWhite;
+
+        CommonVars() {
+            today = Date(15, March, 2024);
+            Settings::instance().evaluationDate() = today;
+            curve = Handle<YieldTermStructure>(
+                ext::make_shared<FlatForward>(today, 0.03, Actual365Fixed()));
+            index = ext::make_shared<Euribor6M>(curve);
+            swapEngine = ext::make_shared<DiscountingSwapEngine>(curve);
+            hullWhite = ext::make_shared<HullWhite>(curve, 0.03, 0.01);
+        }
+
+        ext::shared_ptr<VanillaSwap> swap(const Period& tenor, Rate fixedRate,
+                                          const Period& forwardStart = 0 * Days,
+                                          Swap::Type type = Swap::Payer) const {
+            ext::shared_ptr<VanillaSwap> swap =
+                MakeVanillaSwap(tenor, index, fixedRate, forwardStart)
+                    .withType(type)
+                    .withNominal(1000000.0);
+            swap->setPricingEngine(swapEngine);
+            return swap;
+        }
+
+        std::vector<Date> exposureDates(Size n, const Period& step) const {
+            std::vector<Date> dates(1, today);
+            for (Size i=1; i<n; ++i)
+                dates.push_back(today + (i * step.length()) * step.units());
+            return dates;
+        }
+    };
+
+}
+
+
+BOOST_AUTO_TEST_CASE(testSwapExposureAtReferenceDate) {
+
+    BOOST_TEST_MESSAGE("Testing swap exposures at the reference date...");
+
+    CommonVars vars;
+
+    std::vector<ext::shared_ptr<Instrument> > payers, receivers;
+    Real npv = 0.0;
+    for (Size i=0; i<5; ++i) {
+        ext::shared_ptr<VanillaSwap> s =
+            vars.swap((2 + 2 * i) * Years, 0.025 + 0.002 * i, (3 * i) * Months);
+        npv += s->NPV();
+        payers.push_back(s);
+        receivers.push_back(
+            vars.swap((2 + 2 * i) * Years, 0.025 + 0.002 * i, (3 * i) * Months,
+                      Swap::Receiver));
+    }
+
+    std::vector<Date> dates = vars.exposureDates(6, 1 * Years);
+    ext::shared_ptr<Gsr> gsr = ext::make_shared<Gsr>(
+        vars.curve, std::vector<Date>(), std::vector<Real>(1, 0.01), 0.03);
+
+    std::vector<ext::shared_ptr<ExposureSimulation> > simulations = {
+        ext::make_shared<ExposureSimulation>(vars.hullWhite, dates, 1000),
+        ext::make_shared<ExposureSimulation>(gsr, dates, 1000)
+    };
+    std::vector<std::string> models = { "HullWhite", "Gsr" };
+
+    for (Size m=0; m<simulations.size(); ++m) {
+        ExposureSimulation& simulation = *simulations[m];
+        Size payer = simulation.addNettingSet(payers);
+        Size receiver = simulation.addNettingSet(receivers);
+        Size both = simulation.addNettingSet(
+            {payers[0], payers[3], receivers[0], receivers[3]});
+
+        const ExposureProfile& p = simulation.profile(payer);
+        Real calculated = p.expectedExposure[0] - p.expectedNegativeExposure[0];
+        if (std::fabs(calculated - npv) > 1.0e-6 * std::fabs(npv) + 1.0e-4)
+            BOOST_ERROR("failed to reproduce netting-set value with " << models[m]
+                        << std::setprecision(10)
+                        << "\n    simulated value: " << calculated
+                        << "\n    expected value:  " << npv);
+
+        // receivers mirror payers on each path
+        const ExposureProfile& r = simulation.profile(receiver);
+        for (Size j=0; j<dates.size(); ++j) {
+            if (std::fabs(p.expectedExposure[j] - r.expectedNegativeExposure[j]) >
+                    1.0e-8 * p.expectedExposure[j] + 1.0e-6 ||
+                std::fabs(p.expectedNegativeExposure[j] - r.expectedExposure[j]) >
+                    1.0e-8 * p.expectedNegativeExposure[j] + 1.0e-6)
+                BOOST_ERROR("payer and receiver exposures don't match with "
+                            << models[m] << " at " << dates[j]
+                            << std::setprecision(10)
+                            << "\n    payer EE:     " << p.expectedExposure[j]
+                            << "\n    receiver ENE: " << r.expectedNegativeExposure[j]
+                            << "\n    payer ENE:    " << p.expectedNegativeExposure[j]
+                            << "\n    receiver EE:  " << r.expectedExposure[j]);
+        }
+
+        // offsetting trades net to zero
+        const ExposureProfile& b = simulation.profile(both);
+        for (Size j=0; j<dates.size(); ++j) {
+            if (b.expectedExposure[j] > 1.0e-6 ||
+                b.potentialFutureExposure[j] > 1.0e-6)
+                BOOST_ERROR("offsetting trades don't net with " << models[m]
+                            << " at " << dates[j]
+                            << "\n    EE:  " << b.expectedExposure[j]
+                            << "\n    PFE: " << b.potentialFutureExposure[j]);
+        }
+
+        // the PFE is a high quantile of the exposure
+        for (Size j=1; j<dates.size()-1; ++j) {
+            if (p.potentialFutureExposure[j] <= p.expectedExposure[j])
+                BOOST_ERROR("PFE below EE with " << models[m] << " at " << dates[j]
+                            << "\n    EE:  " << p.expectedExposure[j]
+                            << "\n    PFE: " << p.potentialFutureExposure[j]);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(testSwaptionExposure) {
+
+    BOOST_TEST_MESSAGE("Testing swaption exposures...");
+
+    CommonVars vars;
+
+    Date exerciseDate = vars.index->fixingCalendar().advance(vars.today, 2 * Years);
+    Date startDate = vars.index->valueDate(exerciseDate);
+    ext::shared_ptr<VanillaSwap> underlying =
+        MakeVanillaSwap(5 * Years, vars.index, 0.03)
+            .withEffectiveDate(startDate)
+            .withNominal(1000000.0);
+    underlying->setPricingEngine(vars.swapEngine);
+
+    ext::shared_ptr<Swaption> swaption = ext::make_shared<Swaption>(
+        underlying, ext::make_shared<EuropeanExercise>(exerciseDate));
+    swaption->setPricingEngine(
+        ext::make_shared<JamshidianSwaptionEngine>(vars.hullWhite, vars.curve));
+    Real expected = swaption->NPV();
+
+    std::vector<Date> dates = {vars.today, vars.today + 1 * Years, exerciseDate,
+                               vars.today + 3 * Years, vars.today + 8 * Years};
+    ExposureSimulation simulation(vars.hullWhite, dates, 20000);
+    Size n = simulation.addNettingSet({swaption});
+    Size m = simulation.addNettingSet({underlying});
+    const ExposureProfile& p = simulation.profile(n);
+    const ExposureProfile& u = simulation.profile(m);
+
+    Real calculated = p.expectedExposure[0];
+    if (std::fabs(calculated - expected) > 1.0e-4 * expected)
+        BOOST_ERROR("failed to reproduce swaption value"
+                    << std::setprecision(10)
+                    << "\n    simulated value: " << calculated
+                    << "\n    expected value:  " << expected);
+
+    // the swaption exposure is positive up to exercise; after
+    // exercise, it's the exposure of the underlying, but only on the
+    // paths where the swaption was exercised
+    for (Size j=0; j<3; ++j) {
+        if (p.expectedNegativeExposure[j] != 0.0)
+            BOOST_ERROR("negative swaption exposure at " << dates[j]
+                        << "\n    ENE: " << p.expectedNegativeExposure[j]);
+    }
+    for (Size j=2; j<4; ++j) {
+        if (p.expectedExposure[j] <= 0.0 ||
+            p.expectedExposure[j] > u.expectedExposure[j] * (1.0 + 1.0e-10) ||
+            p.expectedNegativeExposure[j] >
+            u.expectedNegativeExposure[j] * (1.0 + 1.0e-10))
+            BOOST_ERROR("swaption exposure out of range at " << dates[j]
+                        << "\n    swaption EE:    " << p.expectedExposure[j]
+                        << "\n    underlying EE:  " << u.expectedExposure[j]
+                        << "\n    swaption ENE:   " << p.expectedNegativeExposure[j]
+                        << "\n    underlying ENE: " << u.expectedNegativeExposure[j]);
+    }
+    if (p.expectedExposure.back() != 0.0 ||
+        p.expectedNegativeExposure.back() != 0.0)
+        BOOST_ERROR("nonzero swaption exposure after maturity"
+                    << "\n    EE:  " << p.expectedExposure.back()
+                    << "\n    ENE: " << p.expectedNegativeExposure.back());
+
+    // before exercise, the expected exposure is the expected
+    // swaption value; it's a martingale once discounted, so that
+    // with small rate volatility the discounted EE is close to the
+    // swaption value
+    Real ratio = p.expectedExposure[1] *
+                 vars.curve->discount(dates[1]) / expected;
+    if (std::fabs(ratio - 1.0) > 0.02)
+        BOOST_ERROR("unexpected swaption exposure before exercise"
+                    << "\n    EE:    " << p.expectedExposure[1]
+                    << "\n    value: " << expected);
+}
+
+
+BOOST_AUTO_TEST_CASE(testFxForwardExposure) {
+
+    BOOST_TEST_MESSAGE("Testing FX forward exposures...");
+
+    CommonVars vars;
+
+    Real spot = 1.1, volatility = 0.12;
+    Handle<YieldTermStructure> usdCurve(
+        ext::make_shared<FlatForward>(vars.today, 0.045, Actual365Fixed()));
+    // EUR is domestic: the process gives the EUR value of one USD
+    ext::shared_ptr<GeneralizedBlackScholesProcess> process =
+        ext::make_shared<GeneralizedBlackScholesProcess>(
+            Handle<Quote>(ext::make_shared<SimpleQuote>(1.0 / spot)), usdCurve,
+            vars.curve,
+            Handle<BlackVolTermStructure>(ext::make_shared<BlackConstantVol>(
+                vars.today, TARGET(), volatility, Actual365Fixed())));
+
+    // pays EUR, receives USD; almost deterministic rates
+    ext::shared_ptr<HullWhite> model =
+        ext::make_shared<HullWhite>(vars.curve, 0.03, 1.0e-8);
+    Date maturity = vars.today + 2 * Years;
+    Real usdNominal = 1000000.0, eurNominal = 1000000.0 / spot;
+    ext::shared_ptr<FxForward> forward = ext::make_shared<FxForward>(
+        eurNominal, EURCurrency(), usdNominal, USDCurrency(), maturity, true);
+
+    std::vector<Date> dates = {vars.today + 6 * Months, vars.today + 1 * Years,
+                               vars.today + 18 * Months};
+    Size samples = 50000;
+    ExposureSimulation simulation(model, dates, samples, 0.95, 42,
+                                  EURCurrency());
+    simulation.addFxRate(USDCurrency(), process, 0.3);
+    const ExposureProfile& p = simulation.profile(simulation.addNettingSet({forward}));
+
+    for (Size j=0; j<dates.size(); ++j) {
+        Time t = simulation.exposureTimes()[j];
+        Time T = vars.curve->timeFromReference(maturity);
+        // V(t) = a X(t) - b
+        Real a = usdNominal * usdCurve->discount(T) / usdCurve->discount(t);
+        Real b = eurNominal * vars.curve->discount(T) / vars.curve->discount(t);
+        Real forwardFx = process->x0() * usdCurve->discount(t) / vars.curve->discount(t);
+        Real stdDev = volatility * std::sqrt(t);
+        Real expectedEE = a * blackFormula(Option::Call, b / a, forwardFx, stdDev);
+        Real expectedENE = a * blackFormula(Option::Put, b / a, forwardFx, stdDev);
+        Real expectedPFE =
+            a * forwardFx * std::exp(-0.5 * stdDev * stdDev +
+                                     InverseCumulativeNormal()(0.95) * stdDev) - b;
+        // three standard errors
+        Real tolerance = 3.0 * a * forwardFx * stdDev / std::sqrt(Real(samples));
+
+        if (std::fabs(p.expectedExposure[j] - expectedEE) > tolerance ||
+            std::fabs(p.expectedNegativeExposure[j] - expectedENE) > tolerance ||
+            std::fabs(p.potentialFutureExposure[j] - expectedPFE) > 4.0 * tolerance)
+            BOOST_ERROR("failed to reproduce FX forward exposure at " << dates[j]
+                        << std::setprecision(8)
+                        << "\n    EE:           " << p.expectedExposure[j]
+                        << "\n    expected EE:  " << expectedEE
+                        << "\n    ENE:          " << p.expectedNegativeExposure[j]
+                        << "\n    expected ENE: " << expectedENE
+                        << "\n    PFE:          " << p.potentialFutureExposure[j]
+                        << "\n    expected PFE: " << expectedPFE
+                        << "\n    tolerance:    " << tolerance);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(testReproducibility) {
+
+    BOOST_TEST_MESSAGE("Testing reproducibility of exposure simulations...");
+
+    CommonVars vars;
+
+    std::vector<ext::shared_ptr<Instrument> > trades = {
+        vars.swap(5 * Years, 0.03), vars.swap(7 * Years, 0.028, 1 * Years),
+        vars.swap(10 * Years, 0.031, 0 * Days, Swap::Receiver)
+    };
+    std::vector<Date> dates = vars.exposureDates(12, 1 * Years);
+
+    ExposureSimulation first(vars.hullWhite, dates, 3000, 0.99, 1234);
+    first.addNettingSet(trades);
+    ExposureSimulation second(vars.hullWhite, dates, 3000, 0.99, 1234);
+    second.addNettingSet(trades);
+    const ExposureProfile& p1 = first.profile(0);
+    const ExposureProfile& p2 = second.profile(0);
+
+    for (Size j=0; j<dates.size(); ++j) {
+        if (p1.expectedExposure[j] != p2.expectedExposure[j] ||
+            p1.expectedNegativeExposure[j] != p2.expectedNegativeExposure[j] ||
+            p1.potentialFutureExposure[j] != p2.potentialFutureExposure[j])
+            BOOST_ERROR("simulations with the same seed differ at " << dates[j]);
+    }
+    if (p1.expectedPositiveExposure != p2.expectedPositiveExposure)
+        BOOST_ERROR("simulations with the same seed differ in EPE");
+
+    // results are recalculated when the market changes
+    Real epe = p1.expectedPositiveExposure;
+    ext::shared_ptr<SimpleQuote> shift = ext::make_shared<SimpleQuote>(0.03);
+    RelinkableHandle<YieldTermStructure> curve(
+        ext::make_shared<FlatForward>(vars.today, Handle<Quote>(shift),
+                                      Actual365Fixed()));
+    ext::shared_ptr<HullWhite> model = ext::make_shared<HullWhite>(curve, 0.03, 0.01);
+    ExposureSimulation third(model, dates, 3000, 0.99, 1234);
+    third.addNettingSet(trades);
+    Real epe3 = third.profile(0).expectedPositiveExposure;
+    shift->setValue(0.035);
+    Real shifted = third.profile(0).expectedPositiveExposure;
+    if (std::fabs(epe3 - epe) > 1.0e-6 * epe)
+        BOOST_ERROR("same market gives different EPE"
+                    << "\n    EPE:          " << epe
+                    << "\n    same market:  " << epe3);
+    if (shifted == epe3)
+        BOOST_ERROR("EPE not recalculated after market change");
+}
+
+
+BOOST_AUTO_TEST_CASE(testLargeNettingSet) {
+
+    BOOST_TEST_MESSAGE("Testing exposure of a large netting set...");
+
+    CommonVars vars;
+
+    // 10000 swaps, with different tenors, start dates, strikes and sides
+    std::vector<ext::shared_ptr<Instrument> > trades;
+    trades.reserve(10000);
+    Real npv = 0.0;
+    for (Size i=0; i<10000; ++i) {
+        Integer tenor = 1 + (i * 7) % 20;
+        Integer start = (i * 5) % 12;
+        Rate strike = 0.02 + 0.0001 * ((i * 13) % 200);
+        Swap::Type type = (i % 3 == 0) ? Swap::Receiver : Swap::Payer;
+        ext::shared_ptr<VanillaSwap> s =
+            vars.swap(tenor * Years, strike, start * Months, type);
+        npv += s->NPV();
+        trades.push_back(s);
+    }
+
+    // the last swaps mature in less than 21 years
+    std::vector<Date> dates = vars.exposureDates(23, 1 * Years);
+    ExposureSimulation simulation(vars.hullWhite, dates, 500);
+    const ExposureProfile& p = simulation.profile(simulation.addNettingSet(trades));
+
+    Real calculated = p.expectedExposure[0] - p.expectedNegativeExposure[0];
+    if (std::fabs(calculated - npv) > 1.0e-6 * std::fabs(npv))
+        BOOST_ERROR("failed to reproduce netting-set value"
+                    << std::setprecision(10)
+                    << "\n    simulated value: " << calculated
+                    << "\n    expected value:  " << npv);
+    if (p.expectedExposure.back() != 0.0 ||
+        p.expectedNegativeExposure.back() != 0.0)
+        BOOST_ERROR("nonzero exposure after the last maturity");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,7 +26,9 @@
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/matrixutilities/bicgstab.hpp>
+#include <ql/math/matrixutilities/csrmatrix.hpp>
 #include <ql/math/matrixutilities/gmres.hpp>
+#include <ql/math/matrixutilities/ilu0preconditioner.hpp>
 #include <ql/math/matrixutilities/sparseilupreconditioner.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
@@ -49,6 +51,7 @@
 #include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
 #include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm3dimsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
@@ -259,6 +262,24 @@ Size nrElementsOfSparseMatrix(const SparseMatrix& m) {
     return retVal;
 }
 
+ext::shared_ptr<FdmMesher> createHestonMesher(const std::vector<Size>& dim) {
+    const ext::shared_ptr<FdmLinearOpLayout> layout(new FdmLinearOpLayout(dim));
+    const std::vector<std::pair<Real, Real> > boundaries
+        = {{3.8, 5.4}, {0.0, 1.0}};
+    return ext::make_shared<UniformGridMesher>(layout, boundaries);
+}
+
+ext::shared_ptr<FdmHestonOp> createHestonOp(
+                                const ext::shared_ptr<FdmMesher>& mesher) {
+    const Handle<Quote> s0(ext::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    return ext::make_shared<FdmHestonOp>(
+        mesher,
+        ext::make_shared<HestonProcess>(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8));
+}
+
 
 BOOST_AUTO_TEST_CASE(testFdmLinearOpLayout) {
 
@@ -1288,6 +1309,146 @@ BOOST_AUTO_TEST_CASE(testGMRES) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testCsrMatrix) {
+    BOOST_TEST_MESSAGE("Testing CSR sparse matrices...");
+
+    CsrMatrix::Builder builder(3, 4);
+    builder.add(2, 3, 1.0);
+    builder.add(0, 2, 2.0);
+    builder.add(0, 0, 3.0);
+    builder.add(2, 3, 4.0);
+    builder.add(0, 1, 0.0);
+
+    const CsrMatrix m = builder.matrix();
+    const Size expectedOffsets[] = {0, 3, 3, 4};
+    const Size expectedColumns[] = {0, 1, 2, 3};
+    const Real expectedValues[] = {3.0, 0.0, 2.0, 5.0};
+    if (m.nonZeros() != 4
+        || !std::equal(m.rowOffsets().begin(), m.rowOffsets().end(),
+                       expectedOffsets)
+        || !std::equal(m.columnIndices().begin(), m.columnIndices().end(),
+                       expectedColumns)
+        || !std::equal(m.values().begin(), m.values().end(),
+                       expectedValues))
+        BOOST_FAIL("unexpected structure of CSR matrix built");
+
+    if (m(0, 2) != 2.0 || m(2, 3) != 5.0 || m(1, 1) != 0.0 || m(2, 0) != 0.0)
+        BOOST_FAIL("unexpected elements of CSR matrix built");
+
+    // Heston-sized operator
+    const ext::shared_ptr<FdmMesher> mesher = createHestonMesher({200, 100});
+    const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+    const ext::shared_ptr<FdmHestonOp> hestonOp = createHestonOp(mesher);
+    hestonOp->setTime(0.5, 0.6);
+
+    const CsrMatrix csr = hestonOp->toCsrMatrix();
+
+    const std::vector<SparseMatrix> decomp = hestonOp->toMatrixDecomp();
+    const SparseMatrix sum = std::accumulate(
+        decomp.begin()+1, decomp.end(), SparseMatrix(decomp.front()));
+
+    for (auto i1 = sum.begin1(); i1 != sum.end1(); ++i1) {
+        for (auto i2 = i1.begin(); i2 != i1.end(); ++i2) {
+            if (csr(i2.index1(), i2.index2()) != *i2)
+                BOOST_FAIL("CSR and ublas operator matrices differ"
+                           << "\n    row:    " << i2.index1()
+                           << "\n    column: " << i2.index2()
+                           << "\n    CSR:    " << csr(i2.index1(), i2.index2())
+                           << "\n    ublas:  " << *i2);
+        }
+    }
+
+    const CsrMatrix roundTrip(csr.toSparseMatrix());
+    if (roundTrip.rowOffsets() != csr.rowOffsets()
+        || roundTrip.columnIndices() != csr.columnIndices()
+        || roundTrip.values() != csr.values())
+        BOOST_FAIL("conversion to and from ublas matrices is not exact");
+
+    Array x(layout->size());
+    MersenneTwisterUniformRng rng(1234);
+    for (Real& xi : x)
+        xi = rng.next().value;
+
+    const Array expected = axpy(sum, x);
+    const Array applied = hestonOp->apply(x);
+    const Real tol = 1e-12*Norm2(expected);
+    const Array y = prod(csr, x);
+    const Real diffUblas = Norm2(y - expected);
+    const Real diffApply = Norm2(y - applied);
+    if (diffUblas > tol || diffApply > tol)
+        BOOST_FAIL("failed to reproduce operator application"
+                   << "\n    difference with ublas:    " << diffUblas
+                   << "\n    difference with operator: " << diffApply
+                   << "\n    tolerance:                " << tol);
+}
+
+BOOST_AUTO_TEST_CASE(testILU0Preconditioner) {
+    BOOST_TEST_MESSAGE("Testing zero fill-in incomplete LU preconditioner...");
+
+    const SparseMatrix a = createTestMatrix(41, 21, 1.0);
+
+    const CsrMatrix lu = ILU0Preconditioner(CsrMatrix(a)).factors();
+    const SparseILUPreconditioner ilu(a, 0);
+
+    for (Size i=0; i < lu.rows(); ++i) {
+        for (Size k=lu.rowOffsets()[i]; k < lu.rowOffsets()[i+1]; ++k) {
+            const Size j = lu.columnIndices()[k];
+            const Real expected = (j < i) ? ilu.L()(i, j) : ilu.U()(i, j);
+            if (std::fabs(lu.values()[k] - expected) > 1e-14)
+                BOOST_FAIL("ILU(0) factors differ from ublas ones"
+                           << "\n    row:      " << i
+                           << "\n    column:   " << j
+                           << "\n    CSR:      " << lu.values()[k]
+                           << "\n    ublas:    " << expected);
+        }
+    }
+
+    // implicit Euler step of a Heston-sized operator
+    const ext::shared_ptr<FdmMesher> mesher = createHestonMesher({200, 100});
+    const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+    const ext::shared_ptr<FdmHestonOp> hestonOp = createHestonOp(mesher);
+    hestonOp->setTime(0.5, 0.6);
+
+    const Real dt = 0.1;
+    const CsrMatrix l = hestonOp->toCsrMatrix();
+    CsrMatrix::Builder builder(l.rows(), l.columns(), l.nonZeros());
+    for (Size i=0; i < l.rows(); ++i) {
+        builder.add(i, i, 1.0);
+        for (Size k=l.rowOffsets()[i]; k < l.rowOffsets()[i+1]; ++k)
+            builder.add(i, l.columnIndices()[k], -dt*l.values()[k]);
+    }
+    const CsrMatrix m = builder.matrix();
+
+    Array b(layout->size());
+    for (const auto& iter : *layout)
+        b[iter.index()]
+            = std::max(std::exp(mesher->location(iter, 0)) - 100.0, 0.0);
+
+    const std::function<Array(const Array&)> matmult
+        = [&](const Array& _x) { return prod(m, _x); };
+
+    const Real tol = 1e-10;
+    const BiCGStabResult plain = BiCGstab(matmult, 1000, tol).solve(b);
+
+    const ILU0Preconditioner ilu0(m);
+    const std::function<Array(const Array&)> precond
+        = [&](const Array& _x) { return ilu0.apply(_x); };
+
+    const BiCGStabResult result = BiCGstab(matmult, 1000, tol, precond).solve(b);
+
+    const Real error = Norm2(b - prod(m, result.x))/Norm2(b);
+    if (error > tol)
+        BOOST_FAIL("Error solving the implicit step with ILU(0) preconditioning"
+                   << "\n tolerance:  " << tol
+                   << "\n error:      " << error);
+    if (result.iterations >= plain.iterations)
+        BOOST_FAIL("ILU(0) preconditioning does not reduce iterations"
+                   << "\n preconditioned:   " << result.iterations
+                   << "\n unpreconditioned: " << plain.iterations);
+}
+
 BOOST_AUTO_TEST_CASE(testCrankNicolsonWithDamping) {
 
     BOOST_TEST_MESSAGE("Testing Crank-Nicolson with initial implicit damping steps "
@@ -1376,6 +1537,56 @@ BOOST_AUTO_TEST_CASE(testCrankNicolsonWithDamping) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testImplicitEulerWarmStart) {
+
+    BOOST_TEST_MESSAGE("Testing warm starts of the implicit Euler scheme...");
+
+    const ext::shared_ptr<FdmMesher> mesher = createHestonMesher({100, 50});
+    const ext::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+    const ext::shared_ptr<FdmLinearOpComposite> hestonOp = createHestonOp(mesher);
+
+    Array warm(layout->size());
+    for (const auto& iter : *layout)
+        warm[iter.index()]
+            = std::max(std::exp(mesher->location(iter, 0)) - 100.0, 0.0);
+    Array cold = warm;
+
+    const Size steps = 20;
+    const Time dt = 1.0/steps;
+
+    ImplicitEulerScheme warmScheme(hestonOp);
+    Size coldIterations = 0;
+    for (Size i=0; i < steps; ++i) {
+        const Time t = 1.0 - i*dt;
+
+        warmScheme.setStep(dt);
+        warmScheme.step(warm, t);
+
+        // a new scheme starts from scratch at each step
+        ImplicitEulerScheme coldScheme(hestonOp);
+        coldScheme.setStep(dt);
+        coldScheme.step(cold, t);
+        coldIterations += coldScheme.numberOfIterations();
+    }
+
+    // the solver tolerance is relative to the norm of the whole array
+    const Real tol = 1e-6*Norm2(cold)/std::sqrt(Real(cold.size()));
+    for (Size i=0; i < warm.size(); ++i) {
+        if (std::fabs(warm[i] - cold[i]) > tol)
+            BOOST_FAIL("warm-started solution differs from cold-started one"
+                       << "\n    index:        " << i
+                       << "\n    warm start:   " << warm[i]
+                       << "\n    cold start:   " << cold[i]
+                       << "\n    tolerance:    " << tol);
+    }
+
+    if (warmScheme.numberOfIterations() >= coldIterations)
+        BOOST_ERROR("warm starts do not reduce the number of iterations"
+                    << "\n    warm start: " << warmScheme.numberOfIterations()
+                    << "\n    cold start: " << coldIterations);
+}
+
 BOOST_AUTO_TEST_CASE(testSpareMatrixReference) {
     BOOST_TEST_MESSAGE("Testing SparseMatrixReference type...");
 
@@ -752,6 +752,52 @@ BOOST_AUTO_TEST_CASE(testGsrModelQuoteUpdate) {
     BOOST_CHECK(std::fabs(before - after) > 0.01);
 }
 
+BOOST_AUTO_TEST_CASE(testGsrGridEvaluation) {
+
+    BOOST_TEST_MESSAGE("Testing GSR zerobonds and numeraire on a grid...");
+
+    Date refDate = Settings::instance().evaluationDate();
+
+    std::vector<Date> stepDates = {refDate + 1 * Years, refDate + 5 * Years};
+    std::vector<Real> vols = {0.0080, 0.0100, 0.0070};
+    std::vector<Real> reversions = {0.01, 0.02, -0.01};
+
+    Handle<YieldTermStructure> yts(ext::make_shared<FlatForward>(
+        0, TARGET(), 0.03, Actual365Fixed()));
+    Handle<YieldTermStructure> discountCurve(ext::make_shared<FlatForward>(
+        0, TARGET(), 0.025, Actual365Fixed()));
+    auto model = ext::make_shared<Gsr>(yts, stepDates, vols, reversions, 30.0);
+
+    Array y = model->yGrid(7.0, 16);
+    Array tenors = {0.5, 2.0, 7.5, 10.0, 20.0};
+    Real tol = 1E-14;
+
+    for (Time t : {0.0, 0.25, 3.0, 6.0}) {
+        Array maturities = tenors + t;
+        for (const auto& curve : {Handle<YieldTermStructure>(), discountCurve}) {
+            Array numeraires = model->numeraire(t, y, curve);
+            Matrix zerobonds = model->zerobond(maturities, t, y, curve);
+            for (Size j = 0; j < y.size(); ++j) {
+                Real expected = model->numeraire(t, y[j], curve);
+                if (std::fabs(numeraires[j] - expected) > tol * expected)
+                    BOOST_ERROR("numeraire(" << t << ", " << y[j]
+                                << ") on grid (" << numeraires[j]
+                                << ") differs from single value (" << expected
+                                << ")");
+                for (Size i = 0; i < maturities.size(); ++i) {
+                    expected = model->zerobond(maturities[i], t, y[j], curve);
+                    if (std::fabs(zerobonds[i][j] - expected) > tol * expected)
+                        BOOST_ERROR("zerobond(" << maturities[i] << ", " << t
+                                    << ", " << y[j] << ") on grid ("
+                                    << zerobonds[i][j]
+                                    << ") differs from single value ("
+                                    << expected << ")");
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testGsrIborSwaptionAgainstMonteCarlo) {
     BOOST_TEST_MESSAGE("Testing GSR Ibor swaption against Monte Carlo...");
     checkGsrIborSwaptionAgainstMonteCarlo();
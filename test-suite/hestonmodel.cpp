@@ -58,6 +58,7 @@
 #include <ql/time/daycounters/actualactual.hpp>
 #include <ql/time/period.hpp>
 #include <cmath>
+#include <map>
 #include <utility>
 
 using namespace QuantLib;
@@ -588,6 +589,101 @@ BOOST_AUTO_TEST_CASE(testMcVsCached) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testMcGreeks) {
+    BOOST_TEST_MESSAGE(
+        "Testing Monte Carlo Heston pathwise greeks against analytic results...");
+
+    DayCounter dayCounter = Actual365Fixed();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    ext::shared_ptr<SimpleQuote> spot(ext::make_shared<SimpleQuote>(100.0));
+    ext::shared_ptr<SimpleQuote> qRate(ext::make_shared<SimpleQuote>(0.02));
+    ext::shared_ptr<SimpleQuote> rRate(ext::make_shared<SimpleQuote>(0.05));
+    Handle<YieldTermStructure> riskFreeTS(flatRate(today, rRate, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(today, qRate, dayCounter));
+
+    ext::shared_ptr<HestonProcess> process(
+        ext::make_shared<HestonProcess>(
+                   riskFreeTS, dividendTS, Handle<Quote>(spot),
+                   0.04, 1.5, 0.04, 0.5, -0.7,
+                   HestonProcess::QuadraticExponentialMartingale));
+    ext::shared_ptr<PricingEngine> analyticEngine =
+        ext::make_shared<AnalyticHestonEngine>(
+            ext::make_shared<HestonModel>(process));
+
+    ext::shared_ptr<Exercise> exercise(
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 90.0, 110.0 };
+
+    for (auto type : types) {
+        for (Real strike : strikes) {
+            ext::shared_ptr<StrikedTypePayoff> payoff(
+                ext::make_shared<PlainVanillaPayoff>(type, strike));
+            VanillaOption option(payoff, exercise);
+
+            option.setPricingEngine(analyticEngine);
+            auto centralDifference = [&](const ext::shared_ptr<SimpleQuote>& q,
+                                         Real h) {
+                Real q0 = q->value();
+                q->setValue(q0 + h);
+                Real up = option.NPV();
+                q->setValue(q0 - h);
+                Real down = option.NPV();
+                q->setValue(q0);
+                return (up - down) / (2.0 * h);
+            };
+            std::map<std::string, Real> expected;
+            expected["delta"] = centralDifference(spot, 0.01);
+            expected["rho"] = centralDifference(rRate, 1.0e-5);
+            expected["divRho"] = centralDifference(qRate, 1.0e-5);
+
+            option.setPricingEngine(
+                MakeMCEuropeanHestonEngine<PseudoRandom>(process)
+                .withStepsPerYear(20)
+                .withAntitheticVariate()
+                .withSamples(50000)
+                .withSeed(1234)
+                .withGreeks(McGreeks::Pathwise));
+            std::map<std::string, Real> calculated;
+            calculated["delta"] = option.delta();
+            calculated["rho"] = option.rho();
+            calculated["divRho"] = option.dividendRho();
+
+            // the tolerance is relative to the spot for all greeks but
+            // delta, since some of them can be close to zero
+            Real tolerance = 5.0e-3;
+            for (const auto& greek : expected) {
+                Real error = std::fabs(greek.second - calculated[greek.first]);
+                Real scale = greek.first == "delta" ? 1.0 : spot->value();
+                if (error > tolerance * scale) {
+                    BOOST_ERROR("failed to reproduce " << greek.first
+                                << " of " << type << " option"
+                                << "\n    strike:     " << strike
+                                << "\n    calculated: " << calculated[greek.first]
+                                << "\n    expected:   " << greek.second
+                                << "\n    error:      " << error
+                                << "\n    tolerance:  " << tolerance * scale);
+                }
+            }
+
+            // there's no Black volatility to shift
+            BOOST_CHECK_THROW(option.vega(), Error);
+
+            // likelihood-ratio greeks are not available
+            option.setPricingEngine(
+                MakeMCEuropeanHestonEngine<PseudoRandom>(process)
+                .withStepsPerYear(20)
+                .withSamples(1000)
+                .withSeed(1234)
+                .withGreeks(McGreeks::LikelihoodRatio));
+            BOOST_CHECK_THROW(option.delta(), Error);
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testFdBarrierVsCached) {
     BOOST_TEST_MESSAGE("Testing FD barrier Heston engine against cached values...");
 
@@ -46,6 +46,7 @@
 #include <ql/math/optimization/levenbergmarquardt.hpp>
 #include <ql/math/randomnumbers/sobolrsg.hpp>
 #include <ql/math/richardsonextrapolation.hpp>
+#include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/null.hpp>
 #include <cmath>
@@ -2168,6 +2169,42 @@ BOOST_AUTO_TEST_CASE(testSabrSingleCases) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testSabrSmileEvaluation) {
+
+    BOOST_TEST_MESSAGE("Testing Sabr smile evaluation on a number of strikes...");
+
+    Real forward = 0.025;
+    std::vector<Real> strikes;
+    for (Size i = 0; i <= 40; ++i)
+        strikes.push_back(-0.005 + 0.0015 * i);
+    // at the money and very close to it
+    strikes.push_back(forward);
+    strikes.push_back(forward * (1.0 + 1.0E-10));
+
+    std::vector<std::vector<Real> > parameters = {
+        {0.04, 0.5, 0.4, -0.3}, {0.01, 0.0, 0.8, 0.5}, {0.2, 1.0, 0.0, 0.0}};
+
+    for (const auto& p : parameters) {
+        for (auto type : {ShiftedLognormal, Normal}) {
+            SabrSmileSection section(2.5, forward, p, 0.01, type);
+            std::vector<Volatility> vols = section.volatilities(strikes);
+            std::vector<Real> unsafeVols = unsafeShiftedSabrVolatility(
+                strikes, forward, 2.5, p[0], p[1], p[2], p[3], 0.01, type);
+            for (Size i = 0; i < strikes.size(); ++i) {
+                Volatility expected = section.volatility(strikes[i]);
+                Real expectedUnsafe = unsafeShiftedSabrVolatility(
+                    strikes[i], forward, 2.5, p[0], p[1], p[2], p[3], 0.01, type);
+                if (vols[i] != expected || unsafeVols[i] != expectedUnsafe)
+                    BOOST_ERROR("Sabr volatility for strike "
+                                << strikes[i] << " evaluated on the smile ("
+                                << vols[i] << ", " << unsafeVols[i]
+                                << ") differs from single evaluation ("
+                                << expected << ", " << expectedUnsafe << ")");
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testTransformations) {
 
     BOOST_TEST_MESSAGE("Testing Sabr and no-arbitrage Sabr transformation functions...");
@@ -19,8 +19,18 @@
 
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
 #include <ql/instruments/stock.hpp>
+#include <ql/patterns/dependencygraph.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/quotes/simplequote.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <algorithm>
+#include <sstream>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -272,6 +282,157 @@ BOOST_AUTO_TEST_CASE(testNotificationAfterFailedCalculation) {
         BOOST_FAIL("Observer was notified of second change without recalculation");
 }
 
+BOOST_AUTO_TEST_CASE(testDependencyGraph) {
+
+    BOOST_TEST_MESSAGE("Testing the dependency graph between lazy objects...");
+
+    Date today(15, March, 2024);
+    Settings::instance().evaluationDate() = today;
+
+    std::vector<ext::shared_ptr<SimpleQuote>> quotes;
+    std::vector<ext::shared_ptr<RateHelper>> helpers;
+    Integer months[] = { 3, 6, 9, 12 };
+    for (Integer m : months) {
+        quotes.push_back(ext::make_shared<SimpleQuote>(0.03));
+        helpers.push_back(ext::make_shared<DepositRateHelper>(
+            Handle<Quote>(quotes.back()), m * Months, 2, TARGET(),
+            ModifiedFollowing, false, Actual360()));
+    }
+    auto curve = ext::make_shared<PiecewiseYieldCurve<Discount, LogLinear>>(
+        today, helpers, Actual360());
+    curve->enableExtrapolation();
+    RelinkableHandle<YieldTermStructure> forecasting(curve);
+
+    auto engine = ext::make_shared<DiscountingSwapEngine>(
+        Handle<YieldTermStructure>(curve));
+    auto index = ext::make_shared<Euribor3M>(forecasting);
+
+    std::vector<ext::shared_ptr<Instrument>> swaps;
+    for (Integer m : months) {
+        ext::shared_ptr<VanillaSwap> swap =
+            MakeVanillaSwap(m * Months, index, 0.03).withPricingEngine(engine);
+        swaps.push_back(swap);
+    }
+    auto stock = ext::make_shared<Stock>(Handle<Quote>(quotes.front()));
+    swaps.push_back(stock);
+
+    DependencyGraph graph(swaps.begin(), swaps.end());
+
+    auto find = [&graph](const ext::shared_ptr<LazyObject>& x) {
+        for (Size i=0; i<graph.size(); ++i) {
+            if (graph.node(i) == x)
+                return i;
+        }
+        BOOST_FAIL("object not found in graph");
+        return graph.size();
+    };
+
+    Size c = find(curve);
+    BOOST_CHECK_EQUAL(graph.level(c), Size(0));
+    BOOST_CHECK(graph.dependencies(c).empty());
+
+    Size st = find(stock);
+    BOOST_CHECK_EQUAL(graph.level(st), Size(0));
+    BOOST_CHECK(graph.dependencies(st).empty());
+
+    // quotes are reached by the curve through its helpers and by the
+    // stock through its handle; the swaps reach them through the curve
+    auto reaches = [&graph](Size i, const ext::shared_ptr<SimpleQuote>& q) {
+        const std::vector<const Observable*>& o = graph.observables(i);
+        return std::find(o.begin(), o.end(),
+                         static_cast<const Observable*>(q.get())) != o.end();
+    };
+    for (const auto& q : quotes)
+        BOOST_CHECK(reaches(c, q));
+    BOOST_CHECK(reaches(st, quotes.front()));
+    BOOST_CHECK(!reaches(st, quotes.back()));
+    for (Size k=0; k<4; ++k)
+        BOOST_CHECK(!reaches(find(swaps[k]), quotes.front()));
+
+    for (Size i=0; i<graph.size(); ++i) {
+        for (Size j : graph.dependencies(i)) {
+            BOOST_CHECK(j < i);
+            BOOST_CHECK(graph.level(j) < graph.level(i));
+        }
+    }
+
+    // swaps depend on the curve through their floating coupons
+    for (Size k=0; k<4; ++k) {
+        Size i = find(swaps[k]);
+        BOOST_CHECK(graph.level(i) > graph.level(c));
+        std::vector<Size> stack(1, i);
+        bool found = false;
+        while (!stack.empty() && !found) {
+            Size n = stack.back();
+            stack.pop_back();
+            found = (n == c);
+            stack.insert(stack.end(), graph.dependencies(n).begin(),
+                         graph.dependencies(n).end());
+        }
+        BOOST_CHECK(found);
+    }
+
+    std::ostringstream dot;
+    graph.toGraphviz(dot);
+    BOOST_CHECK(dot.str().find("digraph") != std::string::npos);
+    BOOST_CHECK(dot.str().find("->") != std::string::npos);
+
+    // after a market change, the whole graph is recalculated
+    for (auto& q : quotes)
+        q->setValue(0.04);
+
+    BOOST_CHECK(!curve->isCalculated());
+    for (const auto& s : swaps)
+        BOOST_CHECK(!s->isCalculated());
+
+    graph.calculate();
+
+    for (Size i=0; i<graph.size(); ++i)
+        BOOST_CHECK(graph.node(i)->isCalculated());
+
+    // The results must be the ones of a lazy calculation.  They're
+    // compared on the same curve: the bootstrap starts from the
+    // previous state of the curve, so two bootstraps on the same
+    // quotes agree only within their accuracy.
+    for (auto& q : quotes)
+        q->setValue(0.035);
+    graph.calculate();
+    for (const auto& s : swaps) {
+        BOOST_CHECK(s->isCalculated());
+        Real calculated = s->NPV();
+        s->recalculate();
+        BOOST_CHECK_EQUAL(calculated, s->NPV());
+    }
+
+    // a partial calculation only touches the given nodes and their
+    // dependencies
+    for (auto& q : quotes)
+        q->setValue(0.04);
+    graph.calculate(std::vector<Size>(1, st));
+    BOOST_CHECK(stock->isCalculated());
+    BOOST_CHECK(!curve->isCalculated());
+    for (Size k=0; k<4; ++k)
+        BOOST_CHECK(!swaps[k]->isCalculated());
+
+    graph.calculate(std::vector<Size>(1, find(swaps[0])));
+    BOOST_CHECK(curve->isCalculated());
+    BOOST_CHECK(swaps[0]->isCalculated());
+    for (Size k=1; k<4; ++k)
+        BOOST_CHECK(!swaps[k]->isCalculated());
+
+    BOOST_CHECK_THROW(graph.calculate(std::vector<Size>(1, graph.size())),
+                      Error);
+
+    // failures are reported after the other nodes are calculated
+    auto failing = ext::make_shared<Stock>(Handle<Quote>());
+    auto working = ext::make_shared<Stock>(Handle<Quote>(quotes.front()));
+    DependencyGraph stocks(
+        std::vector<ext::shared_ptr<Observable>>{ failing, working });
+    BOOST_CHECK_THROW(stocks.calculate(), Error);
+    BOOST_CHECK(!failing->isCalculated());
+    BOOST_CHECK(working->isCalculated());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
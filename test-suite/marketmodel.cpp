@@ -25,6 +25,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "toplevelfixture.hpp"
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
@@ -37,6 +38,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/callability/upperboundengine.hpp>
 #include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
 #include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+#include <ql/models/marketmodels/evolvers/batchfwdrateevolvers.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerconstrained.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
@@ -107,6 +109,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/products/pathwise/pathwiseproductinversefloater.hpp>
 #include <ql/models/marketmodels/products/multistep/multisteppathwisewrapper.hpp>
 
+#include <boost/mpl/vector.hpp>
 #include <cmath>
 #include <sstream>
 
@@ -3469,6 +3472,94 @@ BOOST_AUTO_TEST_CASE(testPathwiseVegas) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testPathwiseVegasBatching) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing that pathwise vegas don't depend on path batching...");
+
+    setup();
+
+    MarketModelPathwiseMultiDeflatedCaplet capletsDeflated(rateTimes, accruals,
+        paymentTimes, todaysForwards);
+
+    EvolutionDescription evolution = capletsDeflated.evolution();
+    std::vector<Size> numeraires = moneyMarketMeasure(evolution);
+    Size factors = 3;
+    Size paths = 500;
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    ext::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+
+    // one bump for each rate and step, on the first factor
+    std::vector<std::vector<Matrix> > vegaBumps(evolution.numberOfSteps());
+    for (Size l=0; l<evolution.numberOfSteps(); ++l) {
+        for (Size k=0; k<evolution.numberOfRates(); ++k) {
+            Matrix bump(evolution.numberOfRates(), factors, 0.0);
+            if (k >= l)
+                bump[k][0] = 1.0e-2;
+            vegaBumps[l].push_back(bump);
+        }
+    }
+
+    std::vector<Real> means1, errors1, means2, errors2;
+    std::vector<Real> outerMeans1, outerErrors1, outerMeans2, outerErrors2;
+
+    {
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        PathwiseVegasAccountingEngine engine(
+            ext::make_shared<LogNormalFwdRateEuler>(marketModel, generatorFactory,
+                                                    numeraires),
+            capletsDeflated, marketModel, vegaBumps, initialNumeraireValue,
+            1, 1);
+        engine.multiplePathValues(means1, errors1, paths);
+    }
+    {
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        PathwiseVegasAccountingEngine engine(
+            ext::make_shared<LogNormalFwdRateEuler>(marketModel, generatorFactory,
+                                                    numeraires),
+            capletsDeflated, marketModel, vegaBumps, initialNumeraireValue,
+            7, 3);
+        engine.multiplePathValues(means2, errors2, paths);
+    }
+    {
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        PathwiseVegasOuterAccountingEngine engine(
+            ext::make_shared<LogNormalFwdRateEuler>(marketModel, generatorFactory,
+                                                    numeraires),
+            capletsDeflated, marketModel, vegaBumps, initialNumeraireValue,
+            1, 1);
+        engine.multiplePathValuesElementary(outerMeans1, outerErrors1, paths);
+    }
+    {
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        PathwiseVegasOuterAccountingEngine engine(
+            ext::make_shared<LogNormalFwdRateEuler>(marketModel, generatorFactory,
+                                                    numeraires),
+            capletsDeflated, marketModel, vegaBumps, initialNumeraireValue,
+            7, 3);
+        engine.multiplePathValuesElementary(outerMeans2, outerErrors2, paths);
+    }
+
+    // the same operations are performed in the same order
+    for (Size i=0; i<means1.size(); ++i) {
+        if (means1[i] != means2[i] || errors1[i] != errors2[i])
+            BOOST_ERROR("PathwiseVegasAccountingEngine: "
+                        << io::ordinal(i+1) << " value depends on batching:"
+                        << "\n    mean:  " << means1[i] << " vs " << means2[i]
+                        << "\n    error: " << errors1[i] << " vs " << errors2[i]);
+    }
+    for (Size i=0; i<outerMeans1.size(); ++i) {
+        if (outerMeans1[i] != outerMeans2[i] || outerErrors1[i] != outerErrors2[i])
+            BOOST_ERROR("PathwiseVegasOuterAccountingEngine: "
+                        << io::ordinal(i+1) << " value depends on batching:"
+                        << "\n    mean:  " << outerMeans1[i] << " vs " << outerMeans2[i]
+                        << "\n    error: " << outerErrors1[i] << " vs " << outerErrors2[i]);
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testPathwiseMarketVegas) {
 
     BOOST_TEST_MESSAGE("Testing pathwise market vegas in a lognormal forward rate market model...");
@@ -4530,6 +4621,113 @@ BOOST_AUTO_TEST_CASE(testDriftCalculator) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(testBatchEvolvers) {
+
+    BOOST_TEST_MESSAGE("Testing batched evolvers against single-path ones...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    addCoinitialSwaps(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    Size factors = 3;
+    Size paths = 1000;
+    Real tolerance = 1.0e-10;
+
+    enum BatchEvolverType { EulerBatch, PcBatch, IpcBatch, NormalPcBatch };
+    BatchEvolverType evolverTypes[] = { EulerBatch, PcBatch,
+                                        IpcBatch, NormalPcBatch };
+    std::string evolverNames[] = { "Euler", "predictor corrector",
+                                   "iterative predictor corrector",
+                                   "normal predictor corrector" };
+    MeasureType measures[] = { MoneyMarket, Terminal };
+
+    for (auto measure : measures) {
+        std::vector<Size> numeraires = makeMeasure(product, measure);
+        Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+        for (Size k=0; k<std::size(evolverTypes); ++k) {
+            BatchEvolverType type = evolverTypes[k];
+            if (type == IpcBatch && measure != Terminal)
+                continue;
+
+            ext::shared_ptr<MarketModel> marketModel =
+                makeMarketModel(type != NormalPcBatch, evolution, factors,
+                                ExponentialCorrelationAbcdVolatility);
+            MTBrownianGeneratorFactory generatorFactory(seed_);
+
+            ext::shared_ptr<MarketModelEvolver> evolver;
+            ext::shared_ptr<MarketModelBatchEvolver> batchEvolver;
+            switch (type) {
+              case EulerBatch:
+                evolver = ext::make_shared<LogNormalFwdRateEuler>(
+                               marketModel, generatorFactory, numeraires);
+                batchEvolver = ext::make_shared<BatchLogNormalFwdRateEuler>(
+                                                   marketModel, numeraires);
+                break;
+              case PcBatch:
+                evolver = ext::make_shared<LogNormalFwdRatePc>(
+                               marketModel, generatorFactory, numeraires);
+                batchEvolver = ext::make_shared<BatchLogNormalFwdRatePc>(
+                                                   marketModel, numeraires);
+                break;
+              case IpcBatch:
+                evolver = ext::make_shared<LogNormalFwdRateIpc>(
+                               marketModel, generatorFactory, numeraires);
+                batchEvolver = ext::make_shared<BatchLogNormalFwdRateIpc>(
+                                                   marketModel, numeraires);
+                break;
+              case NormalPcBatch:
+                evolver = ext::make_shared<NormalFwdRatePc>(
+                               marketModel, generatorFactory, numeraires);
+                batchEvolver = ext::make_shared<BatchNormalFwdRatePc>(
+                                                   marketModel, numeraires);
+                break;
+            }
+
+            AccountingEngine engine(evolver, product, initialNumeraireValue);
+            SequenceStatisticsInc expected(product.numberOfProducts());
+            engine.multiplePathValues(expected, paths);
+
+            // odd batch sizes so that the last round is incomplete
+            BatchAccountingEngine batchEngine(batchEvolver, generatorFactory,
+                                              product, initialNumeraireValue,
+                                              97, 4);
+            SequenceStatisticsInc calculated(product.numberOfProducts());
+            batchEngine.multiplePathValues(calculated, paths);
+
+            if (calculated.samples() != paths)
+                BOOST_ERROR(evolverNames[k] << " evolver, "
+                            << measureTypeToString(measure) << ": "
+                            << calculated.samples() << " samples, "
+                            << paths << " expected");
+
+            std::vector<Real> expectedMeans = expected.mean();
+            std::vector<Real> calculatedMeans = calculated.mean();
+            std::vector<Real> expectedStdDevs = expected.standardDeviation();
+            std::vector<Real> calculatedStdDevs =
+                calculated.standardDeviation();
+            for (Size i=0; i<expectedMeans.size(); ++i) {
+                Real error = std::fabs(calculatedMeans[i]-expectedMeans[i]) +
+                    std::fabs(calculatedStdDevs[i]-expectedStdDevs[i]);
+                if (error > tolerance)
+                    BOOST_ERROR(evolverNames[k] << " evolver, "
+                                << measureTypeToString(measure) << ", "
+                                << io::ordinal(i+1) << " product:"
+                                << "\n    single-path mean: " << expectedMeans[i]
+                                << "\n    batched mean:     " << calculatedMeans[i]
+                                << "\n    single-path std:  " << expectedStdDevs[i]
+                                << "\n    batched std:      " << calculatedStdDevs[i]
+                                << "\n    error:            " << error);
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_CASE(testIsInSubset) {
 
     // Performance test for isInSubset function (temporary)
@@ -1717,6 +1717,64 @@ BOOST_AUTO_TEST_CASE(testBermudanSwaption) {
                     << ")");
 }
 
+BOOST_AUTO_TEST_CASE(testGridEvaluation) {
+
+    BOOST_TEST_MESSAGE("Testing Markov functional zerobonds and numeraire on a grid...");
+
+    Date referenceDate(14, November, 2012);
+    Settings::instance().evaluationDate() = referenceDate;
+
+    Handle<YieldTermStructure> flatYts_ = flatYts();
+    Handle<YieldTermStructure> md0Yts_ = md0Yts();
+    Handle<SwaptionVolatilityStructure> md0SwaptionVts_ = md0SwaptionVts();
+
+    ext::shared_ptr<SwapIndex> swapIndexBase(
+        new EuriborSwapIsdaFixA(1 * Years));
+
+    std::vector<Date> volStepDates;
+    std::vector<Real> vols = {1.0};
+
+    ext::shared_ptr<MarkovFunctional> mf(
+        new MarkovFunctional(md0Yts_, 0.01, volStepDates, vols, md0SwaptionVts_,
+                             expiriesCalBasket3(), tenorsCalBasket3(),
+                             swapIndexBase, MarkovFunctional::ModelSettings()
+                                                .withYGridPoints(32)
+                                                .withYStdDevs(7.0)
+                                                .withGaussHermitePoints(16)
+                                                .withMarketRateAccuracy(1e-7)
+                                                .withDigitalGap(1e-5)
+                                                .withLowerRateBound(0.0)
+                                                .withUpperRateBound(2.0)));
+
+    Array y = mf->yGrid(7.0, 16);
+    Array maturities = {1.5, 4.0, 7.25, 10.0};
+    Real tol = 1E-12;
+
+    for (Time t : {0.0, 1.0, 3.5}) {
+        for (const auto& curve : {Handle<YieldTermStructure>(), flatYts_}) {
+            Array numeraires = mf->numeraire(t, y, curve);
+            Matrix zerobonds = mf->zerobond(maturities, t, y, curve);
+            for (Size j = 0; j < y.size(); ++j) {
+                Real expected = mf->numeraire(t, y[j], curve);
+                if (std::fabs(numeraires[j] - expected) > tol * expected)
+                    BOOST_ERROR("numeraire(" << t << ", " << y[j]
+                                << ") on grid (" << numeraires[j]
+                                << ") differs from single value (" << expected
+                                << ")");
+                for (Size i = 0; i < maturities.size(); ++i) {
+                    expected = mf->zerobond(maturities[i], t, y[j], curve);
+                    if (std::fabs(zerobonds[i][j] - expected) > tol * expected)
+                        BOOST_ERROR("zerobond(" << maturities[i] << ", " << t
+                                    << ", " << y[j] << ") on grid ("
+                                    << zerobonds[i][j]
+                                    << ") differs from single value ("
+                                    << expected << ")");
+                }
+            }
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
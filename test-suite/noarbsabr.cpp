@@ -21,6 +21,7 @@
 #include "utilities.hpp"
 #include <ql/termstructures/volatility/sabrsmilesection.hpp>
 #include <ql/experimental/volatility/noarbsabrsmilesection.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -120,6 +121,46 @@ BOOST_AUTO_TEST_CASE(testConsistencyWithHagan) {
 
 }
 
+BOOST_AUTO_TEST_CASE(testBatchedPrices) {
+
+    BOOST_TEST_MESSAGE("Testing batched noarb-sabr option prices...");
+
+    Real tau = 1.0;
+    Real beta = 0.5;
+    Real alpha = 0.026;
+    Real rho = -0.1;
+    Real nu = 0.4;
+    Real f = 0.0488;
+
+    NoArbSabrSmileSection noarbsabr(tau, f, {alpha, beta, nu, rho});
+    ext::shared_ptr<NoArbSabrModel> model = noarbsabr.model();
+
+    std::vector<Real> strikes;
+    for (Real strike = 0.0001; strike < 0.15; strike += 0.0025)
+        strikes.push_back(strike);
+
+    // both are accurate up to the integration accuracy
+    Real tolerance = 1e-6;
+
+    std::vector<Real> prices = model->optionPrices(strikes);
+    std::vector<Volatility> vols = noarbsabr.volatilities(strikes);
+    for (Size i = 0; i < strikes.size(); ++i) {
+        Real expected = model->optionPrice(strikes[i]);
+        if (std::fabs(prices[i] - expected) > tolerance)
+            BOOST_ERROR("batched price (" << prices[i]
+                        << ") inconsistent with single price (" << expected
+                        << ") at strike " << strikes[i]);
+        Real vega = blackFormulaStdDevDerivative(strikes[i], f,
+                                                 vols[i] * std::sqrt(tau));
+        Real volError = std::fabs(vols[i] - noarbsabr.volatility(strikes[i]));
+        if (vega * std::sqrt(tau) * volError > tolerance)
+            BOOST_ERROR("batched volatility (" << vols[i]
+                        << ") inconsistent with single volatility ("
+                        << noarbsabr.volatility(strikes[i])
+                        << ") at strike " << strikes[i]);
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -502,6 +502,7 @@ QL_BENCHMARK_DECLARE(FdHestonTests, testAmericanCallPutParity, 15, 1.5);
 QL_BENCHMARK_DECLARE(FdHestonTests, testFdmHestonBarrierVsBlackScholes, 1, 2.0);
 QL_BENCHMARK_DECLARE(HestonSLVModelTests, testMonteCarloCalibration, 1, 3.0);
 QL_BENCHMARK_DECLARE(HestonSLVModelTests, testHestonFokkerPlanckFwdEquation, 1, 5.0);
+QL_BENCHMARK_DECLARE(HestonSLVModelTests, testLocalVolsvSLVPropDensity, 1, 1.0);
 QL_BENCHMARK_DECLARE(HestonSLVModelTests, testBarrierPricingViaHestonLocalVol, 1, 1.0);
 QL_BENCHMARK_DECLARE(MCLongstaffSchwartzEngineTests, testAmericanOption, 1, 2.0);
 QL_BENCHMARK_DECLARE(VarianceGammaTests, testVarianceGamma, 1, 0.1);
@@ -514,6 +515,7 @@ QL_BENCHMARK_DECLARE(AndreasenHugeVolatilityInterplTests, testFlatVolCalibration
 QL_BENCHMARK_DECLARE(AndreasenHugeVolatilityInterplTests, testTimeDependentInterestRates, 1, 1.0);
 QL_BENCHMARK_DECLARE(AndreasenHugeVolatilityInterplTests, testPiecewiseConstantInterpolation, 1, 1.0);
 QL_BENCHMARK_DECLARE(AndreasenHugeVolatilityInterplTests, testLinearInterpolation, 1, 1.0);
+QL_BENCHMARK_DECLARE(AndreasenHugeVolatilityInterplTests, testDenseSurfaceCalibration, 1, 1.0);
 
 // Interest Rates
 QL_BENCHMARK_DECLARE(ShortRateModelTests, testSwaps, 30, 3.0);
@@ -578,6 +580,12 @@ QL_BENCHMARK_DECLARE(RoundingTests, testUp, 100000, 0.1);
 QL_BENCHMARK_DECLARE(RoundingTests, testFloor, 100000, 0.1);
 QL_BENCHMARK_DECLARE(RoundingTests, testDown, 100000, 0.1);
 QL_BENCHMARK_DECLARE(RoundingTests, testClosest, 100000, 0.1);
+QL_BENCHMARK_DECLARE(ArrayTests, testArrayPool, 1000, 0.5);
+QL_BENCHMARK_DECLARE(FdmLinearOpTests, testCsrMatrix, 20, 0.5);
+QL_BENCHMARK_DECLARE(FdmLinearOpTests, testILU0Preconditioner, 5, 1.0);
+QL_BENCHMARK_DECLARE(ExposureSimulationTests, testLargeNettingSet, 2, 2.0);
+QL_BENCHMARK_DECLARE(ScenarioAnalysisTests, testHistoricalScenarios, 1, 2.0);
+QL_BENCHMARK_DECLARE(ScheduleTests, testSwapPortfolioSchedules, 2, 1.0);
 
 
 
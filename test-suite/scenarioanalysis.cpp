@@ -0,0 +1,223 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <https://www.quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include "toplevelfixture.hpp"
+#include "utilities.hpp"
+#include <ql/experimental/risk/scenarioanalysis.hpp>
+#include <ql/indexes/ibor/euribor.hpp>
+#include <ql/instruments/makevanillaswap.hpp>
+#include <ql/math/randomnumbers/rngtraits.hpp>
+#include <ql/pricingengines/swap/discountingswapengine.hpp>
+#include <ql/termstructures/yield/piecewiseyieldcurve.hpp>
+#include <ql/termstructures/yield/ratehelpers.hpp>
+#include <ql/time/calendars/target.hpp>
+#include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+
+using namespace QuantLib;
+using namespace boost::unit_test_framework;
+
+BOOST_FIXTURE_TEST_SUITE(QuantLibTests, TopLevelFixture)
+
+BOOST_AUTO_TEST_SUITE(ScenarioAnalysisTests)
+
+namespace {
+
+    // a curve bootstrapped on deposits and swaps, and a portfolio of
+    // swaps priced on it
+    struct Market {
+        std::vector<ext::shared_ptr<SimpleQuote> > quotes;
+        Handle<YieldTermStructure> curve;
+        std::vector<ext::shared_ptr<Instrument> > swaps;
+
+        Market(Rate level, Size numberOfSwaps) {
+            std::vector<ext::shared_ptr<RateHelper> > helpers;
+            auto index = ext::make_shared<Euribor6M>();
+            for (Integer m : { 3, 6 }) {
+                quotes.push_back(ext::make_shared<SimpleQuote>(level));
+                helpers.push_back(ext::make_shared<DepositRateHelper>(
+                    Handle<Quote>(quotes.back()), m * Months, 2, TARGET(),
+                    ModifiedFollowing, false, Actual360()));
+            }
+            for (Integer y : { 2, 5, 10, 20 }) {
+                quotes.push_back(ext::make_shared<SimpleQuote>(level + 0.001 * y));
+                helpers.push_back(ext::make_shared<SwapRateHelper>(
+                    Handle<Quote>(quotes.back()), y * Years, TARGET(), Annual,
+                    Unadjusted, Thirty360(Thirty360::BondBasis), index));
+            }
+            auto c = ext::make_shared<PiecewiseYieldCurve<Discount, LogLinear> >(
+                0, TARGET(), helpers, Actual360());
+            c->enableExtrapolation();
+            curve = Handle<YieldTermStructure>(c);
+
+            auto engine = ext::make_shared<DiscountingSwapEngine>(curve);
+            auto forecast = ext::make_shared<Euribor6M>(curve);
+            for (Size i=0; i<numberOfSwaps; ++i) {
+                Integer tenor = 1 + (i * 7) % 15;
+                Rate strike = level + 0.0001 * ((i * 13) % 50);
+                ext::shared_ptr<VanillaSwap> swap =
+                    MakeVanillaSwap(tenor * Years, forecast, strike)
+                        .withType(i % 2 == 0 ? Swap::Payer : Swap::Receiver)
+                        .withNominal(1000000.0)
+                        .withPricingEngine(engine);
+                swaps.push_back(swap);
+            }
+        }
+    };
+
+    Matrix randomShifts(Size scenarios, Size quotes, Real size,
+                        BigNatural seed = 42) {
+        PseudoRandom::rsg_type rsg =
+            PseudoRandom::make_sequence_generator(quotes, seed);
+        Matrix shifts(scenarios, quotes);
+        for (Size k=0; k<scenarios; ++k) {
+            const std::vector<Real>& z = rsg.nextSequence().value;
+            for (Size q=0; q<quotes; ++q)
+                shifts[k][q] = size * z[q];
+        }
+        return shifts;
+    }
+
+}
+
+
+BOOST_AUTO_TEST_CASE(testProfitAndLoss) {
+
+    BOOST_TEST_MESSAGE("Testing scenario profit and loss against full revaluation...");
+
+    Settings::instance().evaluationDate() = Date(15, March, 2024);
+
+    Market eur(0.03, 20), usd(0.045, 10);
+    std::vector<ext::shared_ptr<SimpleQuote> > quotes = eur.quotes;
+    quotes.insert(quotes.end(), usd.quotes.begin(), usd.quotes.end());
+    std::vector<ext::shared_ptr<Instrument> > trades = eur.swaps;
+    trades.insert(trades.end(), usd.swaps.begin(), usd.swaps.end());
+    const Size nEur = eur.swaps.size();
+
+    ScenarioAnalysis analysis(quotes, trades);
+
+    for (Size q=0; q<quotes.size(); ++q) {
+        const std::vector<Size>& affected = analysis.affectedTrades(q);
+        bool isEur = q < eur.quotes.size();
+        Size expected = isEur ? nEur : usd.swaps.size();
+        if (affected.size() != expected ||
+            (isEur && affected.back() >= nEur) ||
+            (!isEur && affected.front() < nEur))
+            BOOST_ERROR("wrong trades affected by quote " << q
+                        << " (" << affected.size() << " trades)");
+    }
+
+    Matrix shifts = randomShifts(20, quotes.size(), 0.001);
+    // only EUR quotes shifted in these scenarios...
+    for (Size k=0; k<5; ++k)
+        for (Size q=eur.quotes.size(); q<quotes.size(); ++q)
+            shifts[k][q] = 0.0;
+    // ...and no shifts at all in this one
+    for (Size q=0; q<quotes.size(); ++q)
+        shifts[5][q] = 0.0;
+
+    std::vector<Real> base = analysis.baseValues();
+    Matrix pnl = analysis.profitAndLoss(shifts);
+
+    std::vector<Real> original(quotes.size());
+    for (Size q=0; q<quotes.size(); ++q)
+        original[q] = quotes[q]->value();
+    for (Size i=0; i<trades.size(); ++i) {
+        if (std::fabs(trades[i]->NPV() - base[i]) > 1.0e-4)
+            BOOST_ERROR("base value of trade " << i << " not restored"
+                        << std::setprecision(12)
+                        << "\n    before: " << base[i]
+                        << "\n    after:  " << trades[i]->NPV());
+    }
+
+    // full revaluation
+    for (Size k=0; k<shifts.rows(); ++k) {
+        for (Size q=0; q<quotes.size(); ++q)
+            quotes[q]->setValue(original[q] + shifts[k][q]);
+        for (Size i=0; i<trades.size(); ++i) {
+            Real expected = trades[i]->NPV() - base[i];
+            if (std::fabs(pnl[k][i] - expected) > 1.0e-4)
+                BOOST_ERROR("failed to reproduce P&L of trade " << i
+                            << " in scenario " << k
+                            << std::setprecision(12)
+                            << "\n    calculated: " << pnl[k][i]
+                            << "\n    expected:   " << expected);
+            if (k < 5 && i >= nEur && pnl[k][i] != 0.0)
+                BOOST_ERROR("nonzero P&L for unaffected trade " << i
+                            << " in scenario " << k << ": " << pnl[k][i]);
+        }
+        for (Size q=0; q<quotes.size(); ++q)
+            quotes[q]->setValue(original[q]);
+    }
+    for (Size i=0; i<nEur; ++i) {
+        if (pnl[5][i] != 0.0)
+            BOOST_ERROR("nonzero P&L for trade " << i
+                        << " in unshifted scenario: " << pnl[5][i]);
+    }
+
+    Size revaluations = 5 * nEur + (shifts.rows() - 6) * trades.size();
+    if (analysis.revaluations() != revaluations)
+        BOOST_ERROR("wrong number of revaluations"
+                    << "\n    calculated: " << analysis.revaluations()
+                    << "\n    expected:   " << revaluations);
+}
+
+
+BOOST_AUTO_TEST_CASE(testHistoricalScenarios) {
+
+    BOOST_TEST_MESSAGE("Testing scenario analysis on a large portfolio...");
+
+    Settings::instance().evaluationDate() = Date(15, March, 2024);
+
+    Market market(0.03, 1000);
+    ScenarioAnalysis analysis(market.quotes, market.swaps);
+
+    Matrix shifts = randomShifts(100, market.quotes.size(), 0.0005, 1234);
+    Matrix pnl = analysis.profitAndLoss(shifts);
+    BOOST_TEST_MESSAGE("    " << analysis.throughput()
+                       << " scenarios x trades per second");
+
+    // portfolio P&L against a revaluation of the whole portfolio
+    // in a few scenarios
+    for (Size k=0; k<shifts.rows(); k+=25) {
+        std::vector<Real> original(market.quotes.size());
+        Real before = 0.0, after = 0.0;
+        for (const auto& s : market.swaps)
+            before += s->NPV();
+        for (Size q=0; q<market.quotes.size(); ++q) {
+            original[q] = market.quotes[q]->value();
+            market.quotes[q]->setValue(original[q] + shifts[k][q]);
+        }
+        for (const auto& s : market.swaps)
+            after += s->NPV();
+        for (Size q=0; q<market.quotes.size(); ++q)
+            market.quotes[q]->setValue(original[q]);
+
+        Real calculated = 0.0;
+        for (Size i=0; i<pnl.columns(); ++i)
+            calculated += pnl[k][i];
+        if (std::fabs(calculated - (after - before)) > 1.0e-2)
+            BOOST_ERROR("failed to reproduce portfolio P&L in scenario " << k
+                        << std::setprecision(12)
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << after - before);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -26,6 +26,7 @@
 #include <ql/time/calendars/weekendsonly.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/instruments/creditdefaultswap.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <map>
 #include <vector>
 
@@ -1292,6 +1293,163 @@ BOOST_AUTO_TEST_CASE(testBackwardRegularFirstPeriodWithFirstDate) {
         "Period ending at off-grid nextToLastDate should be irregular");
 }
 
+void check_same_schedule(const Schedule& s, const Schedule& expected) {
+    if (s.dates() != expected.dates()) {
+        std::ostringstream message;
+        for (auto d : s.dates())
+            message << " " << io::iso_date(d);
+        message << "\n    expected:";
+        for (auto d : expected.dates())
+            message << " " << io::iso_date(d);
+        BOOST_FAIL("schedule from " << expected.startDate()
+                   << " to " << expected.endDate()
+                   << " (" << expected.rule()
+                   << ", end of month: " << expected.endOfMonth()
+                   << "):\n    generated:" << message.str());
+    }
+    if (s.isRegular() != expected.isRegular())
+        BOOST_FAIL("schedule from " << expected.startDate()
+                   << " to " << expected.endDate()
+                   << ": mismatch in regular periods");
+    if (s.tenor() != expected.tenor() ||
+        s.calendar() != expected.calendar() ||
+        s.businessDayConvention() != expected.businessDayConvention() ||
+        s.terminationDateBusinessDayConvention() !=
+        expected.terminationDateBusinessDayConvention() ||
+        s.rule() != expected.rule() ||
+        s.endOfMonth() != expected.endOfMonth())
+        BOOST_FAIL("schedule from " << expected.startDate()
+                   << " to " << expected.endDate()
+                   << ": mismatch in schedule information");
+}
+
+BOOST_AUTO_TEST_CASE(testScheduleGenerator) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing bulk schedule generation against the schedule constructor...");
+
+    std::vector<Calendar> calendars = {
+        TARGET(), UnitedStates(UnitedStates::GovernmentBond), NullCalendar() };
+    std::vector<Period> tenors = {
+        1*Months, 3*Months, 6*Months, 1*Years, 2*Weeks };
+    std::vector<BusinessDayConvention> conventions = {
+        Following, ModifiedFollowing, Preceding, Unadjusted };
+    std::vector<DateGeneration::Rule> rules = {
+        DateGeneration::Backward, DateGeneration::Forward,
+        DateGeneration::ThirdWednesday };
+
+    // end-of-month dates, holidays and ordinary dates
+    std::vector<Date> effectiveDates = {
+        Date(31, January, 2020), Date(28, February, 2019),
+        Date(29, February, 2020), Date(30, April, 2021),
+        Date(1, January, 2021), Date(15, March, 2022),
+        Date(30, June, 2023), Date(25, December, 2023),
+        Date(13, October, 2024) };
+    std::vector<Period> maturities = {
+        1*Weeks, 2*Months, 7*Months, 1*Years, 18*Months };
+
+    std::vector<Date> starts, ends;
+    for (auto start : effectiveDates) {
+        for (auto maturity : maturities) {
+            starts.push_back(start);
+            ends.push_back(start + maturity);
+        }
+        // a short final stub
+        starts.push_back(start);
+        ends.push_back(start + 3*Years + 3);
+    }
+
+    for (const auto& calendar : calendars) {
+      for (auto tenor : tenors) {
+        for (auto convention : conventions) {
+          for (auto terminationConvention : conventions) {
+            for (auto rule : rules) {
+              for (bool endOfMonth : { false, true }) {
+                if (rule == DateGeneration::ThirdWednesday && endOfMonth)
+                    continue;
+                ScheduleGenerator generator(tenor, calendar, convention,
+                                            terminationConvention, rule,
+                                            endOfMonth);
+                for (Size i=0; i<starts.size(); ++i) {
+                    std::optional<Schedule> expected;
+                    try {
+                        expected = Schedule(starts[i], ends[i], tenor,
+                                            calendar, convention,
+                                            terminationConvention, rule,
+                                            endOfMonth);
+                    } catch (Error&) {
+                        BOOST_CHECK_THROW(generator(starts[i], ends[i]),
+                                          Error);
+                        continue;
+                    }
+                    check_same_schedule(generator(starts[i], ends[i]),
+                                        *expected);
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+
+    ScheduleGenerator generator(6*Months, TARGET(), ModifiedFollowing,
+                                ModifiedFollowing, DateGeneration::Backward,
+                                false);
+    std::vector<Schedule> schedules = generator(starts, ends);
+    BOOST_CHECK_EQUAL(schedules.size(), starts.size());
+
+    BOOST_CHECK_THROW(generator(Date(15, March, 2022), Date(15, March, 2022)),
+                      Error);
+    BOOST_CHECK_THROW(generator(starts, std::vector<Date>(1, ends[0])),
+                      Error);
+}
+
+BOOST_AUTO_TEST_CASE(testSwapPortfolioSchedules) {
+
+    BOOST_TEST_MESSAGE(
+        "Testing bulk schedule generation for a swap portfolio...");
+
+    // the legs of a portfolio of spot-starting and forward-starting
+    // swaps traded over the last ten years
+    const Size trades = 20000;
+    Calendar calendar = TARGET();
+    Date today(15, May, 2024);
+    MersenneTwisterUniformRng rng(42);
+
+    std::vector<Date> starts(trades), ends(trades);
+    for (Size i=0; i<trades; ++i) {
+        Date tradeDate = today - static_cast<Date::serial_type>(
+            3650*rng.nextReal());
+        Date start = calendar.advance(tradeDate, 2*Days);
+        if (rng.nextReal() < 0.2)
+            start = calendar.advance(
+                start, Integer(1 + 10*rng.nextReal())*Years);
+        Integer length = 1 + Integer(30*rng.nextReal());
+        starts[i] = start;
+        ends[i] = start + length*Years;
+    }
+
+    ScheduleGenerator fixedGenerator(1*Years, calendar, ModifiedFollowing,
+                                     ModifiedFollowing,
+                                     DateGeneration::Backward, false);
+    ScheduleGenerator floatingGenerator(6*Months, calendar, ModifiedFollowing,
+                                        ModifiedFollowing,
+                                        DateGeneration::Backward, false);
+    std::vector<Schedule> fixedSchedules = fixedGenerator(starts, ends);
+    std::vector<Schedule> floatingSchedules = floatingGenerator(starts, ends);
+
+    for (Size i=0; i<trades; i+=97) {
+        check_same_schedule(fixedSchedules[i],
+                            Schedule(starts[i], ends[i], 1*Years, calendar,
+                                     ModifiedFollowing, ModifiedFollowing,
+                                     DateGeneration::Backward, false));
+        check_same_schedule(floatingSchedules[i],
+                            Schedule(starts[i], ends[i], 6*Months, calendar,
+                                     ModifiedFollowing, ModifiedFollowing,
+                                     DateGeneration::Backward, false));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
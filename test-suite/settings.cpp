@@ -21,6 +21,9 @@
 #include "utilities.hpp"
 #include <ql/errors.hpp>
 #include <ql/settings.hpp>
+#ifdef QL_ENABLE_SESSIONS
+#include <thread>
+#endif
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -83,6 +86,110 @@ BOOST_AUTO_TEST_CASE(testNotificationsOnDateChange) {
         BOOST_ERROR("missing notification");
 }
 
+BOOST_AUTO_TEST_CASE(testInstancesWithoutSessions) {
+    BOOST_TEST_MESSAGE("Testing singleton instances outside explicit sessions...");
+
+    SavedSettings backup;
+
+    // the same instance is returned by each call and keeps its state
+    Settings& settings = Settings::instance();
+    Date today(18, July, 2026);
+    settings.evaluationDate() = today;
+    BOOST_CHECK(&Settings::instance() == &settings);
+    BOOST_CHECK_EQUAL(Date(Settings::instance().evaluationDate()), today);
+
+    #ifdef QL_ENABLE_SESSIONS
+    // with no session current, each thread has its own instance
+    BOOST_CHECK(Session::current() == nullptr);
+    const Settings* seen = nullptr;
+    std::thread worker([&]() { seen = &Settings::instance(); });
+    worker.join();
+    BOOST_CHECK(seen != &settings);
+    #endif
+}
+
+#ifdef QL_ENABLE_SESSIONS
+
+namespace {
+
+    // its constructor requests a local singleton created after it
+    class Inner : public Singleton<Inner> {
+        friend class Singleton<Inner>;
+      private:
+        Inner() = default;
+      public:
+        int value = 42;
+    };
+
+    class Outer : public Singleton<Outer> {
+        friend class Singleton<Outer>;
+      private:
+        Outer() : value(Inner::instance().value) {}
+      public:
+        int value;
+    };
+
+}
+
+BOOST_AUTO_TEST_CASE(testExplicitSessions) {
+    BOOST_TEST_MESSAGE("Testing explicit sessions...");
+
+    SavedSettings backup;
+
+    Date threadDate(18, July, 2026);
+    Settings::instance().evaluationDate() = threadDate;
+
+    Session first, second;
+    Date firstDate(1, March, 2025), secondDate(1, April, 2025);
+    {
+        Session::Scope scope(first);
+        BOOST_CHECK(Session::current() == &first);
+        Settings::instance().evaluationDate() = firstDate;
+        {
+            Session::Scope inner(second);
+            Settings::instance().evaluationDate() = secondDate;
+            BOOST_CHECK_EQUAL(Date(Settings::instance().evaluationDate()), secondDate);
+        }
+        // back to the first session
+        BOOST_CHECK_EQUAL(Date(Settings::instance().evaluationDate()), firstDate);
+    }
+
+    // the implicit thread session is not affected
+    BOOST_CHECK(Session::current() == nullptr);
+    BOOST_CHECK_EQUAL(Date(Settings::instance().evaluationDate()), threadDate);
+
+    // a session can be picked up by a different thread
+    Date seen;
+    std::thread worker([&]() {
+        Session::Scope scope(second);
+        seen = Settings::instance().evaluationDate();
+    });
+    worker.join();
+    BOOST_CHECK_EQUAL(seen, secondDate);
+
+    // destroying a session doesn't affect the current one
+    {
+        Session::Scope scope(first);
+        {
+            Session temporary;
+            Session::Scope inner(temporary);
+            Settings::instance().evaluationDate() = secondDate;
+        }
+        BOOST_CHECK(Session::current() == &first);
+        BOOST_CHECK_EQUAL(Date(Settings::instance().evaluationDate()), firstDate);
+    }
+
+    // instances can request other instances while being built
+    {
+        Session session;
+        Session::Scope scope(session);
+        BOOST_CHECK_EQUAL(Outer::instance().value, 42);
+        BOOST_CHECK(&Outer::instance() == &Outer::instance());
+    }
+}
+
+#endif
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
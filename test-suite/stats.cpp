@@ -26,12 +26,20 @@
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/math/statistics/gaussianstatistics.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/math/statistics/streamingstatistics.hpp>
 #include <ql/math/statistics/convergencestatistics.hpp>
 #include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/math/randomnumbers/inversecumulativerng.hpp>
 #include <ql/math/distributions/normaldistribution.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <ql/exercise.hpp>
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/quotes/simplequote.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -294,6 +302,7 @@ BOOST_AUTO_TEST_CASE(testStatistics) {
     check<IncrementalStatistics>(
         std::string("IncrementalStatistics"));
     check<Statistics>(std::string("Statistics"));
+    check<StreamingRiskStatistics>(std::string("StreamingRiskStatistics"));
 }
 
 BOOST_AUTO_TEST_CASE(testSequenceStatistics) {
@@ -303,6 +312,8 @@ BOOST_AUTO_TEST_CASE(testSequenceStatistics) {
     checkSequence<IncrementalStatistics>(
         std::string("IncrementalStatistics"),5);
     checkSequence<Statistics>(std::string("Statistics"),5);
+    checkSequence<StreamingRiskStatistics>(
+        std::string("StreamingRiskStatistics"),5);
 }
 
 BOOST_AUTO_TEST_CASE(testConvergenceStatistics) {
@@ -314,6 +325,122 @@ BOOST_AUTO_TEST_CASE(testConvergenceStatistics) {
     checkConvergence<Statistics>(std::string("Statistics"));
 }
 
+#define TEST_CLOSE_STAT(expr, expected, tolerance)                             \
+    if (std::fabs((expr) - (expected)) > (tolerance)*std::fabs(expected))      \
+        BOOST_ERROR(std::setprecision(16)                                      \
+                    << std::scientific << #expr << " (" << (expr)              \
+                    << ") differs from exact result (" << (expected)           \
+                    << ")");
+
+BOOST_AUTO_TEST_CASE(testStreamingStatistics) {
+
+    BOOST_TEST_MESSAGE("Testing streaming statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+    InverseCumulativeRng<MersenneTwisterUniformRng,InverseCumulativeNormal>
+        normal_gen(mt);
+
+    const Size N = 100000;
+    Statistics exact;
+    StreamingRiskStatistics streaming;
+    // no exact tail: all quantiles are estimated by the digest
+    StreamingStatistics digestOnly(0);
+    std::vector<StreamingRiskStatistics> parts(4);
+
+    for (Size i=0; i<N; ++i) {
+        // skewed distribution with a fat lower tail
+        Real x = 1.0 - std::exp(0.5*normal_gen.next().value);
+        exact.add(x);
+        streaming.add(x);
+        digestOnly.add(x);
+        parts[i % parts.size()].add(x);
+    }
+
+    StreamingRiskStatistics merged = parts.front();
+    for (Size i=1; i<parts.size(); ++i)
+        merged.merge(parts[i]);
+
+    const Real tolerance = 1.0e-10;
+    for (const auto& s : {streaming, merged}) {
+        if (s.samples() != N)
+            BOOST_FAIL("wrong number of samples"
+                       << "\n    calculated: " << s.samples()
+                       << "\n    expected:   " << N);
+
+        TEST_CLOSE_STAT(s.mean(), exact.mean(), tolerance)
+        TEST_CLOSE_STAT(s.variance(), exact.variance(), tolerance)
+        TEST_CLOSE_STAT(s.skewness(), exact.skewness(), tolerance)
+        TEST_CLOSE_STAT(s.kurtosis(), exact.kurtosis(), tolerance)
+        TEST_CLOSE_STAT(s.min(), exact.min(), 0.0)
+        TEST_CLOSE_STAT(s.max(), exact.max(), 0.0)
+
+        // the tail of 1000 samples covers the lowest 1% exactly
+        TEST_CLOSE_STAT(s.percentile(0.005), exact.percentile(0.005), 0.0)
+        TEST_CLOSE_STAT(s.valueAtRisk(0.99), exact.valueAtRisk(0.99), 0.0)
+        TEST_CLOSE_STAT(s.expectedShortfall(0.99),
+                        exact.expectedShortfall(0.99), tolerance)
+        TEST_CLOSE_STAT(s.expectedShortfall(0.995),
+                        exact.expectedShortfall(0.995), tolerance)
+        TEST_CLOSE_STAT(s.shortfall(exact.percentile(0.002)),
+                        exact.shortfall(exact.percentile(0.002)), tolerance)
+    }
+
+    // quantiles estimated by the digest are checked by the rank error
+    const std::vector<std::pair<Real,Real> >& samples = exact.data();
+    const auto rank = [&](Real x) {
+        Size below = 0;
+        for (const auto& sample : samples)
+            below += (sample.first < x) ? 1 : 0;
+        return Real(below)/N;
+    };
+    const std::pair<Real,Real> levels[] = {
+        {0.0001, 0.0001}, {0.001, 0.0002}, {0.01, 0.001},
+        {0.1, 0.003}, {0.5, 0.005}, {0.9, 0.003}, {0.999, 0.0002}};
+    for (const auto& level : levels) {
+        const Real estimates[] = {streaming.percentile(level.first),
+                                  merged.percentile(level.first),
+                                  digestOnly.percentile(level.first)};
+        for (Real q : estimates) {
+            const Real error = std::fabs(rank(q) - level.first);
+            if (error > level.second)
+                BOOST_ERROR("percentile out of tolerance"
+                            << "\n    level:      " << level.first
+                            << "\n    calculated: " << q
+                            << "\n    exact:      " << exact.percentile(level.first)
+                            << "\n    rank error: " << error
+                            << "\n    tolerance:  " << level.second);
+        }
+    }
+
+    // use as a Monte Carlo statistics policy
+    const DayCounter dc = Actual365Fixed();
+    const Date today = Date(17, May, 2024);
+    Settings::instance().evaluationDate() = today;
+    const auto spot = ext::make_shared<SimpleQuote>(100.0);
+    const auto process = ext::make_shared<BlackScholesMertonProcess>(
+        Handle<Quote>(spot),
+        Handle<YieldTermStructure>(flatRate(today, 0.01, dc)),
+        Handle<YieldTermStructure>(flatRate(today, 0.03, dc)),
+        Handle<BlackVolTermStructure>(flatVol(today, 0.2, dc)));
+
+    VanillaOption option(
+        ext::make_shared<PlainVanillaPayoff>(Option::Put, 100.0),
+        ext::make_shared<EuropeanExercise>(today + Period(1, Years)));
+
+    option.setPricingEngine(MakeMCEuropeanEngine<PseudoRandom>(process)
+                            .withSteps(1).withSamples(10000).withSeed(42));
+    const Real expectedNPV = option.NPV();
+    const Real expectedError = option.errorEstimate();
+    if (expectedNPV <= 0.0)
+        BOOST_FAIL("non-positive option value (" << expectedNPV << ")");
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom, StreamingRiskStatistics>(process)
+        .withSteps(1).withSamples(10000).withSeed(42));
+    TEST_CLOSE_STAT(option.NPV(), expectedNPV, tolerance)
+    TEST_CLOSE_STAT(option.errorEstimate(), expectedError, tolerance)
+}
+
 #define TEST_INC_STAT(expr, expected)                                          \
     if (!close_enough(expr, expected))                                         \
         BOOST_ERROR(std::setprecision(16)                                      \
@@ -377,6 +504,150 @@ BOOST_AUTO_TEST_CASE(testIncrementalStatistics) {
                                  << tol);
 }
 
+BOOST_AUTO_TEST_CASE(testMergedStatistics) {
+
+    BOOST_TEST_MESSAGE("Testing merged statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+
+    IncrementalStatistics incremental;
+    GaussianStatistics general;
+    std::vector<IncrementalStatistics> incrementalParts(4);
+    std::vector<GaussianStatistics> generalParts(4);
+
+    const Size N = 10000;
+    for (Size i=0; i<N; ++i) {
+        Real x = 2.0 * (mt.nextReal() - 0.5) * 1234.0 + 100.0;
+        Real w = mt.nextReal();
+        incremental.add(x, w);
+        general.add(x, w);
+        // the last part is left empty
+        incrementalParts[i % 3].add(x, w);
+        generalParts[i % 3].add(x, w);
+    }
+
+    IncrementalStatistics incrementalMerged;
+    GaussianStatistics generalMerged;
+    for (Size i=0; i<incrementalParts.size(); ++i) {
+        incrementalMerged.merge(incrementalParts[i]);
+        generalMerged.merge(generalParts[i]);
+    }
+
+    if (incrementalMerged.samples() != N
+        || incrementalMerged.downsideSamples() != incremental.downsideSamples())
+        BOOST_FAIL("wrong number of samples after merge"
+                   << "\n    calculated: " << incrementalMerged.samples()
+                   << "\n    expected:   " << N);
+
+    const Real tolerance = 1.0e-12;
+    TEST_CLOSE_STAT(incrementalMerged.weightSum(), incremental.weightSum(),
+                    tolerance)
+    TEST_CLOSE_STAT(incrementalMerged.mean(), incremental.mean(), tolerance)
+    TEST_CLOSE_STAT(incrementalMerged.variance(), incremental.variance(),
+                    tolerance)
+    TEST_CLOSE_STAT(incrementalMerged.skewness(), incremental.skewness(),
+                    1.0e-8)
+    TEST_CLOSE_STAT(incrementalMerged.kurtosis(), incremental.kurtosis(),
+                    tolerance)
+    TEST_CLOSE_STAT(incrementalMerged.min(), incremental.min(), 0.0)
+    TEST_CLOSE_STAT(incrementalMerged.max(), incremental.max(), 0.0)
+    TEST_CLOSE_STAT(incrementalMerged.downsideVariance(),
+                    incremental.downsideVariance(), tolerance)
+
+    if (generalMerged.samples() != N)
+        BOOST_FAIL("wrong number of samples after merge"
+                   << "\n    calculated: " << generalMerged.samples()
+                   << "\n    expected:   " << N);
+
+    TEST_CLOSE_STAT(generalMerged.mean(), general.mean(), tolerance)
+    TEST_CLOSE_STAT(generalMerged.variance(), general.variance(), tolerance)
+    TEST_CLOSE_STAT(generalMerged.gaussianPercentile(0.95),
+                    general.gaussianPercentile(0.95), tolerance)
+    TEST_CLOSE_STAT(generalMerged.percentile(0.95), general.percentile(0.95),
+                    0.0)
+
+    // merging an instance with itself doubles the weights
+    IncrementalStatistics doubled = incremental;
+    doubled.merge(doubled);
+    TEST_CLOSE_STAT(doubled.weightSum(), 2.0*incremental.weightSum(), 0.0)
+    TEST_CLOSE_STAT(doubled.mean(), incremental.mean(), tolerance)
+    TEST_CLOSE_STAT(doubled.variance(),
+                    incremental.variance()*(2.0*N-2.0)/(2.0*N-1.0), tolerance)
+}
+
+BOOST_AUTO_TEST_CASE(testBatchedSequenceStatistics) {
+
+    BOOST_TEST_MESSAGE("Testing batched and merged sequence statistics...");
+
+    MersenneTwisterUniformRng mt(42);
+
+    const Size dimension = 8, N = 1000;
+    Matrix samples(N, dimension);
+    std::vector<Real> weights(N);
+    for (Size k=0; k<N; ++k) {
+        Real common = mt.nextReal();
+        for (Size i=0; i<dimension; ++i)
+            samples[k][i] = (i+1)*common + mt.nextReal();
+        weights[k] = mt.nextReal();
+    }
+
+    SequenceStatisticsInc sequential(dimension), batched, merged;
+    SequenceStatisticsInc first, second;
+    for (Size k=0; k<N; ++k) {
+        std::vector<Real> sample(samples.row_begin(k), samples.row_end(k));
+        sequential.add(sample, weights[k]);
+        if (k < N/3)
+            first.add(sample, weights[k]);
+        else
+            second.add(sample, weights[k]);
+    }
+    // uneven batches
+    for (Size k=0; k<N; k+=300) {
+        Size n = std::min<Size>(300, N-k);
+        Matrix batch(n, dimension);
+        std::copy(samples.row_begin(k), samples.row_begin(k) + n*dimension,
+                  batch.begin());
+        batched.addBatch(batch, std::vector<Real>(weights.begin() + k,
+                                                  weights.begin() + k + n));
+    }
+    merged.merge(first);
+    merged.merge(second);
+
+    if (batched.samples() != N || merged.samples() != N)
+        BOOST_FAIL("wrong number of samples"
+                   << "\n    batched:  " << batched.samples()
+                   << "\n    merged:   " << merged.samples()
+                   << "\n    expected: " << N);
+
+    const std::vector<Real> mean = sequential.mean();
+    const std::vector<Real> variance = sequential.variance();
+    const Matrix covariance = sequential.covariance();
+    const Matrix batchedCovariance = batched.covariance();
+    const Matrix mergedCovariance = merged.covariance();
+    for (Size i=0; i<dimension; ++i) {
+        // batches are accumulated in the same order as single samples
+        TEST_CLOSE_STAT(batched.mean()[i], mean[i], 0.0)
+        TEST_CLOSE_STAT(batched.variance()[i], variance[i], 0.0)
+        TEST_CLOSE_STAT(merged.mean()[i], mean[i], 1.0e-12)
+        TEST_CLOSE_STAT(merged.variance()[i], variance[i], 1.0e-12)
+        for (Size j=0; j<dimension; ++j) {
+            TEST_CLOSE_STAT(batchedCovariance[i][j], covariance[i][j], 0.0)
+            TEST_CLOSE_STAT(mergedCovariance[i][j], covariance[i][j], 1.0e-10)
+        }
+    }
+
+    // unit weights are used if none are given
+    SequenceStatistics unweighted, reference;
+    unweighted.addBatch(samples);
+    for (Size k=0; k<N; ++k)
+        reference.add(samples.row_begin(k), samples.row_end(k));
+    TEST_CLOSE_STAT(unweighted.weightSum(), Real(N), 0.0)
+    TEST_CLOSE_STAT(unweighted.percentile(0.9)[dimension-1],
+                    reference.percentile(0.9)[dimension-1], 0.0)
+    TEST_CLOSE_STAT(unweighted.correlation()[0][dimension-1],
+                    reference.correlation()[0][dimension-1], 0.0)
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -581,6 +581,53 @@ BOOST_AUTO_TEST_CASE(testSabrVols) {
     vars.makeVolSpreadsTest(volCube, tolerance);
 }
 
+BOOST_AUTO_TEST_CASE(testSabrVolsWithWarmStart) {
+
+    BOOST_TEST_MESSAGE("Testing swaption volatility cube (sabr interpolation) "
+                       "with warm-started calibration...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (auto& guess : parametersGuess) {
+        guess = {
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.2)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.5)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.4)),
+            Handle<Quote>(ext::make_shared<SimpleQuote>(0.0))
+        };
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    SabrSwaptionVolatilityCube volCube(vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             true,
+                             ext::shared_ptr<EndCriteria>(),
+                             Null<Real>(),
+                             ext::shared_ptr<OptimizationMethod>(),
+                             Null<Real>(),
+                             false,
+                             50,
+                             false,
+                             0.0001,
+                             false,
+                             true);
+    Real tolerance = 3.0e-4;
+    vars.makeAtmVolTest(volCube, tolerance);
+
+    tolerance = 12.0e-4;
+    vars.makeVolSpreadsTest(volCube, tolerance);
+}
+
 BOOST_AUTO_TEST_CASE(testSpreadedCube) {
 
     BOOST_TEST_MESSAGE("Testing spreaded swaption volatility cube...");